@@ -48,3 +48,44 @@ TEST(Chinese2PinyinTest, NonDictCharPassesThrough)
     QString result = Chinese2Pinyin(emoji);
     EXPECT_EQ(result, emoji);
 }
+
+TEST(Chinese2PinyinTest, SyllableOfDenseAndSparseRanges)
+{
+    EXPECT_EQ(syllableOf(u'中'), QLatin1String("zhong1"));
+    EXPECT_EQ(syllableOf(u'㐀'), QLatin1String("qiu1"));
+    // CJK compatibility ideograph U+FA2D, stored outside the dense range
+    EXPECT_EQ(syllableOf(char16_t(0xFA2D)), QLatin1String("he4"));
+    EXPECT_TRUE(syllableOf(char16_t(0xFA2E)).isEmpty());
+    EXPECT_TRUE(syllableOf(u'a').isEmpty());
+    // inside the dense range but not in the dictionary
+    EXPECT_TRUE(syllableOf(char16_t(0x4E06)).isEmpty());
+}
+
+TEST(Chinese2PinyinTest, AppendPinyinFillsFullAndInitials)
+{
+    QString full = QStringLiteral("x");
+    QString initials;
+    EXPECT_TRUE(appendPinyin(QString::fromUtf8("文档1.txt"), &full, &initials));
+    EXPECT_EQ(full, QString("xwen2dang31.txt"));
+    EXPECT_EQ(initials, QString("wd1.txt"));
+    EXPECT_EQ(Chinese2Pinyin(QString::fromUtf8("文档")), QString("wen2dang3"));
+
+    full.clear();
+    EXPECT_FALSE(appendPinyin(u"readme", &full));
+    EXPECT_EQ(full, QString("readme"));
+}
+
+TEST(Chinese2PinyinTest, MatchInitials)
+{
+    const QString name = QString::fromUtf8("我的文档.txt");
+    EXPECT_TRUE(matchInitials(name, u"wd"));
+    EXPECT_TRUE(matchInitials(name, u"WDW"));
+    EXPECT_FALSE(matchInitials(name, u"dw"));
+    EXPECT_TRUE(matchInitials(name, u"dw", false));
+    EXPECT_TRUE(matchInitials(name, u"wd", false));
+    EXPECT_TRUE(matchInitials(name, u"wd.t", false));
+    EXPECT_FALSE(matchInitials(name, u"xy", false));
+    // 不含汉字时不按首字母匹配
+    EXPECT_FALSE(matchInitials(u"wd.txt", u"wd"));
+    EXPECT_FALSE(matchInitials(name, u""));
+}
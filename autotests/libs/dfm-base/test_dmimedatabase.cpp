@@ -130,3 +130,25 @@ TEST(DMimeDatabaseTest, MimeTypeForFileNonExistentPathByExtensionStillResolvesSu
     EXPECT_TRUE(mime.isValid());
     EXPECT_EQ(mime.name(), QStringLiteral("text/plain"));
 }
+
+TEST(DMimeDatabaseTest, MimeTypeForFileRewrittenContentIsNotServedFromCache)
+{
+    // No suffix: the result depends on content sniffing only.
+    QString path = utMakeTempFile(QString(), "plain text content\n");
+    ASSERT_FALSE(path.isEmpty());
+
+    DMimeDatabase db;
+    QMimeType text = db.mimeTypeForFile(path, QMimeDatabase::MatchContent, QString(), false);
+    ASSERT_TRUE(text.inherits(QStringLiteral("text/plain")));
+
+    // Rewrite as a PNG header with a different size, so (mtime, size) no longer match.
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(QByteArray::fromHex("89504e470d0a1a0a0000000d49484452"));
+    file.close();
+
+    QMimeType png = db.mimeTypeForFile(path, QMimeDatabase::MatchContent, QString(), false);
+    EXPECT_EQ(png.name(), QStringLiteral("image/png"));
+
+    utCleanup(path);
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_embeddedpreview.cpp
+ * @brief Unit tests for EmbeddedPreview (embeddedpreview.cpp)
+ *
+ * The EXIF/TIFF structures are assembled in memory around small JPEGs
+ * produced by QImage, so no sample photos are needed.
+ */
+
+#include <gtest/gtest.h>
+#include <dfm-base/utils/thumbnail/embeddedpreview.h>
+
+#include <QBuffer>
+#include <QtEndian>
+
+using namespace dfmbase;
+
+namespace {
+QByteArray jpegOf(int width, int height)
+{
+    QImage img(width, height, QImage::Format_RGB32);
+    img.fill(Qt::red);
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    img.save(&buffer, "jpeg");
+    return data;
+}
+
+void appendU16(QByteArray *out, quint16 v)
+{
+    char b[2];
+    qToLittleEndian(v, b);
+    out->append(b, 2);
+}
+
+void appendU32(QByteArray *out, quint32 v)
+{
+    char b[4];
+    qToLittleEndian(v, b);
+    out->append(b, 4);
+}
+
+void appendEntry(QByteArray *out, quint16 tag, quint16 type, quint32 count, quint32 value)
+{
+    appendU16(out, tag);
+    appendU16(out, type);
+    appendU32(out, count);
+    if (type == 3) {
+        appendU16(out, static_cast<quint16>(value));
+        appendU16(out, 0);
+    } else {
+        appendU32(out, value);
+    }
+}
+
+/*!
+ * 小端 TIFF：IFD0 只有 Orientation，IFD1 指向紧随其后的 JPEG 预览
+ */
+QByteArray tiffWithPreview(const QByteArray &preview, quint16 orientation)
+{
+    QByteArray tiff("II*\0", 4);
+    appendU32(&tiff, 8);
+
+    // IFD0 @8: 1 个条目，12 字节，下一个 IFD @26
+    appendU16(&tiff, 1);
+    appendEntry(&tiff, 0x0112, 3, 1, orientation);
+    appendU32(&tiff, 26);
+
+    // IFD1 @26: 2 个条目，预览数据 @56
+    appendU16(&tiff, 2);
+    appendEntry(&tiff, 0x0201, 4, 1, 56);
+    appendEntry(&tiff, 0x0202, 4, 1, static_cast<quint32>(preview.size()));
+    appendU32(&tiff, 0);
+
+    tiff.append(preview);
+    return tiff;
+}
+}   // namespace
+
+TEST(EmbeddedPreviewTest, ContainerOfRecognizesSignatures)
+{
+    EXPECT_EQ(EmbeddedPreview::containerOf(jpegOf(4, 4)), EmbeddedPreview::Container::kJpeg);
+    EXPECT_EQ(EmbeddedPreview::containerOf(QByteArray("II*\0", 4)), EmbeddedPreview::Container::kTiff);
+    EXPECT_EQ(EmbeddedPreview::containerOf(QByteArray("MM\0*", 4)), EmbeddedPreview::Container::kTiff);
+    EXPECT_EQ(EmbeddedPreview::containerOf(QByteArray("IIRO", 4)), EmbeddedPreview::Container::kTiff);
+    EXPECT_EQ(EmbeddedPreview::containerOf(QByteArray("\x89PNG", 4)), EmbeddedPreview::Container::kUnknown);
+    EXPECT_EQ(EmbeddedPreview::containerOf(QByteArray("II")), EmbeddedPreview::Container::kUnknown);
+}
+
+TEST(EmbeddedPreviewTest, FindsExifThumbnailInJpeg)
+{
+    const QByteArray preview = jpegOf(160, 120);
+    const QByteArray tiff = tiffWithPreview(preview, 6);
+
+    QByteArray app1("\xFF\xE1", 2);
+    char len[2];
+    qToBigEndian<quint16>(static_cast<quint16>(2 + 6 + tiff.size()), len);
+    app1.append(len, 2);
+    app1.append("Exif\0\0", 6);
+    app1.append(tiff);
+
+    QByteArray file = jpegOf(640, 480);
+    file.insert(2, app1);
+
+    QBuffer buffer(&file);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+    const auto &result = EmbeddedPreview::find(&buffer, EmbeddedPreview::Container::kJpeg);
+
+    ASSERT_EQ(result.candidates.size(), 1);
+    EXPECT_EQ(result.orientation, 6);
+    // APP1 头 4 字节 + "Exif\0\0" 6 字节之后才是 TIFF 数据
+    EXPECT_EQ(result.candidates.first().offset, 2 + 4 + 6 + 56);
+    EXPECT_EQ(file.mid(result.candidates.first().offset, result.candidates.first().length), preview);
+}
+
+TEST(EmbeddedPreviewTest, FindsPreviewInTiffBasedRaw)
+{
+    const QByteArray preview = jpegOf(320, 240);
+    QByteArray file = tiffWithPreview(preview, 1);
+
+    QBuffer buffer(&file);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+    const auto &result = EmbeddedPreview::find(&buffer, EmbeddedPreview::containerOf(file));
+
+    ASSERT_EQ(result.candidates.size(), 1);
+    EXPECT_EQ(result.orientation, 1);
+    EXPECT_EQ(result.candidates.first().offset, 56);
+    EXPECT_EQ(result.candidates.first().length, preview.size());
+}
+
+TEST(EmbeddedPreviewTest, TruncatedPreviewIsRejected)
+{
+    QByteArray file = tiffWithPreview(jpegOf(32, 32), 1);
+    file.chop(10);
+
+    QBuffer buffer(&file);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+    EXPECT_TRUE(EmbeddedPreview::find(&buffer, EmbeddedPreview::Container::kTiff).candidates.isEmpty());
+}
+
+TEST(EmbeddedPreviewTest, ApplyOrientationRotatesAndMirrors)
+{
+    QImage img(4, 2, QImage::Format_RGB32);
+    img.fill(Qt::black);
+    img.setPixel(0, 0, qRgb(255, 255, 255));
+
+    EXPECT_EQ(EmbeddedPreview::applyOrientation(img, 1).size(), QSize(4, 2));
+    EXPECT_EQ(EmbeddedPreview::applyOrientation(img, 6).size(), QSize(2, 4));
+    EXPECT_EQ(EmbeddedPreview::applyOrientation(img, 8).size(), QSize(2, 4));
+
+    // 旋转 90 度后左上角移动到右上角
+    EXPECT_EQ(EmbeddedPreview::applyOrientation(img, 6).pixel(1, 0), qRgb(255, 255, 255));
+    EXPECT_EQ(EmbeddedPreview::applyOrientation(img, 2).pixel(3, 0), qRgb(255, 255, 255));
+}
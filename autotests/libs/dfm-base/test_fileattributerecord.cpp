@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_fileattributerecord.cpp
+ * @brief Unit tests for FileAttributeRecord (file/local/private/fileattributerecord.cpp)
+ *        Covers packed/extended storage, change detection, typed round trips,
+ *        statx back-filling and the per-file memory footprint against a QMap.
+ */
+
+#include <gtest/gtest.h>
+#include <QDateTime>
+#include <QDebug>
+#include <QTemporaryDir>
+
+#include <dfm-base/file/local/private/fileattributerecord.h>
+
+#include <dfm-io/dfile.h>
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <sys/stat.h>
+
+#include <vector>
+
+using namespace dfmbase;
+using AttributeID = FileInfo::FileInfoAttributeID;
+
+namespace {
+
+template<typename Store>
+void fillAttributes(Store &store, int index)
+{
+    const QString name = QString("document-%1.txt").arg(index);
+    const QString dir = QStringLiteral("/run/user/1000/gvfs/smb-share:server=nas,share=data/projects");
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    store(AttributeID::kStandardName, name);
+    store(AttributeID::kStandardBaseName, QString("document-%1").arg(index));
+    store(AttributeID::kStandardCompleteBaseName, QString("document-%1").arg(index));
+    store(AttributeID::kStandardCompleteSuffix, QStringLiteral("txt"));
+    store(AttributeID::kStandardDisplayName, name);
+    store(AttributeID::kStandardFilePath, dir + "/" + name);
+    store(AttributeID::kStandardParentPath, dir);
+    store(AttributeID::kStandardSymlinkTarget, QString());
+    store(AttributeID::kOwnerUser, QStringLiteral("uos"));
+    store(AttributeID::kOwnerGroup, QStringLiteral("uos"));
+    store(AttributeID::kStandardContentType, QStringLiteral("text/plain"));
+    store(AttributeID::kStandardFastContentType, QStringLiteral("text/plain"));
+    store(AttributeID::kStandardIcon, QStringList { "text-plain", "text-x-generic" });
+    store(AttributeID::kStandardSize, qint64(4096 + index));
+    store(AttributeID::kTimeModified, now);
+    store(AttributeID::kTimeAccess, now);
+    store(AttributeID::kTimeChanged, now);
+    store(AttributeID::kTimeCreated, now);
+    store(AttributeID::kUnixInode, qint64(100000 + index));
+    store(AttributeID::kTimeModifiedUsec, quint32(index % 1000000));
+    store(AttributeID::kTimeAccessUsec, quint32(index % 1000000));
+    store(AttributeID::kTimeChangedUsec, quint32(index % 1000000));
+    store(AttributeID::kTimeCreatedUsec, quint32(index % 1000000));
+    store(AttributeID::kUnixUID, quint32(1000));
+    store(AttributeID::kUnixGID, quint32(1000));
+    store(AttributeID::kStandardFileType, QVariant::fromValue(FileInfo::FileType::kRegularFile));
+    store(AttributeID::kStandardIsHidden, false);
+    store(AttributeID::kStandardIsFile, true);
+    store(AttributeID::kStandardIsDir, false);
+    store(AttributeID::kStandardIsSymlink, false);
+    store(AttributeID::kStandardFileExists, true);
+    store(AttributeID::kStandardIsLocalDevice, false);
+    store(AttributeID::kStandardIsCdRomDevice, false);
+    store(AttributeID::kAccessCanRead, true);
+    store(AttributeID::kAccessCanWrite, true);
+    store(AttributeID::kAccessCanExecute, false);
+    store(AttributeID::kAccessCanDelete, true);
+    store(AttributeID::kAccessCanTrash, false);
+    store(AttributeID::kAccessCanRename, true);
+    store(AttributeID::kOriginalUri, QString());
+}
+
+size_t heapInUse()
+{
+    return mallinfo2().uordblks;
+}
+
+}   // namespace
+
+TEST(FileAttributeRecordTest, PackedValuesRoundTrip)
+{
+    FileAttributeRecord record;
+    EXPECT_TRUE(record.setValue(AttributeID::kStandardName, QStringLiteral("a.txt")));
+    EXPECT_TRUE(record.setValue(AttributeID::kStandardSize, qint64(1) << 40));
+    EXPECT_TRUE(record.setValue(AttributeID::kUnixUID, quint32(1000)));
+    EXPECT_TRUE(record.setValue(AttributeID::kStandardIsDir, true));
+    EXPECT_TRUE(record.setValue(AttributeID::kStandardIcon, QStringList { "text-plain" }));
+
+    EXPECT_EQ(record.value(AttributeID::kStandardName).toString(), "a.txt");
+    EXPECT_EQ(record.value(AttributeID::kStandardSize).toLongLong(), qint64(1) << 40);
+    EXPECT_EQ(record.value(AttributeID::kUnixUID).toUInt(), 1000u);
+    EXPECT_TRUE(record.value(AttributeID::kStandardIsDir).toBool());
+    EXPECT_FALSE(record.value(AttributeID::kStandardIsFile).isValid());
+    EXPECT_EQ(record.value(AttributeID::kStandardIcon).toStringList(), QStringList { "text-plain" });
+}
+
+TEST(FileAttributeRecordTest, SetValueReportsChanges)
+{
+    FileAttributeRecord record;
+    EXPECT_TRUE(record.setValue(AttributeID::kAccessCanRead, false));
+    EXPECT_FALSE(record.setValue(AttributeID::kAccessCanRead, false));
+    EXPECT_TRUE(record.setValue(AttributeID::kAccessCanRead, true));
+
+    EXPECT_TRUE(record.setValue(AttributeID::kStandardFilePath, QStringLiteral("/a")));
+    EXPECT_FALSE(record.setValue(AttributeID::kStandardFilePath, QStringLiteral("/a")));
+
+    // 空字符串也是有效值，与未设置不同
+    EXPECT_TRUE(record.setValue(AttributeID::kStandardSymlinkTarget, QString()));
+    EXPECT_TRUE(record.contains(AttributeID::kStandardSymlinkTarget));
+}
+
+TEST(FileAttributeRecordTest, InvalidValueRemovesAttribute)
+{
+    FileAttributeRecord record;
+    record.setValue(AttributeID::kTimeModified, qint64(10));
+    record.setValue(AttributeID::kOriginalUri, QStringLiteral("smb://nas/a"));
+
+    EXPECT_TRUE(record.setValue(AttributeID::kTimeModified, QVariant()));
+    EXPECT_FALSE(record.contains(AttributeID::kTimeModified));
+    EXPECT_FALSE(record.setValue(AttributeID::kTimeModified, QVariant()));
+
+    EXPECT_TRUE(record.setValue(AttributeID::kOriginalUri, QVariant()));
+    EXPECT_FALSE(record.contains(AttributeID::kOriginalUri));
+}
+
+TEST(FileAttributeRecordTest, UnpackedAttributesUseExtendedMap)
+{
+    EXPECT_FALSE(FileAttributeRecord::isPacked(AttributeID::kOriginalUri));
+    EXPECT_TRUE(FileAttributeRecord::isPacked(AttributeID::kStandardName));
+
+    FileAttributeRecord record;
+    EXPECT_TRUE(record.setValue(AttributeID::kOriginalUri, QStringLiteral("smb://nas/a")));
+    EXPECT_FALSE(record.setValue(AttributeID::kOriginalUri, QStringLiteral("smb://nas/a")));
+    EXPECT_EQ(record.value(AttributeID::kOriginalUri).toString(), "smb://nas/a");
+}
+
+TEST(FileAttributeRecordTest, TypedValuesRoundTrip)
+{
+    FileAttributeRecord record;
+    record.setValue(AttributeID::kStandardFileType, QVariant::fromValue(FileInfo::FileType::kDirectory));
+    EXPECT_EQ(record.value(AttributeID::kStandardFileType).value<FileInfo::FileType>(), FileInfo::FileType::kDirectory);
+
+    const DFMIO::DFile::Permissions perms = DFMIO::DFile::Permission::kReadOwner | DFMIO::DFile::Permission::kWriteOwner;
+    record.setValue(AttributeID::kAccessPermissions, QVariant::fromValue(perms));
+    EXPECT_EQ(record.value(AttributeID::kAccessPermissions).value<DFMIO::DFile::Permissions>(), perms);
+    EXPECT_FALSE(record.setValue(AttributeID::kAccessPermissions, QVariant::fromValue(perms)));
+}
+
+TEST(FileAttributeRecordTest, StatxFillsOnlyMissingAttributes)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    struct statx stx;
+    ASSERT_EQ(statx(AT_FDCWD, dir.path().toUtf8().constData(), AT_SYMLINK_NOFOLLOW, STATX_BASIC_STATS, &stx), 0);
+
+    FileAttributeRecord record;
+    record.setValue(AttributeID::kUnixUID, quint32(4242));
+    record.fillMissingFromStatx(stx);
+
+    EXPECT_EQ(record.value(AttributeID::kUnixUID).toUInt(), 4242u);
+    EXPECT_EQ(record.value(AttributeID::kUnixGID).toUInt(), stx.stx_gid);
+    EXPECT_EQ(record.value(AttributeID::kUnixInode).toULongLong(), stx.stx_ino);
+    EXPECT_TRUE(S_ISDIR(record.value(AttributeID::kUnixMode).toUInt()));
+    EXPECT_TRUE(record.contains(AttributeID::kUnixDevice));
+}
+
+TEST(FileAttributeRecordTest, MemoryPerFileBenchmark)
+{
+    constexpr int kCount = 100000;
+    malloc_trim(0);
+
+    size_t before = heapInUse();
+    std::vector<QMap<AttributeID, QVariant>> maps(kCount);
+    for (int i = 0; i < kCount; ++i)
+        fillAttributes([&](AttributeID id, const QVariant &v) { maps[i].insert(id, v); }, i);
+    const size_t mapBytes = heapInUse() - before;
+    maps.clear();
+    maps.shrink_to_fit();
+    malloc_trim(0);
+
+    before = heapInUse();
+    std::vector<FileAttributeRecord> records(kCount);
+    for (int i = 0; i < kCount; ++i)
+        fillAttributes([&](AttributeID id, const QVariant &v) { records[i].setValue(id, v); }, i);
+    const size_t recordBytes = heapInUse() - before;
+
+    const double mapPerFile = double(mapBytes) / kCount;
+    const double recordPerFile = double(recordBytes) / kCount;
+    qInfo() << "attribute cache per file: QMap" << mapPerFile << "bytes, record" << recordPerFile << "bytes";
+    RecordProperty("qmap_bytes_per_file", QString::number(mapPerFile, 'f', 1).toStdString());
+    RecordProperty("record_bytes_per_file", QString::number(recordPerFile, 'f', 1).toStdString());
+
+    EXPECT_LT(recordBytes, mapBytes);
+}
@@ -14,12 +14,18 @@
 #include <QUrl>
 #include <QIcon>
 #include <QMimeDatabase>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <atomic>
 #include <mutex>
 
+#include "stubext.h"
+
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/file/local/asyncfileinfo.h>
 #include <dfm-base/utils/fileinfohelper.h>
+#include <dfm-base/utils/protocolutils.h>
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/interfaces/fileinfo.h>
 
@@ -117,3 +123,191 @@ TEST_F(FileInfoHelperTest, HandleFileRefreshCallable)
     ASSERT_NE(info, nullptr);
     EXPECT_NO_FATAL_FAILURE({ FileInfoHelper::instance().handleFileRefresh(info); });
 }
+
+TEST_F(FileInfoHelperTest, HandleFileRefreshGroupsByDirectory)
+{
+    auto &helper = FileInfoHelper::instance();
+    QSharedPointer<AsyncFileInfo> first(new AsyncFileInfo(url));
+    QSharedPointer<AsyncFileInfo> second(new AsyncFileInfo(QUrl::fromLocalFile(rootPath + "/other.txt")));
+
+    helper.handleFileRefresh(first);
+    helper.handleFileRefresh(second);
+    // 查询中的文件再次刷新时只记录一次，等本次查询结束后重新查询
+    helper.handleFileRefresh(first);
+    helper.handleFileRefresh(first);
+
+    const QUrl dirUrl = QUrl::fromLocalFile(rootPath);
+    EXPECT_EQ(helper.pendingRefreshInfos.value(dirUrl).size(), 2);
+    EXPECT_TRUE(helper.queryingInfos.contains(first));
+    EXPECT_TRUE(helper.needQueryInfos.contains(first));
+    EXPECT_FALSE(helper.needQueryInfos.contains(second));
+
+    helper.handleCheckInfoRefresh(second);
+    EXPECT_FALSE(helper.queryingInfos.contains(second));
+
+    helper.pendingRefreshInfos.clear();
+    helper.queryingInfos.clear();
+    helper.needQueryInfos.clear();
+}
+
+TEST_F(FileInfoHelperTest, FlushPendingRefresh_LargeLocalGroupsEnumerateOthersQueryAsync)
+{
+    auto &helper = FileInfoHelper::instance();
+    stub_ext::StubExt stub;
+
+    const QUrl largeDir = QUrl::fromLocalFile(rootPath + "/large");
+    const QUrl smallDir = QUrl::fromLocalFile(rootPath + "/small");
+    const QUrl remoteDir = QUrl::fromLocalFile(rootPath + "/remote");
+    stub.set_lamda(&ProtocolUtils::isLocalFile, [remoteDir](const QUrl &url) {
+        __DBG_STUB_INVOKE__
+        return url != remoteDir;
+    });
+
+    std::atomic_int enumerated { 0 };
+    stub.set_lamda(&FileInfoHelper::threadEnumerateDfmFileInfos, [&enumerated](FileInfoHelper *, const QUrl &, const QList<FileInfoPointer> &infos) {
+        enumerated += infos.size();
+    });
+    int queried = 0;
+    stub.set_lamda(&FileInfoHelper::queryDfmFileInfosAsync, [&queried](FileInfoHelper *, const QList<FileInfoPointer> &infos) {
+        queried += infos.size();
+    });
+
+    for (int i = 0; i < 16; ++i)
+        helper.pendingRefreshInfos[largeDir].append(FileInfoPointer(new AsyncFileInfo(QUrl::fromLocalFile(rootPath + QString("/large/%1").arg(i)))));
+    for (int i = 0; i < 15; ++i)
+        helper.pendingRefreshInfos[smallDir].append(FileInfoPointer(new AsyncFileInfo(QUrl::fromLocalFile(rootPath + QString("/small/%1").arg(i)))));
+    // 非本地文件系统上即使数量足够也不枚举
+    for (int i = 0; i < 16; ++i)
+        helper.pendingRefreshInfos[remoteDir].append(FileInfoPointer(new AsyncFileInfo(QUrl::fromLocalFile(rootPath + QString("/remote/%1").arg(i)))));
+
+    helper.flushPendingRefresh();
+    ASSERT_TRUE(helper.enumeratePool.waitForDone(5000));
+    EXPECT_EQ(enumerated.load(), 16);
+    EXPECT_EQ(queried, 31);
+    EXPECT_TRUE(helper.pendingRefreshInfos.isEmpty());
+}
+
+TEST_F(FileInfoHelperTest, ThreadEnumerateDfmFileInfos_MissingNamesFallBackToSingleQueries)
+{
+    auto &helper = FileInfoHelper::instance();
+    stub_ext::StubExt stub;
+
+    QSet<QUrl> cached;
+    stub.set_lamda(&FileInfoHelper::cacheFileInfosByThread, [&cached](FileInfoHelper *, const QList<FileInfoPointer> &infos) {
+        for (const auto &info : infos)
+            cached.insert(info->fileUrl());
+    });
+    QList<FileInfoPointer> queried;
+    stub.set_lamda(&FileInfoHelper::queryDfmFileInfosAsync, [&queried](FileInfoHelper *, const QList<FileInfoPointer> &infos) {
+        queried.append(infos);
+    });
+
+    QList<FileInfoPointer> infos;
+    QSet<QUrl> existing;
+    for (int i = 0; i < 20; ++i) {
+        const QString path = rootPath + QString("/enum_%1.txt").arg(i);
+        QFile f(path);
+        ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+        f.close();
+        existing.insert(QUrl::fromLocalFile(path));
+        infos.append(FileInfoPointer(new AsyncFileInfo(QUrl::fromLocalFile(path))));
+    }
+    // 已删除的文件不会出现在枚举中，同名的重复请求也交给逐个查询
+    const QUrl missing = QUrl::fromLocalFile(rootPath + "/missing.txt");
+    infos.append(FileInfoPointer(new AsyncFileInfo(missing)));
+    infos.append(FileInfoPointer(new AsyncFileInfo(infos.first()->fileUrl())));
+
+    helper.threadEnumerateDfmFileInfos(QUrl::fromLocalFile(rootPath), infos);
+    // 剩余文件通过排队调用回到主线程查询
+    EXPECT_TRUE(queried.isEmpty());
+    QCoreApplication::processEvents();
+
+    EXPECT_EQ(cached, existing);
+    ASSERT_EQ(queried.size(), 2);
+    QSet<QUrl> queriedUrls;
+    for (const auto &info : queried)
+        queriedUrls.insert(info->fileUrl());
+    EXPECT_TRUE(queriedUrls.contains(missing));
+    EXPECT_TRUE(queriedUrls.contains(infos.first()->fileUrl()));
+}
+
+TEST_F(FileInfoHelperTest, ThreadEnumerateDfmFileInfos_SmallShareOfLargeDirectoryStopsEarly)
+{
+    auto &helper = FileInfoHelper::instance();
+    stub_ext::StubExt stub;
+
+    QSet<QUrl> cached;
+    stub.set_lamda(&FileInfoHelper::cacheFileInfosByThread, [&cached](FileInfoHelper *, const QList<FileInfoPointer> &infos) {
+        for (const auto &info : infos)
+            cached.insert(info->fileUrl());
+    });
+    QSet<QUrl> queried;
+    stub.set_lamda(&FileInfoHelper::queryDfmFileInfosAsync, [&queried](FileInfoHelper *, const QList<FileInfoPointer> &infos) {
+        for (const auto &info : infos)
+            queried.insert(info->fileUrl());
+    });
+
+    const QString dirPath = rootPath + "/big";
+    ASSERT_TRUE(QDir().mkpath(dirPath));
+    QList<FileInfoPointer> infos;
+    for (int i = 0; i < 400; ++i) {
+        const QString path = dirPath + QString("/big_%1.txt").arg(i);
+        QFile f(path);
+        ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+        f.close();
+        if (i % 25 == 0)
+            infos.append(FileInfoPointer(new AsyncFileInfo(QUrl::fromLocalFile(path))));
+    }
+    ASSERT_EQ(infos.size(), 16);
+
+    // 请求只占目录的一小部分，枚举读取 2 倍请求数的条目后停止，其余逐个查询
+    helper.threadEnumerateDfmFileInfos(QUrl::fromLocalFile(dirPath), infos);
+    QCoreApplication::processEvents();
+
+    EXPECT_EQ(cached.size() + queried.size(), infos.size());
+    EXPECT_FALSE(queried.isEmpty());
+    for (const auto &info : infos)
+        EXPECT_TRUE(cached.contains(info->fileUrl()) != queried.contains(info->fileUrl()));
+}
+
+TEST_F(FileInfoHelperTest, RefreshBenchmark)
+{
+    // 基准测试耗时较长，只在设置了 DFM_UT_REFRESH_BENCHMARK_COUNT 时运行（如 100000）
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("DFM_UT_REFRESH_BENCHMARK_COUNT", &ok);
+    if (!ok || count <= 0)
+        GTEST_SKIP() << "Set DFM_UT_REFRESH_BENCHMARK_COUNT to run the refresh benchmark";
+
+    QTemporaryDir benchDir;
+    ASSERT_TRUE(benchDir.isValid());
+    QList<QSharedPointer<AsyncFileInfo>> infos;
+    infos.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString path = benchDir.path() + QString("/file_%1").arg(i);
+        QFile f(path);
+        ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+        f.close();
+        infos.append(QSharedPointer<AsyncFileInfo>(new AsyncFileInfo(QUrl::fromLocalFile(path))));
+    }
+
+    auto &helper = FileInfoHelper::instance();
+    std::atomic_int finished { 0 };
+    auto conn = QObject::connect(&helper, &FileInfoHelper::requestCheckInfoRefresh, &helper,
+                                 [&finished](QSharedPointer<FileInfo>) { ++finished; },
+                                 Qt::DirectConnection);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const auto &info : infos)
+        helper.handleFileRefresh(info);
+
+    while (finished.load() < count && timer.elapsed() < 300 * 1000)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    const qint64 elapsed = timer.elapsed();
+    QObject::disconnect(conn);
+
+    qInfo() << "Refreshed" << finished.load() << "of" << count << "file infos in" << elapsed << "ms";
+    RecordProperty("refresh_count", count);
+    RecordProperty("refresh_ms", static_cast<int>(elapsed));
+    EXPECT_EQ(finished.load(), count);
+}
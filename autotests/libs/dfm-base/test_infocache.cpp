@@ -18,6 +18,7 @@
 #include <mutex>
 
 #include <dfm-base/utils/infocache.h>
+#include "dfm-base/utils/private/infocache_p.h"
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/dfm_global_defines.h>
@@ -167,3 +168,66 @@ TEST_F(InfoCacheTest, InfoCacheControllerDestructsCleanly)
     // The controller is a singleton; verify it's accessible without crash.
     EXPECT_NO_FATAL_FAILURE({ (void)&InfoCacheController::instance(); });
 }
+
+// ---- UrlLruIndex / statistics ----
+
+TEST_F(InfoCacheTest, UrlLruIndexEvictsLeastRecentlyUsed)
+{
+    UrlLruIndex index;
+    const QUrl a("file:///tmp/lru/a");
+    const QUrl b("file:///tmp/lru/b");
+    const QUrl c("file:///tmp/lru/c");
+    index.touch(a, 1);
+    index.touch(b, 2);
+    index.touch(c, 3);
+    index.touch(a, 4);   // a 重新变为最近访问
+    EXPECT_EQ(index.size(), 3);
+
+    EXPECT_EQ(index.takeStale(2), QList<QUrl>({ b }));
+    EXPECT_FALSE(index.contains(b));
+    EXPECT_TRUE(index.contains(a));
+    EXPECT_TRUE(index.takeStale(2).isEmpty());
+}
+
+TEST_F(InfoCacheTest, UrlLruIndexTakesExpiredEntries)
+{
+    UrlLruIndex index;
+    const QUrl a("file:///tmp/lru/a");
+    const QUrl b("file:///tmp/lru/b");
+    index.touch(a, 100);
+    index.touch(b, 200);
+
+    EXPECT_EQ(index.takeStale(10, 150), QList<QUrl>({ a }));
+    EXPECT_TRUE(index.remove(b));
+    EXPECT_FALSE(index.remove(b));
+    EXPECT_EQ(index.size(), 0);
+}
+
+TEST_F(InfoCacheTest, StatisticsCountHitsMissesAndEvictions)
+{
+    InfoCache ic;
+    ic.setCapacity(1, 0);
+
+    QString path = rootPath + "/stat.txt";
+    QFile f(path);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.close();
+    QUrl url = QUrl::fromLocalFile(path);
+    auto info = InfoFactory::create<FileInfo>(url);
+    ASSERT_NE(info, nullptr);
+
+    ic.cacheInfo(url, info);
+    EXPECT_EQ(ic.getCacheInfo(url), info);
+    EXPECT_EQ(ic.getCacheInfo(QUrl("file:///no/such/stat")), nullptr);
+
+    EXPECT_FALSE(ic.updateSortTimeWorker(url));
+    EXPECT_TRUE(ic.updateSortTimeWorker(QUrl("file:///no/such/stat2")));
+    ic.timeRemoveCache();
+
+    const auto stat = ic.statistics();
+    EXPECT_EQ(stat.hits, 1u);
+    EXPECT_EQ(stat.misses, 1u);
+    EXPECT_EQ(stat.evictions, 1u);
+    EXPECT_EQ(stat.size, 1);
+    EXPECT_EQ(stat.capacity, 1);
+}
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_mimetypecache.cpp
+ * @brief Unit tests for MimeTypeCache (mimetype/mimetypecache.cpp)
+ *        Covers key construction from file status, LRU eviction within the
+ *        size bound, hit/miss counters and concurrent use from several threads.
+ */
+
+#include <gtest/gtest.h>
+#include <dfm-base/mimetype/mimetypecache.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QMimeDatabase>
+
+#include <thread>
+#include <vector>
+
+using namespace dfmbase;
+
+namespace {
+
+MimeCacheKey makeKey(ino_t inode)
+{
+    MimeCacheKey key;
+    key.device = 1;
+    key.inode = inode;
+    key.matchMode = QMimeDatabase::MatchDefault;
+    return key;
+}
+
+}   // namespace
+
+TEST(MimeTypeCacheTest, KeyOfMissingFileIsEmpty)
+{
+    EXPECT_FALSE(MimeTypeCache::keyOf("/nonexistent/ut_mime_cache", "ut_mime_cache", QMimeDatabase::MatchDefault));
+    EXPECT_FALSE(MimeTypeCache::keyOf(QString(), QString(), QMimeDatabase::MatchDefault));
+}
+
+TEST(MimeTypeCacheTest, KeyTracksNameModeAndContent)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("a.txt");
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("one");
+    file.close();
+
+    const auto first = MimeTypeCache::keyOf(path, "a.txt", QMimeDatabase::MatchDefault);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(*first, *MimeTypeCache::keyOf(path, "a.txt", QMimeDatabase::MatchDefault));
+    EXPECT_FALSE(*first == *MimeTypeCache::keyOf(path, "a.pdf", QMimeDatabase::MatchDefault));
+    EXPECT_FALSE(*first == *MimeTypeCache::keyOf(path, "a.txt", QMimeDatabase::MatchContent));
+
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    file.write("two");
+    file.close();
+    EXPECT_FALSE(*first == *MimeTypeCache::keyOf(path, "a.txt", QMimeDatabase::MatchDefault));
+}
+
+TEST(MimeTypeCacheTest, FindCountsHitsAndMisses)
+{
+    MimeTypeCache cache(64);
+    const QMimeType text = QMimeDatabase().mimeTypeForName("text/plain");
+
+    QMimeType found;
+    EXPECT_FALSE(cache.find(makeKey(1), &found));
+    cache.insert(makeKey(1), text);
+    EXPECT_TRUE(cache.find(makeKey(1), &found));
+    EXPECT_EQ(found, text);
+
+    const auto stat = cache.statistics();
+    EXPECT_EQ(stat.hits, 1u);
+    EXPECT_EQ(stat.misses, 1u);
+    EXPECT_EQ(stat.size, 1);
+}
+
+TEST(MimeTypeCacheTest, EvictsLeastRecentlyUsedWithinShard)
+{
+    // 每个分片容量为 1，inode 相差 kShardCount 的键落在同一分片
+    MimeTypeCache cache(MimeTypeCache::kShardCount);
+    const QMimeType text = QMimeDatabase().mimeTypeForName("text/plain");
+
+    cache.insert(makeKey(0), text);
+    cache.insert(makeKey(MimeTypeCache::kShardCount), text);
+
+    EXPECT_FALSE(cache.find(makeKey(0), nullptr));
+    EXPECT_TRUE(cache.find(makeKey(MimeTypeCache::kShardCount), nullptr));
+    EXPECT_EQ(cache.statistics().evictions, 1u);
+}
+
+TEST(MimeTypeCacheTest, SizeStaysWithinBound)
+{
+    constexpr qsizetype kCapacity = 256;
+    MimeTypeCache cache(kCapacity);
+    const QMimeType text = QMimeDatabase().mimeTypeForName("text/plain");
+
+    for (int i = 0; i < 10000; ++i)
+        cache.insert(makeKey(ino_t(i)), text);
+
+    EXPECT_LE(cache.statistics().size, kCapacity);
+    cache.clear();
+    EXPECT_EQ(cache.statistics().size, 0);
+}
+
+TEST(MimeTypeCacheTest, ConcurrentInsertAndFind)
+{
+    MimeTypeCache cache(1024);
+    const QMimeType text = QMimeDatabase().mimeTypeForName("text/plain");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache, &text, t] {
+            for (int i = 0; i < 5000; ++i) {
+                const MimeCacheKey key = makeKey(ino_t((i * 8 + t) % 2048));
+                if (!cache.find(key, nullptr))
+                    cache.insert(key, text);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    const auto stat = cache.statistics();
+    EXPECT_EQ(stat.hits + stat.misses, 8u * 5000u);
+    EXPECT_LE(stat.size, 1024);
+}
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_mounttable.cpp
+ * @brief Unit tests for MountTable (base/device/mounttable.cpp)
+ *        Covers the path trie longest-prefix lookup, device lookup with bind
+ *        mounts, snapshot reuse while the mount table does not change, and
+ *        file lookups that do not follow symlinks.
+ */
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+
+#include <dfm-base/base/device/mounttable.h>
+#include <dfm-base/base/device/deviceutils.h>
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+using namespace dfmbase;
+
+namespace {
+
+MountEntry makeEntry(const QString &mountPoint, dev_t device)
+{
+    MountEntry entry;
+    entry.mountPoint = mountPoint;
+    entry.device = device;
+    return entry;
+}
+
+}   // namespace
+
+TEST(MountTableTest, LongestPrefixMatchesWholeComponents)
+{
+    MountTable::Snapshot snap;
+    snap.insert(makeEntry("/", makedev(8, 1)));
+    snap.insert(makeEntry("/home", makedev(8, 2)));
+    snap.insert(makeEntry("/media/uos/USB DISK", makedev(8, 17)));
+
+    EXPECT_EQ(snap.longestPrefix("/home/uos/a.txt")->mountPoint, "/home");
+    EXPECT_EQ(snap.longestPrefix("/home")->mountPoint, "/home");
+    EXPECT_EQ(snap.longestPrefix("/home/")->mountPoint, "/home");
+    EXPECT_EQ(snap.longestPrefix("/homework/a")->mountPoint, "/");
+    EXPECT_EQ(snap.longestPrefix("/media/uos/USB DISK/b")->mountPoint, "/media/uos/USB DISK");
+    EXPECT_EQ(snap.longestPrefix("/media/uos")->mountPoint, "/");
+    EXPECT_EQ(snap.longestPrefix("//home//uos")->mountPoint, "/home");
+}
+
+TEST(MountTableTest, LaterMountOnSameTargetWins)
+{
+    MountTable::Snapshot snap;
+    snap.insert(makeEntry("/", makedev(8, 1)));
+    snap.insert(makeEntry("/mnt", makedev(8, 2)));
+    snap.insert(makeEntry("/mnt", makedev(8, 3)));
+
+    EXPECT_EQ(snap.longestPrefix("/mnt/x")->device, makedev(8, 3));
+}
+
+TEST(MountTableTest, EmptySnapshotHasNoMatch)
+{
+    MountTable::Snapshot snap;
+    EXPECT_EQ(snap.longestPrefix("/home"), nullptr);
+    EXPECT_EQ(snap.ofDevice(makedev(8, 1), "/home"), nullptr);
+}
+
+TEST(MountTableTest, DeviceLookupPrefersBindMountOfPath)
+{
+    MountTable::Snapshot snap;
+    snap.insert(makeEntry("/", makedev(8, 1)));
+    snap.insert(makeEntry("/data", makedev(8, 2)));
+    snap.insert(makeEntry("/home", makedev(8, 2)));
+
+    EXPECT_EQ(snap.ofDevice(makedev(8, 2), "/home/uos")->mountPoint, "/home");
+    EXPECT_EQ(snap.ofDevice(makedev(8, 2), "/data/home/uos")->mountPoint, "/data");
+    // 路径不在任何一个挂载下时取最早的挂载
+    EXPECT_EQ(snap.ofDevice(makedev(8, 2), "/proc")->mountPoint, "/data");
+    EXPECT_EQ(snap.ofDevice(makedev(8, 1), "/home")->mountPoint, "/");
+}
+
+TEST(MountTableTest, SnapshotReusedWhileTableUnchanged)
+{
+    MountTable *table = MountTable::instance();
+    const quint64 generation = table->generation();
+    EXPECT_GT(generation, 0u);
+
+    for (int i = 0; i < 100; ++i)
+        table->mountPointOf("/proc/self");
+    EXPECT_EQ(table->generation(), generation);
+}
+
+TEST(MountTableTest, RealTableResolvesRootAndProc)
+{
+    MountTable *table = MountTable::instance();
+    EXPECT_EQ(table->mountPointOf("/"), "/");
+    EXPECT_EQ(table->mountPointOf("/proc/self/status"), "/proc");
+    EXPECT_EQ(DeviceUtils::getLongestMountRootPath("/proc/self/status"), "/proc/");
+}
+
+TEST(MountTableTest, FileLookupMatchesDeviceOfFile)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    struct stat st;
+    ASSERT_EQ(::stat(dir.path().toUtf8().constData(), &st), 0);
+
+    MountTable *table = MountTable::instance();
+    const MountEntry entry = table->entryOfDevice(st.st_dev);
+    if (entry.mountPoint.isEmpty())
+        GTEST_SKIP() << "device of temporary dir is not listed in mountinfo (e.g. btrfs subvolume)";
+
+    EXPECT_EQ(table->mountPointOfFile(dir.path()), entry.mountPoint);
+    EXPECT_EQ(table->mountPointOfFile(dir.path() + "/not-created"), table->mountPointOf(dir.path()));
+}
+
+TEST(MountTableTest, FileLookupDoesNotFollowSymlinks)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    struct stat st;
+    ASSERT_EQ(::stat(dir.path().toUtf8().constData(), &st), 0);
+
+    MountTable *table = MountTable::instance();
+    const MountEntry entry = table->entryOfDevice(st.st_dev);
+    if (entry.mountPoint.isEmpty())
+        GTEST_SKIP() << "device of temporary dir is not listed in mountinfo (e.g. btrfs subvolume)";
+
+    // 链接指向另一个挂载点，但链接本身属于临时目录所在的挂载
+    const QString link = dir.path() + "/proc-link";
+    ASSERT_TRUE(QFile::link("/proc/self/status", link));
+    EXPECT_EQ(table->mountPointOfFile(link), entry.mountPoint);
+
+    // 悬空链接同样按链接本身解析
+    const QString dangling = dir.path() + "/dangling-link";
+    ASSERT_TRUE(QFile::link(dir.path() + "/not-created", dangling));
+    EXPECT_EQ(table->mountPointOfFile(dangling), entry.mountPoint);
+}
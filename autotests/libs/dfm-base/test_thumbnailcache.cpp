@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_thumbnailcache.cpp
+ * @brief Unit tests for ThumbnailCache (thumbnailcache.cpp)
+ *
+ * Each test uses its own cache instance whose index file lives in a
+ * QTemporaryDir, so the process-wide cache is never touched.
+ */
+
+#include <gtest/gtest.h>
+#include <dfm-base/utils/thumbnail/thumbnailcache.h>
+
+#include <QTemporaryDir>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+
+using namespace dfmbase;
+DFMGLOBAL_USE_NAMESPACE
+
+namespace {
+QByteArray md5Of(const QString &url)
+{
+    return QCryptographicHash::hash(url.toLocal8Bit(), QCryptographicHash::Md5).toHex();
+}
+
+QImage imageOfKiB(int kib)
+{
+    // ARGB32 每像素 4 字节，16 像素宽即每行 64 字节
+    QImage img(16, kib * 16, QImage::Format_ARGB32);
+    img.fill(Qt::white);
+    return img;
+}
+}   // namespace
+
+TEST(ThumbnailCacheTest, ImagesAreEvictedByByteBudgetInLruOrder)
+{
+    QTemporaryDir dir;
+    ThumbnailCache cache(QDir(dir.path()).filePath("index"));
+    cache.setByteBudget(300 * 1024);
+
+    cache.insert("/thumb/a.png", imageOfKiB(100));
+    cache.insert("/thumb/b.png", imageOfKiB(100));
+    cache.insert("/thumb/c.png", imageOfKiB(100));
+    EXPECT_EQ(cache.usedBytes(), 300 * 1024);
+
+    // 访问 a 后 b 成为最久未使用
+    EXPECT_FALSE(cache.image("/thumb/a.png").isNull());
+    cache.insert("/thumb/d.png", imageOfKiB(100));
+
+    EXPECT_FALSE(cache.image("/thumb/a.png").isNull());
+    EXPECT_TRUE(cache.image("/thumb/b.png").isNull());
+    EXPECT_FALSE(cache.image("/thumb/d.png").isNull());
+    EXPECT_LE(cache.usedBytes(), cache.byteBudget());
+
+    // 超过预算的单张图片不会被缓存
+    cache.insert("/thumb/huge.png", imageOfKiB(400));
+    EXPECT_TRUE(cache.image("/thumb/huge.png").isNull());
+
+    cache.remove("/thumb/a.png");
+    EXPECT_TRUE(cache.image("/thumb/a.png").isNull());
+}
+
+TEST(ThumbnailCacheTest, IndexReportsValidityByModifyTime)
+{
+    QTemporaryDir dir;
+    ThumbnailCache cache(QDir(dir.path()).filePath("index"));
+    const QByteArray &md5 = md5Of("file:///tmp/photo.jpg");
+
+    EXPECT_EQ(cache.validity(md5, kLarge, 100), ThumbnailCache::Validity::kUnknown);
+
+    cache.record(md5, kLarge, 100);
+    EXPECT_EQ(cache.validity(md5, kLarge, 100), ThumbnailCache::Validity::kValid);
+    EXPECT_EQ(cache.validity(md5, kLarge, 101), ThumbnailCache::Validity::kOutdated);
+    // 不同尺寸的缩略图分别记录
+    EXPECT_EQ(cache.validity(md5, kNormal, 100), ThumbnailCache::Validity::kUnknown);
+
+    cache.forget(md5, kLarge);
+    EXPECT_EQ(cache.validity(md5, kLarge, 100), ThumbnailCache::Validity::kUnknown);
+}
+
+TEST(ThumbnailCacheTest, IndexSurvivesSaveAndReload)
+{
+    QTemporaryDir dir;
+    const QString indexPath = QDir(dir.path()).filePath("index");
+    const QByteArray &md5a = md5Of("file:///tmp/a.jpg");
+    const QByteArray &md5b = md5Of("file:///tmp/b.jpg");
+
+    {
+        ThumbnailCache cache(indexPath);
+        cache.record(md5a, kLarge, 1700000000);
+        cache.record(md5b, kXLarge, 42);
+        ASSERT_TRUE(cache.saveIndex());
+    }
+
+    // 25 字节/条 + 16 字节文件头
+    EXPECT_EQ(QFileInfo(indexPath).size(), 16 + 2 * 25);
+
+    ThumbnailCache reloaded(indexPath);
+    EXPECT_EQ(reloaded.validity(md5a, kLarge, 1700000000), ThumbnailCache::Validity::kValid);
+    EXPECT_EQ(reloaded.validity(md5b, kXLarge, 43), ThumbnailCache::Validity::kOutdated);
+    EXPECT_EQ(reloaded.indexSize(), 2);
+}
+
+TEST(ThumbnailCacheTest, CorruptIndexFileIsIgnored)
+{
+    QTemporaryDir dir;
+    const QString indexPath = QDir(dir.path()).filePath("index");
+    QFile file(indexPath);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("not an index");
+    file.close();
+
+    ThumbnailCache cache(indexPath);
+    EXPECT_EQ(cache.validity(md5Of("file:///tmp/a.jpg"), kLarge, 1), ThumbnailCache::Validity::kUnknown);
+    EXPECT_EQ(cache.indexSize(), 0);
+}
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_thumbnailpool.cpp
+ * @brief Unit tests for ThumbnailPool (thumbnailpool.cpp)
+ *
+ * The pool runs a caller supplied job, so these tests never create real
+ * thumbnails. A semaphore keeps the first job of a lane busy while the
+ * remaining tasks are queued, which makes the dispatch order observable.
+ */
+
+#include <gtest/gtest.h>
+#include <dfm-base/utils/thumbnail/thumbnailpool.h>
+
+#include <QMutex>
+#include <QSemaphore>
+#include <QStringList>
+
+using namespace dfmbase;
+
+namespace {
+QUrl utUrl(const QString &name)
+{
+    return QUrl::fromLocalFile("/tmp/ut-thumbnail-pool/" + name);
+}
+}   // namespace
+
+TEST(ThumbnailPoolTest, LaneOfClassifiesMimeTypes)
+{
+    EXPECT_EQ(ThumbnailPool::laneOf(QStringLiteral("image/jpeg")), ThumbnailPool::Lane::kImage);
+    EXPECT_EQ(ThumbnailPool::laneOf(QStringLiteral("video/mp4")), ThumbnailPool::Lane::kVideo);
+    EXPECT_EQ(ThumbnailPool::laneOf(QStringLiteral("application/pdf")), ThumbnailPool::Lane::kDocument);
+    EXPECT_EQ(ThumbnailPool::laneOf(QStringLiteral("image/vnd.djvu")), ThumbnailPool::Lane::kDocument);
+    EXPECT_EQ(ThumbnailPool::laneOf(QStringLiteral("audio/flac")), ThumbnailPool::Lane::kOther);
+    EXPECT_EQ(ThumbnailPool::laneOf(utUrl("photo.png")), ThumbnailPool::Lane::kImage);
+}
+
+TEST(ThumbnailPoolTest, NewestRequestRunsFirstAndCancelSkipsPending)
+{
+    QSemaphore blocker;
+    QSemaphore started;
+    QMutex orderLock;
+    QStringList order;
+
+    ThumbnailPool pool([&](const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize) {
+        {
+            QMutexLocker lk(&orderLock);
+            order << url.fileName();
+        }
+        started.release();
+        if (url.fileName() == "busy")
+            blocker.acquire();
+    });
+    pool.setLaneLimit(ThumbnailPool::Lane::kImage, 1);
+
+    ASSERT_TRUE(pool.enqueue(utUrl("busy"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kImage));
+    started.acquire();
+
+    EXPECT_TRUE(pool.enqueue(utUrl("a"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kImage));
+    EXPECT_TRUE(pool.enqueue(utUrl("b"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kImage));
+    EXPECT_TRUE(pool.enqueue(utUrl("c"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kImage));
+    // 再次请求 a：不重复入队，但提升为最高优先级
+    EXPECT_FALSE(pool.enqueue(utUrl("a"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kImage));
+    // 正在执行的任务不重复入队
+    EXPECT_FALSE(pool.enqueue(utUrl("busy"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kImage));
+    EXPECT_EQ(pool.queueDepth(), 3);
+
+    EXPECT_EQ(pool.cancel({ utUrl("b"), utUrl("missing") }), QList<QUrl>({ utUrl("b") }));
+    EXPECT_EQ(pool.queueDepth(), 2);
+
+    blocker.release();
+    ASSERT_TRUE(pool.waitForDone(5000));
+    EXPECT_EQ(order, QStringList({ "busy", "a", "c" }));
+    EXPECT_EQ(pool.runningCount(), 0);
+}
+
+TEST(ThumbnailPoolTest, CancelIfAndStopDropPendingTasks)
+{
+    QSemaphore blocker;
+    QSemaphore started;
+    ThumbnailPool pool([&](const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize) {
+        started.release();
+        if (url.fileName() == "busy")
+            blocker.acquire();
+    });
+    pool.setLaneLimit(ThumbnailPool::Lane::kVideo, 1);
+
+    ASSERT_TRUE(pool.enqueue(utUrl("busy"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kVideo));
+    started.acquire();
+    pool.enqueue(utUrl("keep"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kVideo);
+    pool.enqueue(utUrl("drop"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kVideo);
+
+    const auto &canceled = pool.cancelIf([](const QUrl &url) { return url.fileName() == "drop"; });
+    EXPECT_EQ(canceled, QList<QUrl>({ utUrl("drop") }));
+
+    pool.stop();
+    EXPECT_EQ(pool.queueDepth(), 0);
+    EXPECT_FALSE(pool.enqueue(utUrl("late"), DFMGLOBAL_NAMESPACE::kLarge, ThumbnailPool::Lane::kVideo));
+
+    blocker.release();
+    EXPECT_TRUE(pool.waitForDone(5000));
+}
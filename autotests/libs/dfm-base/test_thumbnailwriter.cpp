@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_thumbnailwriter.cpp
+ * @brief Unit tests for ThumbnailWriter (thumbnailwriter.cpp)
+ *
+ * Thumbnails are written into a QTemporaryDir through a private writer
+ * instance, so the user's thumbnail cache is never touched.
+ */
+
+#include <gtest/gtest.h>
+#include "stubext.h"
+#include <dfm-base/utils/thumbnail/thumbnailwriter.h>
+
+#include <QTemporaryDir>
+#include <QImageReader>
+#include <QDir>
+#include <QMutex>
+
+#include <unistd.h>
+
+using namespace dfmbase;
+
+TEST(ThumbnailWriterTest, WritesPngWithFreedesktopTextChunks)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString target = dir.filePath("thumb.png");
+
+    QImage image(32, 32, QImage::Format_ARGB32);
+    image.fill(Qt::red);
+
+    bool called = false;
+    bool result = false;
+    QString resultPath;
+    ThumbnailWriter writer;
+    writer.write(target, image, "file:///tmp/photo.jpg", 1700000000, [&](bool success, const QString &filePath) {
+        called = true;
+        result = success;
+        resultPath = filePath;
+    });
+    ASSERT_TRUE(writer.waitForDone(5000));
+
+    EXPECT_TRUE(called);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(resultPath, target);
+
+    QImageReader reader(target, "png");
+    const QImage saved = reader.read();
+    ASSERT_FALSE(saved.isNull());
+    EXPECT_EQ(saved.size(), image.size());
+    EXPECT_EQ(saved.text(QT_STRINGIFY(Thumb::URL)), QStringLiteral("file:///tmp/photo.jpg"));
+    EXPECT_EQ(saved.text(QT_STRINGIFY(Thumb::MTime)), QStringLiteral("1700000000"));
+
+    // 临时文件在重命名后不应残留
+    EXPECT_EQ(QDir(dir.path()).entryList(QDir::Files | QDir::Hidden).size(), 1);
+}
+
+TEST(ThumbnailWriterTest, BatchOfWritesAllComplete)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    QImage image(8, 8, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+
+    QMutex lock;
+    int succeeded = 0;
+    ThumbnailWriter writer(2);
+    for (int i = 0; i < 80; ++i) {
+        writer.write(dir.filePath(QString("t%1.png").arg(i)), image, QString("file:///tmp/%1").arg(i), i, [&](bool success, const QString &) {
+            QMutexLocker lk(&lock);
+            succeeded += success ? 1 : 0;
+        });
+    }
+    ASSERT_TRUE(writer.waitForDone(10000));
+
+    EXPECT_EQ(succeeded, 80);
+    EXPECT_EQ(writer.pendingCount(), 0);
+    EXPECT_EQ(QDir(dir.path()).entryList(QDir::Files | QDir::Hidden).size(), 80);
+}
+
+TEST(ThumbnailWriterTest, MissingDirectoryReportsFailure)
+{
+    QImage image(8, 8, QImage::Format_RGB32);
+    image.fill(Qt::green);
+
+    bool result = true;
+    ThumbnailWriter writer;
+    writer.write("/nonexistent-ut-dir/thumb.png", image, "file:///tmp/x", 0, [&](bool success, const QString &) { result = success; });
+    ASSERT_TRUE(writer.waitForDone(5000));
+    EXPECT_FALSE(result);
+}
+
+TEST(ThumbnailWriterTest, CallbackRunsAfterRename)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    QImage image(8, 8, QImage::Format_RGB32);
+    image.fill(Qt::yellow);
+
+    QMutex lock;
+    int visible = 0;
+    ThumbnailWriter writer;
+    for (int i = 0; i < 4; ++i) {
+        writer.write(dir.filePath(QString("r%1.png").arg(i)), image, QString("file:///tmp/%1").arg(i), i, [&](bool success, const QString &filePath) {
+            // 回调时目标文件必须已经可读
+            QMutexLocker lk(&lock);
+            visible += (success && QImageReader(filePath, "png").canRead()) ? 1 : 0;
+        });
+    }
+    ASSERT_TRUE(writer.waitForDone(5000));
+    EXPECT_EQ(visible, 4);
+}
+
+TEST(ThumbnailWriterTest, DataSyncFailureKeepsOldTarget)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    const QString target = dir.filePath("old.png");
+    QFile old(target);
+    ASSERT_TRUE(old.open(QIODevice::WriteOnly));
+    old.write("old");
+    old.close();
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&::fdatasync, [](int) -> int {
+        __DBG_STUB_INVOKE__
+        errno = EIO;
+        return -1;
+    });
+
+    QImage image(8, 8, QImage::Format_RGB32);
+    image.fill(Qt::gray);
+
+    bool result = true;
+    ThumbnailWriter writer;
+    writer.write(target, image, "file:///tmp/old", 0, [&](bool success, const QString &) { result = success; });
+    ASSERT_TRUE(writer.waitForDone(5000));
+
+    // 数据未落盘时不能替换目标文件，临时文件也要清理
+    EXPECT_FALSE(result);
+    ASSERT_TRUE(old.open(QIODevice::ReadOnly));
+    EXPECT_EQ(old.readAll(), QByteArray("old"));
+    EXPECT_EQ(QDir(dir.path()).entryList(QDir::Files | QDir::Hidden).size(), 1);
+}
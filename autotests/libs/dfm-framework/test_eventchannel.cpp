@@ -11,6 +11,12 @@
 #include <dfm-framework/event/eventchannel.h>
 #include <dfm-framework/event/event.h>
 
+#include <QElapsedTimer>
+#include <QReadWriteLock>
+
+#include <atomic>
+#include <thread>
+
 using namespace dpf;
 
 /**
@@ -499,4 +505,122 @@ TEST_F(EventChannelTest, ChannelManagerDirectDisconnect)
     EXPECT_TRUE(stringDisconnected);
 }
 
+/**
+ * @brief 测试类型匹配时走免装箱路径，类型不匹配时回退到QVariant路径
+ */
+TEST_F(EventChannelTest, TypedPushFallsBackOnTypeMismatch)
+{
+    EventType eventType = registerTestEvent("typed_fallback");
+    channelManager->connect(eventType, receiver, &TestReceiver::addOne);
+
+    // int 与处理函数签名一致，走类型化路径
+    EXPECT_EQ(channelManager->push(eventType, 1).toInt(), 2);
+
+    // qint64 与签名不一致，经由QVariant转换后结果相同
+    EXPECT_EQ(channelManager->push(eventType, qint64(1)).toInt(), 2);
+
+    // const引用参数同样走类型化路径
+    channelManager->connect(eventType, receiver, &TestReceiver::combineStrings);
+    const QString hello("Hello");
+    const QString world(" World");
+    EXPECT_EQ(channelManager->push(eventType, hello, world).toString(), QString("Hello World"));
+
+    // char* 参数在QVariant路径中转换为QString
+    EXPECT_EQ(channelManager->push(eventType, "Hello", " World").toString(), QString("Hello World"));
+}
+
+/**
+ * @brief 测试断开后重新连接复用同一事件类型
+ */
+TEST_F(EventChannelTest, ReconnectAfterDisconnect)
+{
+    EventType eventType = registerTestEvent("reconnect_after_disconnect");
+
+    channelManager->connect(eventType, receiver, &TestReceiver::addOne);
+    EXPECT_TRUE(channelManager->disconnect(eventType));
+    EXPECT_FALSE(channelManager->push(eventType, 1).isValid());
+
+    EXPECT_TRUE(channelManager->connect(eventType, receiver, &TestReceiver::addTen));
+    EXPECT_EQ(channelManager->push(eventType, 1).toInt(), 11);
+}
+
+/**
+ * @brief 测试其他线程推送时并发替换接收者
+ */
+TEST_F(EventChannelTest, ConcurrentPushWhileReconnecting)
+{
+    EventType eventType = registerTestEvent("concurrent_reconnect");
+    channelManager->connect(eventType, receiver, &TestReceiver::addOne);
+
+    std::atomic<bool> stop { false };
+    std::atomic<int> unexpected { 0 };
+    std::vector<std::thread> pushers;
+    for (int t = 0; t < 4; ++t) {
+        pushers.emplace_back([&]() {
+            for (int i = 0; !stop.load(); i = (i + 1) % 1000) {
+                const QVariant result = channelManager->push(eventType, i);
+                if (result.isValid() && result.toInt() != i + 1 && result.toInt() != i + 10)
+                    ++unexpected;
+            }
+        });
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        if (i % 3 == 0)
+            channelManager->disconnect(eventType);
+        else
+            channelManager->connect(eventType, receiver, i % 2 ? &TestReceiver::addOne : &TestReceiver::addTen);
+    }
+
+    stop = true;
+    for (auto &pusher : pushers)
+        pusher.join();
+
+    EXPECT_EQ(unexpected.load(), 0);
+}
+
+/**
+ * @brief 微基准：对比类型化分发与原有 QMap + QReadWriteLock + QVariantList 路径
+ */
+TEST_F(EventChannelTest, PushBenchmark)
+{
+    const int iterations = 200000;
+    EventType eventType = registerTestEvent("benchmark");
+    channelManager->connect(eventType, receiver, &TestReceiver::combineStrings);
+
+    // 原有实现：读锁查表，参数装箱到 QVariantList，再经由 Connector 调用
+    QMap<EventType, QSharedPointer<EventChannel>> legacyMap;
+    QReadWriteLock legacyLock;
+    QSharedPointer<EventChannel> legacyChannel(new EventChannel);
+    legacyChannel->setReceiver(receiver, &TestReceiver::combineStrings);
+    legacyMap.insert(eventType, legacyChannel);
+
+    const QString a("a");
+    const QString b("b");
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        QReadLocker guard(&legacyLock);
+        auto channel = legacyMap.value(eventType);
+        guard.unlock();
+        QVariantList args;
+        makeVariantList(&args, a, b);
+        channel->send(args);
+    }
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < iterations; ++i)
+        channelManager->push(eventType, a, b);
+    const qint64 typedNs = timer.nsecsElapsed();
+
+    qInfo() << "EventChannelManager::push" << iterations << "calls, legacy:"
+            << legacyNs / iterations << "ns/call, typed:" << typedNs / iterations << "ns/call";
+    RecordProperty("legacy_ns_per_call", static_cast<int>(legacyNs / iterations));
+    RecordProperty("typed_ns_per_call", static_cast<int>(typedNs / iterations));
+
+    EXPECT_EQ(channelManager->push(eventType, a, b).toString(), QString("ab"));
+}
+
 #include "test_eventchannel.moc"
\ No newline at end of file
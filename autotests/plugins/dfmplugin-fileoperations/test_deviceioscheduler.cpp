@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+#include "stubext.h"
+
+#include "fileoperations/fileoperationutils/deviceioscheduler.h"
+
+using namespace dfmplugin_fileoperations;
+
+class TestDeviceIoScheduler : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+    }
+
+    void TearDown() override
+    {
+        stub.clear();
+        auto scheduler = DeviceIoScheduler::instance();
+        scheduler->profiles.clear();
+        scheduler->usedThreads.clear();
+    }
+
+    QString fakeDisk(const QString &name, int rotational, int queueDepth)
+    {
+        const QString &dir = tempDir.filePath(name);
+        QDir().mkpath(dir + "/queue");
+        writeValue(dir + "/queue/rotational", rotational);
+        writeValue(dir + "/queue/nr_requests", queueDepth);
+        return dir;
+    }
+
+    static void writeValue(const QString &path, int value)
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray::number(value) + "\n");
+    }
+
+    void useFakeDisks(const QMap<QString, QString> &nodeToDisk)
+    {
+        auto scheduler = DeviceIoScheduler::instance();
+        for (const auto &disk : nodeToDisk.values())
+            scheduler->profiles.insert(disk, DeviceIoScheduler::readProfile(tempDir.filePath(disk)));
+        stub.set_lamda(&DeviceIoScheduler::physicalDisk, [nodeToDisk](const QString &node) -> QString {
+            __DBG_STUB_INVOKE__
+            return nodeToDisk.value(node);
+        });
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir tempDir;
+};
+
+TEST_F(TestDeviceIoScheduler, ReadProfile_RotationalDiskGetsOneThread)
+{
+    const auto info = DeviceIoScheduler::readProfile(fakeDisk("sda", 1, 64));
+    EXPECT_EQ(info.disk, QString("sda"));
+    EXPECT_TRUE(info.rotational);
+    EXPECT_EQ(info.maxThreads, 1);
+    EXPECT_GT(info.chunkSize, DeviceIoScheduler::kDefaultChunkSize);
+}
+
+TEST_F(TestDeviceIoScheduler, ReadProfile_SolidStateScalesWithQueueDepth)
+{
+    const auto sata = DeviceIoScheduler::readProfile(fakeDisk("sdb", 0, 32));
+    const auto nvme = DeviceIoScheduler::readProfile(fakeDisk("nvme0n1", 0, 1023));
+    EXPECT_FALSE(sata.rotational);
+    EXPECT_EQ(sata.maxThreads, 2);
+    EXPECT_GE(nvme.maxThreads, sata.maxThreads);
+    EXPECT_LE(nvme.maxThreads, 8);
+}
+
+TEST_F(TestDeviceIoScheduler, ReadProfile_MissingQueueIsUnknown)
+{
+    QDir().mkpath(tempDir.filePath("loop0"));
+    EXPECT_TRUE(DeviceIoScheduler::readProfile(tempDir.filePath("loop0")).disk.isEmpty());
+}
+
+TEST_F(TestDeviceIoScheduler, ChunkSizeForThroughput_IsBoundedPowerOfTwo)
+{
+    EXPECT_EQ(DeviceIoScheduler::chunkSizeForThroughput(0), DeviceIoScheduler::kMinChunkSize);
+    EXPECT_EQ(DeviceIoScheduler::chunkSizeForThroughput(Q_INT64_C(10) * 1024 * 1024 * 1024), DeviceIoScheduler::kMaxChunkSize);
+
+    const quint32 chunk = DeviceIoScheduler::chunkSizeForThroughput(100 * 1024 * 1024);
+    EXPECT_EQ(chunk & (chunk - 1), 0u);
+    EXPECT_LE(static_cast<qint64>(chunk), 100 * 1024 * 1024 / 16);
+}
+
+TEST_F(TestDeviceIoScheduler, Acquire_UnknownDevicesLeaveDecisionToCaller)
+{
+    useFakeDisks({});
+    const auto reservation = DeviceIoScheduler::instance()->acquire("/dev/none", "/dev/none", 4);
+    EXPECT_EQ(reservation.threads, 0);
+    EXPECT_TRUE(reservation.disks.isEmpty());
+}
+
+TEST_F(TestDeviceIoScheduler, Acquire_BudgetIsSharedBetweenJobs)
+{
+    fakeDisk("nvme0n1", 0, 64);
+    useFakeDisks({ { "/dev/nvme0n1p1", "nvme0n1" }, { "/dev/nvme0n1p2", "nvme0n1" } });
+    auto scheduler = DeviceIoScheduler::instance();
+
+    const auto first = scheduler->acquire("/dev/nvme0n1p1", "/dev/nvme0n1p2", 16);
+    EXPECT_EQ(first.disks, QStringList { "nvme0n1" });
+    EXPECT_EQ(first.threads, scheduler->profiles.value("nvme0n1").maxThreads);
+
+    // the budget is used up, a second job gets one thread right away instead of waiting
+    const auto second = scheduler->acquire("/dev/nvme0n1p1", "/dev/nvme0n1p1", 16);
+    EXPECT_EQ(second.threads, 1);
+    EXPECT_EQ(second.disks, QStringList { "nvme0n1" });
+    EXPECT_EQ(scheduler->usedThreads.value("nvme0n1"), first.threads + 1);
+
+    scheduler->release(first);
+    scheduler->release(second);
+    EXPECT_TRUE(scheduler->usedThreads.isEmpty());
+}
+
+TEST_F(TestDeviceIoScheduler, Acquire_BusyRotationalDiskDoesNotBlock)
+{
+    fakeDisk("sdd", 1, 64);
+    useFakeDisks({ { "/dev/sdd1", "sdd" } });
+    auto scheduler = DeviceIoScheduler::instance();
+
+    const auto first = scheduler->acquire("/dev/sdd1", "/dev/sdd1", 1);
+    ASSERT_EQ(first.threads, 1);
+
+    // the only thread of the disk is held, the second job still starts with one thread
+    const auto second = scheduler->acquire("/dev/sdd1", "/dev/sdd1", 4);
+    EXPECT_EQ(second.threads, 1);
+    EXPECT_EQ(scheduler->usedThreads.value("sdd"), 2);
+
+    scheduler->release(first);
+    scheduler->release(second);
+    EXPECT_TRUE(scheduler->usedThreads.isEmpty());
+}
+
+TEST_F(TestDeviceIoScheduler, Acquire_RotationalSideLimitsThreads)
+{
+    fakeDisk("sda", 1, 64);
+    fakeDisk("nvme0n1", 0, 1023);
+    useFakeDisks({ { "/dev/sda1", "sda" }, { "/dev/nvme0n1p1", "nvme0n1" } });
+
+    const auto reservation = DeviceIoScheduler::instance()->acquire("/dev/nvme0n1p1", "/dev/sda1", 8);
+    EXPECT_EQ(reservation.threads, 1);
+    EXPECT_EQ(reservation.disks.size(), 2);
+    DeviceIoScheduler::instance()->release(reservation);
+}
+
+TEST_F(TestDeviceIoScheduler, RecordThroughput_IsRememberedForNextJob)
+{
+    fakeDisk("sdc", 0, 64);
+    useFakeDisks({ { "/dev/sdc1", "sdc" } });
+    auto scheduler = DeviceIoScheduler::instance();
+
+    const auto reservation = scheduler->acquire("/dev/sdc1", "/dev/sdc1", 1);
+    const quint32 chunk = scheduler->recordThroughput(reservation, 20 * 1024 * 1024);
+    scheduler->release(reservation);
+
+    const auto next = scheduler->acquire("/dev/sdc1", "/dev/sdc1", 1);
+    EXPECT_EQ(next.chunkSize, chunk);
+    scheduler->release(next);
+}
@@ -17,11 +17,16 @@
 #include <dfm-base/file/local/localfilehandler.h>
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/dfm_global_defines.h>
+#include <dfm-base/utils/fileutils.h>
 #include <dfm-io/dfile.h>
 
 #include "fileoperations/fileoperationutils/docopyfileworker.h"
 #include "fileoperations/fileoperationutils/workerdata.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 DFMBASE_USE_NAMESPACE
 DPFILEOPERATIONS_USE_NAMESPACE
 
@@ -191,6 +196,204 @@ TEST_F(TestDoCopyFileWorker, DoDfmioFileCopy_Stopped)
     EXPECT_FALSE(result);
 }
 
+// ========== doSmallFilesCopy Tests ==========
+
+TEST_F(TestDoCopyFileWorker, DoSmallFilesCopy_CopiesWholeBatch)
+{
+    QList<DoCopyFileWorker::CopyFilePair> batch;
+    for (int i = 0; i < 3; ++i) {
+        auto sourceFile = createTestFile(QString("small_%1.txt").arg(i), QString("content %1").arg(i));
+        auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+        auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + QString("/small_copy_%1.txt").arg(i))));
+        batch.append({ fromInfo, toInfo });
+    }
+
+    bool dfmioCalled = false;
+    stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy,
+                   [&dfmioCalled](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, bool *) -> bool {
+                       __DBG_STUB_INVOKE__
+                       dfmioCalled = true;
+                       return true;
+                   });
+
+    worker->doSmallFilesCopy(batch);
+
+    EXPECT_FALSE(dfmioCalled);
+    EXPECT_EQ(workData->completeFileCount, 3);
+    for (int i = 0; i < 3; ++i) {
+        QFile copied(tempDirPath + QString("/small_copy_%1.txt").arg(i));
+        ASSERT_TRUE(copied.open(QIODevice::ReadOnly));
+        EXPECT_EQ(copied.readAll(), QString("content %1").arg(i).toUtf8());
+    }
+}
+
+TEST_F(TestDoCopyFileWorker, DoSmallFilesCopy_FallbackToDfmioOnFailure)
+{
+    auto fromInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/missing.txt")));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/missing_copy.txt")));
+
+    int dfmioCalled = 0;
+    stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy,
+                   [&dfmioCalled](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, bool *) -> bool {
+                       __DBG_STUB_INVOKE__
+                       dfmioCalled++;
+                       return false;
+                   });
+
+    worker->doSmallFilesCopy({ { fromInfo, toInfo } });
+
+    EXPECT_EQ(dfmioCalled, 1);
+    EXPECT_EQ(workData->completeFileCount, 1);
+}
+
+// ========== reflink clone Tests ==========
+
+TEST_F(TestDoCopyFileWorker, DoFileCopy_CloneDisabledUsesDfmio)
+{
+    auto sourceFile = createTestFile("clone_disabled.txt");
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/clone_disabled_copy.txt")));
+
+    bool cloneCalled = false;
+    stub.set_lamda(&DoCopyFileWorker::doCloneFile,
+                   [&cloneCalled](DoCopyFileWorker *, const DFileInfoPointer &, const DFileInfoPointer &) -> DoCopyFileWorker::NextDo {
+                       __DBG_STUB_INVOKE__
+                       cloneCalled = true;
+                       return DoCopyFileWorker::NextDo::kDoCopyNext;
+                   });
+    int dfmioCalled = 0;
+    stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy,
+                   [&dfmioCalled](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, bool *) -> bool {
+                       __DBG_STUB_INVOKE__
+                       dfmioCalled++;
+                       return true;
+                   });
+
+    workData->reflinkCopy = false;
+    worker->doFileCopy(fromInfo, toInfo);
+
+    EXPECT_FALSE(cloneCalled);
+    EXPECT_EQ(dfmioCalled, 1);
+    EXPECT_EQ(workData->completeFileCount, 1);
+}
+
+TEST_F(TestDoCopyFileWorker, DoFileCopy_CloneFailureFallsBackToDfmio)
+{
+    auto sourceFile = createTestFile("clone_fail.txt");
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/clone_fail_copy.txt")));
+
+    stub.set_lamda(&DoCopyFileWorker::cloneFileBySys,
+                   [](DoCopyFileWorker *, const int, const int) -> bool {
+                       __DBG_STUB_INVOKE__
+                       return false;
+                   });
+    int dfmioCalled = 0;
+    stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy,
+                   [&dfmioCalled](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, bool *) -> bool {
+                       __DBG_STUB_INVOKE__
+                       dfmioCalled++;
+                       return true;
+                   });
+
+    workData->reflinkCopy = true;
+    worker->doFileCopy(fromInfo, toInfo);
+
+    EXPECT_EQ(dfmioCalled, 1);
+    EXPECT_EQ(workData->completeFileCount, 1);
+}
+
+TEST_F(TestDoCopyFileWorker, DoFileCopy_StoppedCloneDoesNotCopy)
+{
+    auto sourceFile = createTestFile("clone_stopped.txt");
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/clone_stopped_copy.txt")));
+
+    int dfmioCalled = 0;
+    stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy,
+                   [&dfmioCalled](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, bool *) -> bool {
+                       __DBG_STUB_INVOKE__
+                       dfmioCalled++;
+                       return true;
+                   });
+
+    workData->reflinkCopy = true;
+    worker->stop();
+    EXPECT_EQ(worker->doCloneFile(fromInfo, toInfo), DoCopyFileWorker::NextDo::kDoCopyErrorAddCancel);
+    worker->doFileCopy(fromInfo, toInfo);
+
+    EXPECT_EQ(dfmioCalled, 0);
+    EXPECT_EQ(workData->completeFileCount, 0);
+}
+
+TEST_F(TestDoCopyFileWorker, DoCloneFile_NotifiesAndCachesTarget)
+{
+    auto sourceFile = createTestFile("clone_notify.txt", "clone me");
+    const QUrl targetUrl = QUrl::fromLocalFile(tempDirPath + "/clone_notify_copy.txt");
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(targetUrl));
+
+    stub.set_lamda(&DoCopyFileWorker::cloneFileBySys,
+                   [](DoCopyFileWorker *, const int, const int) -> bool {
+                       __DBG_STUB_INVOKE__
+                       return true;
+                   });
+    QList<QUrl> cached;
+    stub.set_lamda(&FileUtils::cacheCopyingFileUrl, [&cached](const QUrl &url) {
+        __DBG_STUB_INVOKE__
+        cached.append(url);
+    });
+    QList<QUrl> uncached;
+    stub.set_lamda(&FileUtils::removeCopyingFileUrl, [&uncached](const QUrl &url) {
+        __DBG_STUB_INVOKE__
+        uncached.append(url);
+    });
+    QList<QUrl> added;
+    stub.set_lamda(&FileUtils::notifyFileChangeManual, [&added](Global::FileNotifyType type, const QUrl &url) {
+        __DBG_STUB_INVOKE__
+        if (type == Global::FileNotifyType::kFileAdded)
+            added.append(url);
+    });
+
+    workData->reflinkCopy = true;
+    EXPECT_EQ(worker->doCloneFile(fromInfo, toInfo), DoCopyFileWorker::NextDo::kDoCopyNext);
+    EXPECT_EQ(cached, QList<QUrl>({ targetUrl }));
+    EXPECT_EQ(uncached, QList<QUrl>({ targetUrl }));
+    EXPECT_EQ(added, QList<QUrl>({ targetUrl }));
+}
+
+TEST_F(TestDoCopyFileWorker, CloneFileBySys_ClonesOrDisablesReflink)
+{
+    auto sourceFile = createTestFile("clone_source.txt", "reflink content");
+    const QString targetPath = tempDirPath + "/clone_target.txt";
+
+    int srcFd = open(sourceFile->urlOf(UrlInfoType::kUrl).path().toLocal8Bit().constData(), O_RDONLY);
+    int dstFd = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(srcFd, 0);
+    ASSERT_GE(dstFd, 0);
+
+    workData->reflinkCopy = true;
+    const bool cloned = worker->cloneFileBySys(srcFd, dstFd);
+    close(srcFd);
+    close(dstFd);
+
+    if (cloned) {
+        QFile target(targetPath);
+        ASSERT_TRUE(target.open(QIODevice::ReadOnly));
+        EXPECT_EQ(target.readAll(), QByteArray("reflink content"));
+    } else {
+        // tmpfs and ext4 do not implement FICLONE
+        EXPECT_FALSE(workData->reflinkCopy);
+    }
+}
+
+TEST_F(TestDoCopyFileWorker, CloneFileBySys_DisabledDoesNothing)
+{
+    workData->reflinkCopy = false;
+    EXPECT_FALSE(worker->cloneFileBySys(-1, -1));
+    EXPECT_FALSE(workData->reflinkCopy);
+}
+
 // ========== progressCallback Tests ==========
 
 TEST_F(TestDoCopyFileWorker, ProgressCallback_UpdatesProgress)
@@ -393,6 +596,48 @@ TEST_F(TestDoCopyFileWorker, DoCopyFileByRange_Success)
     EXPECT_TRUE(result == DoCopyFileWorker::NextDo::kDoCopyNext);
 }
 
+TEST_F(TestDoCopyFileWorker, DoCopyFileByRange_KeepsHoles)
+{
+    const QString sourcePath = tempDirPath + "/sparse_source.img";
+    const QString targetPath = tempDirPath + "/sparse_target.img";
+    const qint64 fileSize = 8 * 1024 * 1024;
+    const QByteArray data(4096, 'd');
+
+    int fd = open(sourcePath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, data.constData(), static_cast<size_t>(data.size()), 2 * 1024 * 1024), data.size());
+    ASSERT_EQ(ftruncate(fd, fileSize), 0);
+    close(fd);
+
+    struct stat st;
+    ASSERT_EQ(stat(sourcePath.toLocal8Bit().constData(), &st), 0);
+    if (st.st_blocks * 512 >= fileSize)
+        GTEST_SKIP() << "filesystem of the temporary directory does not keep holes";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(sourcePath)));
+    fromInfo->initQuerier();
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+
+    stub.set_lamda(&DoCopyFileWorker::setTargetPermissions,
+                   [](DoCopyFileWorker *, const QUrl &, const QUrl &) {
+                       __DBG_STUB_INVOKE__
+                   });
+
+    workData->reflinkCopy = false;
+    bool skip = false;
+    EXPECT_EQ(worker->doCopyFileByRange(fromInfo, toInfo, &skip), DoCopyFileWorker::NextDo::kDoCopyNext);
+    EXPECT_EQ(workData->currentWriteSize, fileSize);
+
+    ASSERT_EQ(stat(targetPath.toLocal8Bit().constData(), &st), 0);
+    EXPECT_EQ(st.st_size, fileSize);
+    EXPECT_LT(st.st_blocks * 512, fileSize);
+
+    QFile target(targetPath);
+    ASSERT_TRUE(target.open(QIODevice::ReadOnly));
+    ASSERT_TRUE(target.seek(2 * 1024 * 1024));
+    EXPECT_EQ(target.read(data.size()), data);
+}
+
 TEST_F(TestDoCopyFileWorker, DoCopyFileByRange_Stopped)
 {
     auto sourceFile = createTestFile("range_stopped.txt");
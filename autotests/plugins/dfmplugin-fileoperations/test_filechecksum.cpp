@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QByteArray>
+
+#include "fileoperations/fileoperationutils/filechecksum.h"
+
+#include <zlib.h>
+
+using namespace dfmplugin_fileoperations;
+
+TEST(TestFileChecksum, AlgorithmFromName_ParsesKnownNames)
+{
+    EXPECT_EQ(FileChecksum::algorithmFromName("crc32c"), FileChecksum::Algorithm::kCrc32c);
+    EXPECT_EQ(FileChecksum::algorithmFromName(" XXH3 "), FileChecksum::Algorithm::kXxh3);
+    EXPECT_EQ(FileChecksum::algorithmFromName("adler32"), FileChecksum::Algorithm::kAdler32);
+    EXPECT_EQ(FileChecksum::algorithmFromName("unknown"), FileChecksum::Algorithm::kAdler32);
+}
+
+TEST(TestFileChecksum, Crc32c_MatchesCheckValue)
+{
+    FileChecksum checksum(FileChecksum::Algorithm::kCrc32c);
+    checksum.update("123456789", 9);
+    EXPECT_EQ(checksum.value(), 0xE3069283u);
+}
+
+TEST(TestFileChecksum, Adler32_MatchesZlib)
+{
+    const QByteArray data("dde-file-manager integrity checking");
+    FileChecksum checksum(FileChecksum::Algorithm::kAdler32);
+    checksum.update(data.constData(), data.size());
+
+    uLong expected = adler32(0L, nullptr, 0);
+    expected = adler32(expected, reinterpret_cast<const Bytef *>(data.constData()), static_cast<uInt>(data.size()));
+    EXPECT_EQ(checksum.value(), expected);
+}
+
+TEST(TestFileChecksum, Update_StreamingEqualsOneShot)
+{
+    QByteArray data(100000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = static_cast<char>(i * 7);
+
+    for (auto algorithm : { FileChecksum::Algorithm::kAdler32, FileChecksum::Algorithm::kCrc32c, FileChecksum::Algorithm::kXxh3 }) {
+        FileChecksum oneShot(algorithm);
+        oneShot.update(data.constData(), data.size());
+
+        FileChecksum streaming(algorithm);
+        for (int pos = 0; pos < data.size(); pos += 4093)
+            streaming.update(data.constData() + pos, qMin(4093, data.size() - pos));
+
+        EXPECT_EQ(oneShot.value(), streaming.value());
+    }
+}
+
+TEST(TestFileChecksum, Reset_RestartsChecksum)
+{
+    FileChecksum checksum(FileChecksum::Algorithm::kCrc32c);
+    checksum.update("garbage", 7);
+    checksum.reset();
+    checksum.update("123456789", 9);
+    EXPECT_EQ(checksum.value(), 0xE3069283u);
+}
+
+TEST(TestFileChecksum, UnavailableAlgorithm_FallsBackToCrc32c)
+{
+    if (FileChecksum::isAvailable(FileChecksum::Algorithm::kXxh3))
+        GTEST_SKIP() << "xxh3 is available in this build";
+
+    FileChecksum checksum(FileChecksum::Algorithm::kXxh3);
+    EXPECT_EQ(checksum.algorithm(), FileChecksum::Algorithm::kCrc32c);
+}
+
+TEST(TestFileChecksum, UpdateZeros_EqualsZeroData)
+{
+    const QByteArray zeros(200000, '\0');
+    for (auto algorithm : { FileChecksum::Algorithm::kAdler32, FileChecksum::Algorithm::kCrc32c }) {
+        FileChecksum data(algorithm);
+        data.update("head", 4);
+        data.update(zeros.constData(), zeros.size());
+
+        FileChecksum holes(algorithm);
+        holes.update("head", 4);
+        holes.updateZeros(zeros.size());
+
+        EXPECT_EQ(data.value(), holes.value());
+    }
+}
@@ -483,6 +483,31 @@ TEST_F(TestFileOperateBaseWorker, InitCopyWay_LocalToLocal)
     EXPECT_EQ(worker->countWriteType, AbstractWorker::CountWriteSizeType::kCustomizeType);
 }
 
+TEST_F(TestFileOperateBaseWorker, InitCopyWay_RotationalDiskUsesSingleThread)
+{
+    worker->isSourceFileLocal = true;
+    worker->isTargetFileLocal = true;
+    worker->sourceFilesCount = 10;
+    worker->sourceFilesTotalSize = 100 * 1024 * 1024;
+
+    stub.set_lamda(&FileUtils::getCpuProcessCount, []() -> int {
+        __DBG_STUB_INVOKE__
+        return 8;
+    });
+    stub.set_lamda(&DeviceIoScheduler::acquire,
+                   [](DeviceIoScheduler *, const QString &, const QString &, int) -> DeviceIoScheduler::Reservation {
+                       __DBG_STUB_INVOKE__
+                       DeviceIoScheduler::Reservation reservation;
+                       reservation.threads = 1;
+                       reservation.chunkSize = 4 * 1024 * 1024;
+                       return reservation;
+                   });
+
+    worker->initCopyWay();
+    EXPECT_TRUE(worker->workData->singleThread);
+    EXPECT_EQ(worker->workData->copyChunkSize, 4u * 1024 * 1024);
+}
+
 // ========== setSkipValue Tests ==========
 
 TEST_F(TestFileOperateBaseWorker, SetSkipValue_SkipAction)
@@ -440,3 +440,10 @@ TEST_F(TestFileOperationsUtils, EdgeCase_IsFilesSizeOutLimit_InvalidUrl)
     SUCCEED();
 }
 
+TEST_F(TestFileOperationsUtils, IsReflinkFileSystem_KnownTypes)
+{
+    EXPECT_TRUE(FileOperationsUtils::isReflinkFileSystem("btrfs"));
+    EXPECT_TRUE(FileOperationsUtils::isReflinkFileSystem("XFS"));
+    EXPECT_FALSE(FileOperationsUtils::isReflinkFileSystem("ext4"));
+    EXPECT_FALSE(FileOperationsUtils::isReflinkFileSystem(""));
+}
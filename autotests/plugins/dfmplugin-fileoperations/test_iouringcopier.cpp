@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QByteArray>
+
+#include "fileoperations/fileoperationutils/iouringcopier.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace dfmplugin_fileoperations;
+
+class TestIoUringCopier : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        sourcePath = tempDir.filePath("source.bin");
+        targetPath = tempDir.filePath("target.bin");
+    }
+
+    QByteArray writeSource(int size)
+    {
+        QByteArray data(size, Qt::Uninitialized);
+        for (int i = 0; i < size; ++i)
+            data[i] = static_cast<char>((i * 131) % 251);
+        QFile file(sourcePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(data);
+        file.close();
+        return data;
+    }
+
+    QTemporaryDir tempDir;
+    QString sourcePath;
+    QString targetPath;
+};
+
+TEST_F(TestIoUringCopier, Init_FailsWhenUnsupported)
+{
+    IoUringCopier copier;
+    if (IoUringCopier::isSupported())
+        GTEST_SKIP() << "io_uring is available on this host";
+
+    EXPECT_FALSE(copier.init(4, 4096));
+    EXPECT_FALSE(copier.isInitialized());
+
+    auto result = copier.copy(-1, -1, 0, 10, nullptr);
+    EXPECT_NE(result.error, 0);
+    EXPECT_EQ(result.copiedOffset, 0);
+}
+
+TEST_F(TestIoUringCopier, Copy_CopiesWholeFileInOrderProgress)
+{
+    if (!IoUringCopier::isSupported())
+        GTEST_SKIP() << "io_uring is not available on this host";
+
+    // several blocks plus a tail that is not block aligned
+    const QByteArray data = writeSource(4096 * 9 + 123);
+
+    IoUringCopier copier;
+    ASSERT_TRUE(copier.init(4, 4096));
+
+    int srcFd = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dstFd = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(srcFd, 0);
+    ASSERT_GE(dstFd, 0);
+
+    qint64 reported = 0;
+    auto result = copier.copy(srcFd, dstFd, 0, data.size(), [&reported](qint64 delta) {
+        reported += delta;
+        return true;
+    });
+    close(srcFd);
+    close(dstFd);
+
+    EXPECT_EQ(result.error, 0);
+    EXPECT_FALSE(result.canceled);
+    EXPECT_EQ(result.copiedOffset, data.size());
+    EXPECT_EQ(reported, data.size());
+
+    QFile target(targetPath);
+    ASSERT_TRUE(target.open(QIODevice::ReadOnly));
+    EXPECT_EQ(target.readAll(), data);
+}
+
+TEST_F(TestIoUringCopier, Copy_StopsWhenProgressCancels)
+{
+    if (!IoUringCopier::isSupported())
+        GTEST_SKIP() << "io_uring is not available on this host";
+
+    const QByteArray data = writeSource(4096 * 16);
+
+    IoUringCopier copier;
+    ASSERT_TRUE(copier.init(2, 4096));
+
+    int srcFd = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dstFd = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(srcFd, 0);
+    ASSERT_GE(dstFd, 0);
+
+    auto result = copier.copy(srcFd, dstFd, 0, data.size(), [](qint64) { return false; });
+    close(srcFd);
+    close(dstFd);
+
+    EXPECT_TRUE(result.canceled);
+    EXPECT_LT(result.copiedOffset, data.size());
+}
+
+TEST_F(TestIoUringCopier, Init_ReallocatesOnBlockSizeChange)
+{
+    if (!IoUringCopier::isSupported())
+        GTEST_SKIP() << "io_uring is not available on this host";
+
+    const QByteArray data = writeSource(8192 * 5 + 17);
+
+    IoUringCopier copier;
+    ASSERT_TRUE(copier.init(4, 4096));
+    // a tuned chunk size is picked up by the next init call
+    ASSERT_TRUE(copier.init(4, 8192));
+    EXPECT_TRUE(copier.isInitialized());
+
+    int srcFd = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dstFd = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(srcFd, 0);
+    ASSERT_GE(dstFd, 0);
+
+    auto result = copier.copy(srcFd, dstFd, 0, data.size(), nullptr);
+    close(srcFd);
+    close(dstFd);
+
+    EXPECT_EQ(result.error, 0);
+    EXPECT_EQ(result.copiedOffset, data.size());
+
+    QFile target(targetPath);
+    ASSERT_TRUE(target.open(QIODevice::ReadOnly));
+    EXPECT_EQ(target.readAll(), data);
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QByteArray>
+
+#include "fileoperations/fileoperationutils/sparsefilemap.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace dfmplugin_fileoperations;
+
+class TestSparseFileMap : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        filePath = tempDir.filePath("sparse.img");
+    }
+
+    // 4 KiB of data at kDataOffset inside a kFileSize file, holes everywhere else
+    void writeSparseFile()
+    {
+        int fd = open(filePath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+        ASSERT_GE(fd, 0);
+        const QByteArray data(kDataSize, 'x');
+        ASSERT_EQ(pwrite(fd, data.constData(), static_cast<size_t>(data.size()), kDataOffset), kDataSize);
+        ASSERT_EQ(ftruncate(fd, kFileSize), 0);
+        close(fd);
+    }
+
+    static constexpr qint64 kDataOffset { 1024 * 1024 };
+    static constexpr qint64 kDataSize { 4096 };
+    static constexpr qint64 kFileSize { 4 * 1024 * 1024 };
+
+    QTemporaryDir tempDir;
+    QString filePath;
+};
+
+TEST_F(TestSparseFileMap, DenseFile_IsOneDataRegion)
+{
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(10000, 'a'));
+    file.close();
+
+    SparseFileMap map(filePath, 10000);
+    EXPECT_FALSE(map.isSparse());
+
+    qint64 dataEnd = 0;
+    EXPECT_EQ(map.nextData(100, &dataEnd), 100);
+    EXPECT_EQ(dataEnd, 10000);
+}
+
+TEST_F(TestSparseFileMap, EmptyPath_IsNotSparse)
+{
+    SparseFileMap map(QString(), 100);
+    EXPECT_FALSE(map.isSparse());
+
+    qint64 dataEnd = 0;
+    EXPECT_EQ(map.nextData(0, &dataEnd), 0);
+    EXPECT_EQ(dataEnd, 100);
+}
+
+TEST_F(TestSparseFileMap, SparseFile_SkipsHoles)
+{
+    writeSparseFile();
+
+    SparseFileMap map(filePath, kFileSize);
+    if (!map.isSparse())
+        GTEST_SKIP() << "filesystem of the temporary directory does not keep holes";
+
+    qint64 dataEnd = 0;
+    const qint64 dataStart = map.nextData(0, &dataEnd);
+    EXPECT_LE(dataStart, kDataOffset);
+    EXPECT_GE(dataEnd, kDataOffset + kDataSize);
+    EXPECT_LT(dataEnd, kFileSize);
+
+    // only the trailing hole is left
+    EXPECT_EQ(map.nextData(dataEnd, &dataEnd), kFileSize);
+    EXPECT_EQ(dataEnd, kFileSize);
+}
+
+TEST_F(TestSparseFileMap, FdConstructor_DoesNotCloseFd)
+{
+    writeSparseFile();
+
+    int fd = open(filePath.toLocal8Bit().constData(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    {
+        SparseFileMap map(fd, kFileSize);
+        qint64 dataEnd = 0;
+        map.nextData(0, &dataEnd);
+    }
+    EXPECT_NE(fcntl(fd, F_GETFD), -1);
+    close(fd);
+}
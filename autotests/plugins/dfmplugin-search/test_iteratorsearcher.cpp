@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "searchmanager/searcher/iterator/iteratorsearcher.h"
+#include "searchmanager/searcher/iterator/trigramindexmanager.h"
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+DPSEARCH_USE_NAMESPACE
+
+class UT_IteratorSearcher : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(root.isValid());
+
+        stub.set_lamda(&TrigramIndexManager::acquire, [this](TrigramIndexManager *, const QString &) {
+            __DBG_STUB_INVOKE__
+            ++acquireCount;
+            return TrigramIndexManager::Snapshot();
+        });
+    }
+
+    void TearDown() override
+    {
+        stub.clear();
+    }
+
+    QTemporaryDir root;
+    stub_ext::StubExt stub;
+    int acquireCount = 0;
+};
+
+TEST_F(UT_IteratorSearcher, StartIndexQuery_InitialsKeyAsksIndex)
+{
+    // 纯字母关键字的字面量和拼音首字母都由索引回答
+    IteratorSearcher searcher(QUrl::fromLocalFile(root.path()), "wd");
+    ASSERT_FALSE(searcher.initialsKey.isEmpty());
+
+    EXPECT_FALSE(searcher.startIndexQuery(root.path()));
+    EXPECT_EQ(acquireCount, 1);
+}
+
+TEST_F(UT_IteratorSearcher, StartIndexQuery_PlainKeyAsksIndex)
+{
+    IteratorSearcher searcher(QUrl::fromLocalFile(root.path()), "wd.txt");
+    ASSERT_TRUE(searcher.initialsKey.isEmpty());
+
+    EXPECT_FALSE(searcher.startIndexQuery(root.path()));
+    EXPECT_EQ(acquireCount, 1);
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "searchmanager/searcher/iterator/localtreewalker.h"
+
+#include <dfm-base/base/schemefactory.h>
+#include <dfm-base/interfaces/fileinfo.h>
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QSet>
+#include <QTemporaryDir>
+
+DFMBASE_USE_NAMESPACE
+DPSEARCH_USE_NAMESPACE
+
+class UT_LocalTreeWalker : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(root.isValid());
+
+        // desktop 文件的显示名称由 FileInfo 提供
+        stub.set_lamda(&InfoFactory::create<FileInfo>,
+                       [](const QUrl &url, Global::CreateFileInfoType, QString *) -> QSharedPointer<FileInfo> {
+                           __DBG_STUB_INVOKE__
+                           return QSharedPointer<FileInfo>(new FileInfo(url));
+                       });
+        stub.set_lamda(VADDR(FileInfo, displayOf), [](FileInfo *self, const DisPlayInfoType) -> QString {
+            __DBG_STUB_INVOKE__
+            return self->urlOf(UrlInfoType::kUrl).fileName() == "editor.desktop" ? QString("Match Editor") : QString("Other");
+        });
+    }
+
+    void TearDown() override
+    {
+        stub.clear();
+    }
+
+    QString makeFile(const QString &relativePath)
+    {
+        const QString path = root.filePath(relativePath);
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        return path;
+    }
+
+    QSet<QString> walk(const QString &pattern, const QString &initialsKey = QString(), int threads = 2)
+    {
+        LocalTreeWalker walker(root.path(), QRegularExpression(pattern, QRegularExpression::CaseInsensitiveOption), initialsKey);
+        walker.start(threads);
+        EXPECT_TRUE(walker.wait(10000));
+        EXPECT_TRUE(walker.isFinished());
+
+        const QStringList &results = walker.takeResults();
+        return QSet<QString>(results.cbegin(), results.cend());
+    }
+
+    QTemporaryDir root;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_LocalTreeWalker, Walk_RegexHitsInNestedDirectories)
+{
+    const QString top = makeFile("match_top.txt");
+    const QString deep = makeFile("a/b/c/deep_MATCH.log");
+    makeFile("a/b/other.txt");
+    const QString dir = QDir(root.path()).filePath("a/matched_dir");
+    QDir().mkpath(dir);
+
+    const auto &results = walk("match");
+    EXPECT_EQ(results, QSet<QString>({ top, deep, dir }));
+}
+
+TEST_F(UT_LocalTreeWalker, Walk_DesktopFilesMatchByDisplayName)
+{
+    const QString editor = makeFile("apps/editor.desktop");
+    makeFile("apps/viewer.desktop");
+
+    const auto &results = walk("match");
+    EXPECT_EQ(results, QSet<QString>({ editor }));
+}
+
+TEST_F(UT_LocalTreeWalker, Walk_SkipsHiddenEntriesAndSymlinkedDirectories)
+{
+    const QString visible = makeFile("sub/match.txt");
+    makeFile(".hidden_match.txt");
+    makeFile(".cache/match_inside_hidden.txt");
+
+    // 指向根目录的链接如果被跟随会重复遍历甚至死循环，这里只报告链接本身
+    const QString link = root.filePath("match_link");
+    ASSERT_TRUE(QFile::link(root.filePath("sub"), link));
+    ASSERT_TRUE(QFile::link(root.path(), root.filePath("loop")));
+
+    const auto &results = walk("match");
+    EXPECT_EQ(results, QSet<QString>({ visible, link }));
+}
+
+TEST_F(UT_LocalTreeWalker, Walk_MatchesPinyinInitials)
+{
+    const QString doc = makeFile("文档.txt");
+    makeFile("图片.png");
+
+    const auto &results = walk("wd", "wd");
+    EXPECT_EQ(results, QSet<QString>({ doc }));
+}
+
+TEST_F(UT_LocalTreeWalker, Walk_SameResultsAsDirIterator)
+{
+    for (int i = 0; i < 20; ++i) {
+        makeFile(QString("d%1/file_%1.txt").arg(i));
+        makeFile(QString("d%1/n%1/item_%1.dat").arg(i));
+        makeFile(QString("d%1/.hidden_%1.txt").arg(i));
+    }
+    ASSERT_TRUE(QFile::link(root.filePath("d1"), root.filePath("d0/link_1")));
+
+    const QRegularExpression regex("1", QRegularExpression::CaseInsensitiveOption);
+    QSet<QString> expected;
+    QDirIterator it(root.path(), QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        if (regex.match(it.fileName()).hasMatch())
+            expected.insert(it.filePath());
+    }
+
+    ASSERT_FALSE(expected.isEmpty());
+    EXPECT_EQ(walk("1", QString(), 4), expected);
+}
+
+TEST_F(UT_LocalTreeWalker, Stop_FinishesEarlyAndEmitsFinishedOnce)
+{
+    for (int i = 0; i < 200; ++i)
+        makeFile(QString("d%1/e%1/f%1/file.txt").arg(i));
+
+    int finishedCount = 0;
+    LocalTreeWalker walker(root.path(), QRegularExpression("file"));
+    QObject::connect(&walker, &LocalTreeWalker::finished, [&finishedCount] { ++finishedCount; });
+    walker.start(2);
+    walker.stop();
+
+    EXPECT_TRUE(walker.wait(10000));
+    EXPECT_TRUE(walker.isFinished());
+    EXPECT_EQ(finishedCount, 1);
+    EXPECT_LE(walker.takeResults().size(), 200);
+}
@@ -0,0 +1,355 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "searchmanager/searcher/iterator/trigramindex.h"
+#include "searchmanager/searcher/iterator/trigramindexmanager.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSet>
+#include <QStorageInfo>
+#include <QTemporaryDir>
+#include <QThread>
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+QString makeFile(const QTemporaryDir &root, const QString &relativePath)
+{
+    const QString path = root.filePath(relativePath);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    file.open(QIODevice::WriteOnly);
+    return path;
+}
+
+QSet<QString> toSet(const QStringList &list)
+{
+    return QSet<QString>(list.cbegin(), list.cend());
+}
+}   // namespace
+
+class UT_TrigramIndex : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(root.isValid());
+        ASSERT_TRUE(indexDir.isValid());
+        indexFile = indexDir.filePath("test.trigram");
+    }
+
+    QSharedPointer<TrigramIndex> buildIndex(QList<QByteArray> *dirs = nullptr)
+    {
+        std::atomic_bool cancelled { false };
+        if (!TrigramIndex::build(root.path(), indexFile, cancelled, dirs))
+            return nullptr;
+        return TrigramIndex::open(indexFile);
+    }
+
+    QStringList search(const QSharedPointer<TrigramIndex> &index, const QString &pattern, const QString &under = QString())
+    {
+        std::atomic_bool cancelled { false };
+        return index->search(QRegularExpression(pattern, QRegularExpression::CaseInsensitiveOption),
+                             under.isEmpty() ? root.path() : under, cancelled);
+    }
+
+    QTemporaryDir root;
+    QTemporaryDir indexDir;
+    QString indexFile;
+};
+
+TEST(UT_TrigramIndexLiterals, RequiredLiterals_PlainAndConcatenated)
+{
+    EXPECT_EQ(TrigramIndex::requiredLiterals("Report"), QList<QByteArray>({ "report" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("foo.*bar"), QList<QByteArray>({ "foo", "bar" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("\\.txt$"), QList<QByteArray>({ ".txt" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("报告"), QList<QByteArray>({ QString("报告").toUtf8() }));
+}
+
+TEST(UT_TrigramIndexLiterals, RequiredLiterals_OptionalPartsAreDropped)
+{
+    EXPECT_EQ(TrigramIndex::requiredLiterals("colou?r"), QList<QByteArray>({ "colo", "r" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("ab+c"), QList<QByteArray>({ "ab", "c" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("[abc]def"), QList<QByteArray>({ "def" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("(abc)?def"), QList<QByteArray>({ "def" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("(?=abc)def"), QList<QByteArray>({ "def" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("(x|y)abc"), QList<QByteArray>({ "abc" }));
+    EXPECT_EQ(TrigramIndex::requiredLiterals("\\dabc\\w"), QList<QByteArray>({ "abc" }));
+}
+
+TEST(UT_TrigramIndexLiterals, RequiredLiterals_AlternationOrUnbalancedGivesNothing)
+{
+    EXPECT_TRUE(TrigramIndex::requiredLiterals("abc|def").isEmpty());
+    EXPECT_TRUE(TrigramIndex::requiredLiterals("abc)").isEmpty());
+    EXPECT_TRUE(TrigramIndex::requiredLiterals("(?x)a b c").isEmpty());
+    EXPECT_TRUE(TrigramIndex::requiredLiterals(".*").isEmpty());
+}
+
+TEST_F(UT_TrigramIndex, Build_OpenAndSearch)
+{
+    const QString report = makeFile(root, "Report.txt");
+    const QString nested = makeFile(root, "docs/2024/annual_report.pdf");
+    const QString chinese = makeFile(root, "docs/项目报告.doc");
+    makeFile(root, "docs/notes.txt");
+    makeFile(root, ".hidden/report_hidden.txt");
+
+    QList<QByteArray> dirs;
+    const auto &index = buildIndex(&dirs);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(index->mountPoint(), root.path());
+    // 根节点 + 6 个可见的文件和目录，隐藏目录不收录
+    EXPECT_EQ(index->entryCount(), 7);
+    EXPECT_TRUE(dirs.contains(QFile::encodeName(root.filePath("docs/2024"))));
+    EXPECT_FALSE(dirs.contains(QFile::encodeName(root.filePath(".hidden"))));
+
+    EXPECT_EQ(toSet(search(index, "report")), QSet<QString>({ report, nested }));
+    EXPECT_EQ(toSet(search(index, "报告")), QSet<QString>({ chinese }));
+    EXPECT_EQ(toSet(search(index, "rep.*pdf")), QSet<QString>({ nested }));
+    EXPECT_TRUE(search(index, "nothing_like_this").isEmpty());
+}
+
+TEST_F(UT_TrigramIndex, Search_NoLiteralsScansAllNames)
+{
+    const QString a = makeFile(root, "a.md");
+    const QString b = makeFile(root, "sub/b.md");
+    makeFile(root, "c.txt");
+
+    const auto &index = buildIndex();
+    ASSERT_TRUE(index);
+    // ".m" 不足一个三元组，退化为扫描全部文件名
+    EXPECT_EQ(toSet(search(index, "^[ab]\\.m")), QSet<QString>({ a, b }));
+}
+
+TEST_F(UT_TrigramIndex, Search_RestrictedToPathAndDropsDeletedFiles)
+{
+    const QString kept = makeFile(root, "one/match_kept.txt");
+    const QString removed = makeFile(root, "one/match_removed.txt");
+    makeFile(root, "two/match_other.txt");
+
+    const auto &index = buildIndex();
+    ASSERT_TRUE(index);
+    ASSERT_TRUE(QFile::remove(removed));
+
+    EXPECT_EQ(toSet(search(index, "match", root.filePath("one"))), QSet<QString>({ kept }));
+}
+
+TEST_F(UT_TrigramIndex, SearchInitials_MatchesChineseNamesUnderPath)
+{
+    const QString doc = makeFile(root, "one/文档.txt");
+    const QString nested = makeFile(root, "one/sub/我的文档");
+    makeFile(root, "one/wd.txt");
+    makeFile(root, "two/文档.md");
+
+    const auto &index = buildIndex();
+    ASSERT_TRUE(index);
+
+    // 纯 ASCII 的文件名不参与首字母匹配，字面量由 search() 回答
+    std::atomic_bool cancelled { false };
+    EXPECT_EQ(toSet(index->searchInitials("WD", root.filePath("one"), cancelled)), QSet<QString>({ doc, nested }));
+}
+
+TEST_F(UT_TrigramIndex, Open_RejectsCorruptedFile)
+{
+    makeFile(root, "file.txt");
+    ASSERT_TRUE(buildIndex());
+
+    QFile file(indexFile);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    file.resize(file.size() - 1);
+    file.close();
+    EXPECT_FALSE(TrigramIndex::open(indexFile));
+
+    QFile garbage(indexDir.filePath("garbage.trigram"));
+    ASSERT_TRUE(garbage.open(QIODevice::WriteOnly));
+    garbage.write(QByteArray(256, 'x'));
+    garbage.close();
+    EXPECT_FALSE(TrigramIndex::open(garbage.fileName()));
+}
+
+TEST_F(UT_TrigramIndex, Build_Cancelled)
+{
+    makeFile(root, "file.txt");
+    std::atomic_bool cancelled { true };
+    EXPECT_FALSE(TrigramIndex::build(root.path(), indexFile, cancelled, nullptr));
+}
+
+TEST_F(UT_TrigramIndex, Build_StopsAboveDirectoryLimit)
+{
+    makeFile(root, "a/file.txt");
+    makeFile(root, "b/file.txt");
+    std::atomic_bool cancelled { false };
+
+    QList<QByteArray> dirs;
+    EXPECT_FALSE(TrigramIndex::build(root.path(), indexFile, cancelled, &dirs, 2));
+    EXPECT_EQ(dirs.size(), 3);
+
+    dirs.clear();
+    EXPECT_TRUE(TrigramIndex::build(root.path(), indexFile, cancelled, &dirs, 3));
+    EXPECT_EQ(dirs.size(), 3);
+}
+
+class UT_TrigramIndexManager : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(root.isValid());
+        ASSERT_TRUE(outside.isValid());
+        manager.reset(new TrigramIndexManager);
+
+        mount.reset(new TrigramIndexManager::Mount);
+        mount->mountPoint = root.path();
+        mount->complete = true;
+        QMutexLocker lk(&manager->lock);
+        manager->mounts.insert(mount->mountPoint, mount);
+    }
+
+    void TearDown() override
+    {
+        manager.reset();
+        stub.clear();
+    }
+
+    bool waitFor(const std::function<bool()> &condition)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < 5000) {
+            {
+                QMutexLocker lk(&manager->lock);
+                if (condition())
+                    return true;
+            }
+            QThread::msleep(10);
+        }
+        return false;
+    }
+
+    bool isWatched(const QString &dir)
+    {
+        const QByteArray &path = QFile::encodeName(dir);
+        for (const auto &watch : std::as_const(manager->watches)) {
+            if (watch.second == path)
+                return true;
+        }
+        return false;
+    }
+
+    QTemporaryDir root;
+    QTemporaryDir outside;
+    QScopedPointer<TrigramIndexManager> manager;
+    TrigramIndexManager::MountPointer mount;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_TrigramIndexManager, WatchDirectories_RespectsBudget)
+{
+    QList<QByteArray> dirs;
+    for (int i = 0; i < 5; ++i) {
+        QDir(root.path()).mkdir(QString::number(i));
+        dirs.append(QFile::encodeName(root.filePath(QString::number(i))));
+    }
+
+    manager->watchBudget = 3;
+    EXPECT_FALSE(manager->watchDirectories(mount, dirs));
+    EXPECT_EQ(manager->watches.size(), 3);
+
+    manager->watchBudget = 100;
+    EXPECT_TRUE(manager->watchDirectories(mount, dirs));
+    EXPECT_EQ(manager->watches.size(), 5);
+}
+
+TEST_F(UT_TrigramIndexManager, Events_RecordCreatedFilesAndMovedInDirectories)
+{
+    ASSERT_TRUE(manager->watchDirectories(mount, { QFile::encodeName(root.path()) }));
+
+    const QString created = makeFile(root, "created.txt");
+    EXPECT_TRUE(waitFor([&] { return mount->recent.contains(created); }));
+
+    // 移入的目录中已有的内容一并记录，并为其添加监听
+    const QString inner = makeFile(outside, "moved/inner.txt");
+    makeFile(outside, "moved/.hidden.txt");
+    ASSERT_TRUE(QDir().rename(outside.filePath("moved"), root.filePath("moved")));
+    const QString movedDir = root.filePath("moved");
+    const QString movedInner = root.filePath("moved/inner.txt");
+    EXPECT_TRUE(waitFor([&] { return mount->recent.contains(movedDir) && mount->recent.contains(movedInner) && isWatched(movedDir); }));
+    EXPECT_FALSE(mount->recent.contains(root.filePath("moved/.hidden.txt")));
+    EXPECT_FALSE(mount->recent.contains(inner));
+
+    const QString later = makeFile(root, "moved/later.txt");
+    EXPECT_TRUE(waitFor([&] { return mount->recent.contains(later); }));
+    EXPECT_TRUE(mount->complete);
+
+    // 监听的目录被移走后路径失效，索引不再完整
+    ASSERT_TRUE(QDir().rename(movedDir, outside.filePath("moved_away")));
+    EXPECT_TRUE(waitFor([&] { return !mount->complete; }));
+}
+
+TEST_F(UT_TrigramIndexManager, Acquire_OnlyCompleteIndexIsReturned)
+{
+    stub.set_lamda(&TrigramIndexManager::isEnabled, [] { return true; });
+
+    makeFile(root, "file.txt");
+    QTemporaryDir indexDir;
+    std::atomic_bool cancelled { false };
+    const QString indexFile = indexDir.filePath("test.trigram");
+    ASSERT_TRUE(TrigramIndex::build(root.path(), indexFile, cancelled, nullptr));
+
+    // 按 root 所在的真实挂载点登记，building 阻止测试中触发整个挂载点的重建
+    const QString mountPoint = QStorageInfo(root.path()).rootPath();
+    {
+        QMutexLocker lk(&manager->lock);
+        manager->mounts.remove(mount->mountPoint);
+        mount->mountPoint = mountPoint;
+        mount->index = TrigramIndex::open(indexFile);
+        mount->recent = QStringList { root.filePath("recent.txt") };
+        mount->building = true;
+        manager->mounts.insert(mountPoint, mount);
+    }
+    ASSERT_TRUE(mount->index);
+
+    mount->complete = false;
+    EXPECT_FALSE(manager->acquire(root.path()).index);
+
+    mount->complete = true;
+    mount->watching = true;
+    EXPECT_FALSE(manager->acquire(root.path()).index);
+
+    mount->watching = false;
+    const auto &snapshot = manager->acquire(root.path());
+    EXPECT_EQ(snapshot.index, mount->index);
+    EXPECT_EQ(snapshot.recentPaths, mount->recent);
+
+    stub.set_lamda(&TrigramIndexManager::isEnabled, [] { return false; });
+    EXPECT_FALSE(manager->acquire(root.path()).index);
+}
+
+TEST_F(UT_TrigramIndexManager, Build_OverWatchBudget_StopsRetrying)
+{
+    for (int i = 0; i < 4; ++i)
+        makeFile(root, QString("%1/file.txt").arg(i));
+
+    QTemporaryDir indexDir;
+    {
+        QMutexLocker lk(&manager->lock);
+        manager->watchBudget = 3;
+        mount->complete = false;
+        mount->indexFile = indexDir.filePath("test.trigram");
+        manager->scheduleBuildLocked(mount);
+    }
+    ASSERT_TRUE(waitFor([&] { return !mount->building; }));
+
+    // 根目录加 4 个子目录超出预算，不再添加监听，也不再按间隔重建
+    QMutexLocker lk(&manager->lock);
+    EXPECT_TRUE(mount->unsupported);
+    EXPECT_FALSE(mount->index);
+    EXPECT_TRUE(manager->watches.isEmpty());
+    mount->lastBuild = 0;
+    EXPECT_FALSE(manager->needsRebuildLocked(*mount));
+}
@@ -303,8 +303,9 @@ TEST_F(TestGroupingEngine, SetGroupOrder)
 
 TEST_F(TestGroupingEngine, SetVisibleTreeChildren)
 {
-    QHash<QUrl, QList<QUrl>> treeChildren;
-    engine->setVisibleTreeChildren(&treeChildren);
+    QHash<QUrl, QVector<SortKeyStore::Id>> treeChildren;
+    QHash<QUrl, SortKeyStore> stores;
+    engine->setVisibleTreeChildren(&treeChildren, &stores);
 }
 
 TEST_F(TestGroupingEngine, SetChildrenDataMap)
@@ -612,8 +613,9 @@ TEST_F(TestGroupingEngine, FindExpandedFiles_NoTreeChildren)
 
 TEST_F(TestGroupingEngine, FindExpandedFiles_NotExpanded)
 {
-    QHash<QUrl, QList<QUrl>> treeChildren;
-    engine->setVisibleTreeChildren(&treeChildren);
+    QHash<QUrl, QVector<SortKeyStore::Id>> treeChildren;
+    QHash<QUrl, SortKeyStore> stores;
+    engine->setVisibleTreeChildren(&treeChildren, &stores);
     
     auto expandedFiles = engine->findExpandedFiles(testFileData);
     EXPECT_TRUE(expandedFiles.isEmpty());
@@ -624,17 +626,20 @@ TEST_F(TestGroupingEngine, FindExpandedFiles_Expanded)
     // Set file as expanded
     testFileData->setExpanded(true);
     
-    QHash<QUrl, QList<QUrl>> treeChildren;
-    QList<QUrl> children;
-    children.append(QUrl::fromLocalFile("/test/child1.txt"));
-    treeChildren.insert(QUrl::fromLocalFile("/test/file1.txt"), children);
+    QUrl childUrl = QUrl::fromLocalFile("/test/child1.txt");
+    SortInfoPointer childInfo(new dfmbase::SortFileInfo);
+    childInfo->setUrl(childUrl);
+
+    QHash<QUrl, SortKeyStore> stores;
+    QHash<QUrl, QVector<SortKeyStore::Id>> treeChildren;
+    const QUrl parentUrl = QUrl::fromLocalFile("/test/file1.txt");
+    treeChildren.insert(parentUrl, { stores[parentUrl].insert(childInfo) });
     
     // Add child data to map
-    QUrl childUrl = QUrl::fromLocalFile("/test/child1.txt");
     FileItemDataPointer childData = FileItemDataPointer::create(childUrl);
     childrenDataMap.insert(QUrl::fromLocalFile("/test/child1.txt"), childData);
     
-    engine->setVisibleTreeChildren(&treeChildren);
+    engine->setVisibleTreeChildren(&treeChildren, &stores);
     
     auto expandedFiles = engine->findExpandedFiles(testFileData);
     EXPECT_EQ(expandedFiles.size(), 1);
@@ -654,12 +659,14 @@ TEST_F(TestGroupingEngine, FindTopLevelAncestorOf_RootUrl)
 
 TEST_F(TestGroupingEngine, FindTopLevelAncestorOf_TopLevelChild)
 {
-    QHash<QUrl, QList<QUrl>> treeChildren;
-    QList<QUrl> rootChildren;
-    rootChildren.append(QUrl::fromLocalFile("/test/file1.txt"));
-    treeChildren.insert(testUrl, rootChildren);
+    SortInfoPointer fileInfo(new dfmbase::SortFileInfo);
+    fileInfo->setUrl(QUrl::fromLocalFile("/test/file1.txt"));
+
+    QHash<QUrl, SortKeyStore> stores;
+    QHash<QUrl, QVector<SortKeyStore::Id>> treeChildren;
+    treeChildren.insert(testUrl, { stores[testUrl].insert(fileInfo) });
     
-    engine->setVisibleTreeChildren(&treeChildren);
+    engine->setVisibleTreeChildren(&treeChildren, &stores);
     
     auto ancestor = engine->findTopLevelAncestorOf(QUrl::fromLocalFile("/test/file1.txt"));
     EXPECT_EQ(ancestor, QUrl::fromLocalFile("/test/file1.txt"));
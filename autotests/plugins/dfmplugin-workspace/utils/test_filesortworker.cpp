@@ -947,3 +947,204 @@ TEST_F(FileSortWorkerTest, DoModelChanged_ValidType_HandlesModelChange)
         // The actual implementation is tested through other public methods
     });
 }
+
+TEST_F(FileSortWorkerTest, CoalesceWatcherEvent_EventsInWindow_AreBuffered)
+{
+    auto sortInfo = QSharedPointer<dfmbase::SortFileInfo>::create();
+    sortInfo->setUrl(QUrl::fromLocalFile("/tmp/test/a.txt"));
+
+    // 空闲时的第一个事件立即处理，并开启合并窗口
+    EXPECT_FALSE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherAdd, { sortInfo }));
+    ASSERT_NE(worker->watcherCoalesceTimer, nullptr);
+    EXPECT_TRUE(worker->watcherCoalesceTimer->isActive());
+
+    // 窗口内的相邻同类事件合并为一批
+    EXPECT_TRUE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherAdd, { sortInfo }));
+    EXPECT_TRUE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherAdd, { sortInfo }));
+    EXPECT_TRUE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherRemove, { sortInfo }));
+    ASSERT_EQ(worker->pendingWatcherEvents.size(), 2);
+    EXPECT_EQ(worker->pendingWatcherEvents.first().children.size(), 2);
+    EXPECT_EQ(worker->pendingWatcherEvents.last().type, FileSortWorker::WatcherEventType::kWatcherRemove);
+
+    EXPECT_FALSE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherAdd, {}));
+}
+
+TEST_F(FileSortWorkerTest, FlushWatcherEvents_DuplicateUpdates_HandledOnce)
+{
+    auto sortInfo = QSharedPointer<dfmbase::SortFileInfo>::create();
+    sortInfo->setUrl(QUrl::fromLocalFile("/tmp/test/growing.log"));
+
+    int updateCount = 0;
+    stub.set_lamda(&FileSortWorker::handleWatcherUpdateFile, [&updateCount]() {
+        ++updateCount;
+        return false;
+    });
+
+    worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherUpdate, { sortInfo });
+    worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherUpdate, { sortInfo, sortInfo });
+    worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherUpdate, { sortInfo });
+
+    worker->flushWatcherEvents();
+    EXPECT_EQ(updateCount, 1);
+    EXPECT_TRUE(worker->pendingWatcherEvents.isEmpty());
+    EXPECT_FALSE(worker->flushingWatcherEvents);
+
+    // 窗口内没有新事件时不再续期
+    worker->watcherCoalesceTimer->stop();
+    worker->flushWatcherEvents();
+    EXPECT_FALSE(worker->watcherCoalesceTimer->isActive());
+}
+
+namespace {
+SortInfoPointer makeSizedSortInfo(const QString &name, qint64 size)
+{
+    auto sortInfo = QSharedPointer<dfmbase::SortFileInfo>::create();
+    sortInfo->setUrl(QUrl::fromLocalFile("/tmp/test/" + name));
+    sortInfo->setFile(true);
+    sortInfo->setSize(size);
+    return sortInfo;
+}
+}   // namespace
+
+class FileSortWorkerBatchTest : public FileSortWorkerTest
+{
+protected:
+    void SetUp() override
+    {
+        FileSortWorkerTest::SetUp();
+        stub.set_lamda(&FileSortWorker::checkFilters, [] { return true; });
+        stub.set_lamda(&FileSortWorker::createAndInsertItemData, [] {});
+        stub.set_lamda(&FileSortWorker::currentIsGroupingMode, [] { return false; });
+
+        worker->orgSortRole = DFMBASE_NAMESPACE::Global::ItemRoles::kItemFileSizeRole;
+        worker->sortOrder = Qt::AscendingOrder;
+        worker->isMixDirAndFile = false;
+
+        // 已有按大小升序的 a(10) c(30) e(50)
+        QList<QUrl> urls;
+        QVector<SortKeyStore::Id> ids;
+        auto &store = worker->children[worker->current];
+        for (const auto &info : { makeSizedSortInfo("a", 10), makeSizedSortInfo("c", 30), makeSizedSortInfo("e", 50) }) {
+            ids.append(store.insert(info));
+            urls.append(info->fileUrl());
+        }
+        worker->visibleTreeChildren.insert(worker->current, ids);
+        worker->visibleChildren = urls;
+
+        QObject::connect(worker, &FileSortWorker::insertRows, [this](int first, int count) {
+            inserts.append({ first, count });
+        });
+        QObject::connect(worker, &FileSortWorker::removeRows, [this](int first, int count) {
+            removes.append({ first, count });
+        });
+        QObject::connect(worker, &FileSortWorker::selectAndEditFile, [this](const QUrl &url) {
+            selected.append(url);
+        });
+    }
+
+    QStringList visibleNames() const
+    {
+        QStringList names;
+        for (const auto &url : worker->visibleChildren)
+            names.append(url.fileName());
+        return names;
+    }
+
+    QList<QPair<int, int>> inserts;
+    QList<QPair<int, int>> removes;
+    QList<QUrl> selected;
+};
+
+TEST_F(FileSortWorkerBatchTest, AddChildrenBatch_ContiguousAdds_EmitSingleInsertRange)
+{
+    worker->addChildrenBatch({ makeSizedSortInfo("g", 70), makeSizedSortInfo("f", 60) });
+
+    EXPECT_EQ(visibleNames(), QStringList({ "a", "c", "e", "f", "g" }));
+    EXPECT_EQ(worker->visibleTreeUrls(worker->current), worker->visibleChildren);
+    EXPECT_TRUE(removes.isEmpty());
+    ASSERT_EQ(inserts.size(), 1);
+    EXPECT_EQ(inserts.first(), qMakePair(3, 2));
+    EXPECT_EQ(worker->children.value(worker->current).count(), 5);
+}
+
+TEST_F(FileSortWorkerBatchTest, AddChildrenBatch_InterleavedAdds_MergeAndReset)
+{
+    worker->addChildrenBatch({ makeSizedSortInfo("d", 40), makeSizedSortInfo("b", 20) });
+
+    EXPECT_EQ(visibleNames(), QStringList({ "a", "b", "c", "d", "e" }));
+    ASSERT_EQ(removes.size(), 1);
+    EXPECT_EQ(removes.first(), qMakePair(0, 3));
+    ASSERT_EQ(inserts.size(), 1);
+    EXPECT_EQ(inserts.first(), qMakePair(0, 5));
+}
+
+TEST_F(FileSortWorkerBatchTest, AddChildrenBatch_NewFiles_RequestSelectAndEdit)
+{
+    const auto f = makeSizedSortInfo("f", 60);
+    const auto b = makeSizedSortInfo("b", 20);
+    worker->addChildrenBatch({ f, b, makeSizedSortInfo("a", 10) });
+
+    // 已存在的 a 不是新文件，不参与选中
+    ASSERT_EQ(selected.size(), 2);
+    EXPECT_TRUE(selected.contains(f->fileUrl()));
+    EXPECT_TRUE(selected.contains(b->fileUrl()));
+}
+
+TEST_F(FileSortWorkerBatchTest, HandleUpdateFile_PendingAdds_FlushedFirst)
+{
+    const auto f = makeSizedSortInfo("f", 60);
+    worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherAdd, { makeSizedSortInfo("x", 1) });
+    ASSERT_TRUE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherAdd, { f }));
+
+    bool addedBeforeUpdate = false;
+    stub.set_lamda(&FileSortWorker::handleWatcherAddChildren, [this, &addedBeforeUpdate](FileSortWorker *, const QList<SortInfoPointer> &children) {
+        for (const auto &info : children)
+            worker->children[worker->current].insert(info);
+        addedBeforeUpdate = true;
+    });
+
+    worker->handleWatcherUpdateFile(f);
+    EXPECT_TRUE(addedBeforeUpdate);
+    EXPECT_TRUE(worker->pendingWatcherEvents.isEmpty());
+}
+
+TEST_F(FileSortWorkerBatchTest, FlushWatcherEvents_TreeRemovesUnderTwoParents_RemoveBothRows)
+{
+    // 树形视图：d1/x 与 d2/y 在同一个合并窗口内被删除
+    worker->istree = true;
+    worker->currentSupportTreeView = true;
+    worker->children.clear();
+    worker->visibleTreeChildren.clear();
+
+    const auto makeChild = [](const QString &path, bool isDir) {
+        auto sortInfo = QSharedPointer<dfmbase::SortFileInfo>::create();
+        sortInfo->setUrl(QUrl::fromLocalFile("/tmp/test/" + path));
+        sortInfo->setDir(isDir);
+        sortInfo->setFile(!isDir);
+        return sortInfo;
+    };
+    const auto d1 = makeChild("d1", true);
+    const auto d2 = makeChild("d2", true);
+    const auto x = makeChild("d1/x", false);
+    const auto y = makeChild("d2/y", false);
+
+    auto &root = worker->children[worker->current];
+    worker->visibleTreeChildren.insert(worker->current, { root.insert(d1), root.insert(d2) });
+    worker->visibleTreeChildren.insert(d1->fileUrl(), { worker->children[d1->fileUrl()].insert(x) });
+    worker->visibleTreeChildren.insert(d2->fileUrl(), { worker->children[d2->fileUrl()].insert(y) });
+    worker->visibleChildren = { d1->fileUrl(), x->fileUrl(), d2->fileUrl(), y->fileUrl() };
+
+    // 第一个事件开启窗口，之后不同父目录的删除不能合并为一批
+    EXPECT_FALSE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherUpdate, { d1 }));
+    EXPECT_TRUE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherRemove, { x }));
+    EXPECT_TRUE(worker->coalesceWatcherEvent(FileSortWorker::WatcherEventType::kWatcherRemove, { y }));
+    ASSERT_EQ(worker->pendingWatcherEvents.size(), 2);
+
+    worker->flushWatcherEvents();
+
+    EXPECT_EQ(visibleNames(), QStringList({ "d1", "d2" }));
+    EXPECT_FALSE(worker->children.value(d1->fileUrl()).contains(x->fileUrl()));
+    EXPECT_FALSE(worker->children.value(d2->fileUrl()).contains(y->fileUrl()));
+    EXPECT_TRUE(worker->visibleTreeChildren.value(d2->fileUrl()).isEmpty());
+    EXPECT_EQ(removes.size(), 2);
+}
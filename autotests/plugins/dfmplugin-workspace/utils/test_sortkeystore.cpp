@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <dfm-base/interfaces/sortfileinfo.h>
+
+#include "utils/sortkeystore.h"
+#include "utils/fileviewsorter.h"
+
+#include <QUrl>
+
+using namespace dfmplugin_workspace;
+
+class SortKeyStoreTest : public ::testing::Test
+{
+protected:
+    static SortInfoPointer makeInfo(const QString &name, qint64 size, qint64 mtime, bool isDir = false)
+    {
+        SortInfoPointer info(new dfmbase::SortFileInfo);
+        info->setUrl(QUrl::fromLocalFile("/tmp/sortkeystore/" + name));
+        info->setSize(size);
+        info->setDir(isDir);
+        info->setFile(!isDir);
+        info->setHide(name.startsWith('.'));
+        info->setLastModifiedTime(mtime);
+        return info;
+    }
+
+    static QStringList names(const QList<QUrl> &urls)
+    {
+        QStringList result;
+        for (const auto &url : urls)
+            result << url.fileName();
+        return result;
+    }
+
+    QStringList names(const QVector<SortKeyStore::Id> &ids) const
+    {
+        return names(store.urls(ids));
+    }
+
+    void sortBy(FileViewSorter::SortRole role, Qt::SortOrder order, bool mix)
+    {
+        FileViewSorter::SortContext ctx;
+        ctx.role = role;
+        ctx.order = order;
+        ctx.isMixDirAndFile = mix;
+        sorter.setContext(ctx);
+    }
+
+    SortKeyStore store;
+    FileViewSorter sorter;
+};
+
+TEST_F(SortKeyStoreTest, Insert_AssignsDenseIdsAndColumns)
+{
+    auto a = makeInfo("a.txt", 10, 100);
+    auto b = makeInfo("b", 0, 200, true);
+
+    const auto idA = store.insert(a);
+    const auto idB = store.insert(b);
+    EXPECT_EQ(idA, 0u);
+    EXPECT_EQ(idB, 1u);
+    EXPECT_EQ(store.count(), 2);
+    EXPECT_EQ(store.insert(a), idA);
+
+    EXPECT_EQ(store.size(idA), 10);
+    EXPECT_EQ(store.lastModified(idB), 200);
+    EXPECT_FALSE(store.isDir(idA));
+    EXPECT_TRUE(store.isDir(idB));
+    EXPECT_EQ(store.url(idA), a->fileUrl());
+}
+
+TEST_F(SortKeyStoreTest, Remove_ReusesId)
+{
+    auto a = makeInfo("a", 1, 1);
+    auto b = makeInfo("b", 1, 1);
+    auto c = makeInfo("c", 1, 1);
+    store.insert(a);
+    const auto idB = store.insert(b);
+
+    store.remove(b->fileUrl());
+    EXPECT_FALSE(store.contains(b->fileUrl()));
+    EXPECT_EQ(store.id(b->fileUrl()), SortKeyStore::kInvalidId);
+
+    EXPECT_EQ(store.insert(c), idB);
+    EXPECT_EQ(store.url(idB), c->fileUrl());
+
+    store.remove(QUrl::fromLocalFile("/not/tracked"));
+    EXPECT_EQ(store.count(), 2);
+}
+
+TEST_F(SortKeyStoreTest, Refresh_InvalidatesDerivedKeys)
+{
+    auto a = makeInfo("a", 1, 1);
+    const auto id = store.insert(a);
+    store.setNameKey(id, "key");
+    store.setKeyRole(1);
+    store.setRoleKey(id, 42);
+    EXPECT_TRUE(store.hasNameKey(id));
+    EXPECT_TRUE(store.hasRoleKey(id));
+
+    a->setSize(99);
+    EXPECT_TRUE(store.refresh(a));
+    EXPECT_EQ(store.size(id), 99);
+    EXPECT_FALSE(store.hasNameKey(id));
+    EXPECT_FALSE(store.hasRoleKey(id));
+
+    EXPECT_FALSE(store.refresh(makeInfo("missing", 1, 1)));
+}
+
+TEST_F(SortKeyStoreTest, SetKeyRole_ChangeDropsRoleColumnOnly)
+{
+    const auto id = store.insert(makeInfo("a", 1, 1));
+    store.setNameKey(id, "key");
+    store.setKeyRole(1);
+    store.setRoleKey(id, 5);
+
+    store.setKeyRole(1);
+    EXPECT_TRUE(store.hasRoleKey(id));
+
+    store.setKeyRole(2);
+    EXPECT_FALSE(store.hasRoleKey(id));
+    EXPECT_TRUE(store.hasNameKey(id));
+
+    store.invalidateKeys();
+    EXPECT_FALSE(store.hasNameKey(id));
+}
+
+TEST_F(SortKeyStoreTest, Value_OwnsSortInfos)
+{
+    auto a = makeInfo("a", 1, 1);
+    auto b = makeInfo("b", 1, 1);
+    store.insert(a);
+    store.insert(b);
+    EXPECT_EQ(store.value(a->fileUrl()), a);
+    EXPECT_TRUE(store.value(QUrl::fromLocalFile("/other")).isNull());
+
+    EXPECT_TRUE(store.remove(a->fileUrl()));
+    EXPECT_FALSE(store.remove(a->fileUrl()));
+    EXPECT_TRUE(store.value(a->fileUrl()).isNull());
+
+    // 已回收的 ID 不出现在遍历结果中
+    EXPECT_EQ(store.ids().size(), 1);
+    EXPECT_EQ(store.urls(), QList<QUrl>({ b->fileUrl() }));
+    ASSERT_EQ(store.infos().size(), 1);
+    EXPECT_EQ(store.infos().first(), b);
+}
+
+TEST_F(SortKeyStoreTest, Ids_FailsWhenUrlIsNotTracked)
+{
+    auto a = makeInfo("a", 1, 1);
+    store.insert(a);
+    EXPECT_EQ(store.ids({ a->fileUrl() }).size(), 1);
+    EXPECT_TRUE(store.ids({ a->fileUrl(), QUrl::fromLocalFile("/other") }).isEmpty());
+}
+
+TEST_F(SortKeyStoreTest, SorterSize_DirsFirstThenNumericSize)
+{
+    QVector<SortKeyStore::Id> ids;
+    for (const auto &info : { makeInfo("big", 1000, 1), makeInfo("small", 2, 1),
+                              makeInfo("dir", 0, 1, true), makeInfo("mid", 100, 1) })
+        ids << store.insert(info);
+
+    sortBy(FileViewSorter::SortRole::Size, Qt::AscendingOrder, true);
+    EXPECT_EQ(names(sorter.sort(ids, &store)), QStringList({ "dir", "small", "mid", "big" }));
+
+    sortBy(FileViewSorter::SortRole::Size, Qt::DescendingOrder, true);
+    EXPECT_EQ(names(sorter.sort(ids, &store)), QStringList({ "dir", "big", "mid", "small" }));
+}
+
+TEST_F(SortKeyStoreTest, SorterLastModified_UsesTimeColumn)
+{
+    QVector<SortKeyStore::Id> ids;
+    for (const auto &info : { makeInfo("new", 1, 3000), makeInfo("old", 1, 1000), makeInfo("mid", 1, 2000) })
+        ids << store.insert(info);
+
+    sortBy(FileViewSorter::SortRole::LastModified, Qt::AscendingOrder, false);
+    EXPECT_EQ(names(sorter.sort(ids, &store)), QStringList({ "old", "mid", "new" }));
+
+    const auto sorted = sorter.sort(ids, &store);
+    const auto added = store.insert(makeInfo("newest", 1, 4000));
+    EXPECT_EQ(sorter.findInsertPosition(added, sorted, &store), 3);
+}
+
+TEST_F(SortKeyStoreTest, SorterLargeInput_ParallelSortIsOrderedAndStable)
+{
+    // 超过并行阈值，走分段排序 + 归并路径
+    const int count = 60000;
+    QVector<SortKeyStore::Id> ids;
+    for (int i = 0; i < count; ++i)
+        ids << store.insert(makeInfo(QString("f%1").arg(i, 6, 10, QChar('0')), (i * 7919) % 97, 1));
+
+    sortBy(FileViewSorter::SortRole::Size, Qt::AscendingOrder, false);
+    const auto sorted = sorter.sort(ids, &store);
+    ASSERT_EQ(sorted.size(), count);
+
+    for (int i = 1; i < sorted.size(); ++i) {
+        const auto prev = sorted.at(i - 1);
+        const auto curr = sorted.at(i);
+        ASSERT_LE(store.size(prev), store.size(curr));
+        if (store.size(prev) == store.size(curr))
+            ASSERT_LT(store.nameKey(prev), store.nameKey(curr));
+    }
+}
+
+TEST_F(SortKeyStoreTest, SorterMerge_InsertsNewItemsInOnePass)
+{
+    QVector<SortKeyStore::Id> oldIds;
+    for (const auto &info : { makeInfo("a", 10, 1), makeInfo("c", 30, 1), makeInfo("e", 50, 1) })
+        oldIds << store.insert(info);
+    QVector<SortKeyStore::Id> newIds;
+    for (const auto &info : { makeInfo("f", 60, 1), makeInfo("b", 20, 1), makeInfo("c2", 30, 1) })
+        newIds << store.insert(info);
+
+    sortBy(FileViewSorter::SortRole::Size, Qt::AscendingOrder, false);
+    const auto merged = sorter.merge(sorter.sort(oldIds, &store), sorter.sort(newIds, &store), &store);
+    EXPECT_EQ(names(merged), QStringList({ "a", "b", "c", "c2", "e", "f" }));
+}
+
+TEST_F(SortKeyStoreTest, SorterReverse_KeepsDirsBeforeFiles)
+{
+    QVector<SortKeyStore::Id> ids;
+    for (const auto &info : { makeInfo("d1", 0, 1, true), makeInfo("d2", 0, 1, true),
+                              makeInfo("f1", 1, 1), makeInfo("f2", 2, 1), makeInfo("f3", 3, 1) })
+        ids << store.insert(info);
+
+    sortBy(FileViewSorter::SortRole::FileName, Qt::DescendingOrder, false);
+    EXPECT_EQ(names(sorter.reverse(ids, &store)), QStringList({ "d2", "d1", "f3", "f2", "f1" }));
+
+    sortBy(FileViewSorter::SortRole::FileName, Qt::DescendingOrder, true);
+    EXPECT_EQ(names(sorter.reverse(ids, &store)), QStringList({ "f3", "f2", "f1", "d2", "d1" }));
+}
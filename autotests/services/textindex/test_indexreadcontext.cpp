@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_indexreadcontext.cpp
+ * @brief Unit tests for IndexReadContext (task/indexreadcontext.cpp)
+ */
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QDir>
+
+#include "dfm_test_main.h"
+#include "services/textindex/service_textindex_global.h"
+#include "services/textindex/profile/indexprofile.h"
+#include "services/textindex/task/indexreadcontext.h"
+
+#include <dfm-search/field_names.h>
+
+#include <lucene++/LuceneHeaders.h>
+#include <lucene++/NumericField.h>
+
+using namespace SERVICETEXTINDEX_NAMESPACE;
+using namespace Lucene;
+
+namespace {
+
+class IndexReadContextTest : public testing::Test
+{
+protected:
+    QTemporaryDir tmp;
+    QString indexDir;
+    IndexWriterPtr writer;
+
+    IndexProfile makeProfile()
+    {
+        return IndexProfile(IndexProfile::Type::Content,
+                            "readctx_test",
+                            "readctx_status.json",
+                            "readctx_version",
+                            1,
+                            [this]() -> QString { return indexDir; },
+                            []() -> bool { return true; },
+                            [](const QString &) -> bool { return true; },
+                            [](const QString &) -> bool { return true; });
+    }
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(tmp.isValid());
+        indexDir = tmp.path() + "/index";
+        QDir().mkpath(indexDir);
+
+        writer = newLucene<IndexWriter>(FSDirectory::open(indexDir.toStdWString()),
+                                        newLucene<StandardAnalyzer>(LuceneVersion::LUCENE_CURRENT),
+                                        true, IndexWriter::MaxFieldLengthUNLIMITED);
+    }
+
+    void TearDown() override
+    {
+        if (writer)
+            writer->close();
+    }
+
+    void addDocument(const QString &path, qint64 modifyTime)
+    {
+        using namespace DFMSEARCH::LuceneFieldNames;
+        DocumentPtr doc = newLucene<Document>();
+        doc->add(newLucene<Field>(Content::kPath, path.toStdWString(),
+                                  Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+        NumericFieldPtr timeField = newLucene<NumericField>(Content::kModifyTime, Field::STORE_YES, true);
+        timeField->setLongValue(modifyTime);
+        doc->add(timeField);
+        writer->addDocument(doc);
+    }
+};
+
+}   // namespace
+
+TEST_F(IndexReadContextTest, Reader_NonExistentIndexThrows)
+{
+    IndexReadContext readContext(makeProfile(), tmp.path() + "/missing");
+    EXPECT_THROW(readContext.reader(), LuceneException);
+}
+
+TEST_F(IndexReadContextTest, LookupText_NonExistentIndexReturnsEmpty)
+{
+    IndexReadContext readContext(makeProfile(), tmp.path() + "/missing");
+    EXPECT_TRUE(readContext.lookupTextByChecksum("d41d8cd98f00b204e9800998ecf8427e").isEmpty());
+    EXPECT_TRUE(readContext.lookupTextByChecksum(QString()).isEmpty());
+}
+
+TEST_F(IndexReadContextTest, StoredModifyTime_LoadsAllDocuments)
+{
+    addDocument("/home/user/a.txt", 1700000000);
+    addDocument("/home/user/b.txt", 1700000123);
+    writer->commit();
+
+    IndexReadContext readContext(makeProfile(), indexDir);
+    EXPECT_EQ(readContext.storedModifyTime("/home/user/a.txt"), std::optional<qint64>(1700000000));
+    EXPECT_EQ(readContext.storedModifyTime("/home/user/b.txt"), std::optional<qint64>(1700000123));
+    EXPECT_FALSE(readContext.storedModifyTime("/home/user/c.txt").has_value());
+}
+
+TEST_F(IndexReadContextTest, StoredModifyTime_SkipsDeletedDocuments)
+{
+    addDocument("/home/user/a.txt", 1700000000);
+    addDocument("/home/user/b.txt", 1700000123);
+    writer->commit();
+    writer->deleteDocuments(newLucene<Term>(DFMSEARCH::LuceneFieldNames::Content::kPath, L"/home/user/b.txt"));
+    writer->commit();
+
+    IndexReadContext readContext(makeProfile(), indexDir);
+    EXPECT_TRUE(readContext.storedModifyTime("/home/user/a.txt").has_value());
+    EXPECT_FALSE(readContext.storedModifyTime("/home/user/b.txt").has_value());
+}
+
+TEST_F(IndexReadContextTest, RecordAndForget_UpdateLoadedTable)
+{
+    addDocument("/home/user/a.txt", 1700000000);
+    writer->commit();
+
+    IndexReadContext readContext(makeProfile(), indexDir);
+    ASSERT_TRUE(readContext.storedModifyTime("/home/user/a.txt").has_value());
+
+    readContext.recordIndexed("/home/user/new.txt", 1700000999);
+    EXPECT_EQ(readContext.storedModifyTime("/home/user/new.txt"), std::optional<qint64>(1700000999));
+
+    readContext.forget("/home/user/a.txt");
+    EXPECT_FALSE(readContext.storedModifyTime("/home/user/a.txt").has_value());
+}
+
+TEST_F(IndexReadContextTest, MarkCommitted_ReopensReader)
+{
+    addDocument("/home/user/a.txt", 1700000000);
+    writer->commit();
+
+    IndexReadContext readContext(makeProfile(), indexDir);
+    EXPECT_EQ(readContext.searcher()->maxDoc(), 1);
+
+    addDocument("/home/user/b.txt", 1700000123);
+    writer->commit();
+
+    // 未标记提交时继续使用原来的 reader
+    EXPECT_EQ(readContext.searcher()->maxDoc(), 1);
+
+    readContext.markCommitted();
+    EXPECT_EQ(readContext.searcher()->maxDoc(), 2);
+    EXPECT_EQ(readContext.reader()->numDocs(), 2);
+}
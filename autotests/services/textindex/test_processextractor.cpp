@@ -116,4 +116,36 @@ TEST_F(ProcessExtractorTest, Extract_MultipleCalls)
         auto result = ext.extract(filePath);
         EXPECT_FALSE(result.success);
     }
-}
\ No newline at end of file
+}
+
+TEST_F(ProcessExtractorTest, ExtractBatch_Empty)
+{
+    ProcessExtractor ext;
+    EXPECT_TRUE(ext.extractBatch({}).isEmpty());
+}
+
+TEST_F(ProcessExtractorTest, ExtractBatch_StartFailure_FailsEveryFile)
+{
+    ProcessExtractor ext(3);
+    ext.setThrottled(false);
+
+    const QStringList files { "/tmp/a.txt", "/tmp/b.txt", "/tmp/c.txt", "/tmp/d.txt" };
+    const auto results = ext.extractBatch(files);
+    ASSERT_EQ(results.size(), files.size());
+    for (const auto &result : results) {
+        EXPECT_FALSE(result.success);
+        EXPECT_FALSE(result.error.isEmpty());
+    }
+}
+
+TEST_F(ProcessExtractorTest, PreferredBatchSize_FollowsMaxProcesses)
+{
+    ProcessExtractor ext(3);
+    EXPECT_EQ(ext.preferredBatchSize(), 6);
+
+    ext.setMaxProcesses(1);
+    EXPECT_EQ(ext.preferredBatchSize(), 2);
+
+    ProcessExtractor automatic;
+    EXPECT_GE(automatic.preferredBatchSize(), 2);
+}
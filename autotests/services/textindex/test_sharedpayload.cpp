@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_sharedpayload.cpp
+ * @brief Unit tests for SharedPayload / MappedPayload (libextractor/sharedpayload.cpp)
+ *        Covers memfd creation and sealing, descriptor passing over a socketpair,
+ *        and mapping validation against the announced payload size.
+ */
+
+#include <gtest/gtest.h>
+#include <QByteArray>
+
+#include "dfm_test_main.h"
+#include "services/textindex/service_textindex_global.h"
+#include "sharedpayload.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace dfm_extractor;
+
+namespace {
+
+QByteArray makePayload(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = static_cast<char>('a' + i % 26);
+    return data;
+}
+
+}   // namespace
+
+TEST(SharedPayloadTest, MemfdRoundTrip)
+{
+    const QByteArray data = makePayload(SharedPayload::kThreshold + 17);
+    const int fd = SharedPayload::createSealedMemfd(data);
+    ASSERT_GE(fd, 0);
+
+    {
+        MappedPayload payload(fd, data.size());
+        ASSERT_TRUE(payload.isValid());
+        EXPECT_EQ(payload.data(), data);
+    }
+    ::close(fd);
+}
+
+TEST(SharedPayloadTest, MemfdIsSealedAgainstWrites)
+{
+    const int fd = SharedPayload::createSealedMemfd(QByteArray("content"));
+    ASSERT_GE(fd, 0);
+
+    const int seals = ::fcntl(fd, F_GET_SEALS);
+    EXPECT_TRUE(seals & F_SEAL_WRITE);
+    EXPECT_TRUE(seals & F_SEAL_SHRINK);
+    EXPECT_LT(::write(fd, "x", 1), 0);
+    ::close(fd);
+}
+
+TEST(SharedPayloadTest, MappingRejectsOversizedLength)
+{
+    const int fd = SharedPayload::createSealedMemfd(QByteArray("short"));
+    ASSERT_GE(fd, 0);
+
+    MappedPayload payload(fd, 4096);
+    EXPECT_FALSE(payload.isValid());
+    EXPECT_TRUE(payload.data().isEmpty());
+    ::close(fd);
+}
+
+TEST(SharedPayloadTest, MappingRejectsInvalidDescriptor)
+{
+    MappedPayload payload(-1, 10);
+    EXPECT_FALSE(payload.isValid());
+}
+
+TEST(SharedPayloadTest, DescriptorPassesOverSocketPair)
+{
+    int sockets[2] { -1, -1 };
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets), 0);
+
+    const QByteArray data = makePayload(1024);
+    const int memfd = SharedPayload::createSealedMemfd(data);
+    ASSERT_GE(memfd, 0);
+    EXPECT_TRUE(SharedPayload::sendFileDescriptor(sockets[1], memfd));
+    ::close(memfd);
+
+    const int received = SharedPayload::receiveFileDescriptor(sockets[0]);
+    ASSERT_GE(received, 0);
+    {
+        MappedPayload payload(received, data.size());
+        ASSERT_TRUE(payload.isValid());
+        EXPECT_EQ(payload.data(), data);
+    }
+    ::close(received);
+    ::close(sockets[0]);
+    ::close(sockets[1]);
+}
+
+TEST(SharedPayloadTest, ReceiveOnEmptySocketDoesNotBlock)
+{
+    int sockets[2] { -1, -1 };
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets), 0);
+
+    EXPECT_EQ(SharedPayload::receiveFileDescriptor(sockets[0]), -1);
+    ::close(sockets[0]);
+    ::close(sockets[1]);
+}
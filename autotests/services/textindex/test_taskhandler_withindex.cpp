@@ -224,6 +224,29 @@ TEST_F(TaskHandlerIndexTest, CreateOrUpdateFileListHandler_CoversUpdateFile)
     SUCCEED();
 }
 
+// ---- A path listed twice in one task is written once ----
+TEST_F(TaskHandlerIndexTest, CreateOrUpdateFileListHandler_DuplicatePathWrittenOnce)
+{
+    {
+        auto rt = std::make_unique<IndexRuntime>(makeProfile());
+        TaskHandler h = TaskHandlers::CreateIndexHandler(rt->context());
+        TaskState state;
+        h(tmp.path(), state);
+    }
+
+    createFile("new.txt", "added after the index was created");
+    const QString newFile = tmp.path() + "/new.txt";
+
+    auto rt = std::make_unique<IndexRuntime>(makeProfile());
+    TaskHandler h = TaskHandlers::CreateOrUpdateFileListHandler(rt->context(), { newFile, newFile });
+    TaskState state;
+    h(tmp.path(), state);
+
+    IndexReaderPtr reader = IndexReader::open(FSDirectory::open(indexDir.toStdWString()), true);
+    EXPECT_LE(reader->docFreq(newLucene<Term>(rt->context().profile().pathField(), newFile.toStdWString())), 1);
+    reader->close();
+}
+
 // ---- MoveFileListHandler covers FileMoveProcessor and DirectoryMoveProcessor ----
 TEST_F(TaskHandlerIndexTest, MoveFileListHandler_CoversProcessors)
 {
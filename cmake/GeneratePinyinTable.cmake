@@ -0,0 +1,135 @@
+# SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+# GeneratePinyinTable.cmake - Generate the static pinyin lookup table
+#
+# Usage: cmake -DPINYIN_DICT=<pinyin.dict> -DPINYIN_TABLE=<output header> -P GeneratePinyinTable.cmake
+#
+# pinyin.dict holds one "0x<code point>:<syllable with tone>" entry per line.
+# The header maps the CJK range 0x3400-0x9FFF through a dense array of syllable
+# indexes, and the few compatibility ideographs outside it through a sorted
+# sparse array, so no parsing is needed at runtime.
+
+cmake_minimum_required(VERSION 3.10)
+
+if(NOT PINYIN_DICT OR NOT PINYIN_TABLE)
+    message(FATAL_ERROR "PINYIN_DICT and PINYIN_TABLE are required")
+endif()
+
+file(STRINGS "${PINYIN_DICT}" _lines REGEX "^0x[0-9a-f]+:[a-z]+[0-9]$")
+
+# collect syllables and code points
+set(_syllables)
+set(_codes)
+foreach(_line IN LISTS _lines)
+    string(REPLACE ":" ";" _pair "${_line}")
+    list(GET _pair 0 _code)
+    list(GET _pair 1 _syllable)
+    set(_CP_${_code} ${_syllable})
+    list(APPEND _codes ${_code})
+    if(NOT DEFINED _SYL_${_syllable})
+        set(_SYL_${_syllable} 0)
+        list(APPEND _syllables ${_syllable})
+    endif()
+endforeach()
+
+list(SORT _syllables)
+list(LENGTH _syllables _syllableCount)
+
+# syllable text and offsets, index is the position in the sorted list
+set(_text "")
+set(_offsets "")
+set(_offset 0)
+set(_index 0)
+foreach(_syllable IN LISTS _syllables)
+    set(_SYL_${_syllable} ${_index})
+    string(APPEND _text "    \"${_syllable}\"\n")
+    string(APPEND _offsets "${_offset}, ")
+    string(LENGTH "${_syllable}" _length)
+    math(EXPR _offset "${_offset} + ${_length}")
+    math(EXPR _index "${_index} + 1")
+endforeach()
+string(APPEND _offsets "${_offset}")
+
+# dense table for 0x3400-0x9fff, one line per 16 code points; value is syllable index + 1
+set(_hex 0 1 2 3 4 5 6 7 8 9 a b c d e f)
+set(_dense "")
+foreach(_a 3 4 5 6 7 8 9)
+    foreach(_b IN LISTS _hex)
+        if(_a STREQUAL "3" AND _b MATCHES "^[0-3]$")
+            continue()
+        endif()
+        foreach(_c IN LISTS _hex)
+            string(APPEND _dense "   ")
+            foreach(_d IN LISTS _hex)
+                set(_code "0x${_a}${_b}${_c}${_d}")
+                if(DEFINED _CP_${_code})
+                    set(_syllable ${_CP_${_code}})
+                    math(EXPR _value "${_SYL_${_syllable}} + 1")
+                    string(APPEND _dense " ${_value},")
+                else()
+                    string(APPEND _dense " 0,")
+                endif()
+            endforeach()
+            string(APPEND _dense "\n")
+        endforeach()
+    endforeach()
+endforeach()
+
+# code points outside the dense range, sorted
+set(_sparseCodes)
+foreach(_code IN LISTS _codes)
+    if(NOT _code MATCHES "^0x[3-9][0-9a-f][0-9a-f][0-9a-f]$" OR _code MATCHES "^0x3[0-3]")
+        list(APPEND _sparseCodes ${_code})
+    endif()
+endforeach()
+list(SORT _sparseCodes)
+set(_sparse "")
+foreach(_code IN LISTS _sparseCodes)
+    set(_syllable ${_CP_${_code}})
+    string(APPEND _sparse "    { ${_code}, ${_SYL_${_syllable}} },\n")
+endforeach()
+
+file(WRITE "${PINYIN_TABLE}.tmp"
+"// Generated by cmake/GeneratePinyinTable.cmake from pinyin.dict, do not edit.
+
+#ifndef PINYINTABLE_DATA_H
+#define PINYINTABLE_DATA_H
+
+#include <QtGlobal>
+
+namespace Pinyin {
+namespace Table {
+
+inline constexpr char16_t kDenseBegin { 0x3400 };
+inline constexpr char16_t kDenseEnd { 0xa000 };
+inline constexpr int kSyllableCount { ${_syllableCount} };
+
+inline constexpr char kSyllableText[] {
+${_text}};
+
+inline constexpr quint16 kSyllableOffsets[kSyllableCount + 1] { ${_offsets} };
+
+// syllable index + 1 for each code point in [kDenseBegin, kDenseEnd), 0 if unknown
+inline constexpr quint16 kDense[kDenseEnd - kDenseBegin] {
+${_dense}};
+
+struct SparseEntry
+{
+    char16_t code;
+    quint16 syllable;
+};
+
+// sorted by code
+inline constexpr SparseEntry kSparse[] {
+${_sparse}};
+
+}   // namespace Table
+}   // namespace Pinyin
+
+#endif   // PINYINTABLE_DATA_H
+")
+
+# 内容不变时不更新时间戳，避免无谓的重新编译
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${PINYIN_TABLE}.tmp" "${PINYIN_TABLE}")
+file(REMOVE "${PINYIN_TABLE}.tmp")
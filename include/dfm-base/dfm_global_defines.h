@@ -123,6 +123,7 @@ enum ItemRoles {
     kItemHighlightKeywordsRole = Qt::UserRole + 45,   // per-item highlight keywords (semantic search etc.)
     kItemGroupTruncatedRole = Qt::UserRole + 46,
     kItemGroupTruncationEnabledRole = Qt::UserRole + 47,
+    kItemFilePinyinInitialsRole = Qt::UserRole + 48,   // pinyin initials of display name, for type-ahead
 
     kItemUnknowRole = Qt::UserRole + 999
 };
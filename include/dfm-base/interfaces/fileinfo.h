@@ -80,6 +80,7 @@ public:
         kFileDisplayPath = 3,   // 文件路径显示名称
         kMimeTypeDisplayName = 4,   // 文件的mimeType显示名称
         kFileTypeDisplayName = 5,   // 文件的文件类型显示名称
+        kFileDisplayPinyinInitials = 6,   // 文件显示名称的拼音首字母
         kCustomerStartDisplay = 50,   // 其他用户使用
         kUnknowDisplayInfo = 255,
     };
@@ -398,6 +399,7 @@ protected:
     mutable QReadWriteLock extendOtherCacheLock;
     mutable QMap<FileInfo::FileExtendedInfoType, QVariant> extendOtherCache;
     QString pinyinName;
+    QString pinyinInitials;
 
 private:
     QSharedPointer<FileInfoPrivate> dptr;
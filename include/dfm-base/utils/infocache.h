@@ -19,6 +19,16 @@ namespace dfmbase {
 class InfoCachePrivate;
 class InfoCache;
 
+// fileinfo缓存的命中统计
+struct InfoCacheStatistics
+{
+    quint64 hits { 0 };
+    quint64 misses { 0 };
+    quint64 evictions { 0 };   // 超出容量或超时被移除的条目数
+    int size { 0 };   // 当前缓存的条目数
+    int capacity { 0 };   // 缓存条目上限
+};
+
 // 异步缓存和移除
 class CacheWorker : public QObject
 {
@@ -77,6 +87,8 @@ private:
     bool cacheDisable(const QString &scheme);
     void setCacheDisbale(const QString &scheme, bool disable = true);
     FileInfoPointer getCacheInfo(const QUrl &url);
+    void setCapacity(const int infoCount, const int watcherCount);
+    InfoCacheStatistics statistics() const;
     void stop();
     void cacheInfo(const QUrl url, const FileInfoPointer info);
     void disconnectWatcher(const QMap<QUrl, FileInfoPointer> infos);
@@ -110,6 +122,8 @@ public:
     bool cacheDisable(const QString &scheme);
     void setCacheDisbale(const QString &scheme, bool disable = true);
     FileInfoPointer getCacheInfo(const QUrl &url);
+    void setCacheCapacity(const int infoCount, const int watcherCount);
+    InfoCacheStatistics statistics() const;
 Q_SIGNALS:
     void cacheFileInfo(const QUrl url, const FileInfoPointer info);
     void removeCacheFileInfo(const QList<QUrl> &urls);
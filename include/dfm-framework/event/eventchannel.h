@@ -10,7 +10,10 @@
 #include <dfm-framework/event/invokehelper.h>
 
 #include <QFuture>
-#include <QReadWriteLock>
+#include <QMutex>
+
+#include <array>
+#include <atomic>
 
 DPF_BEGIN_NAMESPACE
 
@@ -37,12 +40,23 @@ class EventChannel
 {
 public:
     using Connector = std::function<QVariant(const QVariantList &)>;
+    using TypedConnector = std::function<QVariant(void **)>;
+
+    EventChannel() = default;
+    ~EventChannel();
 
     QVariant send();
     QVariant send(const QVariantList &params);
     template<class T, class... Args>
     inline QVariant send(T param, Args &&... args)
     {
+        // 参数类型与接收者签名完全一致时直接按地址调用，避免 QVariant 装箱和 QVariantList 分配
+        const Receiver *current = receiver.load(std::memory_order_acquire);
+        if (current && current->signature == eventSignature<T, Args...>()) {
+            void *argv[] { argumentAddress(param), argumentAddress(args)... };
+            return invoke(current, argv);
+        }
+
         QVariantList ret;
         makeVariantList(&ret, param, std::forward<Args>(args)...);
         return send(ret);
@@ -64,21 +78,51 @@ public:
         static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
         static_assert(!std::is_pointer<T>::value, "Receiver::bind's template type T must not be a pointer type");
 
-        QMutexLocker guard(&receiverMutex);
-        conn = [obj, method](const QVariantList &args) -> QVariant {
+        Receiver *next = new Receiver;
+        next->conn = [obj, method](const QVariantList &args) -> QVariant {
             EventHelper<decltype(method)> helper = (EventHelper<decltype(method)>(obj, method));
             return helper.invoke(args);
         };
+        next->typed = [obj, method](void **argv) -> QVariant {
+            return TypedEventHelper<decltype(method)>::invoke(obj, method, argv);
+        };
+        next->signature = TypedEventHelper<decltype(method)>::signature();
+
+        // 旧的接收者可能仍在其他线程中执行，保留到通道析构时再释放
+        QMutexLocker guard(&receiverMutex);
+        receivers.append(next);
+        receiver.store(next, std::memory_order_release);
     }
 
 private:
-    Connector conn;
+    Q_DISABLE_COPY(EventChannel)
+
+    struct Receiver
+    {
+        Connector conn;
+        TypedConnector typed;
+        const void *signature { nullptr };
+    };
+
+    QVariant invoke(const Receiver *current, void **argv);
+
+    std::atomic<Receiver *> receiver { nullptr };
+    QList<Receiver *> receivers;
     QMutex receiverMutex;
 };
 
+/*!
+ * Channels are looked up in a dense two-level table indexed by EventType. push() and
+ * post() only do acquire loads; connect() and disconnect() serialize on a mutex and
+ * publish with release stores. A channel is never freed while the manager lives, so
+ * a caller that loaded it before a disconnect can finish its call safely.
+ */
 class EventChannelManager
 {
 public:
+    EventChannelManager();
+    ~EventChannelManager();
+
     template<class T, class Func>
     inline bool connect(const QString &space, const QString &topic, T *obj, Func method)
     {
@@ -98,14 +142,12 @@ public:
             return false;
         }
 
-        QWriteLocker guard(&rwLock);
-        if (channelMap.contains(type)) {
-            channelMap[type]->setReceiver(obj, method);
-        } else {
-            ChannelPtr Channel { new EventChannel };
-            Channel->setReceiver(obj, method);
-            channelMap.insert(type, Channel);
-        }
+        QMutexLocker guard(&writeMutex);
+        ChannelPtr &channel = channelMap[type];
+        if (!channel)
+            channel.reset(new EventChannel);
+        channel->setReceiver(obj, method);
+        publish(type, channel.data());
         return true;
     }
 
@@ -124,12 +166,8 @@ public:
     [[gnu::hot]] inline QVariant push(EventType type, T param, Args &&... args)
     {
         threadEventAlert(type);
-        QReadLocker guard(&rwLock);
-        if (Q_LIKELY(channelMap.contains(type))) {
-            auto channel = channelMap.value(type);
-            guard.unlock();
+        if (EventChannel *channel = find(type); Q_LIKELY(channel))
             return channel->send(param, std::forward<Args>(args)...);
-        }
         return QVariant();
     }
 
@@ -143,14 +181,8 @@ public:
     inline QVariant push(const EventType &type)
     {
         threadEventAlert(type);
-        QReadLocker guard(&rwLock);
-        if (Q_LIKELY(channelMap.contains(type))) {
-            auto channel = channelMap.value(type);
-            guard.unlock();
-            if (channel)
-                return channel->send();
-        }
-
+        if (EventChannel *channel = find(type); Q_LIKELY(channel))
+            return channel->send();
         return QVariant();
     }
 
@@ -164,12 +196,8 @@ public:
     template<class T, class... Args>
     inline EventChannelFuture post(EventType type, T param, Args &&... args)
     {
-        QReadLocker guard(&rwLock);
-        if (Q_LIKELY(channelMap.contains(type))) {
-            auto channel { channelMap[type] };
-            guard.unlock();
+        if (EventChannel *channel = find(type); Q_LIKELY(channel))
             return channel->asyncSend(param, std::forward<Args>(args)...);
-        }
         return EventChannelFuture(QFuture<QVariant>());
     }
 
@@ -181,12 +209,8 @@ public:
 
     inline EventChannelFuture post(const EventType &type)
     {
-        QReadLocker guard(&rwLock);
-        if (Q_LIKELY(channelMap.contains(type))) {
-            auto channel { channelMap[type] };
-            guard.unlock();
+        if (EventChannel *channel = find(type); Q_LIKELY(channel))
             return channel->asyncSend();
-        }
         return EventChannelFuture(QFuture<QVariant>());
     }
 
@@ -194,9 +218,30 @@ private:
     using ChannelPtr = QSharedPointer<EventChannel>;
     using EventChannelMap = QMap<EventType, ChannelPtr>;
 
+    static constexpr int kPageBits { 8 };
+    static constexpr int kPageSize { 1 << kPageBits };
+    static constexpr int kPageCount { (EventTypeScope::kCustomTop >> kPageBits) + 1 };
+    using ChannelPage = std::array<std::atomic<EventChannel *>, kPageSize>;
+
+    [[gnu::hot]] inline EventChannel *find(EventType type) const
+    {
+        if (Q_UNLIKELY(!isValidEventType(type)))
+            return nullptr;
+        const ChannelPage *page = pages[static_cast<size_t>(type >> kPageBits)].load(std::memory_order_acquire);
+        if (!page)
+            return nullptr;
+        return (*page)[static_cast<size_t>(type & (kPageSize - 1))].load(std::memory_order_acquire);
+    }
+
+    void publish(EventType type, EventChannel *channel);
+
 private:
+    Q_DISABLE_COPY(EventChannelManager)
+
+    // 拥有曾经创建过的全部通道，disconnect 只从查找表中摘除
     EventChannelMap channelMap;
-    QReadWriteLock rwLock;
+    std::array<std::atomic<ChannelPage *>, kPageCount> pages {};
+    QMutex writeMutex;
 };
 
 DPF_END_NAMESPACE
@@ -15,6 +15,7 @@
 #include <QCoreApplication>
 
 #include <mutex>
+#include <utility>
 
 DPF_BEGIN_NAMESPACE
 
@@ -500,6 +501,67 @@ protected:
     Func f;
 };
 
+/*
+ * Identity of an argument list, used to check at runtime that the caller of a
+ * typed dispatch passes exactly the types the receiver was compiled against.
+ * Symbols are merged across plugins by the dynamic linker; if they are not, the
+ * identities differ and the call just takes the QVariant path.
+ */
+template<class... Args>
+struct EventSignature
+{
+    static inline const char id {};
+};
+
+template<class... Args>
+inline const void *eventSignature()
+{
+    return &EventSignature<REMOVE_CONST_REF(Args)...>::id;
+}
+
+template<class Arg>
+inline decltype(auto) typedParamGenerator(void *arg)
+{
+    using Type = REMOVE_CONST_REF(Arg);
+    if constexpr (std::is_rvalue_reference<Arg>::value)
+        return Type(*static_cast<const Type *>(arg));
+    else
+        return static_cast<const Type &>(*static_cast<const Type *>(arg));
+}
+
+/*
+ * Same as EventHelper but takes the arguments by address, without QVariant boxing
+ */
+template<class Handler>
+struct TypedEventHelper;
+
+template<class Result, class T, class... Args>
+struct TypedEventHelper<Result (T::*)(Args...)>
+{
+    using Func = Result (T::*)(Args...);
+
+    static const void *signature()
+    {
+        return eventSignature<Args...>();
+    }
+
+    static QVariant invoke(T *self, Func func, void **argv)
+    {
+        return invoke(self, func, argv, std::index_sequence_for<Args...> {});
+    }
+
+private:
+    template<std::size_t... I>
+    static QVariant invoke(T *self, Func func, void **argv, std::index_sequence<I...>)
+    {
+        Q_UNUSED(argv)
+        QVariant ret = resultGenerator<Result>();
+        if (self)
+            (self->*func)(typedParamGenerator<Args>(argv[I])...), ApplyReturnValue<Result>(ret.data());
+        return ret;
+    }
+};
+
 /*
  * cast member function to void *
  */
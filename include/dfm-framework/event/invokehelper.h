@@ -9,6 +9,8 @@
 
 #include <QVariantList>
 
+#include <memory>
+
 DPF_BEGIN_NAMESPACE
 
 inline void packParamsHelper(QVariantList &ret)
@@ -59,6 +61,15 @@ inline void makeVariantList(QVariantList *list, T t, Args &&... args)
         packParamsHelper(*list, std::forward<Args>(args)...);
 }
 
+/*
+ * address of an argument for the typed dispatch path, receivers never write through it
+ */
+template<class Arg>
+inline void *argumentAddress(Arg &&arg)
+{
+    return const_cast<void *>(static_cast<const void *>(std::addressof(arg)));
+}
+
 DPF_END_NAMESPACE
 
 #endif   // INVOKEHELPER_H
@@ -27,9 +27,10 @@ ExtractorApp::~ExtractorApp()
 {
 }
 
-bool ExtractorApp::initialize(const QString &pluginPath)
+bool ExtractorApp::initialize(const QString &pluginPath, int fdChannel)
 {
     fmInfo() << "ExtractorApp: Initializing with plugin path:" << pluginPath;
+    m_fdChannel = fdChannel;
 
     // Lower process priority to avoid impacting user experience
     DFMBASE_NAMESPACE::ProcessPriorityManager::lowerAllAvailablePriorities(true);
@@ -49,7 +50,7 @@ void ExtractorApp::run()
 {
     fmInfo() << "ExtractorApp: Starting main loop";
 
-    if (!m_workerPipe->initialize()) {
+    if (!m_workerPipe->initialize(m_fdChannel)) {
         fmCritical() << "ExtractorApp: Failed to initialize worker pipe";
         return;
     }
@@ -31,9 +31,10 @@ public:
      * @brief Initialize the extractor application.
      *
      * @param pluginPath Path to the plugin directory
+     * @param fdChannel Socket inherited from the controller for large results, -1 if none
      * @return true if initialization succeeded
      */
-    bool initialize(const QString &pluginPath);
+    bool initialize(const QString &pluginPath, int fdChannel = -1);
 
     /**
      * @brief Run the main event loop.
@@ -57,6 +58,7 @@ private:
     QSharedPointer<PluginLoader> m_pluginLoader;
     QScopedPointer<EXTRACTOR_NAMESPACE::WorkerPipe> m_workerPipe;
     QTimer *m_idleTimer = nullptr;
+    int m_fdChannel = -1;
 };
 
 EXTRACTOR_PLUGIN_END_NAMESPACE
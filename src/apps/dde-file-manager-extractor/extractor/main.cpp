@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "extractorapp.h"
+#include "sharedpayload.h"
 
 #include <QCommandLineParser>
 #include <QDir>
@@ -54,9 +55,20 @@ int main(int argc, char *argv[])
             "Path to the plugin directory",
             "path");
 
+    QCommandLineOption fdChannelOption(
+            EXTRACTOR_NAMESPACE::SharedPayload::kFdChannelOption,
+            "Unix socket used to pass large results",
+            "fd");
+
     parser.addOption(pluginPathOption);
+    parser.addOption(fdChannelOption);
     parser.process(app);
 
+    bool fdChannelOk = false;
+    int fdChannel = parser.value(fdChannelOption).toInt(&fdChannelOk);
+    if (!fdChannelOk || fdChannel < 0)
+        fdChannel = -1;
+
     // Get plugin path
     QString pluginPath = parser.value(pluginPathOption);
     if (pluginPath.isEmpty()) {
@@ -78,7 +90,7 @@ int main(int argc, char *argv[])
 
     // Create and initialize extractor application
     extractor_plugin::ExtractorApp extractor;
-    if (!extractor.initialize(pluginPath)) {
+    if (!extractor.initialize(pluginPath, fdChannel)) {
         qCritical() << "Failed to initialize extractor with plugin path:" << pluginPath;
         return 1;
     }
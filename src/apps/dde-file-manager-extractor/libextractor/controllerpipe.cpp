@@ -3,11 +3,16 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "controllerpipe.h"
+#include "sharedpayload.h"
 
 #include <QDataStream>
 #include <QProcess>
 #include <QTimer>
 
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 EXTRACTOR_BEGIN_NAMESPACE
 
 class ControllerPipePrivate
@@ -17,6 +22,7 @@ public:
     QByteArray inputBuffer;
     bool waitingForComplete = false;
     qint32 expectedSize = 0;
+    int fdChannel = -1;
 
     void clearState()
     {
@@ -24,6 +30,14 @@ public:
         waitingForComplete = false;
         expectedSize = 0;
     }
+
+    void closeFdChannel()
+    {
+        if (fdChannel >= 0) {
+            ::close(fdChannel);
+            fdChannel = -1;
+        }
+    }
 };
 
 ControllerPipe::ControllerPipe(QObject *parent)
@@ -98,15 +112,36 @@ bool ControllerPipe::start(const QString &extractorPath, const QString &pluginPa
         arguments << "--plugin-path" << pluginPath;
     }
 
+    // 大结果通过 memfd 传递，描述符走单独的 socket；创建失败时全部结果仍走管道
+    d->closeFdChannel();
+    int childChannel = -1;
+    int sockets[2] { -1, -1 };
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) == 0) {
+        d->fdChannel = sockets[0];
+        childChannel = sockets[1];
+        arguments << QStringLiteral("--%1").arg(SharedPayload::kFdChannelOption) << QString::number(childChannel);
+        d->process->setChildProcessModifier([childChannel]() {
+            // 只在子进程中清除 CLOEXEC，父进程的其他子进程不会继承这一端
+            ::fcntl(childChannel, F_SETFD, 0);
+        });
+    } else {
+        fmWarning() << "ControllerPipe: socketpair failed, large results will go through the pipe";
+    }
+
     // Start the process
     fmInfo() << "ControllerPipe: Starting extractor:" << extractorPath
              << "arguments:" << arguments;
 
     d->process->start(extractorPath, arguments, QIODevice::ReadWrite);
 
-    if (!d->process->waitForStarted(5000)) {
+    const bool started = d->process->waitForStarted(5000);
+    if (childChannel >= 0)
+        ::close(childChannel);
+
+    if (!started) {
         fmCritical() << "ControllerPipe: Failed to start process:"
                      << d->process->errorString();
+        d->closeFdChannel();
         emit errorOccurred(QString("Failed to start process: %1").arg(d->process->errorString()));
         d->process->deleteLater();
         d->process = nullptr;
@@ -183,6 +218,9 @@ void ControllerPipe::handleStatusMessage(const QByteArray &messageData)
 
     if (status == ExtractorStatus::Data) {
         messageStream >> data;
+    } else if (status == ExtractorStatus::SharedData) {
+        handleSharedData(filePath, messageStream);
+        return;
     } else if (status == ExtractorStatus::Failed) {
         // Fix: failed packets now carry an explicit error string after filePath.
         messageStream >> error;
@@ -214,7 +252,34 @@ void ControllerPipe::handleStatusMessage(const QByteArray &messageData)
         fmDebug() << "ControllerPipe: Batch completed";
         emit batchFinished();
         break;
+
+    case ExtractorStatus::SharedData:
+        break;
+    }
+}
+
+void ControllerPipe::handleSharedData(const QString &filePath, QDataStream &messageStream)
+{
+    qint64 size = -1;
+    messageStream >> size;
+
+    // 工作进程先发描述符再写消息，所以这里的描述符已经在 socket 中排队
+    const int fd = d->fdChannel >= 0 ? SharedPayload::receiveFileDescriptor(d->fdChannel) : -1;
+    if (fd < 0) {
+        fmCritical() << "ControllerPipe: Shared data without descriptor for:" << filePath;
+        emit extractionFailed(filePath, QStringLiteral("Shared extraction result is missing"));
+        return;
     }
+
+    const MappedPayload payload(fd, size);
+    ::close(fd);
+    if (!payload.isValid()) {
+        emit extractionFailed(filePath, QStringLiteral("Failed to map shared extraction result"));
+        return;
+    }
+
+    fmDebug() << "ControllerPipe: Received shared data for:" << filePath << "size:" << size;
+    emit extractionFinished(filePath, payload.data());
 }
 
 void ControllerPipe::stop()
@@ -243,6 +308,7 @@ void ControllerPipe::stop()
         process->deleteLater();
     }
 
+    d->closeFdChannel();
     d->clearState();
 }
 
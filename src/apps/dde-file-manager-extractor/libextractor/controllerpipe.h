@@ -8,6 +8,7 @@
 #include "extractor_global.h"
 #include "extractortypes.h"
 
+#include <QDataStream>
 #include <QObject>
 #include <QProcess>
 #include <QSharedPointer>
@@ -74,7 +75,9 @@ signals:
     /**
      * @brief Emitted when extraction completes successfully
      * @param filePath The file that was processed
-     * @param data The extracted content
+     * @param data The extracted content. Large results may refer to a shared mapping
+     *             that is released after the signal returns, receivers must copy or
+     *             decode it right away and connect with a direct connection.
      */
     void extractionFinished(const QString &filePath, const QByteArray &data);
 
@@ -110,6 +113,7 @@ private:
     void handleProcessOutput();
     void processInputBuffer();
     void handleStatusMessage(const QByteArray &messageData);
+    void handleSharedData(const QString &filePath, QDataStream &messageStream);
     bool hasPendingPartialMessage() const;
 
     QScopedPointer<ControllerPipePrivate> d;
@@ -21,6 +21,7 @@ enum class ExtractorStatus : quint8 {
     Finished = 'F',    // Successfully completed
     Failed = 'f',      // Processing failed
     Data = 'D',        // Data ready (path + data)
+    SharedData = 'M',  // Data ready in a memfd sent over the fd channel (path + size)
     BatchDone = 'B'    // Batch completed
 };
 
@@ -38,6 +39,8 @@ inline const char* statusToString(ExtractorStatus status)
         return "Failed";
     case ExtractorStatus::Data:
         return "Data";
+    case ExtractorStatus::SharedData:
+        return "SharedData";
     case ExtractorStatus::BatchDone:
         return "BatchDone";
     default:
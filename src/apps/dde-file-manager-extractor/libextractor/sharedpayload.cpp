@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sharedpayload.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+EXTRACTOR_BEGIN_NAMESPACE
+
+namespace SharedPayload {
+
+int createSealedMemfd(const QByteArray &data)
+{
+    const int fd = ::memfd_create("dfm-extractor-result", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        fmWarning() << "SharedPayload: memfd_create failed, errno:" << errno;
+        return -1;
+    }
+
+    qint64 written = 0;
+    while (written < data.size()) {
+        const ssize_t n = ::write(fd, data.constData() + written, static_cast<size_t>(data.size() - written));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            fmWarning() << "SharedPayload: failed to write memfd, errno:" << errno;
+            ::close(fd);
+            return -1;
+        }
+        written += n;
+    }
+
+    // 密封后接收端可以放心映射，不会因为对端截断文件而收到 SIGBUS
+    if (::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+        fmWarning() << "SharedPayload: failed to seal memfd, errno:" << errno;
+
+    return fd;
+}
+
+bool sendFileDescriptor(int socketFd, int fd)
+{
+    char byte = 0;
+    iovec iov { &byte, sizeof(byte) };
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] {};
+    msghdr msg {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+    ssize_t sent = -1;
+    do {
+        sent = ::sendmsg(socketFd, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+
+    if (sent < 0) {
+        fmWarning() << "SharedPayload: sendmsg failed, errno:" << errno;
+        return false;
+    }
+    return true;
+}
+
+int receiveFileDescriptor(int socketFd)
+{
+    char byte = 0;
+    iovec iov { &byte, sizeof(byte) };
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] {};
+    msghdr msg {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received = -1;
+    do {
+        received = ::recvmsg(socketFd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+
+    if (received <= 0)
+        return -1;
+
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            int fd = -1;
+            std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+            return fd;
+        }
+    }
+    return -1;
+}
+
+}   // namespace SharedPayload
+
+MappedPayload::MappedPayload(int fd, qint64 size)
+    : m_size(size)
+{
+    if (fd < 0 || size < 0)
+        return;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < size) {
+        fmWarning() << "MappedPayload: payload is smaller than announced:" << size;
+        return;
+    }
+
+    if (size == 0) {
+        m_valid = true;
+        return;
+    }
+
+    void *address = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+        fmWarning() << "MappedPayload: mmap failed, errno:" << errno;
+        return;
+    }
+
+    ::madvise(address, static_cast<size_t>(size), MADV_SEQUENTIAL);
+    m_address = address;
+    m_valid = true;
+}
+
+MappedPayload::~MappedPayload()
+{
+    if (m_address)
+        ::munmap(m_address, static_cast<size_t>(m_size));
+}
+
+bool MappedPayload::isValid() const
+{
+    return m_valid;
+}
+
+QByteArray MappedPayload::data() const
+{
+    if (!m_address)
+        return QByteArray();
+    return QByteArray::fromRawData(static_cast<const char *>(m_address), static_cast<qsizetype>(m_size));
+}
+
+EXTRACTOR_END_NAMESPACE
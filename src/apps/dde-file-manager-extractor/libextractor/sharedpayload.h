@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SHAREDPAYLOAD_H
+#define SHAREDPAYLOAD_H
+
+#include "extractor_global.h"
+
+#include <QByteArray>
+
+EXTRACTOR_BEGIN_NAMESPACE
+
+/**
+ * @brief Helpers for passing large extraction results through a memfd.
+ *
+ * The worker writes the result into a sealed memfd and sends the descriptor over
+ * a unix socket (SCM_RIGHTS) before writing a small SharedData packet to the pipe.
+ * The controller maps the memfd read-only, so the payload never goes through the
+ * pipe buffers or the QDataStream framing on either side.
+ */
+namespace SharedPayload {
+
+/// Results smaller than this are written to the pipe directly
+inline constexpr qint64 kThreshold { 256 * 1024 };
+
+/// Command line option carrying the worker end of the descriptor socket
+inline constexpr char kFdChannelOption[] { "fd-channel" };
+
+/**
+ * @brief Create a sealed, read-only memfd holding data
+ * @return The descriptor, or -1 on failure
+ */
+int createSealedMemfd(const QByteArray &data);
+
+bool sendFileDescriptor(int socketFd, int fd);
+
+/**
+ * @brief Receive one descriptor without blocking
+ * @return The descriptor, or -1 if none is queued
+ */
+int receiveFileDescriptor(int socketFd);
+
+}   // namespace SharedPayload
+
+/**
+ * @brief Read-only mapping of a memfd payload
+ *
+ * data() does not copy: the returned QByteArray refers to the mapping and must
+ * not be used after this object is destroyed.
+ */
+class MappedPayload
+{
+public:
+    MappedPayload(int fd, qint64 size);
+    ~MappedPayload();
+
+    Q_DISABLE_COPY_MOVE(MappedPayload)
+
+    bool isValid() const;
+    QByteArray data() const;
+
+private:
+    void *m_address { nullptr };
+    qint64 m_size { 0 };
+    bool m_valid { false };
+};
+
+EXTRACTOR_END_NAMESPACE
+
+#endif   // SHAREDPAYLOAD_H
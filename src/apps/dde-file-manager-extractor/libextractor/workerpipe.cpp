@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "workerpipe.h"
+#include "sharedpayload.h"
 
 #include <QDataStream>
 #include <QIODevice>
@@ -28,6 +29,7 @@ public:
     qint32 expectedSize = 0;
     bool initialized = false;
     int outputFd = -1;
+    int fdChannel = -1;
 };
 
 WorkerPipe::WorkerPipe(QObject *parent)
@@ -40,9 +42,12 @@ WorkerPipe::~WorkerPipe()
     if (d->outputFd >= 0) {
         ::close(d->outputFd);
     }
+    if (d->fdChannel >= 0) {
+        ::close(d->fdChannel);
+    }
 }
 
-bool WorkerPipe::initialize()
+bool WorkerPipe::initialize(int fdChannel)
 {
     if (d->initialized) {
         return true;
@@ -66,8 +71,14 @@ bool WorkerPipe::initialize()
         readFromStdin();
     });
 
+    if (fdChannel >= 0) {
+        // 继承来的描述符不应再传给插件启动的子进程
+        ::fcntl(fdChannel, F_SETFD, FD_CLOEXEC);
+        d->fdChannel = fdChannel;
+    }
+
     d->initialized = true;
-    fmDebug() << "WorkerPipe: Initialized successfully";
+    fmDebug() << "WorkerPipe: Initialized successfully, fd channel:" << d->fdChannel;
 
     return true;
 }
@@ -184,9 +195,50 @@ bool WorkerPipe::sendStarted(const QString &filePath)
 
 bool WorkerPipe::sendData(const QString &filePath, const QByteArray &data)
 {
+    if (d->initialized && d->fdChannel >= 0 && data.size() >= SharedPayload::kThreshold) {
+        if (sendSharedData(filePath, data))
+            return true;
+        fmWarning() << "WorkerPipe::sendData: Falling back to inline data for:" << filePath;
+    }
+
     return sendStatus(ExtractorStatus::Data, filePath, data);
 }
 
+bool WorkerPipe::sendSharedData(const QString &filePath, const QByteArray &data)
+{
+    const int memfd = SharedPayload::createSealedMemfd(data);
+    if (memfd < 0)
+        return false;
+
+    // 描述符先于消息发出，控制端读到消息时描述符已经在套接字中排队
+    const bool fdSent = SharedPayload::sendFileDescriptor(d->fdChannel, memfd);
+    ::close(memfd);
+    if (!fdSent) {
+        // 套接字不可用时不再尝试，之后的结果都直接写入管道
+        ::close(d->fdChannel);
+        d->fdChannel = -1;
+        return false;
+    }
+
+    QByteArray messageData;
+    QDataStream messageStream(&messageData, QIODevice::WriteOnly);
+    messageStream << static_cast<quint8>(ExtractorStatus::SharedData) << filePath
+                  << static_cast<qint64>(data.size());
+
+    QByteArray packetData;
+    QDataStream packetStream(&packetData, QIODevice::WriteOnly);
+    packetStream << static_cast<qint32>(messageData.size());
+    packetData.append(messageData);
+
+    if (!writePacket(packetData)) {
+        fmCritical() << "WorkerPipe::sendSharedData: Failed to write packet";
+        return false;
+    }
+
+    fmDebug() << "WorkerPipe::sendSharedData: Sent" << data.size() << "bytes through memfd for" << filePath;
+    return true;
+}
+
 bool WorkerPipe::sendFailed(const QString &filePath, const QString &error)
 {
     return sendStatus(ExtractorStatus::Failed, filePath, error.toUtf8());
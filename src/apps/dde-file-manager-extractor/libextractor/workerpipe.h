@@ -19,7 +19,7 @@ class WorkerPipePrivate;
  *
  * This class is used by the extractor subprocess to:
  * 1. Receive extraction requests from stdin
- * 2. Send status updates and results to stdout
+ * 2. Send status updates and results to stdout, large results as memfds over the fd channel
  * 3. Handle message framing with QDataStream transactions
  */
 class WorkerPipe : public QObject
@@ -32,9 +32,10 @@ public:
 
     /**
      * @brief Initialize the worker pipe
+     * @param fdChannel Unix socket for passing large results as memfds, -1 to send everything inline
      * @return true if initialization succeeded
      */
-    bool initialize();
+    bool initialize(int fdChannel = -1);
 
     /**
      * @brief Send a status message to the controller
@@ -53,6 +54,9 @@ public:
 
     /**
      * @brief Send extraction finished with data
+     *
+     * Results of at least SharedPayload::kThreshold bytes go through a memfd when
+     * an fd channel is available, otherwise they are written to the pipe.
      */
     bool sendData(const QString &filePath, const QByteArray &data);
 
@@ -90,6 +94,7 @@ private:
     bool readFromStdin();
     void processInputBuffer();
     bool writePacket(const QByteArray &packetData);
+    bool sendSharedData(const QString &filePath, const QByteArray &data);
     bool hasPendingPartialMessage() const;
     bool setupOutputChannel();
 
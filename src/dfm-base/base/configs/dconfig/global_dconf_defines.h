@@ -33,6 +33,7 @@ inline constexpr char kKeyCanvasInputMethod[] { "enableCanvasInputMethod" };
 inline constexpr char kConfigEnableSearch[] { "dfm.enable.search" };
 inline constexpr char kShowRunExec[] { "dfm.show.run.exec" };
 inline constexpr char kSortLatinFirstZhCn[] { "dfm.sort.latinfirst.zhCn" };
+inline constexpr char kThumbnailCacheSize[] { "dfm.thumbnail.cache.size" };
 }   // namespace BaseConfig
 
 /*!
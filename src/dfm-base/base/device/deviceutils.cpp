@@ -14,6 +14,7 @@
 #include <dfm-base/utils/networkutils.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
 #include <dfm-base/base/device/private/devicehelper.h>
+#include <dfm-base/base/device/mounttable.h>
 #include <dfm-base/dbusservice/global_server_defines.h>
 #include <dfm-base/utils/protocolutils.h>
 
@@ -570,35 +571,8 @@ bool DeviceUtils::isMountPointOfDlnfs(const QString &path)
  */
 QString DeviceUtils::getLongestMountRootPath(const QString &filePath)
 {
-    libmnt_table *tab { mnt_new_table() };
-    libmnt_iter *iter { mnt_new_iter(MNT_ITER_BACKWARD) };
-
-    FinallyUtil release([&] {
-        if (tab) mnt_free_table(tab);
-        if (iter) mnt_free_iter(iter);
-    });
-
-    int ret = mnt_table_parse_mtab(tab, nullptr);
-    if (ret != 0)
-        return "/";
-
-    QStringList mpts;
-    libmnt_fs *fs = nullptr;
-    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
-        if (!fs)
-            continue;
-
-        const QString &target = mnt_fs_get_target(fs);
-        mpts.append(target == "/" ? "/" : target + "/");
-    }
-    std::sort(mpts.begin(), mpts.end(), [](const QString &a, const QString &b) { return a.length() > b.length(); });
-
-    QString path = filePath;
-    if (!path.endsWith("/"))
-        path.append("/");
-
-    auto found = std::find_if(mpts.cbegin(), mpts.cend(), [path](const QString &mpt) { return path.startsWith(mpt); });
-    return found != mpts.cend() ? *found : "/";
+    const QString &mpt = MountTable::instance()->mountPointOf(filePath);
+    return mpt == "/" ? mpt : mpt + "/";
 }
 
 qint64 DeviceUtils::deviceBytesFree(const QUrl &url)
@@ -640,24 +614,24 @@ QString DeviceUtils::bindPathTransform(const QString &path, bool toDevice)
     if (!path.startsWith("/") || path == "/")
         return path;
 
-    const QMap<QString, QString> &table = DeviceUtils::fstabBindInfo();
-    if (table.isEmpty())
-        return path;
+    // fstab 只读取一次，按 QMap 原有顺序预先展开两个方向的 (前缀, 替换) 对，避免每次调用 values()/key() 的拷贝和反查
+    using BindPairs = QList<QPair<QString, QString>>;
+    static const QPair<BindPairs, BindPairs> pairs = [] {
+        const QMap<QString, QString> &table = DeviceUtils::fstabBindInfo();
+        QPair<BindPairs, BindPairs> ret;
+        for (auto it = table.cbegin(); it != table.cend(); ++it) {
+            ret.first.append({ it.value(), it.key() });
+            ret.second.append({ it.key(), it.value() });
+        }
+        return ret;
+    }();
 
+    const BindPairs &lookup = toDevice ? pairs.first : pairs.second;
     QString bindPath(path);
-    if (toDevice) {
-        for (const auto &mntPoint : table.values()) {
-            if (path.startsWith(mntPoint)) {
-                bindPath.replace(mntPoint, table.key(mntPoint));
-                break;
-            }
-        }
-    } else {
-        for (const auto &device : table.keys()) {
-            if (path.startsWith(device)) {
-                bindPath.replace(device, table[device]);
-                break;
-            }
+    for (const auto &pair : lookup) {
+        if (path.startsWith(pair.first)) {
+            bindPath.replace(pair.first, pair.second);
+            break;
         }
     }
 
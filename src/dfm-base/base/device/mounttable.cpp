@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mounttable.h"
+
+#include <dfm-base/utils/finallyutil.h>
+
+#include <QDebug>
+
+#include <algorithm>
+
+#include <libmount.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+static constexpr char kMountInfoPath[] { "/proc/self/mountinfo" };
+
+MountTable *MountTable::instance()
+{
+    static MountTable ins;
+    return &ins;
+}
+
+MountTable::MountTable()
+{
+    // 打开后的第一次 poll 不会报告变化，因此先打开再解析，避免漏掉两者之间的挂载
+    mountInfoFd = ::open(kMountInfoPath, O_RDONLY | O_CLOEXEC);
+    if (mountInfoFd < 0)
+        qCWarning(logDFMBase) << "MountTable: cannot watch" << kMountInfoPath << ", reload on every query";
+}
+
+MountTable::~MountTable()
+{
+    if (mountInfoFd >= 0)
+        ::close(mountInfoFd);
+}
+
+QString MountTable::mountPointOf(const QString &path)
+{
+    const SnapshotPointer snap = current();
+    const MountEntry *entry = snap->longestPrefix(path);
+    return entry ? entry->mountPoint : QStringLiteral("/");
+}
+
+QString MountTable::mountPointOfFile(const QString &filePath)
+{
+    // 不跟随符号链接，链接文件本身所在的挂载点才是它的挂载点
+    struct stat st;
+    if (::lstat(filePath.toUtf8().constData(), &st) != 0)
+        return mountPointOf(filePath);
+
+    const SnapshotPointer snap = current();
+    const MountEntry *entry = snap->ofDevice(st.st_dev, filePath);
+    if (!entry)
+        entry = snap->longestPrefix(filePath);
+    return entry ? entry->mountPoint : QStringLiteral("/");
+}
+
+MountEntry MountTable::entryOf(const QString &path)
+{
+    const SnapshotPointer snap = current();
+    const MountEntry *entry = snap->longestPrefix(path);
+    return entry ? *entry : MountEntry();
+}
+
+MountEntry MountTable::entryOfDevice(dev_t device)
+{
+    const SnapshotPointer snap = current();
+    const MountEntry *entry = snap->ofDevice(device, QString());
+    return entry ? *entry : MountEntry();
+}
+
+quint64 MountTable::generation()
+{
+    return current()->generation;
+}
+
+MountTable::SnapshotPointer MountTable::current()
+{
+    QMutexLocker lk(&mutex);
+
+    bool changed = !snapshot || mountInfoFd < 0;
+    if (!changed) {
+        // mountinfo 在挂载表变化后对 poll 报告 POLLPRI|POLLERR，poll 本身会清除该状态
+        pollfd pfd { mountInfoFd, POLLPRI, 0 };
+        changed = ::poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLPRI | POLLERR));
+    }
+
+    if (changed) {
+        QSharedPointer<Snapshot> fresh = load();
+        fresh->generation = ++loadCount;
+        snapshot = fresh;
+    }
+
+    return snapshot;
+}
+
+QSharedPointer<MountTable::Snapshot> MountTable::load()
+{
+    QSharedPointer<Snapshot> snap(new Snapshot);
+
+    libmnt_table *tab { mnt_new_table() };
+    libmnt_iter *iter { mnt_new_iter(MNT_ITER_FORWARD) };
+    FinallyUtil release([&] {
+        if (tab) mnt_free_table(tab);
+        if (iter) mnt_free_iter(iter);
+    });
+
+    if (!tab || !iter || mnt_table_parse_file(tab, kMountInfoPath) != 0) {
+        qCWarning(logDFMBase) << "MountTable: failed to parse" << kMountInfoPath;
+        return snap;
+    }
+
+    libmnt_fs *fs = nullptr;
+    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
+        if (!fs || !mnt_fs_get_target(fs))
+            continue;
+
+        MountEntry entry;
+        entry.mountPoint = QString::fromUtf8(mnt_fs_get_target(fs));
+        entry.source = QString::fromUtf8(mnt_fs_get_source(fs));
+        entry.fileSystemType = QString::fromUtf8(mnt_fs_get_fstype(fs));
+        entry.device = mnt_fs_get_devno(fs);
+        snap->insert(entry);
+    }
+
+    qCDebug(logDFMBase) << "MountTable: loaded" << snap->entries.size() << "mounts";
+    return snap;
+}
+
+MountTable::Snapshot::Snapshot()
+    : nodes(1)
+{
+}
+
+void MountTable::Snapshot::insert(const MountEntry &entry)
+{
+    int node = 0;
+    const QStringList &parts = entry.mountPoint.split('/', Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        int next = nodes[node].children.value(part, -1);
+        if (next < 0) {
+            next = static_cast<int>(nodes.size());
+            nodes[node].children.insert(part, next);
+            nodes.emplace_back();
+        }
+        node = next;
+    }
+
+    const int index = static_cast<int>(entries.size());
+    entries.push_back(entry);
+    // mountinfo 按挂载顺序排列，同一挂载点上后挂载的覆盖先挂载的
+    nodes[node].entry = index;
+    devices.insert(entry.device, index);
+}
+
+const MountEntry *MountTable::Snapshot::longestPrefix(const QString &path) const
+{
+    int node = 0;
+    int found = nodes[0].entry;
+    const QStringList &parts = path.split('/', Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        node = nodes[node].children.value(part, -1);
+        if (node < 0)
+            break;
+        if (nodes[node].entry >= 0)
+            found = nodes[node].entry;
+    }
+    return found >= 0 ? &entries[found] : nullptr;
+}
+
+const MountEntry *MountTable::Snapshot::ofDevice(dev_t device, const QString &path) const
+{
+    const QList<int> &indexes = devices.values(device);
+    if (indexes.isEmpty())
+        return nullptr;
+    if (indexes.size() == 1)
+        return &entries[indexes.first()];
+
+    // 同一设备有多个挂载点（bind 挂载），优先取路径所在的那个，否则取最早的挂载
+    const MountEntry *byPath = longestPrefix(path);
+    if (byPath && byPath->device == device)
+        return byPath;
+    return &entries[*std::min_element(indexes.cbegin(), indexes.cend())];
+}
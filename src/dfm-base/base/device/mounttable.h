@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MOUNTTABLE_H
+#define MOUNTTABLE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+
+#include <sys/types.h>
+
+#include <vector>
+
+namespace dfmbase {
+
+struct MountEntry
+{
+    QString mountPoint;
+    QString source;
+    QString fileSystemType;
+    dev_t device { 0 };
+};
+
+/*!
+ * \brief Process-wide snapshot of the mount table.
+ *
+ * The table is parsed once from /proc/self/mountinfo and kept until the kernel
+ * reports a change on that file (POLLPRI), so path queries done per file in copy,
+ * search and recent code paths no longer re-parse the mount table. Lookups run
+ * on an immutable snapshot and are thread-safe.
+ */
+class MountTable
+{
+public:
+    static MountTable *instance();
+
+    // mount point of the longest mounted prefix of path, "/" if none matched
+    QString mountPointOf(const QString &path);
+    // mount point of an existing file (symlinks are not followed), resolved by its device; falls back to mountPointOf
+    QString mountPointOfFile(const QString &filePath);
+    MountEntry entryOf(const QString &path);
+    MountEntry entryOfDevice(dev_t device);
+
+    // increases every time the table is reloaded, lets callers drop derived caches
+    quint64 generation();
+
+private:
+    struct Snapshot
+    {
+        struct Node
+        {
+            QHash<QString, int> children;
+            int entry { -1 };
+        };
+
+        Snapshot();
+        void insert(const MountEntry &entry);
+        const MountEntry *longestPrefix(const QString &path) const;
+        const MountEntry *ofDevice(dev_t device, const QString &path) const;
+
+        std::vector<MountEntry> entries;
+        std::vector<Node> nodes;
+        QMultiHash<dev_t, int> devices;
+        quint64 generation { 0 };
+    };
+    using SnapshotPointer = QSharedPointer<const Snapshot>;
+
+    MountTable();
+    ~MountTable();
+    Q_DISABLE_COPY_MOVE(MountTable)
+
+    SnapshotPointer current();
+    static QSharedPointer<Snapshot> load();
+
+    QMutex mutex;
+    SnapshotPointer snapshot;
+    int mountInfoFd { -1 };
+    quint64 loadCount { 0 };
+};
+
+}
+
+#endif   // MOUNTTABLE_H
@@ -31,13 +31,26 @@ if (EXISTS ${DTK_SETTINGS_TOOLS_EXECUTABLE})
 endif()
 
 
+# pinyin lookup table, generated from the dictionary at build time
+set(PINYIN_DICT ${CMAKE_CURRENT_SOURCE_DIR}/qrc/chinese2pinyin/pinyin.dict)
+set(PINYIN_TABLE ${CMAKE_CURRENT_BINARY_DIR}/pinyintable_data.h)
+add_custom_command(
+    OUTPUT ${PINYIN_TABLE}
+    COMMAND ${CMAKE_COMMAND} -DPINYIN_DICT=${PINYIN_DICT} -DPINYIN_TABLE=${PINYIN_TABLE}
+            -P ${DFM_PROJECT_ROOT}/cmake/GeneratePinyinTable.cmake
+    DEPENDS ${PINYIN_DICT} ${DFM_PROJECT_ROOT}/cmake/GeneratePinyinTable.cmake
+    COMMENT "Generating pinyin table"
+)
+
 # build
 add_library(${BIN_NAME}
     SHARED
     ${QRC_RESOURCES}
     ${INCLUDE_FILES}
     ${SRCS}
+    ${PINYIN_TABLE}
 )
+target_include_directories(${BIN_NAME} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
 
 # Configure library using unified configuration function
 dfm_configure_base_library(${BIN_NAME})
@@ -90,7 +90,7 @@ void AsyncFileInfo::refresh()
 void AsyncFileInfo::cacheAttribute(DFileInfo::AttributeID id, const QVariant &value)
 {
     QMutexLocker locker(&d->lock);
-    d->cacheAsyncAttributes.insert(static_cast<FileInfo::FileInfoAttributeID>(id), value);
+    d->cacheAsyncAttributes.setValue(static_cast<FileInfo::FileInfoAttributeID>(id), value);
 }
 
 QString AsyncFileInfo::nameOf(const NameInfoType type) const
@@ -648,6 +648,15 @@ bool AsyncFileInfo::asyncQueryDfmFileInfo(int ioPriority, FileInfo::initQuerierA
     return true;
 }
 
+void AsyncFileInfo::setDfmFileInfo(QSharedPointer<DFileInfo> dfileInfo)
+{
+    if (!dfileInfo)
+        return;
+
+    d->init(url, dfileInfo);
+    d->notInit = false;
+}
+
 int AsyncFileInfo::errorCodeFromDfmio() const
 {
     QMutexLocker lk(&d->lock);
@@ -1063,10 +1072,14 @@ FileInfo::FileType AsyncFileInfoPrivate::fileType() const
 
         if (statx(AT_FDCWD, path.toUtf8().constData(),
                   AT_SYMLINK_NOFOLLOW,
-                  STATX_TYPE,
+                  STATX_BASIC_STATS,
                   &stx)
             == 0) {
             fileMode = (stx.stx_mode & S_IFMT);
+            // 同一次 statx 顺带补齐 dfm-io 未提供的 unix 属性，避免后续再次查询
+            auto self = const_cast<AsyncFileInfoPrivate *>(this);
+            QMutexLocker lk(&self->lock);
+            self->cacheAsyncAttributes.fillMissingFromStatx(stx);
         } else {
             qWarning() << "Failed to get file status for:" << path
                        << "error:" << strerror(errno);
@@ -1215,10 +1228,9 @@ int AsyncFileInfoPrivate::cacheAllAttributes(const QString &attributes)
 bool AsyncFileInfoPrivate::insertAsyncAttribute(const FileInfo::FileInfoAttributeID id, const QVariant &value)
 {
     QMutexLocker lk(&lock);
-    if (cacheAsyncAttributes.value(id) == value || !value.isValid())
+    if (!value.isValid())
         return false;
-    cacheAsyncAttributes.insert(id, value);
-    return true;
+    return cacheAsyncAttributes.setValue(id, value);
 }
 
 void AsyncFileInfoPrivate::fileMimeTypeAsync(QMimeDatabase::MatchMode mode)
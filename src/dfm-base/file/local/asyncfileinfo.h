@@ -65,6 +65,8 @@ public:
     // less 0,cache fialed, equeal 0,another cache, bigger 0 cache success
     int cacheAsyncAttributes(const QString &attributes = QString());
     bool asyncQueryDfmFileInfo(int ioPriority = 0, initQuerierAsyncCallback func = nullptr, void *userData = nullptr);
+    // use attributes already queried elsewhere, e.g. by a directory enumeration
+    void setDfmFileInfo(QSharedPointer<DFMIO::DFileInfo> dfileInfo);
     int errorCodeFromDfmio() const;
 };
 }
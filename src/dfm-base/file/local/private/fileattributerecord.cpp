@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fileattributerecord.h"
+
+#include <dfm-io/dfile.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+namespace dfmbase {
+
+using AttributeID = FileAttributeRecord::AttributeID;
+
+FileAttributeRecord::Slot FileAttributeRecord::slotOf(AttributeID id)
+{
+    // bit 0-11 字符串，12 图标，13-18 64位整数，19-28 32位整数，29-41 布尔值
+    switch (id) {
+    case AttributeID::kStandardName:
+        return { Kind::kString, 0, 0 };
+    case AttributeID::kStandardBaseName:
+        return { Kind::kString, 1, 1 };
+    case AttributeID::kStandardCompleteBaseName:
+        return { Kind::kString, 2, 2 };
+    case AttributeID::kStandardCompleteSuffix:
+        return { Kind::kString, 3, 3 };
+    case AttributeID::kStandardDisplayName:
+        return { Kind::kString, 4, 4 };
+    case AttributeID::kStandardFilePath:
+        return { Kind::kString, 5, 5 };
+    case AttributeID::kStandardParentPath:
+        return { Kind::kString, 6, 6 };
+    case AttributeID::kStandardSymlinkTarget:
+        return { Kind::kString, 7, 7 };
+    case AttributeID::kOwnerUser:
+        return { Kind::kString, 8, 8 };
+    case AttributeID::kOwnerGroup:
+        return { Kind::kString, 9, 9 };
+    case AttributeID::kStandardContentType:
+        return { Kind::kString, 10, 10 };
+    case AttributeID::kStandardFastContentType:
+        return { Kind::kString, 11, 11 };
+    case AttributeID::kStandardIcon:
+        return { Kind::kStringList, 0, 12 };
+
+    case AttributeID::kStandardSize:
+        return { Kind::kInt64, 0, 13 };
+    case AttributeID::kTimeModified:
+        return { Kind::kInt64, 1, 14 };
+    case AttributeID::kTimeAccess:
+        return { Kind::kInt64, 2, 15 };
+    case AttributeID::kTimeChanged:
+        return { Kind::kInt64, 3, 16 };
+    case AttributeID::kTimeCreated:
+        return { Kind::kInt64, 4, 17 };
+    case AttributeID::kUnixInode:
+        return { Kind::kInt64, 5, 18 };
+
+    case AttributeID::kTimeModifiedUsec:
+        return { Kind::kUInt32, 0, 19 };
+    case AttributeID::kTimeAccessUsec:
+        return { Kind::kUInt32, 1, 20 };
+    case AttributeID::kTimeChangedUsec:
+        return { Kind::kUInt32, 2, 21 };
+    case AttributeID::kTimeCreatedUsec:
+        return { Kind::kUInt32, 3, 22 };
+    case AttributeID::kUnixMode:
+        return { Kind::kUInt32, 4, 23 };
+    case AttributeID::kUnixDevice:
+        return { Kind::kUInt32, 5, 24 };
+    case AttributeID::kUnixUID:
+        return { Kind::kUInt32, 6, 25 };
+    case AttributeID::kUnixGID:
+        return { Kind::kUInt32, 7, 26 };
+    case AttributeID::kStandardFileType:
+        return { Kind::kFileType, 8, 27 };
+    case AttributeID::kAccessPermissions:
+        return { Kind::kPermissions, 9, 28 };
+
+    case AttributeID::kStandardIsHidden:
+        return { Kind::kBool, 0, 29 };
+    case AttributeID::kStandardIsFile:
+        return { Kind::kBool, 1, 30 };
+    case AttributeID::kStandardIsDir:
+        return { Kind::kBool, 2, 31 };
+    case AttributeID::kStandardIsSymlink:
+        return { Kind::kBool, 3, 32 };
+    case AttributeID::kStandardFileExists:
+        return { Kind::kBool, 4, 33 };
+    case AttributeID::kStandardIsLocalDevice:
+        return { Kind::kBool, 5, 34 };
+    case AttributeID::kStandardIsCdRomDevice:
+        return { Kind::kBool, 6, 35 };
+    case AttributeID::kAccessCanRead:
+        return { Kind::kBool, 7, 36 };
+    case AttributeID::kAccessCanWrite:
+        return { Kind::kBool, 8, 37 };
+    case AttributeID::kAccessCanExecute:
+        return { Kind::kBool, 9, 38 };
+    case AttributeID::kAccessCanDelete:
+        return { Kind::kBool, 10, 39 };
+    case AttributeID::kAccessCanTrash:
+        return { Kind::kBool, 11, 40 };
+    case AttributeID::kAccessCanRename:
+        return { Kind::kBool, 12, 41 };
+    default:
+        return {};
+    }
+}
+
+bool FileAttributeRecord::isPacked(AttributeID id)
+{
+    return slotOf(id).kind != Kind::kNone;
+}
+
+void FileAttributeRecord::setPresent(const Slot &slot, bool on)
+{
+    if (on)
+        present |= quint64(1) << slot.bit;
+    else
+        present &= ~(quint64(1) << slot.bit);
+}
+
+bool FileAttributeRecord::setValue(AttributeID id, const QVariant &value)
+{
+    const Slot slot = slotOf(id);
+    if (slot.kind == Kind::kNone) {
+        if (!value.isValid())
+            return extended.remove(id) > 0;
+        if (extended.value(id) == value)
+            return false;
+        extended.insert(id, value);
+        return true;
+    }
+
+    if (!value.isValid()) {
+        const bool had = isPresent(slot);
+        setPresent(slot, false);
+        return had;
+    }
+
+    bool changed = !isPresent(slot);
+    switch (slot.kind) {
+    case Kind::kString: {
+        const QString str = value.toString();
+        changed = changed || strings[slot.index] != str;
+        strings[slot.index] = str;
+        break;
+    }
+    case Kind::kStringList: {
+        const QStringList list = value.toStringList();
+        changed = changed || icon != list;
+        icon = list;
+        break;
+    }
+    case Kind::kBool: {
+        const quint32 mask = quint32(1) << slot.index;
+        const bool on = value.toBool();
+        changed = changed || bool(flags & mask) != on;
+        flags = on ? (flags | mask) : (flags & ~mask);
+        break;
+    }
+    case Kind::kInt64: {
+        const qint64 number = value.toLongLong();
+        changed = changed || int64s[slot.index] != number;
+        int64s[slot.index] = number;
+        break;
+    }
+    case Kind::kUInt32:
+    case Kind::kFileType:
+    case Kind::kPermissions: {
+        quint32 number = 0;
+        if (slot.kind == Kind::kFileType)
+            number = static_cast<quint32>(value.value<FileInfo::FileType>());
+        else if (slot.kind == Kind::kPermissions)
+            number = static_cast<quint32>(value.value<DFMIO::DFile::Permissions>().toInt());
+        else
+            number = value.toUInt();
+        changed = changed || uint32s[slot.index] != number;
+        uint32s[slot.index] = number;
+        break;
+    }
+    case Kind::kNone:
+        break;
+    }
+
+    setPresent(slot, true);
+    return changed;
+}
+
+QVariant FileAttributeRecord::value(AttributeID id) const
+{
+    const Slot slot = slotOf(id);
+    if (slot.kind == Kind::kNone)
+        return extended.value(id);
+
+    if (!isPresent(slot))
+        return QVariant();
+
+    switch (slot.kind) {
+    case Kind::kString:
+        return strings[slot.index];
+    case Kind::kStringList:
+        return icon;
+    case Kind::kBool:
+        return bool(flags & (quint32(1) << slot.index));
+    case Kind::kInt64:
+        return int64s[slot.index];
+    case Kind::kUInt32:
+        return uint32s[slot.index];
+    case Kind::kFileType:
+        return QVariant::fromValue(static_cast<FileInfo::FileType>(uint32s[slot.index]));
+    case Kind::kPermissions:
+        return QVariant::fromValue(DFMIO::DFile::Permissions(static_cast<int>(uint32s[slot.index])));
+    case Kind::kNone:
+        break;
+    }
+    return QVariant();
+}
+
+bool FileAttributeRecord::contains(AttributeID id) const
+{
+    const Slot slot = slotOf(id);
+    if (slot.kind == Kind::kNone)
+        return extended.contains(id);
+    return isPresent(slot);
+}
+
+void FileAttributeRecord::fillMissingFromStatx(const struct statx &stx)
+{
+    const auto fill = [this](AttributeID id, const QVariant &value) {
+        if (!contains(id))
+            setValue(id, value);
+    };
+
+    if (stx.stx_mask & STATX_MODE)
+        fill(AttributeID::kUnixMode, quint32(stx.stx_mode));
+    if (stx.stx_mask & STATX_INO)
+        fill(AttributeID::kUnixInode, qint64(stx.stx_ino));
+    if (stx.stx_mask & STATX_UID)
+        fill(AttributeID::kUnixUID, quint32(stx.stx_uid));
+    if (stx.stx_mask & STATX_GID)
+        fill(AttributeID::kUnixGID, quint32(stx.stx_gid));
+    fill(AttributeID::kUnixDevice, quint32(makedev(stx.stx_dev_major, stx.stx_dev_minor)));
+}
+
+}
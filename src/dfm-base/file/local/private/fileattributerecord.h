@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILEATTRIBUTERECORD_H
+#define FILEATTRIBUTERECORD_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/interfaces/fileinfo.h>
+
+#include <QMap>
+#include <QStringList>
+#include <QVariant>
+
+#include <array>
+
+struct statx;
+
+namespace dfmbase {
+
+/*!
+ * \brief Fixed-layout storage for the attributes every AsyncFileInfo caches.
+ *
+ * Names, paths, stat data and access flags live in plain members with one
+ * presence bit each, so reading them costs no tree lookup and storing them no
+ * allocation besides the shared string data. Attributes outside the fixed set
+ * fall back to a QVariant map. The record is not thread-safe, the owner locks it.
+ */
+class FileAttributeRecord
+{
+public:
+    using AttributeID = FileInfo::FileInfoAttributeID;
+
+    static bool isPacked(AttributeID id);
+
+    // true if the stored value changed; an invalid value removes the attribute
+    bool setValue(AttributeID id, const QVariant &value);
+    QVariant value(AttributeID id) const;
+    bool contains(AttributeID id) const;
+
+    // fill unix attributes dfm-io did not provide, e.g. on some gvfs backends
+    void fillMissingFromStatx(const struct statx &stx);
+
+private:
+    enum class Kind : quint8 {
+        kNone,
+        kString,
+        kStringList,
+        kBool,
+        kInt64,
+        kUInt32,
+        kFileType,
+        kPermissions
+    };
+
+    struct Slot
+    {
+        Kind kind { Kind::kNone };
+        quint8 index { 0 };
+        quint8 bit { 0 };
+    };
+
+    static Slot slotOf(AttributeID id);
+    bool isPresent(const Slot &slot) const { return present & (quint64(1) << slot.bit); }
+    void setPresent(const Slot &slot, bool on);
+
+    std::array<QString, 12> strings;
+    QStringList icon;
+    std::array<qint64, 6> int64s {};
+    std::array<quint32, 10> uint32s {};
+    quint32 flags { 0 };
+    quint64 present { 0 };
+    QMap<AttributeID, QVariant> extended;
+};
+
+}
+
+#endif   // FILEATTRIBUTERECORD_H
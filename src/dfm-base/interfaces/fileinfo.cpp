@@ -305,12 +305,19 @@ QString dfmbase::FileInfo::displayOf(const DisPlayInfoType type) const
     case DisPlayInfoType::kFileTypeDisplayName:
         return MimeTypeDisplayManager::instance()->fullMimeName(nameOf(FileNameInfoType::kMimeTypeName));
     case DisPlayInfoType::kFileDisplayPinyinName:
+    case DisPlayInfoType::kFileDisplayPinyinInitials:
         if (pinyinName.isEmpty()) {
+            // 全拼和首字母一次生成，排序和输入查找都会用到
             const QString &displayName = this->displayOf(DisplayInfoType::kFileDisplayName);
-            const_cast<FileInfo *>(this)->pinyinName = Pinyin::Chinese2Pinyin(displayName);
+            QString full, initials;
+            full.reserve(displayName.size() * 4);
+            initials.reserve(displayName.size());
+            Pinyin::appendPinyin(displayName, &full, &initials);
+            const_cast<FileInfo *>(this)->pinyinInitials = initials;
+            const_cast<FileInfo *>(this)->pinyinName = full;
         }
 
-        return pinyinName;
+        return type == DisPlayInfoType::kFileDisplayPinyinName ? pinyinName : pinyinInitials;
     default:
         return QString();
     }
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dmimedatabase.h"
+#include "mimetypecache.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/utils/networkutils.h>
@@ -13,6 +14,7 @@
 #include <QUrl>
 #include <QFileInfo>
 #include <QRegularExpression>
+#include <QSet>
 
 using namespace dfmbase;
 
@@ -22,7 +24,25 @@ static QStringList wrongMimeTypeNames {
 static QStringList officeSuffixList {
     "docx", "xlsx", "pptx", "doc", "ppt", "xls", "wps"
 };
-static const QStringList blackList { "/sys/kernel/security/apparmor/revision", "/sys/kernel/security/apparmor/policy/revision", "/sys/power/wakeup_count", "/proc/kmsg" };
+static const QSet<QString> blackList { "/sys/kernel/security/apparmor/revision", "/sys/kernel/security/apparmor/policy/revision", "/sys/power/wakeup_count", "/proc/kmsg" };
+
+// fix bug 35448 【文件管理器】【5.1.2.2-1】【sp2】预览ftp路径下某个文件夹后，文管卡死,访问特殊系统文件卡死
+static bool isLockLikeFile(const QString &fileName, const QString &path)
+{
+    return fileName.endsWith(".pid") || path.endsWith("msg.lock")
+            || fileName.endsWith(".lock") || fileName.endsWith("lockfile");
+}
+
+static bool isGvfsPath(const QString &path)
+{
+    // 只编译一次，QRegularExpression 的 const 匹配可以在多个线程中同时进行
+    static const QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
+                                           QRegularExpression::DotMatchesEverythingOption
+                                                   | QRegularExpression::DontCaptureOption);
+    const QRegularExpressionMatch &match = regExp.match(path, 0, QRegularExpression::NormalMatch,
+                                                        QRegularExpression::DontCheckSubjectStringMatchOption);
+    return match.hasMatch();
+}
 
 DMimeDatabase::DMimeDatabase()
 {
@@ -42,27 +62,12 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
     if (!fileInfo)
         return QMimeType();
 
-    QString path = fileInfo->pathOf(PathInfoType::kPath);
+    const QString &path = fileInfo->pathOf(PathInfoType::kPath);
+    const QString &fileName = fileInfo->nameOf(NameInfoType::kFileName);
     bool isMatchExtension = mode == QMimeDatabase::MatchExtension;
     if (!isMatchExtension) {
-        // fix bug 35448 【文件管理器】【5.1.2.2-1】【sp2】预览ftp路径下某个文件夹后，文管卡死,访问特殊系统文件卡死
-        if (fileInfo->nameOf(NameInfoType::kFileName).endsWith(".pid") || path.endsWith("msg.lock")
-            || fileInfo->nameOf(NameInfoType::kFileName).endsWith(".lock") || fileInfo->nameOf(NameInfoType::kFileName).endsWith("lockfile")) {
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption
-                                              | QRegularExpression::OptimizeOnFirstUsageOption);
-#else
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption);
-#endif
-
-            const QRegularExpressionMatch &match = regExp.match(path, 0, QRegularExpression::NormalMatch,
-                                                                QRegularExpression::DontCheckSubjectStringMatchOption);
-
-            isMatchExtension = match.hasMatch();
+        if (isLockLikeFile(fileName, path)) {
+            isMatchExtension = isGvfsPath(path);
         } else {
             // filemanger will be blocked when blacklist contais the filepath.
             QString filePath = fileInfo->pathOf(PathInfoType::kAbsoluteFilePath);
@@ -73,35 +78,25 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
         }
     }
 
-    if (isMatchExtension) {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), QMimeDatabase::MatchExtension);
-    } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), mode);
-    }
+    const QString &filePath = fileInfo->pathOf(PathInfoType::kFilePath);
+    if (isMatchExtension)
+        return fixOfficeMimeType(QMimeDatabase::mimeTypeForFile(filePath, QMimeDatabase::MatchExtension),
+                                 fileInfo->nameOf(NameInfoType::kSuffix), fileName);
 
-    // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
-    // we used to patch our Qt to fix this issue but the patch no longer works, we don't have time to
-    // look into this issue ATM.
-    // https://bugreports.qt.io/browse/QTBUG-71640
-    // https://codereview.qt-project.org/c/qt/qtbase/+/244887
-    // `file` command works but libmagic didn't even comes with any pkg-config support..
+    // 内容识别需要读文件，按 (设备, inode, mtime) 缓存，文件内容变化后自动失效
+    const auto &key = MimeTypeCache::keyOf(filePath, fileName, mode);
+    if (key && MimeTypeCache::instance()->find(*key, &result))
+        return result;
 
-    if (officeSuffixList.contains(fileInfo->nameOf(NameInfoType::kSuffix))
-        && wrongMimeTypeNames.contains(result.name())) {
-        QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo->nameOf(NameInfoType::kFileName));
-        if (!results.isEmpty()) {
-            return results.first();
-        }
-    }
+    result = fixOfficeMimeType(QMimeDatabase::mimeTypeForFile(filePath, mode),
+                               fileInfo->nameOf(NameInfoType::kSuffix), fileName);
+    if (key)
+        MimeTypeCache::instance()->insert(*key, result);
     return result;
 }
 
 QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase::MatchMode mode, const QString &inod, const bool isGvfs) const
 {
-    if (!inod.isEmpty() && inodMimetypeCache.contains(inod)) {
-        return inodMimetypeCache.value(inod);
-    }
-
     QUrl url = QUrl::fromLocalFile(fileName);
     if (!ProtocolUtils::isLocalFile(url) && NetworkUtils::instance()->checkFtpOrSmbBusy(url))
         return QMimeType();
@@ -114,39 +109,21 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase:
 
 QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode, const QString &inod, const bool isGvfs) const
 {
+    // 缓存改为按文件状态生成键，inod 仅保留兼容
+    Q_UNUSED(inod)
     Q_UNUSED(isGvfs)
     // 如果是低速设备，则先从扩展名去获取mime信息；对于本地文件，保持默认的获取策略
-    bool canCache = !inod.isEmpty();
-    if (!inod.isEmpty() && inodMimetypeCache.contains(inod)) {
-        return inodMimetypeCache.value(inod);
-    }
     if (fileInfo.isDir()) {
         return QMimeDatabase::mimeTypeForFile(QFileInfo("/home"), mode);
     }
     QMimeType result;
-    QString path = fileInfo.path();
+    const QString &path = fileInfo.path();
 
     bool isMatchExtension = mode == QMimeDatabase::MatchExtension;
 
-    // fix bug 35448 【文件管理器】【5.1.2.2-1】【sp2】预览ftp路径下某个文件夹后，文管卡死,访问特殊系统文件卡死
     if (!isMatchExtension) {
-        if (fileInfo.fileName().endsWith(".pid") || path.endsWith("msg.lock")
-            || fileInfo.fileName().endsWith(".lock") || fileInfo.fileName().endsWith("lockfile")) {
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption
-                                              | QRegularExpression::OptimizeOnFirstUsageOption);
-#else
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption);
-#endif
-
-            const QRegularExpressionMatch &match = regExp.match(path, 0, QRegularExpression::NormalMatch,
-                                                                QRegularExpression::DontCheckSubjectStringMatchOption);
-
-            isMatchExtension = match.hasMatch();
+        if (isLockLikeFile(fileInfo.fileName(), path)) {
+            isMatchExtension = isGvfsPath(path);
         } else {
             // filemanger will be blocked when blacklist contais the filepath.
             // fix task #29124, bug #108805
@@ -157,12 +134,22 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
             isMatchExtension = blackList.contains(filePath);
         }
     }
-    if (isMatchExtension) {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo, QMimeDatabase::MatchExtension);
-    } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo, mode);
-    }
+    if (isMatchExtension)
+        return fixOfficeMimeType(QMimeDatabase::mimeTypeForFile(fileInfo, QMimeDatabase::MatchExtension),
+                                 fileInfo.suffix(), fileInfo.fileName());
+
+    const auto &key = MimeTypeCache::keyOf(fileInfo.absoluteFilePath(), fileInfo.fileName(), mode);
+    if (key && MimeTypeCache::instance()->find(*key, &result))
+        return result;
 
+    result = fixOfficeMimeType(QMimeDatabase::mimeTypeForFile(fileInfo, mode), fileInfo.suffix(), fileInfo.fileName());
+    if (key)
+        MimeTypeCache::instance()->insert(*key, result);
+    return result;
+}
+
+QMimeType DMimeDatabase::fixOfficeMimeType(const QMimeType &type, const QString &suffix, const QString &fileName) const
+{
     // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
     // we used to patch our Qt to fix this issue but the patch no longer works, we don't have time to
     // look into this issue ATM.
@@ -170,19 +157,13 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     // https://codereview.qt-project.org/c/qt/qtbase/+/244887
     // `file` command works but libmagic didn't even comes with any pkg-config support..
 
-    if (officeSuffixList.contains(fileInfo.suffix()) && wrongMimeTypeNames.contains(result.name())) {
-        QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo.fileName());
+    if (officeSuffixList.contains(suffix) && wrongMimeTypeNames.contains(type.name())) {
+        QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileName);
         if (!results.isEmpty()) {
-            if (canCache) {
-                const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, results.first());
-            }
             return results.first();
         }
     }
-    if (canCache) {
-        const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, result);
-    }
-    return result;
+    return type;
 }
 
 QMimeType DMimeDatabase::mimeTypeForUrl(const QUrl &url) const
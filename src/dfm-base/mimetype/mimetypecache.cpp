@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimetypecache.h"
+
+#include <sys/stat.h>
+
+using namespace dfmbase;
+
+size_t dfmbase::qHash(const MimeCacheKey &key, size_t seed) noexcept
+{
+    return qHashMulti(seed, key.device, key.inode, key.mtimeNsec, key.size, key.nameHash, key.matchMode);
+}
+
+MimeTypeCache::MimeTypeCache(qsizetype capacity)
+    : shardCapacity(qMax<qsizetype>(1, capacity / kShardCount))
+{
+}
+
+MimeTypeCache *MimeTypeCache::instance()
+{
+    static MimeTypeCache ins;
+    return &ins;
+}
+
+std::optional<MimeCacheKey> MimeTypeCache::keyOf(const QString &filePath, const QString &fileName,
+                                                 QMimeDatabase::MatchMode mode)
+{
+    struct stat st;
+    if (filePath.isEmpty() || ::stat(filePath.toUtf8().constData(), &st) != 0)
+        return std::nullopt;
+
+    MimeCacheKey key;
+    key.device = st.st_dev;
+    key.inode = st.st_ino;
+    key.mtimeNsec = qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    key.size = st.st_size;
+    key.nameHash = ::qHash(fileName);
+    key.matchMode = mode;
+    return key;
+}
+
+MimeTypeCache::Shard &MimeTypeCache::shardOf(const MimeCacheKey &key)
+{
+    // inode 的低位分布均匀，直接用来选择分片
+    return shards[(key.inode ^ key.device) % kShardCount];
+}
+
+bool MimeTypeCache::find(const MimeCacheKey &key, QMimeType *type)
+{
+    Shard &shard = shardOf(key);
+    {
+        QMutexLocker lk(&shard.mutex);
+        auto it = shard.index.constFind(key);
+        if (it != shard.index.cend()) {
+            shard.entries.splice(shard.entries.begin(), shard.entries, it.value());
+            if (type)
+                *type = it.value()->second;
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void MimeTypeCache::insert(const MimeCacheKey &key, const QMimeType &type)
+{
+    Shard &shard = shardOf(key);
+    QMutexLocker lk(&shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        it.value()->second = type;
+        shard.entries.splice(shard.entries.begin(), shard.entries, it.value());
+        return;
+    }
+
+    shard.entries.emplace_front(key, type);
+    shard.index.insert(key, shard.entries.begin());
+
+    if (shard.entries.size() > static_cast<size_t>(shardCapacity)) {
+        shard.index.remove(shard.entries.back().first);
+        shard.entries.pop_back();
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MimeTypeCache::clear()
+{
+    for (Shard &shard : shards) {
+        QMutexLocker lk(&shard.mutex);
+        shard.index.clear();
+        shard.entries.clear();
+    }
+}
+
+MimeTypeCache::Statistics MimeTypeCache::statistics() const
+{
+    Statistics stat;
+    stat.hits = hits.load(std::memory_order_relaxed);
+    stat.misses = misses.load(std::memory_order_relaxed);
+    stat.evictions = evictions.load(std::memory_order_relaxed);
+    for (const Shard &shard : shards) {
+        QMutexLocker lk(&shard.mutex);
+        stat.size += shard.index.size();
+    }
+    return stat;
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMETYPECACHE_H
+#define MIMETYPECACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QMimeDatabase>
+#include <QMimeType>
+#include <QHash>
+#include <QMutex>
+
+#include <sys/types.h>
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <optional>
+
+namespace dfmbase {
+
+/*!
+ * \brief Identity of a file's content for mime caching.
+ *
+ * Device and inode identify the file, mtime and size change whenever the content
+ * is rewritten. The file name is part of the key because glob matching makes two
+ * hard links with different suffixes resolve differently.
+ */
+struct MimeCacheKey
+{
+    dev_t device { 0 };
+    ino_t inode { 0 };
+    qint64 mtimeNsec { 0 };
+    qint64 size { 0 };
+    size_t nameHash { 0 };
+    int matchMode { 0 };
+
+    bool operator==(const MimeCacheKey &other) const
+    {
+        return inode == other.inode && device == other.device && mtimeNsec == other.mtimeNsec
+                && size == other.size && nameHash == other.nameHash && matchMode == other.matchMode;
+    }
+};
+
+size_t qHash(const MimeCacheKey &key, size_t seed = 0) noexcept;
+
+/*!
+ * \brief Process-wide, bounded cache of content-sniffed mime types.
+ *
+ * Entries are spread over independently locked shards, each evicting its least
+ * recently used entry once full, so lookups from the model, info and worker
+ * threads do not contend on one lock.
+ */
+class MimeTypeCache
+{
+public:
+    struct Statistics
+    {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 evictions { 0 };
+        qsizetype size { 0 };
+    };
+
+    static constexpr int kShardCount { 16 };
+    static constexpr qsizetype kDefaultCapacity { 16384 };
+
+    explicit MimeTypeCache(qsizetype capacity = kDefaultCapacity);
+    static MimeTypeCache *instance();
+
+    // stats filePath; no key if the file cannot be stat'ed
+    static std::optional<MimeCacheKey> keyOf(const QString &filePath, const QString &fileName,
+                                             QMimeDatabase::MatchMode mode);
+
+    bool find(const MimeCacheKey &key, QMimeType *type);
+    void insert(const MimeCacheKey &key, const QMimeType &type);
+    void clear();
+    Statistics statistics() const;
+
+private:
+    struct Shard
+    {
+        using Entry = std::pair<MimeCacheKey, QMimeType>;
+
+        mutable QMutex mutex;
+        std::list<Entry> entries;   // 最近使用的在前
+        QHash<MimeCacheKey, std::list<Entry>::iterator> index;
+    };
+
+    Shard &shardOf(const MimeCacheKey &key);
+
+    qsizetype shardCapacity;
+    std::array<Shard, kShardCount> shards;
+    std::atomic<quint64> hits { 0 };
+    std::atomic<quint64> misses { 0 };
+    std::atomic<quint64> evictions { 0 };
+};
+
+}
+
+#endif   // MIMETYPECACHE_H
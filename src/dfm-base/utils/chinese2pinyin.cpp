@@ -4,61 +4,87 @@
 
 #include "chinese2pinyin.h"
 
-#include <QHash>
-#include <QTextStream>
-#include <QFile>
+// 构建时由 cmake/GeneratePinyinTable.cmake 根据 pinyin.dict 生成
+#include "pinyintable_data.h"
 
-namespace Pinyin {
-
-static QHash<uint, QString> dict = {};
-
-const char kDictFile[] = ":/misc/pinyin.dict";
-
-void InitDict() {
-    if (!dict.isEmpty()) {
-        return;
-    }
+#include <QVarLengthArray>
 
-    dict.reserve(25333);
+#include <algorithm>
 
-    QFile file(kDictFile);
-
-    if (!file.open(QIODevice::ReadOnly))
-        return;
+namespace Pinyin {
 
-    QByteArray content = file.readAll();
+static int syllableIndex(char16_t ch)
+{
+    if (ch >= Table::kDenseBegin && ch < Table::kDenseEnd)
+        return Table::kDense[ch - Table::kDenseBegin] - 1;
 
-    file.close();
+    const auto end = std::end(Table::kSparse);
+    const auto it = std::lower_bound(std::begin(Table::kSparse), end, ch,
+                                     [](const Table::SparseEntry &entry, char16_t code) { return entry.code < code; });
+    return (it != end && it->code == ch) ? it->syllable : -1;
+}
 
-    QTextStream stream(&content, QIODevice::ReadOnly);
+QLatin1String syllableOf(char16_t ch)
+{
+    const int index = syllableIndex(ch);
+    if (index < 0)
+        return QLatin1String();
 
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QStringList items = line.split(QChar(':'));
+    const quint16 begin = Table::kSyllableOffsets[index];
+    return QLatin1String(Table::kSyllableText + begin, Table::kSyllableOffsets[index + 1] - begin);
+}
 
-        if (items.size() == 2) {
-            dict.insert(static_cast<uint>(items[0].toInt(nullptr, 16)), items[1]);
+bool appendPinyin(QStringView words, QString *full, QString *initials)
+{
+    bool hasChinese = false;
+    for (const QChar ch : words) {
+        const QLatin1String syllable = syllableOf(ch.unicode());
+        if (syllable.isEmpty()) {
+            if (full)
+                full->append(ch);
+            if (initials)
+                initials->append(ch);
+            continue;
         }
+
+        hasChinese = true;
+        if (full)
+            full->append(syllable);
+        if (initials)
+            initials->append(syllable.front());
     }
+    return hasChinese;
 }
 
 QString Chinese2Pinyin(const QString& words) {
-    InitDict();
-
     QString result;
+    // 大多数拼音（含声调）不超过 4 个字符
+    result.reserve(words.size() * 4);
+    appendPinyin(words, &result);
+    return result;
+}
 
-    for (int i = 0; i < words.length(); ++i) {
-        const uint key = words.at(i).unicode();
-        auto find_result = dict.find(key);
-
-        if (find_result != dict.end()) {
-            result.append(find_result.value());
-        } else {
-            result.append(words.at(i));
-        }
+bool matchInitials(QStringView words, QStringView keys, bool matchStart)
+{
+    if (keys.isEmpty() || keys.size() > words.size())
+        return false;
+
+    QVarLengthArray<QChar, 256> initials;
+    bool hasChinese = false;
+    for (const QChar ch : words) {
+        const QLatin1String syllable = syllableOf(ch.unicode());
+        hasChinese = hasChinese || !syllable.isEmpty();
+        initials.append(syllable.isEmpty() ? ch : QChar(syllable.front()));
+        if (matchStart && initials.size() == keys.size())
+            break;
     }
 
-    return result;
+    if (!hasChinese)
+        return false;
+
+    const QStringView text(initials.constData(), initials.size());
+    return matchStart ? text.startsWith(keys, Qt::CaseInsensitive)
+                      : text.contains(keys, Qt::CaseInsensitive);
 }
 
 }  // namespace Pinyin end
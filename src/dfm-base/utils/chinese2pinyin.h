@@ -6,9 +6,20 @@
 #define CHINESE_2_PINYIN_H
 
 #include <QString>
+#include <QStringView>
 
 namespace Pinyin {
 QString Chinese2Pinyin(const QString& words);
+
+// 单个汉字带声调的拼音，如 "zhong1"；不在字典中时返回空
+QLatin1String syllableOf(char16_t ch);
+
+// 把 words 的全拼追加到 full、拼音首字母追加到 initials（可为空），非汉字原样追加。
+// 调用方可以复用缓冲区，返回 words 中是否包含汉字
+bool appendPinyin(QStringView words, QString *full, QString *initials = nullptr);
+
+// keys 是否匹配 words 的拼音首字母（不区分大小写），如 "wd" 匹配 "文档"；words 不含汉字时返回 false
+bool matchInitials(QStringView words, QStringView keys, bool matchStart = true);
 };
 
 #endif  // CHINESE_2_PINYIN_H
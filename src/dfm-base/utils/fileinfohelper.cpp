@@ -9,12 +9,25 @@
 #include <dfm-base/utils/networkutils.h>
 #include <dfm-base/utils/protocolutils.h>
 
+#include <dfm-io/denumerator.h>
+
+#include <QDir>
 #include <QGuiApplication>
 #include <QTimer>
 
 Q_DECLARE_METATYPE(QSharedPointer<dfmio::DFileInfo>);
 
 DFMBASE_USE_NAMESPACE
+
+namespace {
+// 同一目录下待刷新的文件达到该数量时，用一次目录枚举代替逐个查询
+constexpr int kEnumerateThreshold { 16 };
+// 枚举读取的条目超过待刷新文件数的该倍数时停止：请求只占目录的一小部分，
+// 继续枚举整个目录比逐个查询更慢，剩余文件回退到逐个查询
+constexpr int kEnumerateScanFactor { 2 };
+// 批量缓存属性时每个线程池任务处理的文件数
+constexpr int kCacheChunkSize { 256 };
+}   // namespace
 FileInfoHelper::FileInfoHelper(QObject *parent)
     : QObject(parent), thread(new QThread), worker(new FileInfoAsycWorker)
 {
@@ -40,6 +53,7 @@ void FileInfoHelper::init()
     worker->moveToThread(thread.data());
     thread->start();
     pool.setMaxThreadCount(std::max(FileUtils::getCpuProcessCount(), 10));
+    enumeratePool.setMaxThreadCount(2);
 }
 
 void FileInfoHelper::threadHandleDfmFileInfo(const QSharedPointer<FileInfo> dfileInfo)
@@ -74,6 +88,109 @@ void FileInfoHelper::threadHandleDfmFileInfo(const QSharedPointer<FileInfo> dfil
     checkInfoRefresh(asyncInfo);
 }
 
+void FileInfoHelper::threadHandleDfmFileInfos(const QList<FileInfoPointer> &infos)
+{
+    for (const auto &info : infos) {
+        if (stoped)
+            return;
+        threadHandleDfmFileInfo(info);
+    }
+}
+
+void FileInfoHelper::threadEnumerateDfmFileInfos(const QUrl &dirUrl, const QList<FileInfoPointer> &infos)
+{
+    if (stoped)
+        return;
+
+    QHash<QString, FileInfoPointer> wanted;
+    QList<FileInfoPointer> remaining;
+    for (const auto &info : infos) {
+        const QString &name = info->fileUrl().fileName();
+        if (wanted.contains(name))
+            remaining.append(info);
+        else
+            wanted.insert(name, info);
+    }
+
+    // 一次枚举父目录取回所有待刷新文件的信息，找齐后立即停止；
+    // 读取的条目数以请求数为基准限制，请求只覆盖大目录中的少数文件时不会枚举整个目录
+    QList<FileInfoPointer> refreshed;
+    const int maxScanned = infos.size() * kEnumerateScanFactor;
+    int scanned = 0;
+    DFMIO::DEnumerator enumerator(dirUrl, {},
+                                  static_cast<DFMIO::DEnumerator::DirFilter>(static_cast<int32_t>(
+                                          QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System | QDir::Hidden)),
+                                  DFMIO::DEnumerator::IteratorFlag::kNoIteratorFlags);
+    while (!wanted.isEmpty() && !stoped && scanned++ < maxScanned && enumerator.hasNext()) {
+        const QString &name = enumerator.next().fileName();
+        auto it = wanted.find(name);
+        if (it == wanted.end())
+            continue;
+
+        auto dfmInfo = enumerator.fileInfo();
+        auto asyncInfo = it.value().dynamicCast<AsyncFileInfo>();
+        if (dfmInfo && asyncInfo) {
+            asyncInfo->setDfmFileInfo(dfmInfo);
+            refreshed.append(asyncInfo);
+        } else {
+            remaining.append(it.value());
+        }
+        wanted.erase(it);
+    }
+
+    if (stoped)
+        return;
+
+    // 枚举中没有出现的文件（已删除、枚举失败或超出读取上限）回到主线程按原方式逐个异步查询
+    remaining.append(wanted.values());
+    qCDebug(logDFMBase) << "Refreshed" << refreshed.size() << "file infos by enumerating" << dirUrl
+                        << "," << remaining.size() << "left for single queries";
+
+    cacheFileInfosByThread(refreshed);
+    if (!remaining.isEmpty()) {
+        QMetaObject::invokeMethod(this, [this, remaining] {
+            queryDfmFileInfosAsync(remaining);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void FileInfoHelper::queryDfmFileInfosAsync(const QList<FileInfoPointer> &infos)
+{
+    assert(qApp->thread() == QThread::currentThread());
+
+    for (const auto &info : infos) {
+        if (stoped)
+            return;
+
+        auto asyncInfo = info.dynamicCast<AsyncFileInfo>();
+        auto callback = [asyncInfo, this](bool success, void *data) {
+            Q_UNUSED(data);
+            if (!success) {
+                handleQueryFailed(asyncInfo);
+                return;
+            }
+            cacheFileInfoByThread(asyncInfo);
+        };
+
+        // 查询无法发起时同样释放查询中的记录
+        if (!asyncInfo || !asyncInfo->asyncQueryDfmFileInfo(0, callback))
+            handleQueryFailed(info);
+    }
+}
+
+void FileInfoHelper::handleQueryFailed(const FileInfoPointer &dfileInfo)
+{
+    emit requestCheckInfoRefresh(dfileInfo);
+
+    auto asyncInfo = dfileInfo.dynamicCast<AsyncFileInfo>();
+    if (asyncInfo && ProtocolUtils::isSMBFile(asyncInfo->fileUrl())
+        && asyncInfo->errorCodeFromDfmio() == DFMIOErrorCode::DFM_IO_ERROR_HOST_IS_DOWN
+        && !NetworkUtils::instance()->checkFtpOrSmbBusy(asyncInfo->fileUrl())) {
+        qCWarning(logDFMBase) << "SMB server connection lost for URL:" << asyncInfo->fileUrl();
+        emit smbSeverMayModifyPassword(asyncInfo->fileUrl());
+    }
+}
+
 QSharedPointer<FileInfoHelperUeserData> FileInfoHelper::fileCountAsync(QUrl &url)
 {
     if (stoped)
@@ -109,6 +226,16 @@ void FileInfoHelper::cacheFileInfoByThread(const QSharedPointer<FileInfo> dfileI
     });
 }
 
+void FileInfoHelper::cacheFileInfosByThread(const QList<FileInfoPointer> &infos)
+{
+    for (int i = 0; i < infos.size() && !stoped; i += kCacheChunkSize) {
+        const auto chunk = infos.mid(i, kCacheChunkSize);
+        pool.start([this, chunk] {
+            threadHandleDfmFileInfos(chunk);
+        });
+    }
+}
+
 FileInfoHelper::~FileInfoHelper()
 {
     aboutToQuit();
@@ -143,32 +270,44 @@ void FileInfoHelper::handleFileRefresh(QSharedPointer<FileInfo> dfileInfo)
     if (!asyncInfo)
         return;
 
-    auto callback = [asyncInfo, this](bool success, void *data) {
-        Q_UNUSED(data);
-        if (!success) {
-            emit this->requestCheckInfoRefresh(asyncInfo);
-            if (ProtocolUtils::isSMBFile(asyncInfo->fileUrl())
-                && asyncInfo->errorCodeFromDfmio() == DFMIOErrorCode::DFM_IO_ERROR_HOST_IS_DOWN
-                && !NetworkUtils::instance()->checkFtpOrSmbBusy(asyncInfo->fileUrl())) {
-                qCWarning(logDFMBase) << "SMB server connection lost for URL:" << asyncInfo->fileUrl();
-                emit this->smbSeverMayModifyPassword(asyncInfo->fileUrl());
-            }
-            return;
-        }
-        FileInfoHelper::instance().cacheFileInfoByThread(asyncInfo);
-    };
-
-    if (qureingInfo.containsByLock(asyncInfo) && needQureingInfo.containsByLock(asyncInfo))
+    if (queryingInfos.contains(asyncInfo)) {
+        needQueryInfos.insert(asyncInfo);
         return;
+    }
 
-    if (qureingInfo.containsByLock(asyncInfo)) {
-        needQureingInfo.appendByLock(asyncInfo);
-        return;
+    queryingInfos.insert(asyncInfo);
+    const QUrl &dirUrl = asyncInfo->fileUrl().adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash);
+    pendingRefreshInfos[dirUrl].append(asyncInfo);
+
+    // 同一轮事件中的刷新请求合并后统一查询
+    if (!refreshScheduled) {
+        refreshScheduled = true;
+        QMetaObject::invokeMethod(this, &FileInfoHelper::flushPendingRefresh, Qt::QueuedConnection);
     }
+}
 
-    qureingInfo.appendByLock(asyncInfo);
-    qCDebug(logDFMBase) << "Starting async file info query for URL:" << asyncInfo->fileUrl();
-    asyncInfo->asyncQueryDfmFileInfo(0, callback);
+void FileInfoHelper::flushPendingRefresh()
+{
+    assert(qApp->thread() == QThread::currentThread());
+
+    refreshScheduled = false;
+    const auto pending = std::exchange(pendingRefreshInfos, {});
+    if (stoped)
+        return;
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        const QUrl dirUrl = it.key();
+        const QList<FileInfoPointer> infos = it.value();
+        qCDebug(logDFMBase) << "Starting file info query for" << infos.size() << "files in:" << dirUrl;
+        // 网络和外部设备上的枚举可能长时间阻塞，只对本地文件系统使用
+        if (infos.size() >= kEnumerateThreshold && ProtocolUtils::isLocalFile(dirUrl)) {
+            enumeratePool.start([this, dirUrl, infos] {
+                threadEnumerateDfmFileInfos(dirUrl, infos);
+            });
+        } else {
+            queryDfmFileInfosAsync(infos);
+        }
+    }
 }
 
 void FileInfoHelper::checkInfoRefresh(QSharedPointer<FileInfo> dfileInfo)
@@ -185,9 +324,7 @@ void FileInfoHelper::handleCheckInfoRefresh(QSharedPointer<FileInfo> dfileInfo)
     if (stoped)
         return;
 
-    qureingInfo.removeOneByLock(dfileInfo);
-    if (needQureingInfo.containsByLock(dfileInfo)) {
-        needQureingInfo.removeOneByLock(dfileInfo);
+    queryingInfos.remove(dfileInfo);
+    if (needQueryInfos.remove(dfileInfo))
         fileRefreshAsync(dfileInfo);
-    }
 }
@@ -8,7 +8,6 @@
 #include <dfm-base/dfm_base_global.h>
 #include <dfm-base/utils/fileinfoasycworker.h>
 #include <dfm-base/interfaces/fileinfo.h>
-#include <dfm-base/utils/threadcontainer.h>
 
 #include <dfm-io/dfileinfo.h>
 
@@ -18,6 +17,7 @@
 #include <QMimeDatabase>
 #include <QThreadPool>
 #include <QReadWriteLock>
+#include <QSet>
 
 namespace dfmbase {
 class FileInfoHelper : public QObject
@@ -31,11 +31,16 @@ public:
                                                               const QString &inod, const bool isGvfs);
     void fileRefreshAsync(const QSharedPointer<dfmbase::FileInfo> dfileInfo);
     void cacheFileInfoByThread(const QSharedPointer<FileInfo> dfileInfo);
+    void cacheFileInfosByThread(const QList<FileInfoPointer> &infos);
 
 private:
     explicit FileInfoHelper(QObject *parent = nullptr);
     void init();
     void threadHandleDfmFileInfo(const QSharedPointer<FileInfo> dfileInfo);
+    void threadHandleDfmFileInfos(const QList<FileInfoPointer> &infos);
+    void threadEnumerateDfmFileInfos(const QUrl &dirUrl, const QList<FileInfoPointer> &infos);
+    void queryDfmFileInfosAsync(const QList<FileInfoPointer> &infos);
+    void handleQueryFailed(const FileInfoPointer &dfileInfo);
 
 private:
     // send for other
@@ -57,6 +62,7 @@ private Q_SLOTS:
     void aboutToQuit();
     void handleFileRefresh(QSharedPointer<FileInfo> dfileInfo);
     void handleCheckInfoRefresh(QSharedPointer<FileInfo> dfileInfo);
+    void flushPendingRefresh();
 
 private:
     void checkInfoRefresh(QSharedPointer<FileInfo> dfileInfo);
@@ -65,9 +71,14 @@ private:
     QSharedPointer<QThread> thread { nullptr };
     QSharedPointer<FileInfoAsycWorker> worker { nullptr };
     std::atomic_bool stoped { false };
-    DThreadList<FileInfoPointer> qureingInfo;
-    DThreadList<FileInfoPointer> needQureingInfo;
+    // 以下成员只在主线程访问
+    QSet<FileInfoPointer> queryingInfos;
+    QSet<FileInfoPointer> needQueryInfos;
+    QHash<QUrl, QList<FileInfoPointer>> pendingRefreshInfos;   // 按父目录分组，等待批量查询
+    bool refreshScheduled { false };
     QThreadPool pool;
+    // 目录枚举在网络断开时可能长时间阻塞，使用单独的线程池，退出时不等待
+    QThreadPool enumeratePool;
 };
 }
 
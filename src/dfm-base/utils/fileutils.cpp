@@ -14,6 +14,7 @@
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/utils/finallyutil.h>
 #include <dfm-base/base/device/deviceutils.h>
+#include <dfm-base/base/device/mounttable.h>
 #include <dfm-base/utils/networkutils.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
 #include <dfm-base/base/schemefactory.h>
@@ -321,7 +322,9 @@ bool FileUtils::isSameMountPoint(const QUrl &url1, const QUrl &url2)
     if (url1.scheme() != url2.scheme())
         return false;
 
-    return DFMIO::DFMUtils::mountPathFromUrl(url1) == DFMIO::DFMUtils::mountPathFromUrl(url2);
+    // 复制任务中逐个文件调用，使用缓存的挂载表而不是每次重新解析
+    MountTable *table = MountTable::instance();
+    return table->mountPointOfFile(url1.toLocalFile()) == table->mountPointOfFile(url2.toLocalFile());
 }
 
 bool FileUtils::isSameDevice(const QUrl &url1, const QUrl &url2)
@@ -19,8 +19,60 @@ static constexpr int kRotationTrainingTime = (60 * 1000);
 static constexpr int kCacheRemoveTime = (60 * (60 * 1000));
 
 namespace dfmbase {
+void UrlLruIndex::touch(const QUrl &url, qint64 msecs)
+{
+    auto it = index.constFind(url);
+    if (it != index.constEnd()) {
+        auto node = it.value();
+        node->time = msecs;
+        if (node != order.begin())
+            order.splice(order.begin(), order, node);
+        return;
+    }
+
+    order.push_front({ url, msecs });
+    index.insert(url, order.begin());
+}
+
+bool UrlLruIndex::remove(const QUrl &url)
+{
+    auto it = index.find(url);
+    if (it == index.end())
+        return false;
+
+    order.erase(it.value());
+    index.erase(it);
+    return true;
+}
+
+/*!
+ * \brief UrlLruIndex::takeStale 从尾部取出超出容量或访问时间早于deadline的url
+ *
+ * \param int 保留的条目上限
+ *
+ * \param qint64 访问时间早于该时间的条目全部取出
+ *
+ * \return 取出的url，最久未访问的在前
+ */
+QList<QUrl> UrlLruIndex::takeStale(int capacity, qint64 deadline)
+{
+    QList<QUrl> stale;
+    while (!order.empty() && (index.size() > capacity || order.back().time < deadline)) {
+        stale.append(order.back().url);
+        index.remove(order.back().url);
+        order.pop_back();
+    }
+    return stale;
+}
+
+void UrlLruIndex::clear()
+{
+    order.clear();
+    index.clear();
+}
+
 InfoCachePrivate::InfoCachePrivate(InfoCache *qq)
-    : q(qq)
+    : q(qq), infoCapacity(kCacheFileinfoCount), watcherCapacity(kCacheFileWatcherCount)
 {
 }
 
@@ -199,13 +251,38 @@ bool InfoCache::updateSortTimeWorker(const QUrl url)
     Q_D(InfoCache);
     if (d->cacheWorkerStoped)
         return false;
-    auto time = QDateTime::currentMSecsSinceEpoch();
-    auto key = QString::number(time) + QString("-") + url.toString();
-    if (d->urlTimeSortHash.contains(url))
-        d->timeToUrlMap.remove(d->urlTimeSortHash.value(url));
-    d->timeToUrlMap.insert(key, url);
-    d->urlTimeSortHash.insert(url, key);
-    return d->timeToUrlMap.count() > kCacheFileinfoCount;
+    d->infoTimeIndex.touch(url, QDateTime::currentMSecsSinceEpoch());
+    return d->infoTimeIndex.size() > d->infoCapacity;
+}
+
+/*!
+ * \brief setCapacity 设置fileinfo和watcher缓存的条目上限，超出的部分在下一次访问或定时检查时淘汰
+ *
+ * \param int fileinfo缓存上限，小于等于0时不修改
+ *
+ * \param int watcher缓存上限，小于等于0时不修改
+ */
+void InfoCache::setCapacity(const int infoCount, const int watcherCount)
+{
+    Q_D(InfoCache);
+    if (infoCount > 0)
+        d->infoCapacity = infoCount;
+    if (watcherCount > 0)
+        d->watcherCapacity = watcherCount;
+}
+
+InfoCacheStatistics InfoCache::statistics() const
+{
+    InfoCacheStatistics stat;
+    stat.hits = d->hitCount.load(std::memory_order_relaxed);
+    stat.misses = d->missCount.load(std::memory_order_relaxed);
+    stat.evictions = d->evictionCount.load(std::memory_order_relaxed);
+    stat.capacity = d->infoCapacity;
+    {
+        QReadLocker rlk(&d->mianLock);
+        stat.size = d->mainCache.size();
+    }
+    return stat;
 }
 
 void InfoCache::stop()
@@ -274,10 +351,15 @@ FileInfoPointer InfoCache::getCacheInfo(const QUrl &url)
         QReadLocker wlk(&d->copyLock);
         info = d->copyCache.value(url);
     }
+    if (!info) {
+        d->missCount.fetch_add(1, std::memory_order_relaxed);
+        return info;
+    }
+
+    d->hitCount.fetch_add(1, std::memory_order_relaxed);
     // 异步线程或者信号更新时间
     // 使用线程处理加入时间序列问题
-    if (info)
-        emit cacheUpdateInfoTime(url);
+    emit cacheUpdateInfoTime(url);
 
     return info;
 }
@@ -304,26 +386,17 @@ void InfoCache::addWatcherTimeInfo(const QList<QUrl> &urls)
     for (const auto &url : urls) {
         if (d->cacheWorkerStoped)
             return;
-        auto key = QString::number(time) + QString("-") + url.toString();
-        if (d->urlTimeSortWatcherHash.contains(url))
-            d->timeToUrlWatcherMap.remove(d->urlTimeSortWatcherHash.value(url));
-        d->timeToUrlWatcherMap.insert(key, url);
-        d->urlTimeSortWatcherHash.insert(url, key);
+        d->watcherTimeIndex.touch(url, time);
     }
 
-    if (d->timeToUrlWatcherMap.count() <= kCacheFileWatcherCount)
+    if (d->watcherTimeIndex.size() <= d->watcherCapacity)
         return;
 
-    // 超出限制移除先进入的watcher
-    auto it = d->timeToUrlWatcherMap.begin();
-    while (d->urlTimeSortWatcherHash.size() > kCacheFileWatcherCount
-           && it != d->timeToUrlWatcherMap.end()) {
+    // 超出限制移除最久未使用的watcher
+    for (const auto &url : d->watcherTimeIndex.takeStale(d->watcherCapacity)) {
         if (d->cacheWorkerStoped)
             return;
-        auto url = it.value();
-        d->urlTimeSortWatcherHash.remove(url);
         WatcherCache::instance().removeCacheWatcher(url, false);
-        it = d->timeToUrlWatcherMap.erase(it);
     }
 }
 
@@ -332,9 +405,7 @@ void InfoCache::removeWatcherTimeInfo(const QList<QUrl> &urls)
     for (const auto &url : urls) {
         if (d->cacheWorkerStoped)
             return;
-        if (d->urlTimeSortWatcherHash.contains(url)) {
-            d->timeToUrlWatcherMap.remove(d->urlTimeSortWatcherHash.take(url));
-        }
+        d->watcherTimeIndex.remove(url);
     }
 }
 /*!
@@ -345,29 +416,13 @@ void InfoCache::removeWatcherTimeInfo(const QList<QUrl> &urls)
 void InfoCache::timeRemoveCache()
 {
     Q_D(InfoCache);
-    // 取出哪些url的时间超出了u
-    qint64 delCount = d->urlTimeSortHash.size() < kCacheFileinfoCount ? 0 : d->urlTimeSortHash.size() - kCacheFileinfoCount;
-    QList<QUrl> delList;
-    foreach (const auto time, d->timeToUrlMap.keys()) {
-        if (d->cacheWorkerStoped)
-            return;
-
-        if (time < QString::number(QDateTime::currentDateTime().toMSecsSinceEpoch() - kCacheRemoveTime)) {
-            delList.append(d->timeToUrlMap.value(time));
-            continue;
-        }
-
-        if (delList.size() >= delCount) {
-            break;
-        }
+    if (d->cacheWorkerStoped)
+        return;
 
-        delList.append(d->timeToUrlMap.value(time));
-    }
-    for (auto url : delList) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
-        }
-    }
+    // 取出超出容量和超时未访问的url
+    const QList<QUrl> &delList = d->infoTimeIndex.takeStale(d->infoCapacity,
+                                                           QDateTime::currentMSecsSinceEpoch() - kCacheRemoveTime);
+    d->evictionCount.fetch_add(static_cast<quint64>(delList.size()), std::memory_order_relaxed);
     // 发送异步消息 告诉移除线程创建移除线程移除，考虑是否是使用线程一直还是使用临时线程（使用临时线程）
     if (delList.size() > 0 && !d->cacheWorkerStoped)
         emit cacheRemoveCaches(delList);
@@ -375,11 +430,8 @@ void InfoCache::timeRemoveCache()
 
 void InfoCache::removeInfosTimeWorker(const QList<QUrl> urls)
 {
-    for (auto url : urls) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
-        }
-    }
+    for (const auto &url : urls)
+        d->infoTimeIndex.remove(url);
 }
 
 void InfoCache::updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool add)
@@ -456,6 +508,16 @@ FileInfoPointer InfoCacheController::getCacheInfo(const QUrl &url)
     return InfoCache::instance().getCacheInfo(url);
 }
 
+void InfoCacheController::setCacheCapacity(const int infoCount, const int watcherCount)
+{
+    InfoCache::instance().setCapacity(infoCount, watcherCount);
+}
+
+InfoCacheStatistics InfoCacheController::statistics() const
+{
+    return InfoCache::instance().statistics();
+}
+
 InfoCacheController::InfoCacheController(QObject *parent)
     : QObject(parent), thread(new QThread), worker(new CacheWorker), removeTimer(new QTimer), threadUpdate(new QThread), workerUpdate(new TimeToUpdateCache)
 {
@@ -12,11 +12,41 @@
 #include <QTimer>
 #include <QMap>
 
+#include <list>
+#include <limits>
+
 namespace dfmbase {
 enum CacheInfoStatus : uint8_t {
     kCacheMain = 0,   // 1.正常状态 插入(同时插入主和副缓存hash)， 读取主缓存hash， 删除主缓存hash
     kCacheCopy,
 };
+
+/*!
+ * \brief The UrlLruIndex class 按最近访问时间排序的url索引
+ * 每次访问把节点移到链表头部，尾部即最久未访问的条目，链表顺序同时也是时间顺序，
+ * 淘汰时只需从尾部弹出。访问时不再构造"时间-url"字符串，也不做有序map的插入删除。
+ */
+class UrlLruIndex
+{
+public:
+    void touch(const QUrl &url, qint64 msecs);
+    bool remove(const QUrl &url);
+    QList<QUrl> takeStale(int capacity, qint64 deadline = std::numeric_limits<qint64>::min());
+    void clear();
+
+    int size() const { return index.size(); }
+    bool contains(const QUrl &url) const { return index.contains(url); }
+
+private:
+    struct Node
+    {
+        QUrl url;
+        qint64 time { 0 };
+    };
+    std::list<Node> order;   // 头部最近访问
+    QHash<QUrl, std::list<Node>::iterator> index;
+};
+
 class InfoCachePrivate
 {
     friend class InfoCache;
@@ -30,13 +60,16 @@ class InfoCachePrivate
     QReadWriteLock mianLock;
     QReadWriteLock copyLock;
 
-    // 时间排序url,利用map的有序性，来处理时间到了要移除的url
-    QHash<QUrl, QString> urlTimeSortHash;
-    QMap<QString, QUrl> timeToUrlMap;
+    // 按访问时间排序的url，只在TimeToUpdateCache线程中访问
+    UrlLruIndex infoTimeIndex;
+    UrlLruIndex watcherTimeIndex;
+    std::atomic_int infoCapacity;
+    std::atomic_int watcherCapacity;
 
-    // 时间排序url,利用map的有序性，来处理时间到了要移除的url
-    QHash<QUrl, QString> urlTimeSortWatcherHash;
-    QMap<QString, QUrl> timeToUrlWatcherMap;
+    // 统计
+    std::atomic<quint64> hitCount { 0 };
+    std::atomic<quint64> missCount { 0 };
+    std::atomic<quint64> evictionCount { 0 };
     std::atomic_bool cacheWorkerStoped { false };
 
 public:
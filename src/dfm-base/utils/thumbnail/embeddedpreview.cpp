@@ -0,0 +1,266 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "embeddedpreview.h"
+
+#include <QIODevice>
+#include <QSet>
+#include <QTransform>
+#include <QtEndian>
+
+using namespace dfmbase;
+
+static constexpr int kMaxJpegSegments { 32 };
+static constexpr int kMaxIfds { 16 };
+static constexpr int kMaxIfdEntries { 512 };
+static constexpr int kMaxSubIfds { 8 };
+static constexpr qint64 kMaxPreviewBytes { 32 * 1024 * 1024 };
+
+namespace {
+enum Tag : quint16 {
+    kTagJpgFromRaw = 0x002E,   // Panasonic RW2
+    kTagCompression = 0x0103,
+    kTagStripOffsets = 0x0111,
+    kTagOrientation = 0x0112,
+    kTagStripByteCounts = 0x0117,
+    kTagSubIfds = 0x014A,
+    kTagJpegOffset = 0x0201,
+    kTagJpegLength = 0x0202
+};
+
+enum Type : quint16 {
+    kTypeShort = 3
+};
+
+class TiffReader
+{
+public:
+    TiffReader(QIODevice *device, qint64 base)
+        : device(device), base(base) { }
+
+    bool readHeader(quint32 *firstIfd)
+    {
+        const QByteArray &header = read(0, 8);
+        if (header.size() != 8)
+            return false;
+        if (header.startsWith("II"))
+            littleEndian = true;
+        else if (header.startsWith("MM"))
+            littleEndian = false;
+        else
+            return false;
+        *firstIfd = u32(header.constData() + 4);
+        return true;
+    }
+
+    QByteArray read(qint64 offset, qint64 length)
+    {
+        if (offset < 0 || length <= 0 || !device->seek(base + offset))
+            return {};
+        return device->read(length);
+    }
+
+    quint16 u16(const char *p) const
+    {
+        return littleEndian ? qFromLittleEndian<quint16>(p) : qFromBigEndian<quint16>(p);
+    }
+
+    quint32 u32(const char *p) const
+    {
+        return littleEndian ? qFromLittleEndian<quint32>(p) : qFromBigEndian<quint32>(p);
+    }
+
+    // SHORT 类型的单个值保存在值字段的前两个字节
+    quint32 value(const char *entry) const
+    {
+        return u16(entry + 2) == kTypeShort ? u16(entry + 8) : u32(entry + 8);
+    }
+
+    QIODevice *device { nullptr };
+    qint64 base { 0 };
+    bool littleEndian { true };
+};
+
+void addCandidate(EmbeddedPreview::Result *result, const TiffReader &reader, quint32 offset, quint32 length)
+{
+    if (offset == 0 || length == 0 || length > kMaxPreviewBytes)
+        return;
+
+    const qint64 absolute = reader.base + offset;
+    if (absolute + length > reader.device->size())
+        return;
+    result->candidates.append({ absolute, length });
+}
+
+void parseTiff(QIODevice *device, qint64 base, EmbeddedPreview::Result *result)
+{
+    TiffReader reader(device, base);
+    quint32 firstIfd = 0;
+    if (!reader.readHeader(&firstIfd))
+        return;
+
+    QList<quint32> pending { firstIfd };
+    QSet<quint32> visited;
+    bool isIfd0 = true;
+    while (!pending.isEmpty() && visited.size() < kMaxIfds) {
+        const quint32 ifd = pending.takeFirst();
+        if (ifd == 0 || visited.contains(ifd))
+            continue;
+        visited.insert(ifd);
+
+        const QByteArray &countData = reader.read(ifd, 2);
+        if (countData.size() != 2)
+            continue;
+        const int count = qMin<int>(reader.u16(countData.constData()), kMaxIfdEntries);
+        const QByteArray &entries = reader.read(ifd + 2, count * 12 + 4);
+        if (entries.size() < count * 12)
+            continue;
+
+        quint32 jpegOffset = 0, jpegLength = 0, stripOffset = 0, stripLength = 0, compression = 0;
+        for (int i = 0; i < count; ++i) {
+            const char *entry = entries.constData() + i * 12;
+            const quint16 tag = reader.u16(entry);
+            const quint32 valueCount = reader.u32(entry + 4);
+            switch (tag) {
+            case kTagOrientation:
+                if (isIfd0)
+                    result->orientation = static_cast<int>(reader.value(entry));
+                break;
+            case kTagJpegOffset:
+                jpegOffset = reader.value(entry);
+                break;
+            case kTagJpegLength:
+                jpegLength = reader.value(entry);
+                break;
+            case kTagCompression:
+                compression = reader.value(entry);
+                break;
+            case kTagStripOffsets:
+                if (valueCount == 1)
+                    stripOffset = reader.value(entry);
+                break;
+            case kTagStripByteCounts:
+                if (valueCount == 1)
+                    stripLength = reader.value(entry);
+                break;
+            case kTagJpgFromRaw:
+                addCandidate(result, reader, reader.u32(entry + 8), valueCount);
+                break;
+            case kTagSubIfds:
+                if (valueCount == 1) {
+                    pending.append(reader.u32(entry + 8));
+                } else {
+                    const int subCount = qMin<int>(static_cast<int>(valueCount), kMaxSubIfds);
+                    const QByteArray &offsets = reader.read(reader.u32(entry + 8), subCount * 4);
+                    for (int j = 0; j + 4 <= offsets.size(); j += 4)
+                        pending.append(reader.u32(offsets.constData() + j));
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        addCandidate(result, reader, jpegOffset, jpegLength);
+        // 压缩方式 6/7 表示条带数据本身就是 JPEG（NEF、DNG 的预览 IFD）
+        if ((compression == 6 || compression == 7) && jpegOffset == 0)
+            addCandidate(result, reader, stripOffset, stripLength);
+
+        if (entries.size() >= count * 12 + 4)
+            pending.append(reader.u32(entries.constData() + count * 12));
+        isIfd0 = false;
+    }
+}
+
+void parseJpeg(QIODevice *device, EmbeddedPreview::Result *result)
+{
+    qint64 pos = 2;   // 跳过 SOI
+    for (int i = 0; i < kMaxJpegSegments; ++i) {
+        if (!device->seek(pos))
+            return;
+        const QByteArray &marker = device->read(4);
+        if (marker.size() != 4 || static_cast<uchar>(marker.at(0)) != 0xFF)
+            return;
+
+        const uchar type = static_cast<uchar>(marker.at(1));
+        if (type == 0xDA || type == 0xD9)   // SOS/EOI 之后不再有元数据段
+            return;
+
+        const quint16 length = qFromBigEndian<quint16>(marker.constData() + 2);
+        if (length < 2)
+            return;
+
+        if (type == 0xE1 && length > 8 && device->read(6) == QByteArray("Exif\0\0", 6)) {
+            parseTiff(device, pos + 10, result);
+            return;
+        }
+        pos += 2 + length;
+    }
+}
+}   // namespace
+
+EmbeddedPreview::Container EmbeddedPreview::containerOf(const QByteArray &head)
+{
+    if (head.size() < 4)
+        return Container::kUnknown;
+
+    const auto *p = reinterpret_cast<const uchar *>(head.constData());
+    if (p[0] == 0xFF && p[1] == 0xD8 && p[2] == 0xFF)
+        return Container::kJpeg;
+
+    // 标准 TIFF 以及 RW2("IIU\0")、ORF("IIRO"/"IIRS"/"MMOR") 等变体
+    if (head.startsWith("II") && ((p[2] == 0x2A && p[3] == 0x00) || (p[2] == 'U' && p[3] == 0x00) || (p[2] == 'R' && (p[3] == 'O' || p[3] == 'S'))))
+        return Container::kTiff;
+    if (head.startsWith("MM") && ((p[2] == 0x00 && p[3] == 0x2A) || (p[2] == 'O' && p[3] == 'R')))
+        return Container::kTiff;
+
+    return Container::kUnknown;
+}
+
+EmbeddedPreview::Result EmbeddedPreview::find(QIODevice *device, Container container)
+{
+    Result result;
+    if (!device || !device->isOpen() || device->isSequential())
+        return result;
+
+    switch (container) {
+    case Container::kJpeg:
+        parseJpeg(device, &result);
+        break;
+    case Container::kTiff:
+        parseTiff(device, 0, &result);
+        break;
+    case Container::kUnknown:
+        break;
+    }
+
+    if (result.orientation < 1 || result.orientation > 8)
+        result.orientation = 1;
+    return result;
+}
+
+/*!
+ * \brief EmbeddedPreview::applyOrientation 内嵌预览不带方向信息，按原图的 EXIF Orientation 旋转
+ */
+QImage EmbeddedPreview::applyOrientation(const QImage &image, int orientation)
+{
+    switch (orientation) {
+    case 2:
+        return image.mirrored(true, false);
+    case 3:
+        return image.transformed(QTransform().rotate(180));
+    case 4:
+        return image.mirrored(false, true);
+    case 5:
+        return image.mirrored(true, false).transformed(QTransform().rotate(270));
+    case 6:
+        return image.transformed(QTransform().rotate(90));
+    case 7:
+        return image.mirrored(true, false).transformed(QTransform().rotate(90));
+    case 8:
+        return image.transformed(QTransform().rotate(270));
+    default:
+        return image;
+    }
+}
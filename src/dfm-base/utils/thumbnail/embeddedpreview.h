@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef EMBEDDEDPREVIEW_H
+#define EMBEDDEDPREVIEW_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QList>
+#include <QImage>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+namespace dfmbase {
+
+/*!
+ * \brief EmbeddedPreview 查找图片文件中内嵌的 JPEG 预览图
+ *
+ * 相机拍摄的 JPEG 在 EXIF（APP1）的 IFD1 中保存一张小缩略图，RAW 文件（CR2/NEF/ARW/DNG/ORF/RW2 等
+ * 基于 TIFF 结构的格式）在 IFD 链和 SubIFD 中保存一张或多张 JPEG 预览。只解析 TIFF 目录结构，
+ * 不解码图像数据；调用方根据需要的尺寸选择预览，避免解码全分辨率原图。
+ */
+namespace EmbeddedPreview {
+
+enum class Container : uint8_t {
+    kUnknown,
+    kJpeg,
+    kTiff   // TIFF 及基于 TIFF 的 RAW 格式
+};
+
+struct Candidate
+{
+    qint64 offset { 0 };   // 相对文件起始位置
+    qint64 length { 0 };
+};
+
+struct Result
+{
+    QList<Candidate> candidates;
+    int orientation { 1 };   // EXIF Orientation，1 表示不需要旋转
+};
+
+Container containerOf(const QByteArray &head);
+Result find(QIODevice *device, Container container);
+QImage applyOrientation(const QImage &image, int orientation);
+
+}   // namespace EmbeddedPreview
+}   // namespace dfmbase
+
+#endif   // EMBEDDEDPREVIEW_H
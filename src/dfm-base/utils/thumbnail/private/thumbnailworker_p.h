@@ -10,29 +10,49 @@
 #include <dfm-base/utils/thumbnail/thumbnailworker.h>
 #include <dfm-base/utils/thumbnail/thumbnailhelper.h>
 #include <dfm-base/mimetype/dmimedatabase.h>
+#include <dfm-base/utils/thumbnail/thumbnailpool.h>
 
 #include <QFuture>
 #include <QTimer>
+#include <QMutex>
+#include <QReadWriteLock>
 
 namespace dfmbase {
 
 class ThumbnailWorkerPrivate
 {
 public:
+    // 生成线程各自持有的上下文，DMimeDatabase 和 ThumbnailHelper 内部的缓存不是线程安全的
+    struct ThreadContext
+    {
+        ThreadContext() { thumbHelper.initSizeLimit(); }
+        DMimeDatabase mimeDb;
+        ThumbnailHelper thumbHelper;
+    };
+
+    using ThumbnailResult = std::function<void(const QString &thumbnailPath)>;
+
     explicit ThumbnailWorkerPrivate(ThumbnailWorker *qq);
-    QString createThumbnail(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    static ThreadContext &threadContext();
+    void createThumbnail(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size, const ThumbnailResult &finished);
+    bool findCreator(const QMimeType &mime, QString *key, ThumbnailWorker::ThumbnailCreator *creator);
+    void recordCreatorTime(const QString &key, qint64 msecs);
     bool checkFileStable(const QUrl &url);
+    void delayTask(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    void clearDelayCount(const QUrl &url);
     void startDelayWork();
 
     ThumbnailWorker *q { nullptr };
-    DMimeDatabase mimeDb;
     QMap<QString, ThumbnailWorker::ThumbnailCreator> creators;
-    QUrl originalUrl;
-    ThumbnailHelper thumbHelper;
+    QReadWriteLock creatorLock;
     std::atomic_bool isStoped = false;
     QTimer *delayTimer { nullptr };
+    QMutex delayLock;
     ThumbnailWorker::ThumbnailTaskMap delayTaskMap;
     QMap<QUrl, int> urlCheckCountMap;  // 用于跟踪URL的重试次数
+    mutable QMutex statLock;
+    QHash<QString, ThumbnailCreatorStatistics> creatorStats;
+    QScopedPointer<ThumbnailPool> pool;
 };
 
 }   // namespace dfmbase
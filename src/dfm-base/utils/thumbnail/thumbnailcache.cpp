@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailcache.h"
+
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+#include <dfm-base/base/configs/dconfig/global_dconf_defines.h>
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include <climits>
+#include <cstring>
+
+using namespace dfmbase;
+using namespace GlobalDConfDefines::ConfigPath;
+using namespace GlobalDConfDefines::BaseConfig;
+DFMGLOBAL_USE_NAMESPACE
+
+static constexpr char kIndexFileName[] { "thumbnail.index" };
+static constexpr char kIndexMagic[] { "DFMTHIDX" };
+static constexpr quint32 kIndexVersion { 1 };
+static constexpr int kIndexKeySize { 17 };   // md5 16 字节 + 尺寸 1 字节
+static constexpr int kMaxIndexEntries { 200000 };   // 约 5MB
+static constexpr int kIndexSaveThreshold { 512 };
+static constexpr qint64 kDefaultByteBudget { 64 * 1024 * 1024 };
+
+ThumbnailCache &ThumbnailCache::instance()
+{
+    static ThumbnailCache cache(QDir(StandardPaths::location(StandardPaths::kCachePath)).filePath(kIndexFileName));
+    return cache;
+}
+
+ThumbnailCache::ThumbnailCache(const QString &indexFilePath)
+    : indexFilePath(indexFilePath)
+{
+    const qint64 budgetMb = DConfigManager::instance()->value(kDefaultCfgPath, kThumbnailCacheSize, kDefaultByteBudget / 1024 / 1024).toLongLong();
+    setByteBudget(budgetMb * 1024 * 1024);
+}
+
+/*!
+ * \brief ThumbnailCache::image 查找已解码的缩略图，命中时提升为最近使用
+ */
+QImage ThumbnailCache::image(const QString &thumbnailPath)
+{
+    QMutexLocker lk(&imageLock);
+    const QImage *img = images.object(thumbnailPath);
+    return img ? *img : QImage();
+}
+
+void ThumbnailCache::insert(const QString &thumbnailPath, const QImage &image)
+{
+    if (thumbnailPath.isEmpty() || image.isNull())
+        return;
+
+    const qint64 cost = qMax<qint64>(1, image.sizeInBytes() / 1024);
+    QMutexLocker lk(&imageLock);
+    // 超过预算的单张图片会被 QCache 直接丢弃
+    images.insert(thumbnailPath, new QImage(image), cost);
+}
+
+void ThumbnailCache::remove(const QString &thumbnailPath)
+{
+    QMutexLocker lk(&imageLock);
+    images.remove(thumbnailPath);
+}
+
+/*!
+ * \brief ThumbnailCache::validity 根据索引判断缩略图是否仍然有效，不访问缩略图文件
+ * \param fileModify 原文件当前的修改时间（秒）
+ */
+ThumbnailCache::Validity ThumbnailCache::validity(const QByteArray &urlMd5Hex, ThumbnailSize size, qint64 fileModify)
+{
+    QMutexLocker lk(&indexLock);
+    loadIndexLocked();
+
+    auto it = index.constFind(indexKey(urlMd5Hex, size));
+    if (it == index.cend())
+        return Validity::kUnknown;
+    return it.value() == fileModify ? Validity::kValid : Validity::kOutdated;
+}
+
+void ThumbnailCache::record(const QByteArray &urlMd5Hex, ThumbnailSize size, qint64 fileModify)
+{
+    bool needSave = false;
+    {
+        QMutexLocker lk(&indexLock);
+        loadIndexLocked();
+
+        if (index.size() >= kMaxIndexEntries) {
+            // 索引只用于加速判断，满了直接清空重建
+            qCInfo(logDFMBase) << "thumbnail: index reached" << index.size() << "entries, rebuilding";
+            index.clear();
+        }
+
+        const QByteArray &key = indexKey(urlMd5Hex, size);
+        if (key.size() != kIndexKeySize)
+            return;
+        auto it = index.find(key);
+        if (it != index.end() && it.value() == fileModify)
+            return;
+
+        index.insert(key, fileModify);
+        needSave = ++dirtyCount >= kIndexSaveThreshold;
+    }
+
+    if (needSave)
+        saveIndex();
+}
+
+void ThumbnailCache::forget(const QByteArray &urlMd5Hex, ThumbnailSize size)
+{
+    QMutexLocker lk(&indexLock);
+    loadIndexLocked();
+    if (index.remove(indexKey(urlMd5Hex, size)) > 0)
+        ++dirtyCount;
+}
+
+void ThumbnailCache::setByteBudget(qint64 bytes)
+{
+    if (bytes <= 0)
+        bytes = kDefaultByteBudget;
+
+    QMutexLocker lk(&imageLock);
+    images.setMaxCost(static_cast<int>(qMin<qint64>(bytes / 1024, INT_MAX)));
+    qCInfo(logDFMBase) << "thumbnail: decoded cache budget set to" << bytes << "bytes";
+}
+
+qint64 ThumbnailCache::byteBudget() const
+{
+    QMutexLocker lk(&imageLock);
+    return static_cast<qint64>(images.maxCost()) * 1024;
+}
+
+qint64 ThumbnailCache::usedBytes() const
+{
+    QMutexLocker lk(&imageLock);
+    return static_cast<qint64>(images.totalCost()) * 1024;
+}
+
+int ThumbnailCache::indexSize() const
+{
+    QMutexLocker lk(&indexLock);
+    return index.size();
+}
+
+/*!
+ * \brief ThumbnailCache::saveIndex 将索引写入缓存目录，文件格式：
+ * magic(8) + version(4) + count(4) + count * (key(17) + mtime(8))
+ */
+bool ThumbnailCache::saveIndex()
+{
+    QHash<QByteArray, qint64> snapshot;
+    {
+        QMutexLocker lk(&indexLock);
+        if (!indexLoaded || dirtyCount == 0)
+            return true;
+        snapshot = index;
+        dirtyCount = 0;
+    }
+
+    QSaveFile file(indexFilePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "thumbnail: failed to open index file:" << indexFilePath << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.writeRawData(kIndexMagic, sizeof(kIndexMagic) - 1);
+    out << kIndexVersion << static_cast<quint32>(snapshot.size());
+    for (auto it = snapshot.cbegin(); it != snapshot.cend(); ++it) {
+        out.writeRawData(it.key().constData(), kIndexKeySize);
+        out << it.value();
+    }
+
+    if (!file.commit()) {
+        qCWarning(logDFMBase) << "thumbnail: failed to save index file:" << indexFilePath << file.errorString();
+        return false;
+    }
+
+    qCDebug(logDFMBase) << "thumbnail: saved" << snapshot.size() << "index entries to" << indexFilePath;
+    return true;
+}
+
+QByteArray ThumbnailCache::indexKey(const QByteArray &urlMd5Hex, ThumbnailSize size)
+{
+    QByteArray key = QByteArray::fromHex(urlMd5Hex);
+    key.append(static_cast<char>(size));
+    return key;
+}
+
+void ThumbnailCache::loadIndexLocked()
+{
+    if (indexLoaded)
+        return;
+    indexLoaded = true;
+
+    QFile file(indexFilePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    char magic[sizeof(kIndexMagic) - 1];
+    quint32 version = 0;
+    quint32 count = 0;
+    if (in.readRawData(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, kIndexMagic, sizeof(magic)) != 0) {
+        qCWarning(logDFMBase) << "thumbnail: ignoring invalid index file:" << indexFilePath;
+        return;
+    }
+    in >> version >> count;
+    if (version != kIndexVersion || count > static_cast<quint32>(kMaxIndexEntries)) {
+        qCWarning(logDFMBase) << "thumbnail: ignoring index file, version:" << version << "count:" << count;
+        return;
+    }
+
+    index.reserve(static_cast<int>(count));
+    char key[kIndexKeySize];
+    qint64 mtime = 0;
+    for (quint32 i = 0; i < count; ++i) {
+        if (in.readRawData(key, kIndexKeySize) != kIndexKeySize)
+            break;
+        in >> mtime;
+        if (in.status() != QDataStream::Ok)
+            break;
+        index.insert(QByteArray(key, kIndexKeySize), mtime);
+    }
+
+    qCInfo(logDFMBase) << "thumbnail: loaded" << index.size() << "index entries from" << indexFilePath;
+}
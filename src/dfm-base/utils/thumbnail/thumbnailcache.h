@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+
+namespace dfmbase {
+
+/*!
+ * \brief The ThumbnailCache class 进程内缩略图缓存
+ *
+ * 包含两部分：
+ * 1. 已解码缩略图的 LRU 缓存，按图像字节数计算开销，总量不超过 byteBudget；
+ * 2. 缩略图有效性索引，记录 url 哈希 + 尺寸对应的原文件修改时间，持久化到缓存目录下。
+ *    原文件被修改后不需要打开 PNG 读取 Thumb::MTime 就能判断缩略图已过期。
+ * 缩略图路径由 url 哈希和尺寸唯一确定，索引中不再保存路径。所有接口都是线程安全的。
+ */
+class ThumbnailCache
+{
+public:
+    enum class Validity : uint8_t {
+        kUnknown,   // 索引中没有记录，需要读取 PNG 判断
+        kValid,
+        kOutdated
+    };
+
+    static ThumbnailCache &instance();
+
+    explicit ThumbnailCache(const QString &indexFilePath);
+
+    QImage image(const QString &thumbnailPath);
+    void insert(const QString &thumbnailPath, const QImage &image);
+    void remove(const QString &thumbnailPath);
+
+    Validity validity(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 fileModify);
+    void record(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 fileModify);
+    void forget(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+
+    void setByteBudget(qint64 bytes);
+    qint64 byteBudget() const;
+    qint64 usedBytes() const;
+    int indexSize() const;
+
+    bool saveIndex();
+
+private:
+    static QByteArray indexKey(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    void loadIndexLocked();
+
+    const QString indexFilePath;
+
+    mutable QMutex imageLock;
+    QCache<QString, QImage> images;   // 开销单位为 KiB
+
+    mutable QMutex indexLock;
+    QHash<QByteArray, qint64> index;   // md5(16 字节) + 尺寸(1 字节) -> 原文件修改时间
+    bool indexLoaded { false };
+    int dirtyCount { 0 };
+};
+
+}   // namespace dfmbase
+
+#endif   // THUMBNAILCACHE_H
@@ -4,6 +4,7 @@
 
 #include "thumbnailcreators.h"
 #include "thumbnailhelper.h"
+#include "embeddedpreview.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/mimetype/dmimedatabase.h>
@@ -26,6 +27,10 @@
 #include <libheif/heif.h>
 #include <QImage>
 #include <QBuffer>
+#include <QFile>
+#include <QSet>
+
+#include <algorithm>
 
 // use original poppler api
 #include <poppler/cpp/poppler-document.h>
@@ -36,6 +41,8 @@
 #include <appimage/appimage.h>
 
 static constexpr char kFormat[] { ".png" };
+static constexpr int kSignatureSize { 16 };
+static constexpr int kPreviewProbeSize { 64 * 1024 };
 
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
@@ -56,6 +63,115 @@ DTK_GUI_NAMESPACE::DThumbnailProvider::Size providerSizeFor(ThumbnailSize size)
         return DTK_GUI_NAMESPACE::DThumbnailProvider::Large;
     }
 }
+
+struct PreviewInfo
+{
+    EmbeddedPreview::Candidate candidate;
+    QSize size;
+};
+
+/*!
+ * \brief knownImageMimeType 复用文件信息中已有的 MIME 类型
+ * 只有文件头与类型一致时才使用，扩展名被修改过的文件仍按内容检测（bug #53200）
+ */
+QString knownImageMimeType(const QString &filePath, EmbeddedPreview::Container container)
+{
+    static const QSet<QString> kTiffBasedTypes {
+        Mime::kTypeImageTiff, Mime::kTypeImageXADng,
+        "image/x-canon-cr2", "image/x-nikon-nef", "image/x-nikon-nrw",
+        "image/x-sony-arw", "image/x-sony-sr2", "image/x-sony-srf",
+        "image/x-pentax-pef", "image/x-olympus-orf", "image/x-panasonic-rw2",
+        "image/x-panasonic-raw", "image/x-samsung-srw"
+    };
+
+    if (container == EmbeddedPreview::Container::kUnknown)
+        return {};
+
+    const auto &info = InfoFactory::create<FileInfo>(QUrl::fromLocalFile(filePath));
+    if (!info)
+        return {};
+
+    const QString &mime = info->nameOf(NameInfoType::kMimeTypeName);
+    if (container == EmbeddedPreview::Container::kJpeg)
+        return mime == Mime::kTypeImageJpeg ? mime : QString();
+    return kTiffBasedTypes.contains(mime) ? mime : QString();
+}
+
+/*!
+ * \brief probeEmbeddedPreviews 读取每个内嵌预览的尺寸，只读取数据开头部分，按面积从小到大排序
+ */
+QList<PreviewInfo> probeEmbeddedPreviews(QFile *file, const EmbeddedPreview::Result &result)
+{
+    QList<PreviewInfo> previews;
+    for (const auto &candidate : result.candidates) {
+        if (!file->seek(candidate.offset))
+            continue;
+
+        QByteArray head = file->read(qMin<qint64>(candidate.length, kPreviewProbeSize));
+        if (!head.startsWith("\xFF\xD8"))
+            continue;
+
+        QBuffer buffer(&head);
+        QImageReader reader(&buffer, "jpeg");
+        QSize size = reader.size();
+        if (!size.isValid() && candidate.length > head.size()) {
+            // SOF 不在开头部分（预览中又嵌入了 EXIF），读取完整数据
+            file->seek(candidate.offset);
+            QByteArray data = file->read(candidate.length);
+            QBuffer fullBuffer(&data);
+            size = QImageReader(&fullBuffer, "jpeg").size();
+        }
+        if (size.isValid())
+            previews.append({ candidate, size });
+    }
+
+    std::sort(previews.begin(), previews.end(), [](const PreviewInfo &a, const PreviewInfo &b) {
+        return qint64(a.size.width()) * a.size.height() < qint64(b.size.width()) * b.size.height();
+    });
+    return previews;
+}
+
+/*!
+ * \brief pickEmbeddedPreview 选择长边不小于目标尺寸的最小预览
+ * EXIF 小缩略图常带黑边，宽高比与原图不一致时不使用
+ */
+const PreviewInfo *pickEmbeddedPreview(const QList<PreviewInfo> &previews, ThumbnailSize size, const QSize &imageSize)
+{
+    for (const auto &preview : previews) {
+        if (qMax(preview.size.width(), preview.size.height()) < size)
+            continue;
+
+        if (imageSize.isValid()) {
+            const qreal imageRatio = qreal(imageSize.width()) / imageSize.height();
+            const qreal previewRatio = qreal(preview.size.width()) / preview.size.height();
+            if (qAbs(imageRatio - previewRatio) > imageRatio * 0.02)
+                continue;
+        }
+        return &preview;
+    }
+    return nullptr;
+}
+
+QImage decodeEmbeddedPreview(QFile *file, const PreviewInfo &preview, ThumbnailSize size, int orientation)
+{
+    if (!file->seek(preview.candidate.offset))
+        return {};
+
+    QByteArray data = file->read(preview.candidate.length);
+    QBuffer buffer(&data);
+    QImageReader reader(&buffer, "jpeg");
+    if (preview.size.width() > size || preview.size.height() > size)
+        reader.setScaledSize(preview.size.scaled(size, size, Qt::KeepAspectRatio));
+
+    QImage image;
+    if (!reader.read(&image))
+        return {};
+    image = EmbeddedPreview::applyOrientation(image, orientation);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    image = FileUtils::convertToSRgbColorSpace(image);
+#endif
+    return image;
+}
 }   // namespace
 
 QImage decodeHeifThumbnail(const QString &filePath, int maxSize)
@@ -338,7 +454,21 @@ QImage ThumbnailCreators::imageThumbnailCreator(const QString &filePath, Thumbna
     //! QImageReader构造时不传format参数，让其自行判断
     //! fix bug #53200 QImageReader构造时不传format参数，会造成没有读取不了真实的文件 类型比如将png图标后缀修改为jpg，读取的类型不对
 
-    QString mimeType = DMimeDatabase().mimeTypeForFile(QUrl::fromLocalFile(filePath), QMimeDatabase::MatchContent).name();
+    // 相机 JPEG 和 RAW 文件先解析内嵌预览的位置，只读取 TIFF 目录，不解码图像
+    QFile file(filePath);
+    EmbeddedPreview::Container container = EmbeddedPreview::Container::kUnknown;
+    EmbeddedPreview::Result embedded;
+    QList<PreviewInfo> previews;
+    if (file.open(QIODevice::ReadOnly)) {
+        container = EmbeddedPreview::containerOf(file.peek(kSignatureSize));
+        embedded = EmbeddedPreview::find(&file, container);
+        previews = probeEmbeddedPreviews(&file, embedded);
+    }
+
+    QString mimeType = knownImageMimeType(filePath, container);
+    if (mimeType.isEmpty())
+        mimeType = DMimeDatabase().mimeTypeForFile(QUrl::fromLocalFile(filePath), QMimeDatabase::MatchContent).name();
+    const bool isSvg = mimeType == DFMGLOBAL_NAMESPACE::Mime::kTypeImageSvgXml;
 
     if (mimeType == "image/heif" || mimeType == "image/heic") {
         QImage heifImage = decodeHeifThumbnail(filePath, size);
@@ -354,21 +484,36 @@ QImage ThumbnailCreators::imageThumbnailCreator(const QString &filePath, Thumbna
 
     QImageReader reader(filePath, suffix.toLatin1());
     if (!reader.canRead()) {
+        // Qt 无法解码的 RAW 格式，使用最大的内嵌预览
+        if (!previews.isEmpty()) {
+            const QImage &preview = decodeEmbeddedPreview(&file, previews.last(), size, embedded.orientation);
+            if (!preview.isNull()) {
+                qCDebug(logDFMBase) << "thumbnail: using largest embedded preview" << previews.last().size << "for:" << filePath;
+                return preview;
+            }
+        }
         qCWarning(logDFMBase) << "thumbnail: cannot read image file:" << filePath
                               << "error:" << reader.errorString();
         return {};
     }
 
     const QSize imageSize = reader.size();
+    if (const PreviewInfo *preview = pickEmbeddedPreview(previews, size, imageSize)) {
+        const QImage &image = decodeEmbeddedPreview(&file, *preview, size, embedded.orientation);
+        if (!image.isNull()) {
+            qCDebug(logDFMBase) << "thumbnail: using embedded preview" << preview->size << "instead of" << imageSize << "for:" << filePath;
+            return image;
+        }
+    }
+
     reader.setAutoTransform(true);
     QImage image;
 
     if (imageSize.isValid()) {
-        // size 有效：优先让 QImageReader 在解码阶段按比例缩放，效率更高
+        // size 有效：优先让 QImageReader 在解码阶段按比例缩放，效率更高（JPEG 由 libjpeg 按 DCT 缩放解码）
         qCDebug(logDFMBase) << "thumbnail: image file size:" << imageSize << "for:" << filePath;
 
-        const QString &defaultMime = DMimeDatabase().mimeTypeForFile(QUrl::fromLocalFile(filePath)).name();
-        if (imageSize.width() > size || imageSize.height() > size || defaultMime == DFMGLOBAL_NAMESPACE::Mime::kTypeImageSvgXml) {
+        if (imageSize.width() > size || imageSize.height() > size || isSvg) {
             qCDebug(logDFMBase) << "thumbnail: scaling image from" << imageSize << "to fit size:" << size;
             reader.setScaledSize(imageSize.scaled(size, size, Qt::KeepAspectRatio));
         }
@@ -4,6 +4,8 @@
 
 #include "thumbnailfactory.h"
 #include "thumbnailcreators.h"
+#include "thumbnailwriter.h"
+#include "thumbnailcache.h"
 
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/utils/universalutils.h>
@@ -17,9 +19,6 @@
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
-static constexpr int kMaxCountLimit { 50 };
-static constexpr int kPushInterval { 100 };   // ms
-
 ThumbnailFactory::ThumbnailFactory(QObject *parent)
     : QObject(parent),
       thread(new QThread),
@@ -54,20 +53,16 @@ void ThumbnailFactory::init()
 {
     Q_ASSERT(qApp->thread() == QThread::currentThread());
 
-    taskPushTimer.setSingleShot(true);
-    taskPushTimer.setInterval(kPushInterval);
-    connect(&taskPushTimer, &QTimer::timeout, this, &ThumbnailFactory::pushTask);
     connect(this, &ThumbnailFactory::thumbnailJob, this, &ThumbnailFactory::doJoinThumbnailJob, Qt::QueuedConnection);
     connect(qApp, &QGuiApplication::aboutToQuit, this, &ThumbnailFactory::onAboutToQuit);
 
-    connect(this, &ThumbnailFactory::addTask, worker.data(), &ThumbnailWorker::onTaskAdded, Qt::QueuedConnection);
     connect(worker.data(), &ThumbnailWorker::thumbnailCreateFinished, this, &ThumbnailFactory::produceFinished, Qt::QueuedConnection);
     connect(worker.data(), &ThumbnailWorker::thumbnailCreateFailed, this, &ThumbnailFactory::produceFailed, Qt::QueuedConnection);
 
     worker->moveToThread(thread.data());
     thread->start();
 
-    qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initialized, worker thread started";
+    qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initialized, worker thread and generation pool started";
 }
 
 void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -80,6 +75,41 @@ void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
     doJoinThumbnailJob(url, size);
 }
 
+/*!
+ * \brief ThumbnailFactory::cancelThumbnailJobs 取消尚未开始的任务，例如已滚出视口的文件
+ * 被取消的文件会发出 produceCanceled，视图据此清除"已请求"标记，再次显示时重新请求
+ */
+void ThumbnailFactory::cancelThumbnailJobs(const QList<QUrl> &urls)
+{
+    if (urls.isEmpty())
+        return;
+
+    const auto &canceled = worker->cancelTasks(urls);
+    if (!canceled.isEmpty())
+        qCDebug(logDFMBase) << "thumbnail: canceled" << canceled.size() << "pending jobs";
+    for (const auto &url : canceled)
+        emit produceCanceled(url);
+}
+
+void ThumbnailFactory::cancelThumbnailJobsIf(const std::function<bool(const QUrl &)> &filter)
+{
+    const auto &canceled = worker->cancelTasksIf(filter);
+    if (!canceled.isEmpty())
+        qCDebug(logDFMBase) << "thumbnail: canceled" << canceled.size() << "pending jobs";
+    for (const auto &url : canceled)
+        emit produceCanceled(url);
+}
+
+int ThumbnailFactory::pendingJobCount() const
+{
+    return worker->queueDepth();
+}
+
+QHash<QString, ThumbnailCreatorStatistics> ThumbnailFactory::creatorStatistics() const
+{
+    return worker->creatorStatistics();
+}
+
 bool ThumbnailFactory::registerThumbnailCreator(const QString &mimeType, ThumbnailCreator creator)
 {
     Q_ASSERT(creator);
@@ -97,20 +127,15 @@ void ThumbnailFactory::onAboutToQuit()
     qCInfo(logDFMBase) << "thumbnail: application about to quit, stopping worker and thread";
     worker->stop();
     thread->quit();
-    bool finished = thread->wait(3000);
+    bool finished = thread->wait(3000) && worker->waitForDone(3000) && ThumbnailWriter::instance().waitForDone(3000);
     if (!finished) {
         qCWarning(logDFMBase) << "thumbnail: worker thread did not finish within 3 seconds, forcing termination";
         _exit(1);
     } else {
         qCInfo(logDFMBase) << "thumbnail: worker thread stopped gracefully";
     }
-}
 
-void ThumbnailFactory::pushTask()
-{
-    auto map = std::move(taskMap);
-    qCDebug(logDFMBase) << "thumbnail: pushing" << map.size() << "tasks to worker thread";
-    emit addTask(map);
+    ThumbnailCache::instance().saveIndex();
 }
 
 void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -120,19 +145,6 @@ void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
         return;
     }
 
-    if (taskMap.contains(url)) {
-        return;
-    }
-
-    if (taskMap.isEmpty()) {
-        taskPushTimer.start();
-    }
-
-    taskMap.insert(url, size);
-
-    if (taskMap.size() < kMaxCountLimit)
-        return;
-
-    qCDebug(logDFMBase) << "thumbnail: task queue reached limit" << kMaxCountLimit << ", pushing immediately";
-    pushTask();
+    // 直接进入生成线程池：新请求的文件（正在绘制的视口内文件）优先生成
+    worker->addTask(url, size);
 }
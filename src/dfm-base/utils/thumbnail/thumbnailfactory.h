@@ -11,7 +11,7 @@
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/interfaces/fileinfo.h>
 
-#include <QTimer>
+#include <QThread>
 
 namespace dfmbase {
 
@@ -26,18 +26,21 @@ public:
     }
 
     void joinThumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    void cancelThumbnailJobs(const QList<QUrl> &urls);
+    void cancelThumbnailJobsIf(const std::function<bool(const QUrl &)> &filter);
+    int pendingJobCount() const;
+    QHash<QString, ThumbnailCreatorStatistics> creatorStatistics() const;
     using ThumbnailCreator = std::function<QImage(const QString &, DFMGLOBAL_NAMESPACE::ThumbnailSize)>;
     bool registerThumbnailCreator(const QString &mimeType, ThumbnailCreator creator);
 
 Q_SIGNALS:
     void produceFinished(const QUrl &src, const QString &thumb);
     void produceFailed(const QUrl &src);
+    void produceCanceled(const QUrl &src);
 
-    void addTask(const ThumbnailWorker::ThumbnailTaskMap &taskMap);
     void thumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 private Q_SLOTS:
     void onAboutToQuit();
-    void pushTask();
     void doJoinThumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 
 protected:
@@ -46,10 +49,8 @@ protected:
     void init();
 
 private:
-    ThumbnailWorker::ThumbnailTaskMap taskMap;
     QSharedPointer<QThread> thread { nullptr };
     QSharedPointer<ThumbnailWorker> worker { nullptr };
-    QTimer taskPushTimer;
 };
 }   // namespace dfmbase
 
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "thumbnailhelper.h"
+#include "thumbnailcache.h"
 
 #include <dfm-base/base/standardpaths.h>
 #include <dfm-base/base/schemefactory.h>
@@ -21,8 +22,6 @@
 
 #include <sys/stat.h>
 
-#include <sys/stat.h>
-
 static constexpr qint64 kDefaultSizeLimit = 1024 * 1024 * 20;   // 20MB
 static constexpr char kFormat[] { ".png" };
 
@@ -203,7 +202,11 @@ void ThumbnailHelper::makePath(const QString &path)
     }
 }
 
-QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, ThumbnailSize size)
+/*!
+ * \brief ThumbnailHelper::saveThumbnail 异步保存缩略图
+ * \return 缩略图的目标路径，文件在 done 回调之后才可读取
+ */
+QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, ThumbnailSize size, ThumbnailWriter::Callback done)
 {
     if (img.isNull()) {
         qCWarning(logDFMBase) << "thumbnail: cannot save null image for:" << url;
@@ -217,7 +220,8 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
     }
 
     const QString &fileUrl = url.toString(QUrl::FullyEncoded);
-    const QString &thumbnailName = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit()) + kFormat;
+    const QByteArray &urlMd5 = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit());
+    const QString &thumbnailName = urlMd5 + kFormat;
     const QString &thumbnailPath = ThumbnailHelper::sizeToFilePath(size);
     const QString &thumbnailFilePath = DFMIO::DFMUtils::buildFilePath(thumbnailPath.toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
     const qint64 fileModify = info->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
@@ -226,19 +230,18 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
 
     qCDebug(logDFMBase) << "thumbnail: saving thumbnail to:" << thumbnailFilePath << "for file:" << url;
 
-    QMetaObject::invokeMethod(
-            QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify]() {
-                Q_ASSERT(QThread::currentThread() == qApp->thread());
-                QImage tmpImg = img;
-                tmpImg.setText(QT_STRINGIFY(Thumb::URL), fileUrl);
-                tmpImg.setText(QT_STRINGIFY(Thumb::MTime), QString::number(fileModify));
-                if (!tmpImg.save(thumbnailFilePath, Q_NULLPTR, 50)) {
-                    qCWarning(logDFMBase) << "thumbnail: failed to save thumbnail file:" << thumbnailFilePath << "for:" << fileUrl;
-                } else {
-                    qCDebug(logDFMBase) << "thumbnail: successfully saved thumbnail:" << thumbnailFilePath;
-                }
-            },
-            Qt::QueuedConnection);
+    // 编码和写盘在后台写入线程完成，不阻塞 GUI 线程；写入成功后直接缓存已解码的图像，界面无需再读取文件
+    ThumbnailWriter::instance().write(thumbnailFilePath, img, fileUrl, fileModify,
+                                      [img, urlMd5, size, fileModify, done = std::move(done)](bool success, const QString &filePath) {
+                                          if (success) {
+                                              QImage cached = img;
+                                              cached.setText(QT_STRINGIFY(Thumb::Path), filePath);
+                                              ThumbnailCache::instance().insert(filePath, cached);
+                                              ThumbnailCache::instance().record(urlMd5, size, fileModify);
+                                          }
+                                          if (done)
+                                              done(success, filePath);
+                                      });
 
     return thumbnailFilePath;
 }
@@ -265,36 +268,64 @@ QImage ThumbnailHelper::thumbnailImage(const QUrl &fileUrl, ThumbnailSize size)
         return img;
     }
 
-    const QString thumbnailName = dataToMd5Hex((QUrl::fromLocalFile(filePath).toString(QUrl::FullyEncoded)).toLocal8Bit()) + kFormat;
-    QString thumbnail = DFMIO::DFMUtils::buildFilePath(sizeToFilePath(size).toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
+    const QByteArray &urlMd5 = dataToMd5Hex((QUrl::fromLocalFile(filePath).toString(QUrl::FullyEncoded)).toLocal8Bit());
+    const QString thumbnail = DFMIO::DFMUtils::buildFilePath(sizeToFilePath(size).toStdString().c_str(), (urlMd5 + kFormat).toStdString().c_str(), nullptr);
+    const qint64 fileModify = fileInfo->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
+
+    // 先查索引：有效的缩略图优先使用已解码的缓存
+    auto &cache = ThumbnailCache::instance();
+    switch (cache.validity(urlMd5, size, fileModify)) {
+    case ThumbnailCache::Validity::kValid: {
+        const QImage &cached = cache.image(thumbnail);
+        if (!cached.isNull())
+            return cached;
+        break;
+    }
+    case ThumbnailCache::Validity::kOutdated:
+        // 索引可能落后于磁盘（如其它进程已重新生成缩略图），以 PNG 中的 Thumb::MTime 为准，不能直接删除
+        qCDebug(logDFMBase) << "thumbnail: indexed thumbnail may be outdated, checking:" << thumbnail;
+        break;
+    case ThumbnailCache::Validity::kUnknown:
+        break;
+    }
+
     if (!DFMIO::DFile(thumbnail).exists()) {
         qCDebug(logDFMBase) << "thumbnail: cached thumbnail not found:" << thumbnail;
+        cache.forget(urlMd5, size);
         return {};
     }
 
     QImageReader ir(thumbnail, QByteArray(kFormat).mid(1));
     if (!ir.canRead()) {
         qCWarning(logDFMBase) << "thumbnail: cannot read cached thumbnail, deleting:" << thumbnail;
-        LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        removeThumbnail(urlMd5, size, thumbnail);
         return {};
     }
     ir.setAutoDetectImageFormat(false);
 
     QImage image = ir.read();
-    const qint64 fileModify = fileInfo->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
     if (!image.isNull() && image.text(QT_STRINGIFY(Thumb::MTime)).toInt() != static_cast<int>(fileModify)) {
         qCDebug(logDFMBase) << "thumbnail: cached thumbnail is outdated, deleting:" << thumbnail;
-        LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        removeThumbnail(urlMd5, size, thumbnail);
         return {};
     }
 
     if (!image.isNull()) {
         image.setText(QT_STRINGIFY(Thumb::Path), thumbnail);
+        cache.insert(thumbnail, image);
+        cache.record(urlMd5, size, fileModify);
     }
 
     return image;
 }
 
+void ThumbnailHelper::removeThumbnail(const QByteArray &urlMd5, ThumbnailSize size, const QString &thumbnailPath)
+{
+    ThumbnailCache::instance().forget(urlMd5, size);
+    ThumbnailCache::instance().remove(thumbnailPath);
+    LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnailPath));
+}
+
 void ThumbnailHelper::setSizeLimit(const QMimeType &mime, qint64 size)
 {
     if (mime.isValid() && !sizeLimitHash.contains(mime))
@@ -9,6 +9,7 @@
 #include <dfm-base/dfm_global_defines.h>
 
 #include <dfm-base/mimetype/dmimedatabase.h>
+#include <dfm-base/utils/thumbnail/thumbnailwriter.h>
 
 #include <QUrl>
 #include <QMimeType>
@@ -27,7 +28,8 @@ public:
     void setSizeLimit(const QMimeType &mime, qint64 size);
     qint64 sizeLimit(const QMimeType &mime);
 
-    QString saveThumbnail(const QUrl &url, const QImage &img, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    QString saveThumbnail(const QUrl &url, const QImage &img, DFMGLOBAL_NAMESPACE::ThumbnailSize size,
+                          ThumbnailWriter::Callback done = nullptr);
     static QImage thumbnailImage(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 
     static const QStringList &defaultThumbnailDirs();
@@ -47,6 +49,7 @@ private:
     void initMimeTypeSupport();
     bool checkMimeTypeSupport(const QMimeType &mime);
     void makePath(const QString &path);
+    static void removeThumbnail(const QByteArray &urlMd5, DFMGLOBAL_NAMESPACE::ThumbnailSize size, const QString &thumbnailPath);
     bool evaluateStrategy(SupportCheckStrategy strategy);
 
 private:
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailpool.h"
+
+#include <QMimeDatabase>
+#include <QThread>
+
+using namespace dfmbase;
+DFMGLOBAL_USE_NAMESPACE
+
+static constexpr int kMaxImageLanes { 8 };
+static constexpr int kVideoLanes { 2 };   // ffmpeg 自身会再开解码线程
+static constexpr int kDocumentLanes { 1 };   // pdf/djvu 解析库不保证可重入
+static constexpr int kOtherLanes { 2 };
+
+ThumbnailPool::ThumbnailPool(Job job)
+    : job(std::move(job))
+{
+    const int ideal = QThread::idealThreadCount();
+    lanes[static_cast<size_t>(Lane::kImage)].limit = qBound(2, ideal / 2, kMaxImageLanes);
+    lanes[static_cast<size_t>(Lane::kVideo)].limit = kVideoLanes;
+    lanes[static_cast<size_t>(Lane::kDocument)].limit = kDocumentLanes;
+    lanes[static_cast<size_t>(Lane::kOther)].limit = kOtherLanes;
+
+    int total = 0;
+    for (const auto &lane : lanes)
+        total += lane.limit;
+    threadPool.setMaxThreadCount(total);
+
+    qCInfo(logDFMBase) << "thumbnail: pool initialized, image lanes:" << laneLimit(Lane::kImage) << "total threads:" << total;
+}
+
+ThumbnailPool::~ThumbnailPool()
+{
+    stop();
+    threadPool.waitForDone();
+}
+
+ThumbnailPool::Lane ThumbnailPool::laneOf(const QString &mimeName)
+{
+    if (mimeName == Mime::kTypeAppVRRMedia || mimeName.startsWith("video/"))
+        return Lane::kVideo;
+    if (mimeName == Mime::kTypeImageVDjvu || mimeName == Mime::kTypeImageVDMultipage)
+        return Lane::kDocument;
+    if (mimeName.startsWith("image/"))
+        return Lane::kImage;
+    if (mimeName == Mime::kTypeAppPdf || mimeName == Mime::kTypeAppPptx || mimeName == Mime::kTypeTextPlain)
+        return Lane::kDocument;
+    return Lane::kOther;
+}
+
+/*!
+ * \brief ThumbnailPool::laneOf 仅按文件名判断通道，在主线程调用，不读取文件内容
+ */
+ThumbnailPool::Lane ThumbnailPool::laneOf(const QUrl &url)
+{
+    static const QMimeDatabase db;
+    return laneOf(db.mimeTypeForFile(url.path(), QMimeDatabase::MatchExtension).name());
+}
+
+/*!
+ * \brief ThumbnailPool::enqueue 加入任务，已在队列中的任务提升为最高优先级
+ * \return 任务是新加入的返回 true；已在队列或正在执行、线程池已停止时返回 false
+ */
+bool ThumbnailPool::enqueue(const QUrl &url, ThumbnailSize size, Lane lane)
+{
+    QMutexLocker lk(&mutex);
+    if (stopped || runningTasks.contains(url))
+        return false;
+
+    const quint64 sequence = ++nextSequence;
+    auto it = pendingTasks.find(url);
+    if (it != pendingTasks.end()) {
+        auto &queue = lanes[static_cast<size_t>(it->lane)].pending;
+        queue.erase(it->sequence);
+        it->sequence = sequence;
+        it->size = size;
+        queue.emplace(sequence, url);
+        return false;
+    }
+
+    pendingTasks.insert(url, { size, lane, sequence });
+    lanes[static_cast<size_t>(lane)].pending.emplace(sequence, url);
+    dispatchLocked();
+    return true;
+}
+
+/*!
+ * \brief ThumbnailPool::cancel 取消尚未开始的任务，正在执行的任务不受影响
+ * \return 实际被取消的 url
+ */
+QList<QUrl> ThumbnailPool::cancel(const QList<QUrl> &urls)
+{
+    QList<QUrl> canceled;
+    QMutexLocker lk(&mutex);
+    for (const auto &url : urls) {
+        auto it = pendingTasks.find(url);
+        if (it == pendingTasks.end())
+            continue;
+
+        lanes[static_cast<size_t>(it->lane)].pending.erase(it->sequence);
+        pendingTasks.erase(it);
+        canceled.append(url);
+    }
+    return canceled;
+}
+
+/*!
+ * \brief ThumbnailPool::cancelIf 取消所有满足条件且尚未开始的任务，条件在锁内调用，应尽量轻量
+ */
+QList<QUrl> ThumbnailPool::cancelIf(const std::function<bool(const QUrl &)> &filter)
+{
+    QList<QUrl> canceled;
+    QMutexLocker lk(&mutex);
+    for (auto it = pendingTasks.begin(); it != pendingTasks.end();) {
+        if (!filter(it.key())) {
+            ++it;
+            continue;
+        }
+
+        lanes[static_cast<size_t>(it->lane)].pending.erase(it->sequence);
+        canceled.append(it.key());
+        it = pendingTasks.erase(it);
+    }
+    return canceled;
+}
+
+void ThumbnailPool::stop()
+{
+    QMutexLocker lk(&mutex);
+    stopped = true;
+    pendingTasks.clear();
+    for (auto &lane : lanes)
+        lane.pending.clear();
+}
+
+bool ThumbnailPool::waitForDone(int msecs)
+{
+    return threadPool.waitForDone(msecs);
+}
+
+void ThumbnailPool::setLaneLimit(Lane lane, int limit)
+{
+    if (limit <= 0 || lane == Lane::kLaneCount)
+        return;
+
+    QMutexLocker lk(&mutex);
+    auto &state = lanes[static_cast<size_t>(lane)];
+    threadPool.setMaxThreadCount(threadPool.maxThreadCount() - state.limit + limit);
+    state.limit = limit;
+    dispatchLocked();
+}
+
+int ThumbnailPool::laneLimit(Lane lane) const
+{
+    QMutexLocker lk(&mutex);
+    return lane == Lane::kLaneCount ? 0 : lanes[static_cast<size_t>(lane)].limit;
+}
+
+int ThumbnailPool::queueDepth() const
+{
+    QMutexLocker lk(&mutex);
+    return pendingTasks.size();
+}
+
+int ThumbnailPool::runningCount() const
+{
+    QMutexLocker lk(&mutex);
+    return runningTasks.size();
+}
+
+void ThumbnailPool::dispatchLocked()
+{
+    for (size_t i = 0; i < lanes.size(); ++i) {
+        auto &state = lanes[i];
+        while (!stopped && state.running < state.limit && !state.pending.empty()) {
+            auto newest = std::prev(state.pending.end());
+            const QUrl url = newest->second;
+            state.pending.erase(newest);
+
+            const Task task = pendingTasks.take(url);
+            ++state.running;
+            runningTasks.insert(url);
+            threadPool.start([this, url, task] {
+                job(url, task.size);
+                finish(task.lane, url);
+            });
+        }
+    }
+}
+
+void ThumbnailPool::finish(Lane lane, const QUrl &url)
+{
+    QMutexLocker lk(&mutex);
+    --lanes[static_cast<size_t>(lane)].running;
+    runningTasks.remove(url);
+    dispatchLocked();
+}
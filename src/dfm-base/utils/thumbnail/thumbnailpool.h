@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILPOOL_H
+#define THUMBNAILPOOL_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QUrl>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QThreadPool>
+
+#include <array>
+#include <map>
+#include <functional>
+
+namespace dfmbase {
+
+/*!
+ * \brief The ThumbnailPool class 有界的缩略图生成线程池
+ *
+ * 任务按 MIME 大类分到不同的通道，每个通道有独立的并发上限（图片通道多，视频、文档通道少），
+ * 避免少量 ffmpeg/pdf 任务占满线程。通道内最近加入（或再次请求）的任务优先执行，
+ * 视图绘制时才会请求缩略图，因此视口内的文件总是先生成；未开始的任务可以被取消。
+ */
+class ThumbnailPool
+{
+public:
+    enum class Lane : uint8_t {
+        kImage,
+        kVideo,
+        kDocument,
+        kOther,
+        kLaneCount
+    };
+
+    using Job = std::function<void(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size)>;
+
+    explicit ThumbnailPool(Job job);
+    ~ThumbnailPool();
+
+    static Lane laneOf(const QString &mimeName);
+    static Lane laneOf(const QUrl &url);
+
+    bool enqueue(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size, Lane lane);
+    QList<QUrl> cancel(const QList<QUrl> &urls);
+    QList<QUrl> cancelIf(const std::function<bool(const QUrl &)> &filter);
+    void stop();
+    bool waitForDone(int msecs = -1);
+
+    void setLaneLimit(Lane lane, int limit);
+    int laneLimit(Lane lane) const;
+    int queueDepth() const;
+    int runningCount() const;
+
+private:
+    struct Task
+    {
+        DFMGLOBAL_NAMESPACE::ThumbnailSize size;
+        Lane lane;
+        quint64 sequence;
+    };
+
+    struct LaneState
+    {
+        std::map<quint64, QUrl> pending;   // 按请求序号排序，序号越大越优先
+        int running { 0 };
+        int limit { 1 };
+    };
+
+    void dispatchLocked();
+    void finish(Lane lane, const QUrl &url);
+
+    Job job;
+    mutable QMutex mutex;
+    QHash<QUrl, Task> pendingTasks;
+    QSet<QUrl> runningTasks;
+    std::array<LaneState, static_cast<size_t>(Lane::kLaneCount)> lanes;
+    quint64 nextSequence { 0 };
+    bool stopped { false };
+    QThreadPool threadPool;
+};
+
+}   // namespace dfmbase
+
+#endif   // THUMBNAILPOOL_H
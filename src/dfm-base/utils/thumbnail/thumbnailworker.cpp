@@ -12,76 +12,69 @@
 
 #include <QtConcurrent>
 #include <QPainter>
+#include <QElapsedTimer>
 #include <QDebug>
 
 using namespace dfmbase;
 
 ThumbnailWorkerPrivate::ThumbnailWorkerPrivate(ThumbnailWorker *qq)
-    : q(qq)
+    : q(qq),
+      pool(new ThumbnailPool([qq](const QUrl &url, Global::ThumbnailSize size) { qq->createThumbnail(url, size); }))
 {
-    thumbHelper.initSizeLimit();
 }
 
-QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::ThumbnailSize size)
+ThumbnailWorkerPrivate::ThreadContext &ThumbnailWorkerPrivate::threadContext()
+{
+    thread_local ThreadContext context;
+    return context;
+}
+
+/*!
+ * \brief ThumbnailWorkerPrivate::createThumbnail 生成缩略图，缩略图文件可读取后（或失败时）调用 finished
+ */
+void ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::ThumbnailSize size, const ThumbnailResult &finished)
 {
     auto info = InfoFactory::create<FileInfo>(url);
     if (!info) {
         qCWarning(logDFMBase) << "thumbnail: failed to create FileInfo for URL:" << url;
-        return "";
+        return finished(QString());
     }
 
-    if (!thumbHelper.canGenerateThumbnail(url)) {
+    auto &context = threadContext();
+    if (!context.thumbHelper.canGenerateThumbnail(url)) {
         qCDebug(logDFMBase) << "thumbnail: file does not support thumbnail generation:" << url;
-        return "";
+        return finished(QString());
     }
 
     const auto &absoluteFilePath = info->pathOf(PathInfoType::kAbsoluteFilePath);
     // if the file is in thumb dirs, just return the file itself
-    if (thumbHelper.defaultThumbnailDirs().contains(info->pathOf(PathInfoType::kAbsolutePath))) {
+    if (context.thumbHelper.defaultThumbnailDirs().contains(info->pathOf(PathInfoType::kAbsolutePath))) {
         qCDebug(logDFMBase) << "thumbnail: file is already in thumbnail directory, returning original path:" << absoluteFilePath;
-        return absoluteFilePath;
+        return finished(absoluteFilePath);
     }
 
     QImage img;
-    const auto &mime = mimeDb.mimeTypeForUrl(url);
-    const auto &mimeName = mime.name();
-
-    if (creators.contains(mimeName)) {   // accurate match
-        qCDebug(logDFMBase) << "thumbnail: using exact mime type creator for:" << mimeName;
-        img = creators.value(mimeName)(absoluteFilePath, size);
-    } else {
-        // Try parent MIME types for inheritance support (e.g., WPS override)
-        QStringList parentTypes = mime.parentMimeTypes();
-        for (const QString &parentType : parentTypes) {
-            if (creators.contains(parentType)) {
-                qCDebug(logDFMBase) << "thumbnail: using parent mime type creator for:" << mimeName << "matched parent:" << parentType;
-                img = creators.value(parentType)(absoluteFilePath, size);
-                break;
-            }
-        }
-
-        // If no parent match, try pattern matching
-        if (img.isNull()) {
-            for (auto &mimeRegx : creators.keys()) {
-                QRegularExpression regx(mimeRegx);
-                if (mimeName.contains(regx)) {
-                    qCDebug(logDFMBase) << "thumbnail: using pattern creator for mime type:" << mimeName << "with pattern:" << mimeRegx;
-                    img = creators.value(mimeRegx)(absoluteFilePath, size);
-                    break;
-                }
-            }
-        }
+    const auto &mime = context.mimeDb.mimeTypeForUrl(url);
+    QString creatorKey;
+    ThumbnailWorker::ThumbnailCreator creator;
+    QElapsedTimer timer;
+    if (findCreator(mime, &creatorKey, &creator)) {
+        timer.start();
+        img = creator(absoluteFilePath, size);
+        recordCreatorTime(creatorKey, timer.elapsed());
     }
 
     // default image generator if cannot create by customized function
     if (img.isNull()) {
         qCDebug(logDFMBase) << "thumbnail: using default creator for:" << url;
+        timer.start();
         img = ThumbnailCreators::defaultThumbnailCreator(absoluteFilePath, size);
+        recordCreatorTime(QStringLiteral("default"), timer.elapsed());
     }
 
     if (img.isNull()) {
         qCWarning(logDFMBase) << "thumbnail: failed to generate thumbnail for file:" << url;
-        return "";
+        return finished(QString());
     }
 
     if (img.height() > size || img.width() > size) {
@@ -89,12 +82,63 @@ QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::Thumbna
         img = img.scaled({ size, size }, Qt::KeepAspectRatio);
     }
 
-    const QString thumbnailPath = thumbHelper.saveThumbnail(url, img, size);
-    if (!thumbnailPath.isEmpty()) {
-        qCInfo(logDFMBase) << "thumbnail: successfully created thumbnail for:" << url << "saved to:" << thumbnailPath;
+    // 写入在后台写入线程完成，文件落盘后再通知，避免视图读取到尚未写完的文件
+    const QString &thumbnailPath = context.thumbHelper.saveThumbnail(url, img, size, [url, finished](bool success, const QString &filePath) {
+        if (!success)
+            return finished(QString());
+        qCInfo(logDFMBase) << "thumbnail: successfully created thumbnail for:" << url << "saved to:" << filePath;
+        finished(filePath);
+    });
+    if (thumbnailPath.isEmpty())
+        finished(QString());
+}
+
+/*!
+ * \brief ThumbnailWorkerPrivate::findCreator 依次按精确类型、父类型、通配符查找生成器
+ */
+bool ThumbnailWorkerPrivate::findCreator(const QMimeType &mime, QString *key, ThumbnailWorker::ThumbnailCreator *creator)
+{
+    const auto &mimeName = mime.name();
+    QReadLocker lk(&creatorLock);
+    if (creators.contains(mimeName)) {   // accurate match
+        qCDebug(logDFMBase) << "thumbnail: using exact mime type creator for:" << mimeName;
+        *key = mimeName;
+        *creator = creators.value(mimeName);
+        return true;
+    }
+
+    // Try parent MIME types for inheritance support (e.g., WPS override)
+    const QStringList parentTypes = mime.parentMimeTypes();
+    for (const QString &parentType : parentTypes) {
+        if (creators.contains(parentType)) {
+            qCDebug(logDFMBase) << "thumbnail: using parent mime type creator for:" << mimeName << "matched parent:" << parentType;
+            *key = parentType;
+            *creator = creators.value(parentType);
+            return true;
+        }
     }
 
-    return thumbnailPath;
+    // If no parent match, try pattern matching
+    for (auto it = creators.cbegin(); it != creators.cend(); ++it) {
+        QRegularExpression regx(it.key());
+        if (mimeName.contains(regx)) {
+            qCDebug(logDFMBase) << "thumbnail: using pattern creator for mime type:" << mimeName << "with pattern:" << it.key();
+            *key = it.key();
+            *creator = it.value();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThumbnailWorkerPrivate::recordCreatorTime(const QString &key, qint64 msecs)
+{
+    QMutexLocker lk(&statLock);
+    auto &stat = creatorStats[key];
+    ++stat.count;
+    stat.totalMsecs += msecs;
+    stat.maxMsecs = qMax(stat.maxMsecs, msecs);
 }
 
 bool ThumbnailWorkerPrivate::checkFileStable(const QUrl &url)
@@ -118,6 +162,39 @@ bool ThumbnailWorkerPrivate::checkFileStable(const QUrl &url)
     return true;
 }
 
+/*!
+ * \brief ThumbnailWorkerPrivate::delayTask 文件尚未稳定，稍后重新生成，可在生成线程中调用
+ */
+void ThumbnailWorkerPrivate::delayTask(const QUrl &url, Global::ThumbnailSize size)
+{
+    {
+        QMutexLocker lk(&delayLock);
+        // Give up generation after 10 attempts
+        auto count = urlCheckCountMap.value(url, 0);
+        if (++count > 10) {
+            qCWarning(logDFMBase) << "thumbnail: giving up after 10 stability check attempts for:" << url;
+            urlCheckCountMap.remove(url);   // 清理映射表
+            return;
+        }
+
+        urlCheckCountMap[url] = count;
+        delayTaskMap.insert(url, size);
+        qCDebug(logDFMBase) << "thumbnail: file not stable, retry count:" << count << "for:" << url;
+    }
+
+    // 定时器属于工作线程
+    QMetaObject::invokeMethod(q, [this] { startDelayWork(); }, Qt::QueuedConnection);
+}
+
+void ThumbnailWorkerPrivate::clearDelayCount(const QUrl &url)
+{
+    QMutexLocker lk(&delayLock);
+    if (urlCheckCountMap.remove(url) > 0) {
+        // 文件已稳定，清理重试计数
+        qCDebug(logDFMBase) << "thumbnail: file is now stable, cleared check count for:" << url;
+    }
+}
+
 void ThumbnailWorkerPrivate::startDelayWork()
 {
     if (!delayTimer) {
@@ -125,12 +202,20 @@ void ThumbnailWorkerPrivate::startDelayWork()
         delayTimer->setInterval(2 * 1000);
         delayTimer->setSingleShot(true);
         q->connect(
-                delayTimer, &QTimer::timeout, q, [this] { q->onTaskAdded(delayTaskMap); }, Qt::QueuedConnection);
+                delayTimer, &QTimer::timeout, q, [this] {
+                    ThumbnailWorker::ThumbnailTaskMap tasks;
+                    {
+                        QMutexLocker lk(&delayLock);
+                        tasks.swap(delayTaskMap);
+                    }
+                    q->onTaskAdded(tasks);
+                },
+                Qt::QueuedConnection);
         qCDebug(logDFMBase) << "thumbnail: delay timer initialized with 2 second interval";
     }
 
     delayTimer->start();
-    qCDebug(logDFMBase) << "thumbnail: delay timer started for" << delayTaskMap.size() << "tasks";
+    qCDebug(logDFMBase) << "thumbnail: delay timer started";
 }
 
 ThumbnailWorker::ThumbnailWorker(QObject *parent)
@@ -141,12 +226,18 @@ ThumbnailWorker::ThumbnailWorker(QObject *parent)
 
 ThumbnailWorker::~ThumbnailWorker()
 {
+    // 生成任务会访问 d，必须在 d 析构前结束
+    d->isStoped = true;
+    d->pool.reset();
+    // 写入完成的回调会访问 this
+    ThumbnailWriter::instance().waitForDone();
 }
 
 bool ThumbnailWorker::registerCreator(const QString &mimeType, ThumbnailWorker::ThumbnailCreator creator)
 {
     Q_ASSERT(creator);
 
+    QWriteLocker lk(&d->creatorLock);
     if (d->creators.contains(mimeType)) {
         qCWarning(logDFMBase) << "thumbnail: failed to register creator, mime type already registered:" << mimeType;
         return false;
@@ -160,9 +251,44 @@ bool ThumbnailWorker::registerCreator(const QString &mimeType, ThumbnailWorker::
 void ThumbnailWorker::stop()
 {
     d->isStoped = true;
+    d->pool->stop();
     qCInfo(logDFMBase) << "thumbnail: ThumbnailWorker stopped";
 }
 
+bool ThumbnailWorker::waitForDone(int msecs)
+{
+    return d->pool->waitForDone(msecs);
+}
+
+void ThumbnailWorker::addTask(const QUrl &url, Global::ThumbnailSize size)
+{
+    if (d->isStoped)
+        return;
+
+    d->pool->enqueue(url, size, ThumbnailPool::laneOf(url));
+}
+
+QList<QUrl> ThumbnailWorker::cancelTasks(const QList<QUrl> &urls)
+{
+    return d->pool->cancel(urls);
+}
+
+QList<QUrl> ThumbnailWorker::cancelTasksIf(const std::function<bool(const QUrl &)> &filter)
+{
+    return d->pool->cancelIf(filter);
+}
+
+int ThumbnailWorker::queueDepth() const
+{
+    return d->pool->queueDepth();
+}
+
+QHash<QString, ThumbnailCreatorStatistics> ThumbnailWorker::creatorStatistics() const
+{
+    QMutexLocker lk(&d->statLock);
+    return d->creatorStats;
+}
+
 void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
 {
     if (d->isStoped) {
@@ -170,64 +296,44 @@ void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
         return;
     }
 
-    qCInfo(logDFMBase) << "thumbnail: processing" << taskMap.size() << "thumbnail tasks";
+    qCInfo(logDFMBase) << "thumbnail: queuing" << taskMap.size() << "thumbnail tasks";
+    for (auto iter = taskMap.cbegin(); iter != taskMap.cend(); ++iter)
+        addTask(iter.key(), iter.value());
+}
 
-    QMapIterator<QUrl, Global::ThumbnailSize> iter(taskMap);
-    while (iter.hasNext()) {
-        iter.next();
-        QUrl fileUrl = d->originalUrl = iter.key();
-        if (!d->thumbHelper.checkThumbEnable(fileUrl)) {
-            continue;
-        }
+/*!
+ * \brief ThumbnailWorker::createThumbnail 在线程池的生成线程中执行
+ */
+void ThumbnailWorker::createThumbnail(const QUrl &url, Global::ThumbnailSize size)
+{
+    if (d->isStoped)
+        return;
 
-        const auto &img = d->thumbHelper.thumbnailImage(fileUrl, iter.value());
-        if (!img.isNull()) {
-            Q_EMIT thumbnailCreateFinished(iter.key(), img.text(QT_STRINGIFY(Thumb::Path)));
-            continue;
-        }
+    if (!ThumbnailWorkerPrivate::threadContext().thumbHelper.checkThumbEnable(url))
+        return;
 
-        createThumbnail(fileUrl, iter.value());
+    const auto &img = ThumbnailHelper::thumbnailImage(url, size);
+    if (!img.isNull()) {
+        Q_EMIT thumbnailCreateFinished(url, img.text(QT_STRINGIFY(Thumb::Path)));
+        return;
     }
-}
 
-void ThumbnailWorker::createThumbnail(const QUrl &url, Global::ThumbnailSize size)
-{
     // check whether the file is stable
     // if not, rejoin the event queue and create thumbnail later
     if (!d->checkFileStable(url)) {
-        if (!d->delayTaskMap.contains(d->originalUrl)) {
-            d->urlCheckCountMap[d->originalUrl] = 1;
-            qCDebug(logDFMBase) << "thumbnail: file not stable, adding to delay queue:" << d->originalUrl;
-        } else {
-            d->delayTaskMap.remove(d->originalUrl);
-            // Give up generation after 10 attempts
-            auto count = d->urlCheckCountMap.value(d->originalUrl, 0);
-            if (++count > 10) {
-                qCWarning(logDFMBase) << "thumbnail: giving up after 10 stability check attempts for:" << d->originalUrl;
-                d->urlCheckCountMap.remove(d->originalUrl);   // 清理映射表
-                return;
-            }
-
-            d->urlCheckCountMap[d->originalUrl] = count;
-            qCDebug(logDFMBase) << "thumbnail: file still not stable, retry count:" << count << "for:" << d->originalUrl;
-        }
-
-        d->delayTaskMap.insert(d->originalUrl, size);
-        d->startDelayWork();
+        d->delayTask(url, size);
         return;
-    } else if (d->urlCheckCountMap.contains(d->originalUrl)) {
-        // 文件已稳定，清理重试计数
-        d->urlCheckCountMap.remove(d->originalUrl);
-        qCDebug(logDFMBase) << "thumbnail: file is now stable, cleared check count for:" << d->originalUrl;
     }
+    d->clearDelayCount(url);
 
     // create thumbnail
-    const auto &thumbnailPath = d->createThumbnail(url, size);
-    if (!thumbnailPath.isEmpty()) {
-        qCInfo(logDFMBase) << "thumbnail: thumbnail creation completed for:" << d->originalUrl;
-        Q_EMIT thumbnailCreateFinished(d->originalUrl, thumbnailPath);
-    } else {
-        qCWarning(logDFMBase) << "thumbnail: thumbnail creation failed for:" << d->originalUrl;
-        Q_EMIT thumbnailCreateFailed(d->originalUrl);
-    }
+    d->createThumbnail(url, size, [this, url](const QString &thumbnailPath) {
+        if (!thumbnailPath.isEmpty()) {
+            qCInfo(logDFMBase) << "thumbnail: thumbnail creation completed for:" << url;
+            Q_EMIT thumbnailCreateFinished(url, thumbnailPath);
+        } else {
+            qCWarning(logDFMBase) << "thumbnail: thumbnail creation failed for:" << url;
+            Q_EMIT thumbnailCreateFailed(url);
+        }
+    });
 }
@@ -9,15 +9,26 @@
 #include <dfm-base/dfm_global_defines.h>
 
 #include <QUrl>
+#include <QHash>
 
 #include <functional>
 
 namespace dfmbase {
 
+// 单个缩略图生成器的耗时统计
+struct ThumbnailCreatorStatistics
+{
+    quint64 count { 0 };
+    qint64 totalMsecs { 0 };
+    qint64 maxMsecs { 0 };
+};
+
 class ThumbnailWorkerPrivate;
 class ThumbnailWorker : public QObject
 {
     Q_OBJECT
+    friend class ThumbnailWorkerPrivate;
+
 public:
     using ThumbnailTaskMap = QMap<QUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize>;
 
@@ -27,6 +38,14 @@ public:
     using ThumbnailCreator = std::function<QImage(const QString &, DFMGLOBAL_NAMESPACE::ThumbnailSize)>;
     bool registerCreator(const QString &mimeType, ThumbnailCreator creator);
     void stop();
+    bool waitForDone(int msecs);
+
+    // 以下接口线程安全
+    void addTask(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    QList<QUrl> cancelTasks(const QList<QUrl> &urls);
+    QList<QUrl> cancelTasksIf(const std::function<bool(const QUrl &)> &filter);
+    int queueDepth() const;
+    QHash<QString, ThumbnailCreatorStatistics> creatorStatistics() const;
 
 public Q_SLOTS:
     void onTaskAdded(const ThumbnailTaskMap &taskMap);
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailwriter.h"
+
+#include <QTemporaryFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSet>
+
+#include <memory>
+#include <vector>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+static constexpr int kMaxBatchSize { 32 };
+static constexpr int kPngQuality { 50 };
+
+ThumbnailWriter &ThumbnailWriter::instance()
+{
+    static ThumbnailWriter writer(2);
+    return writer;
+}
+
+ThumbnailWriter::ThumbnailWriter(int threadCount)
+    : maxDrains(qMax(1, threadCount))
+{
+    threadPool.setMaxThreadCount(maxDrains);
+}
+
+ThumbnailWriter::~ThumbnailWriter()
+{
+    threadPool.waitForDone();
+}
+
+/*!
+ * \brief ThumbnailWriter::write 加入写入队列，可在任意线程调用
+ *
+ * \param filePath 缩略图目标路径
+ *
+ * \param fileUrl 原文件的 url，写入 Thumb::URL
+ *
+ * \param fileModify 原文件的修改时间（秒），写入 Thumb::MTime
+ *
+ * \param done 目标文件写入完成（或失败）后在写入线程中回调
+ */
+void ThumbnailWriter::write(const QString &filePath, const QImage &image, const QString &fileUrl, qint64 fileModify, Callback done)
+{
+    QMutexLocker lk(&mutex);
+    queue.append({ filePath, image, fileUrl, fileModify, std::move(done) });
+    if (activeDrains >= maxDrains)
+        return;
+
+    ++activeDrains;
+    threadPool.start([this] { drain(); });
+}
+
+bool ThumbnailWriter::waitForDone(int msecs)
+{
+    return threadPool.waitForDone(msecs);
+}
+
+int ThumbnailWriter::pendingCount() const
+{
+    QMutexLocker lk(&mutex);
+    return queue.size();
+}
+
+void ThumbnailWriter::drain()
+{
+    forever {
+        QList<Request> batch;
+        {
+            QMutexLocker lk(&mutex);
+            if (queue.isEmpty()) {
+                --activeDrains;
+                return;
+            }
+            batch = queue.mid(0, kMaxBatchSize);
+            queue.erase(queue.begin(), queue.begin() + batch.size());
+        }
+        writeBatch(batch);
+    }
+}
+
+void ThumbnailWriter::writeBatch(QList<Request> &batch)
+{
+    std::vector<std::unique_ptr<QTemporaryFile>> files(static_cast<size_t>(batch.size()));
+
+    // 1. 编码并写入临时文件
+    for (int i = 0; i < batch.size(); ++i) {
+        const auto &request = batch.at(i);
+        const QFileInfo target(request.filePath);
+        auto file = std::make_unique<QTemporaryFile>(target.absoluteDir().filePath("." + target.fileName() + ".XXXXXX"));
+        if (!file->open()) {
+            qCWarning(logDFMBase) << "thumbnail: failed to create temporary file for:" << request.filePath << file->errorString();
+            continue;
+        }
+
+        QImage img = request.image;
+        img.setText(QT_STRINGIFY(Thumb::URL), request.fileUrl);
+        img.setText(QT_STRINGIFY(Thumb::MTime), QString::number(request.fileModify));
+        if (!img.save(file.get(), "png", kPngQuality) || !file->flush()) {
+            qCWarning(logDFMBase) << "thumbnail: failed to save thumbnail file:" << request.filePath << "for:" << request.fileUrl;
+            continue;
+        }
+
+        // 先为整批文件发起回写，后续逐个 fdatasync 时大部分数据已在写盘中
+        ::sync_file_range(file->handle(), 0, 0, SYNC_FILE_RANGE_WRITE);
+        files[static_cast<size_t>(i)] = std::move(file);
+    }
+
+    // 2. 数据落盘后再原子替换目标文件，替换完成即可通知，读取方不会看到写了一半的文件；
+    //    掉电后目标文件要么是旧内容，要么是完整的新内容
+    QSet<QString> dirs;
+    for (int i = 0; i < batch.size(); ++i) {
+        const auto &request = batch.at(i);
+        auto &file = files[static_cast<size_t>(i)];
+        bool success = false;
+        if (file) {
+            if (::fdatasync(file->handle()) != 0) {
+                qCWarning(logDFMBase) << "thumbnail: failed to sync temporary file for:" << request.filePath << strerror(errno);
+            } else if (::rename(QFile::encodeName(file->fileName()).constData(), QFile::encodeName(request.filePath).constData()) != 0) {
+                qCWarning(logDFMBase) << "thumbnail: failed to rename temporary file to:" << request.filePath << strerror(errno);
+            } else {
+                file->setAutoRemove(false);
+                success = true;
+                dirs.insert(QFileInfo(request.filePath).absolutePath());
+                qCDebug(logDFMBase) << "thumbnail: successfully saved thumbnail:" << request.filePath;
+            }
+        }
+
+        if (request.done)
+            request.done(success, request.filePath);
+    }
+    files.clear();
+
+    // 3. 每个目录整批只 fsync 一次，持久化本批的重命名
+    for (const auto &dir : dirs) {
+        int fd = ::open(QFile::encodeName(dir).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+        if (::fsync(fd) != 0)
+            qCWarning(logDFMBase) << "thumbnail: failed to sync thumbnail directory:" << dir << strerror(errno);
+        ::close(fd);
+    }
+}
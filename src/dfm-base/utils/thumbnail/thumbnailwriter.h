@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILWRITER_H
+#define THUMBNAILWRITER_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QImage>
+#include <QMutex>
+#include <QThreadPool>
+
+#include <functional>
+
+namespace dfmbase {
+
+/*!
+ * \brief The ThumbnailWriter class 异步缩略图写入器
+ *
+ * PNG 编码和写盘在后台线程完成，不占用 GUI 线程。每个缩略图先写入同目录下的临时文件，
+ * 再原子重命名为目标文件并立即回调，其它程序读取缓存时不会看到写了一半的文件。
+ * 整批文件先统一发起回写，每个临时文件 fdatasync 后再重命名，每个目录整批只 fsync 一次。
+ * 写入时保留 freedesktop 规范要求的 Thumb::URL 和 Thumb::MTime 文本块。
+ */
+class ThumbnailWriter
+{
+public:
+    using Callback = std::function<void(bool success, const QString &filePath)>;
+
+    static ThumbnailWriter &instance();
+
+    explicit ThumbnailWriter(int threadCount = 1);
+    ~ThumbnailWriter();
+
+    void write(const QString &filePath, const QImage &image, const QString &fileUrl, qint64 fileModify, Callback done = nullptr);
+    bool waitForDone(int msecs = -1);
+    int pendingCount() const;
+
+private:
+    struct Request
+    {
+        QString filePath;
+        QImage image;
+        QString fileUrl;
+        qint64 fileModify { 0 };
+        Callback done;
+    };
+
+    void drain();
+    void writeBatch(QList<Request> &batch);
+
+    mutable QMutex mutex;
+    QList<Request> queue;
+    int activeDrains { 0 };
+    int maxDrains { 1 };
+    QThreadPool threadPool;
+};
+
+}   // namespace dfmbase
+
+#endif   // THUMBNAILWRITER_H
@@ -54,8 +54,17 @@ QVariant EventChannelFuture::result() const
  * \brief
  */
 
+EventChannel::~EventChannel()
+{
+    qDeleteAll(receivers);
+}
+
 QVariant EventChannel::send()
 {
+    const Receiver *current = receiver.load(std::memory_order_acquire);
+    if (current && current->signature == eventSignature<>())
+        return invoke(current, nullptr);
+
     return send(QVariantList());
 }
 
@@ -71,12 +80,24 @@ QVariant EventChannel::send(const QVariantList &params)
         return QVariant();
     }
 
-    if (!conn) {
+    const Receiver *current = receiver.load(std::memory_order_acquire);
+    if (!current || !current->conn) {
         qCWarning(logDPF) << "EventChannel: no connection available for send operation";
         return QVariant();
     }
 
-    return conn(params);
+    return current->conn(params);
+}
+
+QVariant EventChannel::invoke(const Receiver *current, void **argv)
+{
+    // 与 send(const QVariantList &) 相同，进程退出阶段不再调用其他插件的处理函数
+    if (Q_UNLIKELY(LifeCycle::isShuttingDown())) {
+        qCDebug(logDPF) << "EventChannel: dropping send during shutdown";
+        return QVariant();
+    }
+
+    return current->typed(argv);
 }
 
 EventChannelFuture EventChannel::asyncSend()
@@ -91,6 +112,31 @@ EventChannelFuture EventChannel::asyncSend(const QVariantList &params)
     }));
 }
 
+EventChannelManager::EventChannelManager()
+{
+}
+
+EventChannelManager::~EventChannelManager()
+{
+    for (auto &page : pages)
+        delete page.load(std::memory_order_relaxed);
+}
+
+void EventChannelManager::publish(EventType type, EventChannel *channel)
+{
+    // 调用方持有 writeMutex
+    auto &pageSlot = pages[static_cast<size_t>(type >> kPageBits)];
+    ChannelPage *page = pageSlot.load(std::memory_order_relaxed);
+    if (!page) {
+        if (!channel)
+            return;
+        page = new ChannelPage {};
+        pageSlot.store(page, std::memory_order_release);
+    }
+
+    (*page)[static_cast<size_t>(type & (kPageSize - 1))].store(channel, std::memory_order_release);
+}
+
 bool EventChannelManager::disconnect(const QString &space, const QString &topic)
 {
     Q_ASSERT(topic.startsWith(kSlotStrategePrefix));
@@ -99,9 +145,13 @@ bool EventChannelManager::disconnect(const QString &space, const QString &topic)
 
 bool EventChannelManager::disconnect(const EventType &type)
 {
-    QWriteLocker guard(&rwLock);
-    if (channelMap.contains(type))
-        return channelMap.remove(type) > 0;
+    if (!isValidEventType(type))
+        return false;
+
+    QMutexLocker guard(&writeMutex);
+    if (!find(type))
+        return false;
 
-    return false;
+    publish(type, nullptr);
+    return true;
 }
@@ -14,6 +14,8 @@ function(dfm_setup_fileoperations_dependencies target_name)
     find_package(Qt6 REQUIRED COMPONENTS Core DBus)
     find_package(PkgConfig REQUIRED)
     pkg_check_modules(zlib REQUIRED zlib IMPORTED_TARGET)
+    pkg_check_modules(liburing QUIET liburing IMPORTED_TARGET)
+    pkg_check_modules(libxxhash QUIET libxxhash IMPORTED_TARGET)
     
     # Apply default plugin configuration first
     dfm_apply_default_plugin_config(${target_name})
@@ -24,6 +26,19 @@ function(dfm_setup_fileoperations_dependencies target_name)
         Qt6::DBus
         PkgConfig::zlib
     )
+
+    # io_uring copy engine is optional, copies fall back to read/write without it
+    if(liburing_FOUND)
+        target_link_libraries(${target_name} PRIVATE PkgConfig::liburing)
+        target_compile_definitions(${target_name} PRIVATE DFM_ENABLE_IO_URING)
+        message(STATUS "DFM: io_uring copy engine enabled")
+    endif()
+
+    # xxh3 integrity checksum is optional, crc32c is used without it
+    if(libxxhash_FOUND)
+        target_link_libraries(${target_name} PRIVATE PkgConfig::libxxhash)
+        target_compile_definitions(${target_name} PRIVATE DFM_ENABLE_XXHASH)
+    endif()
     
     # Configure config.h if needed
     if(EXISTS "${DFM_APP_SOURCE_DIR}/config.h.in")
@@ -198,4 +198,5 @@ void DoCopyFilesWorker::onUpdateProgress()
     const qint64 writeSize = getWriteDataSize();
     emitProgressChangedNotify(writeSize);
     emitSpeedUpdatedNotify(writeSize);
+    tuneChunkSize(writeSize);
 }
@@ -263,7 +263,8 @@ bool AbstractWorker::statisticsFilesSize()
 
     if (isSourceFileLocal) {
         const QString &fsType = DFMIO::DFMUtils::fsTypeFromUrl(firstUrl);
-        isSourceFileLocal = fsType.startsWith("ext");
+        // reflink filesystems take the local path too, so clones can run in the thread pool
+        isSourceFileLocal = fsType.startsWith("ext") || FileOperationsUtils::isReflinkFileSystem(fsType);
     }
 
     // Set workData flags for use in DoCopyFileWorker
@@ -325,6 +326,8 @@ bool AbstractWorker::initArgs()
     completeTargetFiles.clear();
     completeCustomInfos.clear();
     bigFileSize = FileOperationsUtils::bigFileSize();
+    workData->ioUringCopy = FileOperationsUtils::ioUringCopy();
+    workData->integrityAlgorithm = FileChecksum::algorithmFromName(FileOperationsUtils::integrityHash());
 
     return true;
 }
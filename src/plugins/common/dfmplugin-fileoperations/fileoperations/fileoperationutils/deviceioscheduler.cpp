@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "deviceioscheduler.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+namespace {
+
+constexpr int kMaxStackDepth { 8 };   // dm on md on partition is already deep
+constexpr int kMaxSolidStateThreads { 8 };
+constexpr quint32 kRotationalChunkSize { 4 * 1024 * 1024 };
+
+int readSysfsInt(const QString &path, bool *ok)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *ok = false;
+        return 0;
+    }
+    return file.readAll().trimmed().toInt(ok);
+}
+
+}   // namespace
+
+DeviceIoScheduler *DeviceIoScheduler::instance()
+{
+    static DeviceIoScheduler ins;
+    return &ins;
+}
+
+/*!
+ * \brief DeviceIoScheduler::profile Cached profile of the physical disk behind a device node
+ * \param deviceNode block device, e.g. /dev/sda1 or /dev/mapper/luks-xxx
+ * \return profile, with an empty disk name if the device is not a local block device
+ */
+DeviceIoScheduler::DeviceProfile DeviceIoScheduler::profile(const QString &deviceNode)
+{
+    const QString &disk = physicalDisk(deviceNode);
+    if (disk.isEmpty())
+        return {};
+
+    QMutexLocker locker(&mutex);
+    auto it = profiles.find(disk);
+    if (it == profiles.end()) {
+        it = profiles.insert(disk, readProfile(QStringLiteral("/sys/block/") + disk));
+        fmInfo() << "Copy device profile - disk:" << disk << "rotational:" << it->rotational
+                 << "queue depth:" << it->queueDepth << "max threads:" << it->maxThreads;
+    }
+    return it.value();
+}
+
+/*!
+ * \brief DeviceIoScheduler::acquire Reserve copy threads on the source and target disks
+ * The per-disk limit holds across jobs. When other jobs already hold the whole budget of
+ * one of the disks the job still gets one thread instead of waiting, so it makes progress
+ * at the lowest concurrency rather than sitting at 0% until the other jobs finish.
+ * \param sourceDevice block device of the source files
+ * \param targetDevice block device of the target directory
+ * \param wantedThreads threads the job would like to use
+ * \return reservation to hand back with release(), threads is 0 if neither disk is known
+ */
+DeviceIoScheduler::Reservation DeviceIoScheduler::acquire(const QString &sourceDevice, const QString &targetDevice,
+                                                          int wantedThreads)
+{
+    Reservation reservation;
+    QList<DeviceProfile> known;
+    for (const QString &node : { sourceDevice, targetDevice }) {
+        const DeviceProfile &info = profile(node);
+        if (!info.disk.isEmpty() && !reservation.disks.contains(info.disk)) {
+            reservation.disks.append(info.disk);
+            known.append(info);
+        }
+    }
+    if (known.isEmpty())
+        return reservation;
+
+    QMutexLocker locker(&mutex);
+    int threads = qMax(1, wantedThreads);
+    quint32 chunkSize = 0;
+    for (const auto &info : known) {
+        threads = qMin(threads, info.maxThreads - usedThreads.value(info.disk));
+        chunkSize = qMax(chunkSize, profiles.value(info.disk).chunkSize);
+    }
+    if (threads <= 0) {
+        fmInfo() << "Copy threads of disks" << reservation.disks << "are all in use, copying with one thread";
+        threads = 1;
+    }
+
+    reservation.threads = threads;
+    reservation.chunkSize = chunkSize;
+    for (const auto &disk : reservation.disks)
+        usedThreads[disk] += reservation.threads;
+
+    fmInfo() << "Copy threads reserved - disks:" << reservation.disks << "threads:" << reservation.threads
+             << "chunk size:" << reservation.chunkSize;
+    return reservation;
+}
+
+void DeviceIoScheduler::release(const Reservation &reservation)
+{
+    if (reservation.disks.isEmpty() || reservation.threads <= 0)
+        return;
+
+    QMutexLocker locker(&mutex);
+    for (const auto &disk : reservation.disks) {
+        auto it = usedThreads.find(disk);
+        if (it == usedThreads.end())
+            continue;
+        it.value() -= reservation.threads;
+        if (it.value() <= 0)
+            usedThreads.erase(it);
+    }
+}
+
+/*!
+ * \brief DeviceIoScheduler::recordThroughput Derive the chunk size from a measured throughput
+ * The result is remembered for the reserved disks, so the next job starts with it.
+ * \param reservation reservation of the measuring job
+ * \param bytesPerSecond measured write throughput
+ * \return chunk size the job should use from now on
+ */
+quint32 DeviceIoScheduler::recordThroughput(const Reservation &reservation, qint64 bytesPerSecond)
+{
+    const quint32 chunkSize = chunkSizeForThroughput(bytesPerSecond);
+
+    QMutexLocker locker(&mutex);
+    for (const auto &disk : reservation.disks) {
+        auto it = profiles.find(disk);
+        if (it != profiles.end())
+            it->chunkSize = chunkSize;
+    }
+    return chunkSize;
+}
+
+/*!
+ * \brief DeviceIoScheduler::physicalDisk Resolve partitions and stacked devices to the disk below them
+ * \param deviceNode block device node
+ * \return disk name in /sys/block, empty if it can not be resolved
+ */
+QString DeviceIoScheduler::physicalDisk(const QString &deviceNode)
+{
+    const QString &node = QFileInfo(deviceNode).canonicalFilePath();
+    if (!node.startsWith(QStringLiteral("/dev/")))
+        return {};
+
+    QString name = QFileInfo(node).fileName();
+    for (int depth = 0; depth < kMaxStackDepth; ++depth) {
+        const QString &sysPath = QStringLiteral("/sys/class/block/") + name;
+        if (!QFileInfo::exists(sysPath))
+            return {};
+
+        // a partition directory sits inside the directory of its disk
+        if (QFileInfo::exists(sysPath + QStringLiteral("/partition"))) {
+            name = QFileInfo(QFileInfo(sysPath + QStringLiteral("/..")).canonicalFilePath()).fileName();
+            continue;
+        }
+
+        // device mapper (LUKS, LVM) and md devices: follow the first slave
+        const QStringList &slaves = QDir(sysPath + QStringLiteral("/slaves")).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        if (!slaves.isEmpty()) {
+            name = slaves.first();
+            continue;
+        }
+        return name;
+    }
+    return {};
+}
+
+/*!
+ * \brief DeviceIoScheduler::readProfile Build a disk profile from its sysfs directory
+ * \param sysBlockDir e.g. /sys/block/sda
+ * \return profile, with an empty disk name if the queue attributes are missing
+ */
+DeviceIoScheduler::DeviceProfile DeviceIoScheduler::readProfile(const QString &sysBlockDir)
+{
+    DeviceProfile info;
+    bool ok = false;
+    const int rotational = readSysfsInt(sysBlockDir + QStringLiteral("/queue/rotational"), &ok);
+    if (!ok)
+        return info;
+
+    info.disk = QFileInfo(sysBlockDir).fileName();
+    info.rotational = rotational == 1;
+    info.queueDepth = readSysfsInt(sysBlockDir + QStringLiteral("/queue/nr_requests"), &ok);
+    if (!ok)
+        info.queueDepth = 0;
+
+    if (info.rotational) {
+        // more than one stream makes the heads seek between files
+        info.maxThreads = 1;
+        info.chunkSize = kRotationalChunkSize;
+    } else {
+        const int cpuLimit = qMax(2, QThread::idealThreadCount());
+        info.maxThreads = qBound(2, info.queueDepth / 16, qMin(kMaxSolidStateThreads, cpuLimit));
+        info.chunkSize = kDefaultChunkSize;
+    }
+    return info;
+}
+
+/*!
+ * \brief DeviceIoScheduler::chunkSizeForThroughput About 1/16 s of data per request
+ * \param bytesPerSecond measured throughput
+ * \return power of two between kMinChunkSize and kMaxChunkSize
+ */
+quint32 DeviceIoScheduler::chunkSizeForThroughput(qint64 bytesPerSecond)
+{
+    const qint64 target = bytesPerSecond / 16;
+    quint32 chunkSize = kMinChunkSize;
+    while (chunkSize < kMaxChunkSize && static_cast<qint64>(chunkSize) * 2 <= target)
+        chunkSize *= 2;
+    return chunkSize;
+}
+
+DPFILEOPERATIONS_END_NAMESPACE
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICEIOSCHEDULER_H
+#define DEVICEIOSCHEDULER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/**
+ * 按物理磁盘分配拷贝并发数与读写块大小
+ *
+ * 磁盘画像来自 sysfs（queue/rotational、queue/nr_requests），分区、dm-crypt、LVM
+ * 都归到底层物理磁盘上。机械盘只允许一个拷贝线程并使用大块顺序读写，SSD/NVMe 按队列深度
+ * 放开线程数。线程预算按磁盘在所有任务之间共享，而不是每个任务各自计算；预算用完时
+ * 新任务不排队，只分到一个线程降低并发继续拷贝，避免任务停在 0% 像是卡死。
+ * 任务开始几秒后的实测吞吐用于调整块大小，并记录到磁盘画像中供后续任务使用。
+ */
+class DeviceIoScheduler
+{
+    Q_DISABLE_COPY(DeviceIoScheduler)
+
+public:
+    static constexpr quint32 kDefaultChunkSize { 1024 * 1024 };
+    static constexpr quint32 kMinChunkSize { 256 * 1024 };
+    static constexpr quint32 kMaxChunkSize { 8 * 1024 * 1024 };
+
+    struct DeviceProfile
+    {
+        QString disk;   // 物理磁盘名（/sys/block 下），为空表示无法识别
+        bool rotational { false };
+        int queueDepth { 0 };
+        int maxThreads { 0 };   // 该磁盘在所有任务间允许的拷贝线程总数
+        quint32 chunkSize { kDefaultChunkSize };
+    };
+
+    struct Reservation
+    {
+        QStringList disks;   // 占用了线程预算的磁盘
+        int threads { 0 };   // 0 表示磁盘未知，由调用方沿用原有策略
+        quint32 chunkSize { kDefaultChunkSize };
+    };
+
+    static DeviceIoScheduler *instance();
+
+    DeviceProfile profile(const QString &deviceNode);
+    Reservation acquire(const QString &sourceDevice, const QString &targetDevice, int wantedThreads);
+    void release(const Reservation &reservation);
+    quint32 recordThroughput(const Reservation &reservation, qint64 bytesPerSecond);
+
+    static QString physicalDisk(const QString &deviceNode);
+    static DeviceProfile readProfile(const QString &sysBlockDir);
+    static quint32 chunkSizeForThroughput(qint64 bytesPerSecond);
+
+private:
+    DeviceIoScheduler() = default;
+
+    QMutex mutex;
+    QHash<QString, DeviceProfile> profiles;
+    QHash<QString, int> usedThreads;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // DEVICEIOSCHEDULER_H
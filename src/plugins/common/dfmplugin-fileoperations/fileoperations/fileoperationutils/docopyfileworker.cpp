@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "docopyfileworker.h"
+#include "sparsefilemap.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/device/deviceutils.h>
@@ -18,13 +19,17 @@
 #include <QWaitCondition>
 #include <QMutex>
 #include <QThread>
+#include <QElapsedTimer>
 
 #include <fcntl.h>
-#include <zlib.h>
+#include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <linux/fs.h>
 
 static const quint32 kMaxBufferLength { 1024 * 1024 * 1 };
+static const int kIoUringQueueDepth { 8 };
 
 DPFILEOPERATIONS_USE_NAMESPACE
 USING_IO_NAMESPACE
@@ -78,10 +83,89 @@ void DoCopyFileWorker::operateAction(const AbstractJobHandler::SupportAction act
 }
 void DoCopyFileWorker::doFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo)
 {
-    doDfmioFileCopy(fromInfo, toInfo, nullptr);
+    const NextDo nextDo = workData->reflinkCopy ? doCloneFile(fromInfo, toInfo) : NextDo::kDoCopyFallback;
+    if (nextDo == NextDo::kDoCopyErrorAddCancel)
+        return;
+    if (nextDo == NextDo::kDoCopyFallback)
+        doDfmioFileCopy(fromInfo, toInfo, nullptr);
     workData->completeFileCount++;
 }
 
+/*!
+ * \brief DoCopyFileWorker::doCloneFile Clone a local regular file instead of copying its data
+ * \param fromInfo File information of source file
+ * \param toInfo File information of target file
+ * \return kDoCopyNext if cloned, kDoCopyErrorAddCancel if the job was stopped,
+ * kDoCopyFallback if the file was not cloned and needs the normal copy path
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::doCloneFile(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo)
+{
+    if (!stateCheck())
+        return NextDo::kDoCopyErrorAddCancel;
+
+    const QByteArray &fromPath = fromInfo->uri().path().toLocal8Bit();
+    const QByteArray &toPath = toInfo->uri().path().toLocal8Bit();
+
+    int srcFd = open(fromPath.constData(), O_RDONLY | O_CLOEXEC);
+    if (srcFd < 0)
+        return NextDo::kDoCopyFallback;
+    FinallyUtil releaseSc([&] {
+        close(srcFd);
+    });
+
+    struct stat st;
+    if (fstat(srcFd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+        return NextDo::kDoCopyFallback;
+
+    emit currentTask(fromInfo->uri(), toInfo->uri());
+    const QUrl &targetUrl = toInfo->uri();
+    FileUtils::cacheCopyingFileUrl(targetUrl);
+    FinallyUtil releaseCache([&] {
+        FileUtils::removeCopyingFileUrl(targetUrl);
+    });
+
+    int dstFd = open(toPath.constData(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0666);
+    if (dstFd < 0)
+        return NextDo::kDoCopyFallback;
+    FinallyUtil releaseTg([&] {
+        close(dstFd);
+    });
+
+    if (!cloneFileBySys(srcFd, dstFd))
+        return isStopped() ? NextDo::kDoCopyErrorAddCancel : NextDo::kDoCopyFallback;
+
+    workData->currentWriteSize += st.st_size;
+    setTargetPermissions(fromInfo->uri(), toInfo->uri());
+    FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, targetUrl);
+    return NextDo::kDoCopyNext;
+}
+
+/*!
+ * \brief DoCopyFileWorker::doSmallFilesCopy Copy a batch of small files
+ * All files share one buffer, one current task notification and the source stat is
+ * reused for target permissions and times. A file that can not be copied by the plain
+ * read/write path is handed to doDfmioFileCopy, which owns the error handling.
+ * \param files source and target infos of the batch
+ */
+void DoCopyFileWorker::doSmallFilesCopy(const QList<CopyFilePair> &files)
+{
+    if (files.isEmpty() || isStopped())
+        return;
+
+    emit currentTask(files.first().first->uri(), files.first().second->uri());
+
+    const bool setPermission = DeviceUtils::supportSetPermissionsDevice(files.first().second->uri());
+    QScopedArrayPointer<char> buffer(new char[kMaxBufferLength]);
+    for (const auto &file : files) {
+        if (!stateCheck())
+            return;
+
+        if (!copySmallFileBySys(file.first, file.second, buffer.data(), kMaxBufferLength, setPermission))
+            doDfmioFileCopy(file.first, file.second, nullptr);
+        workData->completeFileCount++;
+    }
+}
+
 bool DoCopyFileWorker::doDfmioFileCopy(const DFileInfoPointer fromInfo,
                                        const DFileInfoPointer toInfo, bool *skip)
 {
@@ -218,10 +302,22 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
     if (useDirectMode) {
         // Use new O_DIRECT implementation for safe sync mode
         return doCopyFileWithDirectIO(fromInfo, toInfo, skip);
-    } else {
-        // Use traditional DFMIO implementation for other cases
-        return doCopyFileTraditional(fromInfo, toInfo, skip);
     }
+
+    // Keep the device queue busy with io_uring when the kernel supports it,
+    // gvfs and other remote mounts may not accept out-of-order writes
+    const bool canUseIoUring = workData->ioUringCopy && IoUringCopier::isSupported()
+            && fromInfo->uri().isLocalFile() && toInfo->uri().isLocalFile()
+            && !ProtocolUtils::isRemoteFile(fromInfo->uri()) && !ProtocolUtils::isRemoteFile(toInfo->uri());
+    if (canUseIoUring) {
+        auto nextDo = doCopyFileByIoUring(fromInfo, toInfo, skip);
+        if (nextDo != NextDo::kDoCopyFallback)
+            return nextDo;
+        fmDebug() << "io_uring copy fallback to traditional copy - file:" << fromInfo->uri();
+    }
+
+    // Use traditional DFMIO implementation for other cases
+    return doCopyFileTraditional(fromInfo, toInfo, skip);
 }
 
 /*!
@@ -261,7 +357,7 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileWithDirectIO(const DFileInf
     }
 
     // Get optimal chunk size and ensure alignment
-    qint64 baseChunkSize = 1024 * 1024;   // 1M
+    qint64 baseChunkSize = workData->copyChunkSize;
     qint64 chunkSize = ((baseChunkSize + writer.alignment - 1) / writer.alignment) * writer.alignment;
 
     // Allocate aligned buffer
@@ -279,6 +375,12 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileWithDirectIO(const DFileInf
     qint64 copied = 0;
     bool directModeActive = (writer.mode == WriteMode::Direct);
     bool success = true;
+    const bool integrityChecking = workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking);
+    FileChecksum sourceChecksum(workData->integrityAlgorithm);
+    SparseFileMap sparseMap(sourcePath, fromSize);
+    qint64 dataEnd = 0;
+    QElapsedTimer copyTimer;
+    copyTimer.start();
 
     while (copied < fromSize && !isStopped()) {
         // Handle pause/resume
@@ -300,7 +402,28 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileWithDirectIO(const DFileInf
             break;
         }
 
-        qint64 remaining = fromSize - copied;
+        if (copied >= dataEnd) {
+            // O_DIRECT offsets must stay aligned, the partial blocks around a hole are copied as data
+            qint64 dataStart = sparseMap.nextData(copied, &dataEnd);
+            dataStart = qMax(copied, dataStart / static_cast<qint64>(writer.alignment) * static_cast<qint64>(writer.alignment));
+            dataEnd = qMin(fromSize, (dataEnd + static_cast<qint64>(writer.alignment) - 1) / static_cast<qint64>(writer.alignment) * static_cast<qint64>(writer.alignment));
+            if (dataStart > copied) {
+                if (lseek(srcFd, dataStart, SEEK_SET) < 0 || lseek(writer.fd, dataStart, SEEK_SET) < 0) {
+                    fmWarning() << "Failed to seek over hole - file:" << sourcePath << "error:" << strerror(errno);
+                    success = false;
+                    break;
+                }
+                // the hole is left unallocated in the target but counts as copied
+                if (integrityChecking)
+                    sourceChecksum.updateZeros(dataStart - copied);
+                workData->currentWriteSize += dataStart - copied;
+                copied = dataStart;
+                if (copied >= fromSize)
+                    break;
+            }
+        }
+
+        qint64 remaining = dataEnd - copied;
         qint64 toRead = qMin(chunkSize, remaining);
 
         // For O_DIRECT, ensure read size is aligned (except for the very last read)
@@ -398,10 +521,18 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileWithDirectIO(const DFileInf
             break;
         }
 
+        if (integrityChecking)
+            sourceChecksum.update(buffer, actualBytesToWrite);
         copied += actualBytesToWrite;
         workData->currentWriteSize += actualBytesToWrite;
     }
 
+    // a trailing hole is not written, give the target its full size
+    if (success && sparseMap.isSparse() && ftruncate(writer.fd, fromSize) != 0) {
+        fmWarning() << "Failed to extend sparse target file - file:" << destPath << "error:" << strerror(errno);
+        success = false;
+    }
+
     // Cleanup
     free(buffer);
     close(srcFd);
@@ -418,12 +549,111 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileWithDirectIO(const DFileInf
     if (!stateCheck())
         return NextDo::kDoCopyErrorAddCancel;
 
+    if (integrityChecking) {
+        logThroughput("copy", toInfo->uri(), copied, copyTimer.elapsed());
+        QSharedPointer<DFMIO::DFile> noDevice;
+        if (!verifyFileIntegrity(chunkSize, sourceChecksum, fromInfo, toInfo, noDevice))
+            return NextDo::kDoCopyErrorAddCancel;
+    }
+
     toInfo->refresh();
     FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
 
     return NextDo::kDoCopyNext;
 }
 
+/*!
+ * \brief DoCopyFileWorker::doCopyFileByIoUring Copy file through io_uring with several blocks in flight
+ * Pause is honoured between completions through stateCheck(), errors go through the usual
+ * retry/skip/cancel dialog and a retry restarts from the last contiguous written offset.
+ * \param fromInfo Source file info
+ * \param toInfo Target file info
+ * \param skip Skip flag
+ * \return NextDo status, kDoCopyFallback if the file must be copied by another method
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByIoUring(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
+{
+    // integrity checking needs the data in user space, leave it to the traditional copy
+    if (workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))
+        return NextDo::kDoCopyFallback;
+
+    if (!ioUringCopier)
+        ioUringCopier.reset(new IoUringCopier);
+    // 块大小可能已按实测吞吐调整，每个文件都重新读取，变化时 init 会重新分配缓冲区
+    if (!ioUringCopier->init(kIoUringQueueDepth, workData->copyChunkSize))
+        return NextDo::kDoCopyFallback;
+
+    int sourceFd = openFileBySys(fromInfo, toInfo, O_RDONLY, skip);
+    if (sourceFd < 0)
+        return NextDo::kDoCopyErrorAddCancel;
+    FinallyUtil releaseSc([&] {
+        close(sourceFd);
+    });
+
+    // the traditional copy skips the holes of sparse files
+    const auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    if (SparseFileMap(sourceFd, fromSize).isSparse())
+        return NextDo::kDoCopyFallback;
+
+    int targetFd = openFileBySys(fromInfo, toInfo, O_CREAT | O_WRONLY | O_TRUNC, skip, false);
+    if (targetFd < 0)
+        return NextDo::kDoCopyErrorAddCancel;
+    FinallyUtil releaseTg([&] {
+        close(targetFd);
+    });
+
+    if (fromSize <= 0) {
+        setTargetPermissions(fromInfo->uri(), toInfo->uri());
+        workData->zeroOrlinkOrDirWriteSize += FileUtils::getMemoryPageSize();
+        FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+        return NextDo::kDoCopyNext;
+    }
+
+    auto progress = [this](qint64 delta) {
+        workData->currentWriteSize += delta;
+        return stateCheck();
+    };
+
+    qint64 offset = 0;
+    AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
+    do {
+        action = AbstractJobHandler::SupportAction::kNoAction;
+        if (Q_UNLIKELY(!stateCheck()))
+            return NextDo::kDoCopyErrorAddCancel;
+
+        const auto result = ioUringCopier->copy(sourceFd, targetFd, offset, fromSize - offset, progress);
+        offset = result.copiedOffset;
+        if (result.canceled)
+            return NextDo::kDoCopyErrorAddCancel;
+        if (result.error == 0)
+            break;
+
+        // Nothing was written yet and the files do not accept io_uring requests
+        if (offset == 0 && (result.error == EINVAL || result.error == EOPNOTSUPP || result.error == EBADF)) {
+            fmWarning() << "io_uring copy fallback needed - error:" << strerror(result.error);
+            return NextDo::kDoCopyFallback;
+        }
+
+        const QString lastError = QString::fromLocal8Bit(strerror(result.error));
+        fmWarning() << "io_uring copy error - from:" << fromInfo->uri() << "to:" << toInfo->uri()
+                    << "offset:" << offset << "error:" << lastError;
+        action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(),
+                                      mapSystemErrorToJobError(result.error, result.isWriteError),
+                                      result.isWriteError, lastError);
+    } while (action == AbstractJobHandler::SupportAction::kRetryAction && !isStopped());
+    checkRetry();
+    if (!actionOperating(action, fromSize - offset, skip))
+        return NextDo::kDoCopyErrorAddCancel;
+
+    setTargetPermissions(fromInfo->uri(), toInfo->uri());
+    if (!stateCheck())
+        return NextDo::kDoCopyErrorAddCancel;
+
+    toInfo->refresh();
+    FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+    return NextDo::kDoCopyNext;
+}
+
 /*!
  * \brief DoCopyFileWorker::doCopyFileTraditional Traditional copy implementation using DFMIO
  * \param fromInfo Source file info
@@ -449,13 +679,44 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileTraditional(const DFileInfo
         return NextDo::kDoCopyErrorAddCancel;
 
     // 循环读取和写入文件，拷贝
-    qint64 blockSize = fromSize > kMaxBufferLength ? kMaxBufferLength : fromSize;
+    const qint64 chunkSize = workData->copyChunkSize;
+    qint64 blockSize = fromSize > chunkSize ? chunkSize : fromSize;
     char *data = new char[static_cast<uint>(blockSize + 1)];
-    uLong sourceCheckSum = adler32(0L, nullptr, 0);
+    const bool integrityChecking = workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking);
+    FileChecksum sourceChecksum(workData->integrityAlgorithm);
     qint64 sizeRead = 0;
+    QElapsedTimer copyTimer;
+    copyTimer.start();
+
+    // holes of local sparse files are skipped by seeking both devices, remote targets
+    // may not accept writes past their end
+    const bool sparseCopy = fromInfo->uri().isLocalFile() && toInfo->uri().isLocalFile()
+            && !ProtocolUtils::isRemoteFile(toInfo->uri());
+    SparseFileMap sparseMap(sparseCopy ? fromInfo->uri().path() : QString(), fromSize);
+    qint64 dataEnd = 0;
 
     do {
-        auto nextReadDo = doReadFile(fromInfo, toInfo, fromDevice, data, blockSize, sizeRead, skip);
+        const qint64 pos = fromDevice->pos();
+        if (pos >= dataEnd) {
+            const qint64 dataStart = sparseMap.nextData(pos, &dataEnd);
+            if (dataStart > pos) {
+                if (toDevice->seek(dataStart) && fromDevice->seek(dataStart)) {
+                    if (integrityChecking)
+                        sourceChecksum.updateZeros(dataStart - pos);
+                    workData->currentWriteSize += dataStart - pos;
+                    if (dataStart == fromSize)
+                        break;
+                } else {
+                    fmWarning() << "Seek over hole failed, copying it as data - file:" << fromInfo->uri();
+                    toDevice->seek(pos);
+                    fromDevice->seek(pos);
+                    dataEnd = fromSize;
+                }
+            }
+        }
+        const qint64 readBlockSize = qMin(blockSize, dataEnd - fromDevice->pos());
+
+        auto nextReadDo = doReadFile(fromInfo, toInfo, fromDevice, data, readBlockSize, sizeRead, skip);
         if (nextReadDo != NextDo::kDoCopyCurrentFile) {
             delete[] data;
             return nextReadDo;
@@ -466,13 +727,24 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileTraditional(const DFileInfo
             return nextDo;
         }
 
-        if (Q_LIKELY(workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))) {
-            sourceCheckSum = adler32(sourceCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(sizeRead));
-        }
+        if (integrityChecking)
+            sourceChecksum.update(data, sizeRead);
 
     } while (fromDevice->pos() != fromSize);
 
     delete[] data;
+    if (integrityChecking)
+        logThroughput("copy", toInfo->uri(), fromSize, copyTimer.elapsed());
+
+    // a trailing hole is not written, give the target its full size
+    if (sparseMap.isSparse() && truncate(toInfo->uri().path().toLocal8Bit().constData(), fromSize) != 0) {
+        const QString lastError = QString::fromLocal8Bit(strerror(errno));
+        fmWarning() << "Failed to extend sparse target file - file:" << toInfo->uri() << "error:" << lastError;
+        auto action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(),
+                                           AbstractJobHandler::JobErrorType::kResizeError, true, lastError);
+        if (!actionOperating(action, 0, skip))
+            return NextDo::kDoCopyErrorAddCancel;
+    }
 
     // 对文件加权
     setTargetPermissions(fromInfo->uri(), toInfo->uri());
@@ -481,7 +753,7 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileTraditional(const DFileInfo
 
     // 校验文件完整性
     if (skip)
-        *skip = verifyFileIntegrity(blockSize, sourceCheckSum, fromInfo, toInfo, toDevice);
+        *skip = verifyFileIntegrity(blockSize, sourceChecksum, fromInfo, toInfo, toDevice);
     toInfo->refresh();
 
     if (skip && *skip)
@@ -541,12 +813,22 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
         FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
         return NextDo::kDoCopyNext;
     }
+    // 同一文件系统支持 reflink 时直接共享数据块，失败再逐块拷贝
+    if (cloneFileBySys(sourcFd, targetFd)) {
+        workData->currentWriteSize += fromSize;
+        setTargetPermissions(fromInfo->uri(), toInfo->uri());
+        return stateCheck() ? NextDo::kDoCopyNext : NextDo::kDoCopyErrorAddCancel;
+    }
     // 循环读取和写入文件，拷贝
-    size_t blockSize = static_cast<size_t>(fromSize > kMaxBufferLength ? kMaxBufferLength : fromSize);
+    const qint64 chunkSize = workData->copyChunkSize;
+    size_t blockSize = static_cast<size_t>(fromSize > chunkSize ? chunkSize : fromSize);
     off_t offset_in = 0;
     off_t offset_out = 0;
     size_t total = static_cast<size_t>(fromSize);
     ssize_t result = -1;
+    // copy_file_range uses explicit offsets, so the map may share the source fd
+    SparseFileMap sparseMap(sourcFd, fromSize);
+    qint64 dataEnd = 0;
     AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
     do {
         if (Q_UNLIKELY(!stateCheck()))
@@ -554,8 +836,18 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
         do {
             if (Q_UNLIKELY(!stateCheck()))
                 return NextDo::kDoCopyErrorAddCancel;
+            if (offset_in >= dataEnd) {
+                // 空洞不写入目标文件，但计入已拷贝大小
+                const qint64 dataStart = sparseMap.nextData(offset_in, &dataEnd);
+                workData->currentWriteSize += dataStart - offset_in;
+                total -= static_cast<size_t>(dataStart - offset_in);
+                offset_in = offset_out = dataStart;
+                if (offset_out == fromSize)
+                    break;
+            }
             blockSize = total < blockSize ? total : blockSize;
-            result = copy_file_range(sourcFd, &offset_in, targetFd, &offset_out, blockSize, 0);
+            const size_t copySize = qMin(blockSize, static_cast<size_t>(dataEnd - offset_in));
+            result = copy_file_range(sourcFd, &offset_in, targetFd, &offset_out, copySize, 0);
             if (result < 0) {
                 // Check if this is a "should fallback" error vs a real error
                 if (shouldFallbackFromCopyFileRange(errno)) {
@@ -581,6 +873,15 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
         if (!actionOperating(action, fromSize - offset_out, skip))
             return NextDo::kDoCopyErrorAddCancel;
     } while (offset_out != fromSize);
+    // 末尾的空洞没有写入，补齐目标文件大小
+    if (sparseMap.isSparse() && ftruncate(targetFd, fromSize) != 0) {
+        auto lastError = strerror(errno);
+        fmWarning() << "Failed to extend sparse target file - file:" << toInfo->uri() << "error:" << lastError;
+        action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(),
+                                      AbstractJobHandler::JobErrorType::kResizeError, true, lastError);
+        if (!actionOperating(action, 0, skip))
+            return NextDo::kDoCopyErrorAddCancel;
+    }
     // 对文件加权
     setTargetPermissions(fromInfo->uri(), toInfo->uri());
     if (!stateCheck())
@@ -999,52 +1300,57 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doWriteFileErrorRetry(const DFileInfo
     return NextDo::kDoCopyReDoCurrentFile;
 }
 
-bool DoCopyFileWorker::verifyFileIntegrity(const qint64 &blockSize, const ulong &sourceCheckSum,
+/*!
+ * \brief DoCopyFileWorker::verifyFileIntegrity Compare the checksum computed while copying with the target content
+ * Local targets are read back once with O_DIRECT (or with the page cache dropped), so the
+ * comparison sees what reached the device and the read-back does not evict useful cache.
+ * \param blockSize read block size
+ * \param sourceChecksum checksum of the source data computed during the copy
+ * \param fromInfo File information of source file
+ * \param toInfo File information of target file
+ * \param toDevice target device, used for targets that are not local files
+ * \return true if the target is correct or the user chose to skip the error
+ */
+bool DoCopyFileWorker::verifyFileIntegrity(const qint64 &blockSize, const FileChecksum &sourceChecksum,
                                            const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
                                            QSharedPointer<DFMIO::DFile> &toDevice)
 {
     if (!workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))
         return true;
-    char *data = new char[static_cast<uint>(blockSize + 1)];
+
     QElapsedTimer t;
-    ulong targetCheckSum = adler32(0L, nullptr, 0);
+    t.start();
+    FileChecksum targetChecksum(sourceChecksum.algorithm());
+    const bool isLocal = toInfo->uri().isLocalFile() || !toDevice;
     Q_FOREVER {
-        qint64 size = toDevice->read(data, blockSize);
-
-        if (Q_UNLIKELY(size <= 0)) {
-            if (size == 0 && toInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong() == toDevice->pos()) {
-                break;
-            }
-
-            fmWarning() << "Integrity check read failed - size:" << size << "pos:" << toDevice->pos() << "file:" << toInfo->uri() << "error:" << toDevice->lastError().errorMsg();
-            AbstractJobHandler::SupportAction actionForCheckRead = doHandleErrorAndWait(fromInfo->uri(),
-                                                                                        toInfo->uri(),
-                                                                                        AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
-                                                                                        true,
-                                                                                        toDevice->lastError().errorMsg());
-            if (!isStopped() && AbstractJobHandler::SupportAction::kRetryAction == actionForCheckRead) {
-                continue;
-            } else {
-                checkRetry();
-                return actionForCheckRead == AbstractJobHandler::SupportAction::kSkipAction;
-            }
-        }
+        QString errorMsg;
+        targetChecksum.reset();
+        const bool ok = isLocal ? readBackLocalChecksum(toInfo->uri().path(), blockSize, targetChecksum, &errorMsg)
+                                : readBackDeviceChecksum(toInfo, toDevice, blockSize, targetChecksum, &errorMsg);
+        if (Q_UNLIKELY(!stateCheck()))
+            return false;
+        if (ok)
+            break;
 
-        targetCheckSum = adler32(targetCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(size));
+        fmWarning() << "Integrity check read failed - file:" << toInfo->uri() << "error:" << errorMsg;
+        AbstractJobHandler::SupportAction actionForCheckRead = doHandleErrorAndWait(fromInfo->uri(),
+                                                                                    toInfo->uri(),
+                                                                                    AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
+                                                                                    true,
+                                                                                    errorMsg);
+        if (!isStopped() && AbstractJobHandler::SupportAction::kRetryAction == actionForCheckRead)
+            continue;
 
-        if (Q_UNLIKELY(!stateCheck())) {
-            delete[] data;
-            data = nullptr;
-            return false;
-        }
+        checkRetry();
+        return actionForCheckRead == AbstractJobHandler::SupportAction::kSkipAction;
     }
-    delete[] data;
 
-    fmDebug("Time spent of integrity check of the file: %d", t.elapsed());
+    logThroughput("verify", toInfo->uri(), toInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong(), t.elapsed());
 
-    if (sourceCheckSum != targetCheckSum) {
-        fmWarning("Integrity check failed - source checksum: 0x%lx, target checksum: 0x%lx, file: %s",
-                  sourceCheckSum, targetCheckSum, qPrintable(toInfo->uri().toString()));
+    if (sourceChecksum.value() != targetChecksum.value()) {
+        fmWarning("Integrity check failed - %s source checksum: 0x%llx, target checksum: 0x%llx, file: %s",
+                  qPrintable(FileChecksum::algorithmName(sourceChecksum.algorithm())),
+                  sourceChecksum.value(), targetChecksum.value(), qPrintable(toInfo->uri().toString()));
         AbstractJobHandler::SupportAction actionForCheck = doHandleErrorAndWait(fromInfo->uri(),
                                                                                 toInfo->uri(),
                                                                                 AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
@@ -1055,6 +1361,218 @@ bool DoCopyFileWorker::verifyFileIntegrity(const qint64 &blockSize, const ulong
     return true;
 }
 
+/*!
+ * \brief DoCopyFileWorker::readBackLocalChecksum Read a local target file once, bypassing the page cache
+ * \param path target file path
+ * \param blockSize read block size
+ * \param checksum checksum to update
+ * \param errorMsg Output parameter: error message
+ * \return true if the whole file was read
+ */
+bool DoCopyFileWorker::readBackLocalChecksum(const QString &path, const qint64 blockSize,
+                                             FileChecksum &checksum, QString *errorMsg)
+{
+    const QByteArray &localPath = path.toLocal8Bit();
+    int fd = open(localPath.constData(), O_RDONLY | O_DIRECT);
+    bool direct = fd >= 0;
+    if (!direct)
+        fd = open(localPath.constData(), O_RDONLY);
+    if (fd < 0) {
+        *errorMsg = QString::fromLocal8Bit(strerror(errno));
+        return false;
+    }
+    FinallyUtil releaseFd([&] {
+        // do not leave the verified data in the page cache
+        if (!direct)
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    });
+
+    auto dropCache = [fd] {
+        // written pages must reach the device before they can be dropped and read back
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    };
+    if (!direct)
+        dropCache();
+
+    const size_t kAlignment = 4096;
+    const size_t size = ((static_cast<size_t>(qMax<qint64>(blockSize, 1)) + kAlignment - 1) / kAlignment) * kAlignment;
+    char *buffer = allocateAlignedBuffer(size, kAlignment);
+    if (!buffer) {
+        *errorMsg = QStringLiteral("Failed to allocate aligned buffer");
+        return false;
+    }
+    FinallyUtil releaseBuffer([&] {
+        free(buffer);
+    });
+
+    Q_FOREVER {
+        ssize_t readSize = read(fd, buffer, size);
+        if (readSize < 0 && errno == EINTR)
+            continue;
+        if (readSize < 0 && errno == EINVAL && direct) {
+            // filesystem refuses O_DIRECT, continue with a cache-dropped buffered read
+            const int flags = fcntl(fd, F_GETFL);
+            if (flags == -1 || fcntl(fd, F_SETFL, flags & ~O_DIRECT) != 0) {
+                *errorMsg = QString::fromLocal8Bit(strerror(errno));
+                return false;
+            }
+            direct = false;
+            dropCache();
+            continue;
+        }
+        if (readSize < 0) {
+            *errorMsg = QString::fromLocal8Bit(strerror(errno));
+            return false;
+        }
+        if (readSize == 0)
+            return true;
+        checksum.update(buffer, readSize);
+        if (Q_UNLIKELY(isStopped()))
+            return false;
+    }
+}
+
+/*!
+ * \brief DoCopyFileWorker::readBackDeviceChecksum Read a non-local target through its dfmio device
+ * \param toInfo File information of target file
+ * \param toDevice target device
+ * \param blockSize read block size
+ * \param checksum checksum to update
+ * \param errorMsg Output parameter: error message
+ * \return true if the whole file was read
+ */
+bool DoCopyFileWorker::readBackDeviceChecksum(const DFileInfoPointer &toInfo, const QSharedPointer<DFMIO::DFile> &toDevice,
+                                              const qint64 blockSize, FileChecksum &checksum, QString *errorMsg)
+{
+    QScopedArrayPointer<char> data(new char[static_cast<uint>(blockSize + 1)]);
+    Q_FOREVER {
+        qint64 size = toDevice->read(data.data(), blockSize);
+        if (Q_UNLIKELY(size <= 0)) {
+            if (size == 0 && toInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong() == toDevice->pos())
+                return true;
+            *errorMsg = toDevice->lastError().errorMsg();
+            return false;
+        }
+        checksum.update(data.data(), size);
+        if (Q_UNLIKELY(isStopped()))
+            return false;
+    }
+}
+
+void DoCopyFileWorker::logThroughput(const char *phase, const QUrl &url, const qint64 size, const qint64 elapsedMs)
+{
+    const double seconds = qMax<qint64>(elapsedMs, 1) / 1000.0;
+    fmInfo("Integrity %s phase - file: %s, size: %lld, time: %lld ms, throughput: %.1f MB/s",
+           phase, qPrintable(url.toString()), size, elapsedMs, size / seconds / (1024 * 1024));
+}
+
+/*!
+ * \brief DoCopyFileWorker::copySmallFileBySys Copy one small regular file with read/write
+ * \param fromInfo File information of source file
+ * \param toInfo File information of target file
+ * \param buffer shared copy buffer
+ * \param bufferSize size of the shared buffer
+ * \param setPermission whether the target device supports permissions
+ * \return false if the file was not copied and needs the full copy path
+ */
+bool DoCopyFileWorker::copySmallFileBySys(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
+                                          char *buffer, const qint64 bufferSize, const bool setPermission)
+{
+    const QByteArray &fromPath = fromInfo->uri().path().toLocal8Bit();
+    const QByteArray &toPath = toInfo->uri().path().toLocal8Bit();
+
+    int srcFd = open(fromPath.constData(), O_RDONLY | O_CLOEXEC);
+    if (srcFd < 0)
+        return false;
+    FinallyUtil releaseSc([&] {
+        close(srcFd);
+    });
+
+    struct stat st;
+    if (fstat(srcFd, &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    int dstFd = open(toPath.constData(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0666);
+    if (dstFd < 0)
+        return false;
+    FinallyUtil releaseTg([&] {
+        close(dstFd);
+    });
+
+    const bool cloned = st.st_size > 0 && cloneFileBySys(srcFd, dstFd);
+    qint64 copied = cloned ? st.st_size : 0;
+    while (!cloned) {
+        ssize_t readSize = read(srcFd, buffer, static_cast<size_t>(bufferSize));
+        if (readSize < 0 && errno == EINTR)
+            continue;
+        if (readSize < 0)
+            return false;
+        if (readSize == 0)
+            break;
+
+        ssize_t written = 0;
+        while (written < readSize) {
+            ssize_t ret = write(dstFd, buffer + written, static_cast<size_t>(readSize - written));
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                return false;
+            written += ret;
+        }
+        copied += readSize;
+    }
+
+    if (setPermission) {
+        const struct timespec times[2] { st.st_atim, st.st_mtim };
+        if (futimens(dstFd, times) != 0)
+            fmWarning() << "Failed to set file time - file:" << toInfo->uri() << "error:" << strerror(errno);
+        // 权限为0000时，源文件已经被删除，无需修改新建的文件的权限为0000
+        const mode_t mode = st.st_mode & 07777;
+        if (mode != 0 && fchmod(dstFd, mode) != 0)
+            fmWarning() << "Failed to set permissions - file:" << toInfo->uri()
+                        << "permissions:" << QString::number(mode, 8) << "error:" << strerror(errno);
+    }
+
+    if (copied <= 0)
+        workData->zeroOrlinkOrDirWriteSize += FileUtils::getMemoryPageSize();
+    else
+        workData->currentWriteSize += copied;
+    return true;
+}
+
+/*!
+ * \brief DoCopyFileWorker::cloneFileBySys Share the source extents with the target (FICLONE)
+ * A filesystem without reflink support turns cloning off for the rest of the job,
+ * other failures such as EXDEV between btrfs subvolumes only affect this file.
+ * \param sourceFd source file descriptor
+ * \param targetFd target file descriptor opened for writing
+ * \return true if the whole file was cloned
+ */
+bool DoCopyFileWorker::cloneFileBySys(const int sourceFd, const int targetFd)
+{
+    if (!workData->reflinkCopy)
+        return false;
+
+    if (ioctl(targetFd, FICLONE, sourceFd) == 0)
+        return true;
+
+    const int error = errno;
+    switch (error) {
+    case EOPNOTSUPP:
+    case ENOTTY:
+    case ENOSYS:
+        if (workData->reflinkCopy.exchange(false))
+            fmInfo() << "Reflink is not supported by the filesystem, copying data instead - error:" << strerror(error);
+        break;
+    default:
+        fmDebug() << "Reflink clone failed, copying data instead - error:" << strerror(error);
+        break;
+    }
+    return false;
+}
+
 void DoCopyFileWorker::checkRetry()
 {
     if (!workData->singleThread && retry && !isStopped()) {
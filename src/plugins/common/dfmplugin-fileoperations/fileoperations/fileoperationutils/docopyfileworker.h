@@ -7,6 +7,7 @@
 
 #include "dfmplugin_fileoperations_global.h"
 #include "workerdata.h"
+#include "iouringcopier.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/interfaces/abstractjobhandler.h>
@@ -43,6 +44,8 @@ public:
         kDoCopyFallback,   // copy_file_range失败，需要fallback到其他方法
     };
 
+    using CopyFilePair = QPair<DFileInfoPointer, DFileInfoPointer>;   // source info, target info
+
     struct ProgressData
     {
         QUrl copyFile;
@@ -81,11 +84,18 @@ public:
     // Traditional DFMIO copy
     [[nodiscard]] NextDo doCopyFileTraditional(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                                                bool *skip);
+    // io_uring copy with several reads and writes in flight
+    [[nodiscard]] NextDo doCopyFileByIoUring(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
+                                             bool *skip);
     // normal copy
     [[nodiscard]] NextDo doCopyFileByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                                            bool *skip);
     // small file copy
     void doFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo);
+    // clone a file on a reflink capable filesystem
+    [[nodiscard]] NextDo doCloneFile(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo);
+    // copy a batch of small files with one buffer and one notification
+    void doSmallFilesCopy(const QList<CopyFilePair> &files);
     // copy file by dfmio
     bool doDfmioFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip);
 signals:
@@ -132,9 +142,16 @@ private:   // file copy
                                  const qint64 currentPos,
                                  const qint64 &surplusSize, qint64 &curWrite);
     void setTargetPermissions(const QUrl &fromUrl, const QUrl &toUrl);
-    bool verifyFileIntegrity(const qint64 &blockSize, const ulong &sourceCheckSum,
+    bool verifyFileIntegrity(const qint64 &blockSize, const FileChecksum &sourceChecksum,
                              const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
                              QSharedPointer<DFMIO::DFile> &toFile);
+    bool readBackLocalChecksum(const QString &path, const qint64 blockSize, FileChecksum &checksum, QString *errorMsg);
+    bool readBackDeviceChecksum(const DFileInfoPointer &toInfo, const QSharedPointer<DFMIO::DFile> &toDevice,
+                                const qint64 blockSize, FileChecksum &checksum, QString *errorMsg);
+    void logThroughput(const char *phase, const QUrl &url, const qint64 size, const qint64 elapsedMs);
+    bool copySmallFileBySys(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
+                            char *buffer, const qint64 bufferSize, const bool setPermission);
+    bool cloneFileBySys(const int sourceFd, const int targetFd);
     void checkRetry();
     bool isStopped();
     int openFileBySys(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
@@ -163,6 +180,7 @@ private:
     int blockFileFd { -1 };
     QList<QUrl> skipUrls;
     DThreadList<QSharedPointer<dfmio::DOperator>> fileOps;
+    QScopedPointer<IoUringCopier> ioUringCopier;   // lazily created, reused by every file of this worker
 };
 DPFILEOPERATIONS_END_NAMESPACE
 #endif   // DOCOPYFILEWORKER_H
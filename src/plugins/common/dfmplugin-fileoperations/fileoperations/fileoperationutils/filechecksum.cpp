@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "filechecksum.h"
+
+#include <QByteArray>
+
+#include <zlib.h>
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#    include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#    include <arm_acle.h>
+#endif
+
+#ifdef DFM_ENABLE_XXHASH
+#    include <xxhash.h>
+#endif
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+namespace {
+
+constexpr quint32 kCrc32cPolynomial { 0x82F63B78 };   // Castagnoli, reflected
+
+std::array<quint32, 256> makeCrc32cTable()
+{
+    std::array<quint32, 256> table {};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ kCrc32cPolynomial : crc >> 1;
+        table[i] = crc;
+    }
+    return table;
+}
+
+quint32 crc32cSoftware(quint32 crc, const uchar *data, size_t size)
+{
+    static const std::array<quint32, 256> kTable = makeCrc32cTable();
+    for (size_t i = 0; i < size; ++i)
+        crc = kTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) quint32 crc32cHardware(quint32 crc, const uchar *data, size_t size)
+{
+    quint64 crc64 = crc;
+    while (size >= sizeof(quint64)) {
+        quint64 word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+    crc = static_cast<quint32>(crc64);
+    while (size--)
+        crc = _mm_crc32_u8(crc, *data++);
+    return crc;
+}
+
+bool hasCrc32cHardware()
+{
+    static const bool kSupported = __builtin_cpu_supports("sse4.2");
+    return kSupported;
+}
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+quint32 crc32cHardware(quint32 crc, const uchar *data, size_t size)
+{
+    while (size >= sizeof(quint64)) {
+        quint64 word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32cd(crc, word);
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+    while (size--)
+        crc = __crc32cb(crc, *data++);
+    return crc;
+}
+
+bool hasCrc32cHardware()
+{
+    return true;
+}
+#else
+quint32 crc32cHardware(quint32 crc, const uchar *data, size_t size)
+{
+    return crc32cSoftware(crc, data, size);
+}
+
+bool hasCrc32cHardware()
+{
+    return false;
+}
+#endif
+
+quint32 crc32cUpdate(quint32 crc, const char *data, qint64 size)
+{
+    const auto bytes = reinterpret_cast<const uchar *>(data);
+    crc = ~crc;
+    crc = hasCrc32cHardware() ? crc32cHardware(crc, bytes, static_cast<size_t>(size))
+                              : crc32cSoftware(crc, bytes, static_cast<size_t>(size));
+    return ~crc;
+}
+
+}   // namespace
+
+FileChecksum::FileChecksum(Algorithm algorithm)
+    : algo(isAvailable(algorithm) ? algorithm : Algorithm::kCrc32c)
+{
+#ifdef DFM_ENABLE_XXHASH
+    if (algo == Algorithm::kXxh3)
+        xxhState = XXH3_createState();
+#endif
+    reset();
+}
+
+FileChecksum::~FileChecksum()
+{
+#ifdef DFM_ENABLE_XXHASH
+    if (xxhState)
+        XXH3_freeState(static_cast<XXH3_state_t *>(xxhState));
+#endif
+}
+
+FileChecksum::Algorithm FileChecksum::algorithmFromName(const QString &name)
+{
+    const QString &lower = name.trimmed().toLower();
+    if (lower == QStringLiteral("crc32c"))
+        return Algorithm::kCrc32c;
+    if (lower == QStringLiteral("xxh3"))
+        return Algorithm::kXxh3;
+    return Algorithm::kAdler32;
+}
+
+QString FileChecksum::algorithmName(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::kCrc32c:
+        return QStringLiteral("crc32c");
+    case Algorithm::kXxh3:
+        return QStringLiteral("xxh3");
+    default:
+        return QStringLiteral("adler32");
+    }
+}
+
+bool FileChecksum::isAvailable(Algorithm algorithm)
+{
+#ifdef DFM_ENABLE_XXHASH
+    Q_UNUSED(algorithm)
+    return true;
+#else
+    return algorithm != Algorithm::kXxh3;
+#endif
+}
+
+void FileChecksum::reset()
+{
+    switch (algo) {
+    case Algorithm::kAdler32:
+        state = adler32(0L, nullptr, 0);
+        break;
+    case Algorithm::kCrc32c:
+        state = 0;
+        break;
+    case Algorithm::kXxh3:
+#ifdef DFM_ENABLE_XXHASH
+        XXH3_64bits_reset(static_cast<XXH3_state_t *>(xxhState));
+#endif
+        break;
+    }
+}
+
+void FileChecksum::update(const char *data, qint64 size)
+{
+    if (size <= 0)
+        return;
+
+    switch (algo) {
+    case Algorithm::kAdler32:
+        state = adler32(static_cast<uLong>(state), reinterpret_cast<const Bytef *>(data), static_cast<uInt>(size));
+        break;
+    case Algorithm::kCrc32c:
+        state = crc32cUpdate(static_cast<quint32>(state), data, size);
+        break;
+    case Algorithm::kXxh3:
+#ifdef DFM_ENABLE_XXHASH
+        XXH3_64bits_update(static_cast<XXH3_state_t *>(xxhState), data, static_cast<size_t>(size));
+#endif
+        break;
+    }
+}
+
+void FileChecksum::updateZeros(qint64 size)
+{
+    static const QByteArray kZeros(64 * 1024, '\0');
+    while (size > 0) {
+        const qint64 chunk = qMin<qint64>(size, kZeros.size());
+        update(kZeros.constData(), chunk);
+        size -= chunk;
+    }
+}
+
+quint64 FileChecksum::value() const
+{
+#ifdef DFM_ENABLE_XXHASH
+    if (algo == Algorithm::kXxh3)
+        return XXH3_64bits_digest(static_cast<XXH3_state_t *>(xxhState));
+#endif
+    return state;
+}
+
+DPFILEOPERATIONS_END_NAMESPACE
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILECHECKSUM_H
+#define FILECHECKSUM_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QString>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/**
+ * 拷贝完整性校验使用的流式校验和
+ *
+ * 源文件的校验和在拷贝过程中随数据块增量计算，目标文件只需回读一次。
+ * kCrc32c 在支持 SSE4.2/ARMv8 CRC 指令的 CPU 上使用硬件指令；
+ * kXxh3 需要构建时找到 libxxhash，否则回退到 kCrc32c。
+ */
+class FileChecksum
+{
+    Q_DISABLE_COPY(FileChecksum)
+
+public:
+    enum class Algorithm : quint8 {
+        kAdler32,
+        kCrc32c,
+        kXxh3,
+    };
+
+    explicit FileChecksum(Algorithm algorithm);
+    ~FileChecksum();
+
+    static Algorithm algorithmFromName(const QString &name);
+    static QString algorithmName(Algorithm algorithm);
+    static bool isAvailable(Algorithm algorithm);
+
+    Algorithm algorithm() const { return algo; }
+    void reset();
+    void update(const char *data, qint64 size);
+    void updateZeros(qint64 size);   // 稀疏文件跳过的空洞按全零数据计入
+    quint64 value() const;
+
+private:
+    Algorithm algo { Algorithm::kAdler32 };
+    quint64 state { 0 };
+    void *xxhState { nullptr };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // FILECHECKSUM_H
@@ -38,6 +38,13 @@
 DPFILEOPERATIONS_USE_NAMESPACE
 USING_IO_NAMESPACE
 
+// 小文件批量拷贝：小于阈值的文件攒成一批提交到线程池，减少任务调度和单文件开销
+static constexpr qint64 kSmallFileMaxSize { 1024 * 1024 };
+static constexpr int kSmallFileBatchMaxCount { 64 };
+static constexpr qint64 kSmallFileBatchMaxSize { 16 * 1024 * 1024 };
+
+static constexpr qint64 kThroughputProbeTime { 3000 };   // ms of copying before the chunk size is tuned
+
 /*!
  * \brief 为文件操作准备替换目标
  *
@@ -124,6 +131,7 @@ FileOperateBaseWorker::FileOperateBaseWorker(QObject *parent)
 
 FileOperateBaseWorker::~FileOperateBaseWorker()
 {
+    releaseDeviceIo();
 }
 /*!
  * \brief FileOperateBaseWorker::doHandleErrorAndWait Handle the error and block waiting for the error handling operation to return
@@ -701,15 +709,32 @@ bool FileOperateBaseWorker::checkAndCopyFile(const DFileInfoPointer fromInfo, co
 
     // 使用统一的判断接口（替换原来的内联判断）
     if (shouldUseMultiThreadCopy(fromInfo)) {
+        const bool bigSameMountFile = fromSize > bigFileSize && FileUtils::isSameMountPoint(fromInfo->uri(), targetUrl);
+        // A clone only shares extents with the source, so big same-mount files do not
+        // have to wait behind bigFileCopy; if the clone fails the file keeps the big file path
+        if (bigSameMountFile && workData->reflinkCopy) {
+            if (threadPool)
+                return doCloneLocalFile(fromInfo, toInfo);
+
+            initSignalCopyWorker();
+            const auto nextDo = copyOtherFileWorker->doCloneFile(fromInfo, toInfo);
+            if (nextDo == DoCopyFileWorker::NextDo::kDoCopyNext)
+                return true;
+            if (nextDo == DoCopyFileWorker::NextDo::kDoCopyErrorAddCancel)
+                return false;
+        }
+
         while (bigFileCopy && !isStopped()) {
             QThread::msleep(10);
         }
-        if (fromSize > bigFileSize && FileUtils::isSameMountPoint(fromInfo->uri(), targetUrl)) {
+        if (bigSameMountFile) {
             bigFileCopy = true;
             auto result = doCopyLocalByRange(fromInfo, toInfo, skip);
             bigFileCopy = false;
             return result;
         }
+        if (fromSize <= kSmallFileMaxSize)
+            return appendSmallFileBatch(fromInfo, toInfo, fromSize);
         return doCopyLocalFile(fromInfo, toInfo);
     }
 
@@ -908,6 +933,12 @@ bool FileOperateBaseWorker::applyAllPendingReplacements()
 
 void FileOperateBaseWorker::waitThreadPoolOver()
 {
+    // send the small files collected so far before waiting
+    if (!isStopped())
+        flushSmallFileBatch();
+    smallFileBatch.clear();
+    smallFileBatchSize = 0;
+
     // wait all thread start
     if (!isStopped() && threadPool) {
         QThread::msleep(10);
@@ -917,6 +948,9 @@ void FileOperateBaseWorker::waitThreadPoolOver()
         QThread::msleep(10);
     }
 
+    // big files that could not be cloned on the copy threads
+    copyCloneFallbackFiles();
+
     // 等待完成后，批量执行所有延迟的替换操作
     if (!applyAllPendingReplacements()) {
         fmWarning() << "Some pending replacements failed";
@@ -929,11 +963,34 @@ void FileOperateBaseWorker::initCopyWay()
 {
     if (isSourceFileLocal && isTargetFileLocal) {
         countWriteType = CountWriteSizeType::kCustomizeType;
-        workData->singleThread = (sourceFilesCount > 1 || sourceFilesTotalSize > FileOperationsUtils::bigFileSize()) && FileUtils::getCpuProcessCount() > 4
-                ? false
-                : true;
-        if (!workData->singleThread)
-            threadCount = FileUtils::getCpuProcessCount() < 4 ? 2 : 4;
+        const bool worthThreads = (sourceFilesCount > 1 || sourceFilesTotalSize > FileOperationsUtils::bigFileSize())
+                && FileUtils::getCpuProcessCount() > 4;
+
+        // threads and block size follow the disks below source and target, shared with other jobs;
+        // a disk whose budget is used up still gives one thread, so the job never waits here
+        releaseDeviceIo();
+        const auto reservation = DeviceIoScheduler::instance()->acquire(
+                DFMUtils::deviceNameFromUrl(sourceUrls.isEmpty() ? QUrl() : sourceUrls.first()),
+                DFMUtils::deviceNameFromUrl(targetOrgUrl),
+                worthThreads ? FileUtils::getCpuProcessCount() : 1);
+        {
+            QMutexLocker locker(&ioReservationMutex);
+            ioReservation = reservation;
+            chunkSizeTuned = false;
+        }
+        workData->copyChunkSize = reservation.chunkSize;
+        if (reservation.threads > 0) {
+            workData->singleThread = reservation.threads <= 1;
+            threadCount = qMax(1, reservation.threads);
+        } else {
+            workData->singleThread = !worthThreads;
+            if (!workData->singleThread)
+                threadCount = FileUtils::getCpuProcessCount() < 4 ? 2 : 4;
+        }
+    }
+    {
+        QMutexLocker locker(&ioReservationMutex);
+        copyElapsed.start();
     }
 
     if (ProtocolUtils::isSMBFile(targetUrl)
@@ -953,6 +1010,44 @@ void FileOperateBaseWorker::initCopyWay()
     copyTid = (countWriteType == CountWriteSizeType::kTidType) ? syscall(SYS_gettid) : -1;
 }
 
+/*!
+ * \brief FileOperateBaseWorker::tuneChunkSize Adapt the read/write block size to the measured throughput
+ * Called with the progress updates, acts once after kThroughputProbeTime of copying.
+ * \param writeSize bytes written so far
+ */
+void FileOperateBaseWorker::tuneChunkSize(const qint64 writeSize)
+{
+    QMutexLocker locker(&ioReservationMutex);
+    if (chunkSizeTuned || !copyElapsed.isValid())
+        return;
+
+    const qint64 elapsed = copyElapsed.elapsed();
+    if (elapsed < kThroughputProbeTime || writeSize <= 0)
+        return;
+
+    chunkSizeTuned = true;
+    const qint64 bytesPerSecond = writeSize * 1000 / elapsed;
+    workData->copyChunkSize = DeviceIoScheduler::instance()->recordThroughput(ioReservation, bytesPerSecond);
+    fmInfo() << "Copy throughput:" << bytesPerSecond / (1024 * 1024) << "MB/s, chunk size:" << workData->copyChunkSize;
+}
+
+void FileOperateBaseWorker::releaseDeviceIo()
+{
+    QMutexLocker locker(&ioReservationMutex);
+    chunkSizeTuned = true;
+    if (ioReservation.disks.isEmpty())
+        return;
+    DeviceIoScheduler::instance()->release(ioReservation);
+    ioReservation = {};
+}
+
+void FileOperateBaseWorker::endWork()
+{
+    // let the next job on these disks have the threads as soon as this one is done
+    releaseDeviceIo();
+    AbstractWorker::endWork();
+}
+
 /*!
  * \brief FileOperateBaseWorker::shouldUseBlockWriteType Determine if should use block write type for progress counting
  * \return true if should use kWriteBlockType, false otherwise
@@ -1088,6 +1183,90 @@ bool FileOperateBaseWorker::doCopyLocalFile(const DFileInfoPointer fromInfo, con
     return true;
 }
 
+/*!
+ * \brief FileOperateBaseWorker::doCloneLocalFile Clone a big same-mount file on a copy thread
+ * Files the filesystem refuses to clone are collected and copied by range once the
+ * thread pool is idle, so they still go through the big file path one at a time.
+ * \param fromInfo File information of source file
+ * \param toInfo File information of target file
+ * \return false if the job has been stopped
+ */
+bool FileOperateBaseWorker::doCloneLocalFile(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo)
+{
+    if (!stateCheck())
+        return false;
+
+    threadPool->start([this, fromInfo, toInfo]() {
+        const auto nextDo = threadCopyWorker[threadCopyFileCount % threadCount]->doCloneFile(fromInfo, toInfo);
+        if (nextDo == DoCopyFileWorker::NextDo::kDoCopyNext) {
+            workData->completeFileCount++;
+        } else if (nextDo == DoCopyFileWorker::NextDo::kDoCopyFallback) {
+            QMutexLocker lk(&cloneFallbackMutex);
+            cloneFallbackFiles.append({ fromInfo, toInfo });
+        }
+    });
+
+    threadCopyFileCount++;
+    return true;
+}
+
+void FileOperateBaseWorker::copyCloneFallbackFiles()
+{
+    QList<DoCopyFileWorker::CopyFilePair> files;
+    {
+        QMutexLocker lk(&cloneFallbackMutex);
+        files.swap(cloneFallbackFiles);
+    }
+
+    for (const auto &file : files) {
+        while (bigFileCopy && !isStopped()) {
+            QThread::msleep(10);
+        }
+        if (isStopped())
+            return;
+        bigFileCopy = true;
+        doCopyLocalByRange(file.first, file.second, nullptr);
+        bigFileCopy = false;
+    }
+}
+
+/*!
+ * \brief FileOperateBaseWorker::appendSmallFileBatch Collect a small file into the pending batch
+ * Directories are created by the traversing thread before their files are queued, so the
+ * batches copy into existing directories while the traversal keeps going.
+ * \param fromInfo File information of source file
+ * \param toInfo File information of target file
+ * \param size source file size
+ * \return false if the job has been stopped
+ */
+bool FileOperateBaseWorker::appendSmallFileBatch(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo, const qint64 size)
+{
+    if (!stateCheck())
+        return false;
+
+    smallFileBatch.append({ fromInfo, toInfo });
+    smallFileBatchSize += qMax<qint64>(size, 0);
+    if (smallFileBatch.count() >= kSmallFileBatchMaxCount || smallFileBatchSize >= kSmallFileBatchMaxSize)
+        flushSmallFileBatch();
+
+    return true;
+}
+
+void FileOperateBaseWorker::flushSmallFileBatch()
+{
+    if (smallFileBatch.isEmpty() || !threadPool)
+        return;
+
+    const QList<DoCopyFileWorker::CopyFilePair> batch = std::move(smallFileBatch);
+    smallFileBatch.clear();
+    smallFileBatchSize = 0;
+
+    threadPool->start([this, batch]() {
+        threadCopyWorker[threadCopyFileCount % threadCount]->doSmallFilesCopy(batch);
+    });
+    threadCopyFileCount++;
+}
+
 bool FileOperateBaseWorker::doCopyLocalByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
 {
     waitThreadPoolOver();
@@ -1424,8 +1603,11 @@ void FileOperateBaseWorker::determineCountProcessType()
 
     fmDebug("Target block device: \"%s\", Root Path: \"%s\"", device.toStdString().data(), qPrintable(rootPath));
 
-    if (isTargetFileLocal)
+    if (isTargetFileLocal) {
+        workData->reflinkCopy = FileOperationsUtils::isReflinkFileSystem(DFMUtils::fsTypeFromUrl(targetOrgUrl));
+        fmDebug() << "Target supports reflink clone:" << bool(workData->reflinkCopy);
         return;
+    }
 
     // Use DeviceProxyManager to check if target is on external removable device
     // This handles encrypted devices (LUKS/dm-crypt) correctly by checking backing device
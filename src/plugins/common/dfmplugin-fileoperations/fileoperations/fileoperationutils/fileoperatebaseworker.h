@@ -8,11 +8,13 @@
 #include "fileoperations/fileoperationutils/abstractworker.h"
 #include "fileoperations/fileoperationutils/filecleanupmanager.h"
 #include "fileoperations/fileoperationutils/filereplacer.h"
+#include "fileoperations/fileoperationutils/deviceioscheduler.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/utils/threadcontainer.h>
 
 #include <QTime>
+#include <QElapsedTimer>
 
 class QObject;
 
@@ -90,8 +92,11 @@ public:
     bool checkAndCopyDir(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo, bool *skip);
 
 protected:
+    void endWork() override;
     void waitThreadPoolOver();
     void initCopyWay();
+    void tuneChunkSize(const qint64 writeSize);
+    void releaseDeviceIo();
     bool shouldUseBlockWriteType() const;
     QUrl trashInfo(const DFileInfoPointer &fromInfo);
     QString fileOriginName(const QUrl &trashInfoUrl);
@@ -112,6 +117,10 @@ private:
     void initSignalCopyWorker();
     QUrl createNewTargetUrl(const DFileInfoPointer &toInfo, const QString &fileName);
     bool doCopyLocalFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo);
+    bool doCloneLocalFile(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo);
+    void copyCloneFallbackFiles();
+    bool appendSmallFileBatch(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo, const qint64 size);
+    void flushSmallFileBatch();
     bool doCopyOtherFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip);
     bool doCopyLocalByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip);
     void setExpectedSizeForTarget(const QUrl &targetUrl, qint64 size);
@@ -141,6 +150,15 @@ protected:
     FileCleanupManager cleanupManager;   // 管理不完整文件的清理
 
     std::atomic_int threadCopyFileCount { 0 };
+    QList<DoCopyFileWorker::CopyFilePair> smallFileBatch;   // small files waiting to be sent to the thread pool together
+    qint64 smallFileBatchSize { 0 };
+    QMutex cloneFallbackMutex;   // guards cloneFallbackFiles, appended by the copy threads
+    QList<DoCopyFileWorker::CopyFilePair> cloneFallbackFiles;   // big files the filesystem refused to clone
+    // tuneChunkSize runs on the progress timer thread, the worker thread acquires and releases
+    QMutex ioReservationMutex;   // guards ioReservation, copyElapsed and chunkSizeTuned
+    DeviceIoScheduler::Reservation ioReservation;   // copy threads held on the source and target disks
+    QElapsedTimer copyElapsed;   // started when copying begins, used to measure throughput
+    bool chunkSizeTuned { false };
     QList<DFileInfoPointer> cutAndDeleteFiles;
 
     // 延迟替换：待处理的替换上下文队列（主线程访问，无需锁）
@@ -5,6 +5,7 @@
 #include "fileoperationsutils.h"
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/base/device/mounttable.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 
 #include <dfm-io/dfmio_utils.h>
@@ -13,6 +14,7 @@
 #include <QUrl>
 #include <QDebug>
 #include <QMutexLocker>
+#include <QHash>
 
 #undef signals
 extern "C" {
@@ -33,6 +35,8 @@ inline constexpr char kFileOperations[] { "org.deepin.dde.file-manager.operation
 inline constexpr char kFileBigSize[] { "file.operation.bigfilesize" };
 inline constexpr char kBlockEverySync[] { "file.operation.blockeverysync" };
 inline constexpr char kBroadcastPaste[] { "file.operation.broadcastpastevent" };
+inline constexpr char kIoUringCopy[] { "file.operation.iouringcopy" };
+inline constexpr char kIntegrityHash[] { "file.operation.integrityhash" };
 
 /*!
  * \brief FileOperationsUtils::statisticsFilesSize 使用c库统计文件大小
@@ -166,12 +170,53 @@ bool FileOperationsUtils::isFileOnDisk(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    g_autoptr(GFile) destDirFile = g_file_new_for_uri(url.toString().toLocal8Bit().data());
-    g_autoptr(GMount) destDirMount = g_file_find_enclosing_mount(destDirFile, nullptr, nullptr);
-    if (destDirMount) {
-        return !g_mount_can_unmount(destDirMount);
+    const auto queryOnDisk = [&url] {
+        g_autoptr(GFile) destDirFile = g_file_new_for_uri(url.toString().toLocal8Bit().data());
+        g_autoptr(GMount) destDirMount = g_file_find_enclosing_mount(destDirFile, nullptr, nullptr);
+        if (destDirMount) {
+            return !g_mount_can_unmount(destDirMount);
+        }
+        return true;
+    };
+
+    if (!url.isLocalFile())
+        return queryOnDisk();
+
+    // 本地文件的结果只取决于所在挂载点，按挂载点缓存，挂载表变化后整体失效
+    static QMutex cacheMutex;
+    static QHash<QString, bool> onDiskCache;
+    static quint64 cacheGeneration { 0 };
+
+    MountTable *table = MountTable::instance();
+    const quint64 generation = table->generation();
+    const QString &mountPoint = table->mountPointOf(url.toLocalFile());
+    {
+        QMutexLocker lk(&cacheMutex);
+        if (cacheGeneration != generation) {
+            onDiskCache.clear();
+            cacheGeneration = generation;
+        }
+        auto it = onDiskCache.constFind(mountPoint);
+        if (it != onDiskCache.cend())
+            return it.value();
     }
-    return true;
+
+    const bool onDisk = queryOnDisk();
+    QMutexLocker lk(&cacheMutex);
+    if (cacheGeneration == generation)
+        onDiskCache.insert(mountPoint, onDisk);
+    return onDisk;
+}
+
+/*!
+ * \brief FileOperationsUtils::isReflinkFileSystem Whether the filesystem can share extents between files (FICLONE)
+ * \param fsType filesystem type, e.g. from DFMUtils::fsTypeFromUrl
+ * \return true for filesystems known to implement reflink
+ */
+bool FileOperationsUtils::isReflinkFileSystem(const QString &fsType)
+{
+    static const QStringList kReflinkFileSystems { "btrfs", "xfs", "bcachefs", "ocfs2" };
+    return kReflinkFileSystems.contains(fsType.toLower());
 }
 
 qint64 FileOperationsUtils::bigFileSize()
@@ -189,6 +234,16 @@ bool FileOperationsUtils::blockSync()
     return sync;
 }
 
+bool FileOperationsUtils::ioUringCopy()
+{
+    return DConfigManager::instance()->value(kFileOperations, kIoUringCopy, true).toBool();
+}
+
+QString FileOperationsUtils::integrityHash()
+{
+    return DConfigManager::instance()->value(kFileOperations, kIntegrityHash, "crc32c").toString();
+}
+
 QUrl FileOperationsUtils::parentUrl(const QUrl &url)
 {
     auto parent = url.adjusted(QUrl::StripTrailingSlash);
@@ -71,8 +71,11 @@ private:
     static void statisticFilesSize(const QUrl &url, SizeInfoPointer &sizeInfo, const bool &isRecordUrl = false);
     static bool isAncestorUrl(const QUrl &from, const QUrl &to);
     static bool isFileOnDisk(const QUrl &url);
+    static bool isReflinkFileSystem(const QString &fsType);
     static qint64 bigFileSize();
     static bool blockSync();
+    static bool ioUringCopy();
+    static QString integrityHash();
     static QUrl parentUrl(const QUrl &url);
     static bool canBroadcastPaste();
 };
@@ -0,0 +1,402 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iouringcopier.h"
+
+#include <QVector>
+
+#include <map>
+#include <mutex>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#ifdef DFM_ENABLE_IO_URING
+#    include <liburing.h>
+#endif
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+#ifdef DFM_ENABLE_IO_URING
+
+class IoUringCopierPrivate
+{
+public:
+    enum class SlotState : quint8 {
+        kIdle,
+        kReading,
+        kWriting,
+    };
+
+    struct Slot
+    {
+        char *buffer { nullptr };
+        qint64 offset { 0 };
+        quint32 length { 0 };
+        quint32 done { 0 };   // 当前阶段（读或写）已完成的字节数
+        SlotState state { SlotState::kIdle };
+    };
+
+    ~IoUringCopierPrivate()
+    {
+        if (ringInited) {
+            releaseBuffers();
+            io_uring_queue_exit(&ring);
+        }
+    }
+
+    bool allocateBuffers(quint32 size)
+    {
+        QVector<iovec> iovecs;
+        iovecs.reserve(slots.size());
+        for (auto &slot : slots) {
+            if (posix_memalign(reinterpret_cast<void **>(&slot.buffer), 4096, size) != 0) {
+                fmWarning() << "Failed to allocate io_uring copy buffer - size:" << size;
+                slot.buffer = nullptr;
+                releaseBuffers();
+                return false;
+            }
+            iovecs.append({ slot.buffer, size });
+        }
+        blockSize = size;
+
+        // Registering pins the buffers, which may exceed RLIMIT_MEMLOCK on older kernels;
+        // plain reads and writes through the ring still keep the queue busy in that case.
+        int ret = io_uring_register_buffers(&ring, iovecs.constData(), static_cast<unsigned>(iovecs.size()));
+        fixedBuffers = (ret == 0);
+        if (!fixedBuffers)
+            fmInfo() << "io_uring buffer registration failed, using unregistered buffers, error:" << strerror(-ret);
+        return true;
+    }
+
+    void releaseBuffers()
+    {
+        if (fixedBuffers)
+            io_uring_unregister_buffers(&ring);
+        fixedBuffers = false;
+        for (auto &slot : slots) {
+            free(slot.buffer);
+            slot.buffer = nullptr;
+        }
+        blockSize = 0;
+    }
+
+    bool submitSlot(int index, int srcFd, int dstFd)
+    {
+        Slot &slot = slots[index];
+        io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+        if (!sqe)
+            return false;
+
+        char *buf = slot.buffer + slot.done;
+        const unsigned size = slot.length - slot.done;
+        const qint64 pos = slot.offset + slot.done;
+        if (slot.state == SlotState::kReading) {
+            if (fixedBuffers)
+                io_uring_prep_read_fixed(sqe, srcFd, buf, size, static_cast<__u64>(pos), index);
+            else
+                io_uring_prep_read(sqe, srcFd, buf, size, static_cast<__u64>(pos));
+        } else {
+            if (fixedBuffers)
+                io_uring_prep_write_fixed(sqe, dstFd, buf, size, static_cast<__u64>(pos), index);
+            else
+                io_uring_prep_write(sqe, dstFd, buf, size, static_cast<__u64>(pos));
+        }
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(static_cast<quintptr>(index)));
+        ++inflight;
+        return true;
+    }
+
+    io_uring ring;
+    bool ringInited { false };
+    bool fixedBuffers { false };
+    quint32 blockSize { 0 };
+    int inflight { 0 };
+    QVector<Slot> slots;
+};
+
+IoUringCopier::IoUringCopier()
+    : d(new IoUringCopierPrivate)
+{
+}
+
+IoUringCopier::~IoUringCopier()
+{
+}
+
+/*!
+ * \brief IoUringCopier::isSupported Probe once whether the running kernel can serve io_uring reads and writes
+ * \return true if io_uring is usable in this process
+ */
+bool IoUringCopier::isSupported()
+{
+    static bool supported { false };
+    static std::once_flag probeFlag;
+    std::call_once(probeFlag, [] {
+        io_uring ring;
+        int ret = io_uring_queue_init(2, &ring, 0);
+        if (ret < 0) {
+            // ENOSYS: kernel without io_uring, EPERM: disabled by kernel.io_uring_disabled
+            fmInfo() << "io_uring is unavailable, error:" << strerror(-ret);
+            return;
+        }
+
+        io_uring_probe *probe = io_uring_get_probe_ring(&ring);
+        if (probe) {
+            supported = io_uring_opcode_supported(probe, IORING_OP_READ)
+                    && io_uring_opcode_supported(probe, IORING_OP_WRITE)
+                    && io_uring_opcode_supported(probe, IORING_OP_READ_FIXED)
+                    && io_uring_opcode_supported(probe, IORING_OP_WRITE_FIXED);
+            io_uring_free_probe(probe);
+        }
+        io_uring_queue_exit(&ring);
+        fmInfo() << "io_uring copy engine supported:" << supported;
+    });
+    return supported;
+}
+
+/*!
+ * \brief IoUringCopier::init Create the ring and the per-slot buffers
+ * Calling it again with another block size reallocates the buffers, so a job whose chunk
+ * size was tuned picks the new size up with the next file.
+ * \param queueDepth number of blocks kept in flight at the same time
+ * \param blockSize size of every block buffer
+ * \return true if the engine is ready to copy
+ */
+bool IoUringCopier::init(int queueDepth, quint32 blockSize)
+{
+    if (blockSize == 0)
+        return false;
+    if (d->ringInited) {
+        if (blockSize == d->blockSize)
+            return true;
+        d->releaseBuffers();
+        if (d->allocateBuffers(blockSize))
+            return true;
+        io_uring_queue_exit(&d->ring);
+        d->slots.clear();
+        d->ringInited = false;
+        return false;
+    }
+    if (!isSupported() || queueDepth <= 0)
+        return false;
+
+    int ret = io_uring_queue_init(static_cast<unsigned>(queueDepth), &d->ring, 0);
+    if (ret < 0) {
+        fmWarning() << "io_uring_queue_init failed, error:" << strerror(-ret);
+        return false;
+    }
+    d->ringInited = true;
+    d->slots.resize(queueDepth);
+    if (!d->allocateBuffers(blockSize)) {
+        io_uring_queue_exit(&d->ring);
+        d->slots.clear();
+        d->ringInited = false;
+        return false;
+    }
+    return true;
+}
+
+bool IoUringCopier::isInitialized() const
+{
+    return d->ringInited;
+}
+
+/*!
+ * \brief IoUringCopier::copy Copy [offset, offset + length) from srcFd to dstFd at the same offset
+ * Reads and writes of different blocks overlap; progress is only reported for the contiguous
+ * prefix that has been written, so a retry can restart from Result::copiedOffset.
+ * \param srcFd source file descriptor
+ * \param dstFd destination file descriptor
+ * \param offset start offset in both files
+ * \param length bytes to copy
+ * \param progress called when the contiguous written prefix grows
+ * \return copy result
+ */
+IoUringCopier::Result IoUringCopier::copy(int srcFd, int dstFd, qint64 offset, qint64 length, const ProgressFunc &progress)
+{
+    using SlotState = IoUringCopierPrivate::SlotState;
+
+    Result result;
+    result.copiedOffset = offset;
+    if (!d->ringInited) {
+        result.error = ENODEV;
+        return result;
+    }
+
+    const qint64 end = offset + length;
+    qint64 nextOffset = offset;
+    bool stopping = false;
+    std::map<qint64, quint32> completed;   // 乱序完成的块，等待并入连续前缀
+
+    auto startRead = [&](int index) {
+        auto &slot = d->slots[index];
+        slot.offset = nextOffset;
+        slot.length = static_cast<quint32>(qMin<qint64>(d->blockSize, end - nextOffset));
+        slot.done = 0;
+        slot.state = SlotState::kReading;
+        nextOffset += slot.length;
+        return d->submitSlot(index, srcFd, dstFd);
+    };
+
+    auto fail = [&](int err, bool isWrite) {
+        if (result.error == 0) {
+            result.error = err;
+            result.isWriteError = isWrite;
+        }
+        stopping = true;
+    };
+
+    for (int i = 0; i < d->slots.size() && nextOffset < end; ++i) {
+        if (!startRead(i)) {
+            fail(EAGAIN, false);
+            break;
+        }
+    }
+
+    while (d->inflight > 0) {
+        int ret = io_uring_submit_and_wait(&d->ring, 1);
+        if (ret < 0 && ret != -EINTR) {
+            // The ring itself is broken, nothing more will complete
+            fail(-ret, false);
+            d->inflight = 0;
+            break;
+        }
+
+        io_uring_cqe *cqe = nullptr;
+        unsigned head = 0;
+        unsigned count = 0;
+        io_uring_for_each_cqe(&d->ring, head, cqe)
+        {
+            ++count;
+            --d->inflight;
+            const int index = static_cast<int>(reinterpret_cast<quintptr>(io_uring_cqe_get_data(cqe)));
+            const int res = cqe->res;
+            auto &slot = d->slots[index];
+            const bool isWrite = slot.state == SlotState::kWriting;
+
+            if (res < 0) {
+                if ((res == -EINTR || res == -EAGAIN) && !stopping) {
+                    if (!d->submitSlot(index, srcFd, dstFd)) {
+                        slot.state = SlotState::kIdle;
+                        fail(EAGAIN, isWrite);
+                    }
+                    continue;
+                }
+                slot.state = SlotState::kIdle;
+                fail(-res, isWrite);
+                continue;
+            }
+
+            if (stopping) {
+                slot.state = SlotState::kIdle;
+                continue;
+            }
+
+            if (res == 0) {
+                // Source shrank underneath us or the target stopped accepting data
+                slot.state = SlotState::kIdle;
+                fail(isWrite ? ENOSPC : ENODATA, isWrite);
+                continue;
+            }
+
+            slot.done += static_cast<quint32>(res);
+            if (slot.done < slot.length) {
+                // 短读/短写：继续提交剩余部分，提交失败时不能让这个块悄悄丢失
+                if (!d->submitSlot(index, srcFd, dstFd)) {
+                    slot.state = SlotState::kIdle;
+                    fail(EAGAIN, isWrite);
+                }
+                continue;
+            }
+
+            if (!isWrite) {
+                slot.state = SlotState::kWriting;
+                slot.done = 0;
+                if (!d->submitSlot(index, srcFd, dstFd)) {
+                    slot.state = SlotState::kIdle;
+                    fail(EAGAIN, true);
+                }
+                continue;
+            }
+
+            slot.state = SlotState::kIdle;
+            completed.emplace(slot.offset, slot.length);
+            qint64 delta = 0;
+            while (!completed.empty() && completed.begin()->first == result.copiedOffset) {
+                result.copiedOffset += completed.begin()->second;
+                delta += completed.begin()->second;
+                completed.erase(completed.begin());
+            }
+            if (delta > 0 && progress && !progress(delta)) {
+                result.canceled = true;
+                stopping = true;
+                continue;
+            }
+
+            if (nextOffset < end && !startRead(index))
+                fail(EAGAIN, false);
+        }
+        io_uring_cq_advance(&d->ring, count);
+    }
+
+    // 没有报错也没有取消时，连续写完的前缀必须覆盖整个区间，否则目标文件中会留下空洞
+    if (result.error == 0 && !result.canceled && result.copiedOffset != end) {
+        fmWarning() << "io_uring copy finished with a gap - copied to:" << result.copiedOffset << "expected:" << end;
+        result.error = EIO;
+        result.isWriteError = true;
+    }
+
+    return result;
+}
+
+#else   // DFM_ENABLE_IO_URING
+
+class IoUringCopierPrivate
+{
+};
+
+IoUringCopier::IoUringCopier()
+    : d(new IoUringCopierPrivate)
+{
+}
+
+IoUringCopier::~IoUringCopier()
+{
+}
+
+bool IoUringCopier::isSupported()
+{
+    return false;
+}
+
+bool IoUringCopier::init(int queueDepth, quint32 blockSize)
+{
+    Q_UNUSED(queueDepth)
+    Q_UNUSED(blockSize)
+    return false;
+}
+
+bool IoUringCopier::isInitialized() const
+{
+    return false;
+}
+
+IoUringCopier::Result IoUringCopier::copy(int srcFd, int dstFd, qint64 offset, qint64 length, const ProgressFunc &progress)
+{
+    Q_UNUSED(srcFd)
+    Q_UNUSED(dstFd)
+    Q_UNUSED(length)
+    Q_UNUSED(progress)
+    Result result;
+    result.copiedOffset = offset;
+    result.error = ENOSYS;
+    return result;
+}
+
+#endif   // DFM_ENABLE_IO_URING
+
+DPFILEOPERATIONS_END_NAMESPACE
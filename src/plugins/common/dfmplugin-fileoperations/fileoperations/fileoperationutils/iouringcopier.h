@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IOURINGCOPIER_H
+#define IOURINGCOPIER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QScopedPointer>
+
+#include <functional>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+class IoUringCopierPrivate;
+
+/**
+ * 基于 io_uring 的文件数据拷贝引擎
+ *
+ * 同时保持多个读写请求在途，使用注册缓冲区（registered buffers）减少内核映射开销。
+ * 每个 DoCopyFileWorker 持有一个实例，在同一线程内顺序复用于多个文件。
+ * 内核或构建环境不支持 io_uring 时 isSupported() 返回 false，由调用方回退到已有拷贝路径。
+ */
+class IoUringCopier
+{
+    Q_DISABLE_COPY(IoUringCopier)
+
+public:
+    struct Result
+    {
+        qint64 copiedOffset { 0 };   // 从起始偏移开始连续写完的位置
+        int error { 0 };   // 第一个失败请求的 errno，0 表示无错误
+        bool isWriteError { false };   // 出错的是写请求还是读请求
+        bool canceled { false };   // 进度回调要求中止
+    };
+
+    // 连续写完的字节数增加时回调；返回 false 中止拷贝（已在途的请求会先被收割）
+    using ProgressFunc = std::function<bool(qint64 delta)>;
+
+    IoUringCopier();
+    ~IoUringCopier();
+
+    static bool isSupported();
+
+    bool init(int queueDepth, quint32 blockSize);
+    bool isInitialized() const;
+
+    Result copy(int srcFd, int dstFd, qint64 offset, qint64 length, const ProgressFunc &progress);
+
+private:
+    QScopedPointer<IoUringCopierPrivate> d;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // IOURINGCOPIER_H
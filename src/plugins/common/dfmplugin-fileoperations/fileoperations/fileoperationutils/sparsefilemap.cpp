@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sparsefilemap.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+SparseFileMap::SparseFileMap(int fileFd, qint64 size)
+    : fd(fileFd), fileSize(size)
+{
+    probe();
+}
+
+SparseFileMap::SparseFileMap(const QString &path, qint64 size)
+    : fileSize(size)
+{
+    if (!path.isEmpty()) {
+        fd = open(path.toLocal8Bit().constData(), O_RDONLY | O_CLOEXEC);
+        ownsFd = fd >= 0;
+    }
+    probe();
+}
+
+SparseFileMap::~SparseFileMap()
+{
+    if (ownsFd)
+        close(fd);
+}
+
+void SparseFileMap::probe()
+{
+    struct stat st;
+    if (fd < 0 || fileSize <= 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return;
+
+    // st_blocks is counted in 512 byte units regardless of the filesystem block size
+    sparse = static_cast<qint64>(st.st_blocks) * 512 < static_cast<qint64>(st.st_size);
+    if (!sparse && ownsFd) {
+        close(fd);
+        fd = -1;
+        ownsFd = false;
+    }
+}
+
+/*!
+ * \brief SparseFileMap::nextData Find the data region at or after offset
+ * \param offset file offset to start looking from
+ * \param dataEnd Output parameter: end of the returned data region
+ * \return start of the next data region, the file size if only a hole is left
+ */
+qint64 SparseFileMap::nextData(qint64 offset, qint64 *dataEnd)
+{
+    *dataEnd = fileSize;
+    if (!sparse || offset >= fileSize)
+        return qMin(offset, fileSize);
+
+    const off_t data = lseek(fd, offset, SEEK_DATA);
+    if (data < 0) {
+        if (errno == ENXIO)
+            return fileSize;   // trailing hole
+
+        // SEEK_DATA is not supported here, treat the rest as data
+        fmDebug() << "SEEK_DATA failed, copying holes as data - error:" << strerror(errno);
+        sparse = false;
+        return offset;
+    }
+
+    const off_t hole = lseek(fd, data, SEEK_HOLE);
+    const qint64 start = qMin<qint64>(data, fileSize);
+    if (hole > data)
+        *dataEnd = qMin<qint64>(hole, fileSize);
+    return start;
+}
+
+DPFILEOPERATIONS_END_NAMESPACE
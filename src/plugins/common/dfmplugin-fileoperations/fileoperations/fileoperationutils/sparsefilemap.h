@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SPARSEFILEMAP_H
+#define SPARSEFILEMAP_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QString>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/**
+ * 稀疏源文件的数据区/空洞查询
+ *
+ * 只有分配的块少于文件大小时才认为是稀疏文件，此后通过 SEEK_DATA/SEEK_HOLE 逐段查询，
+ * 拷贝时跳过空洞，目标文件在空洞处保持未分配。普通文件只多一次 fstat。
+ * 文件系统不支持 SEEK_DATA 时整个剩余部分按数据处理。
+ */
+class SparseFileMap
+{
+    Q_DISABLE_COPY(SparseFileMap)
+
+public:
+    // 查询会移动 fd 的文件偏移，调用方需使用带偏移的读写或自行 lseek
+    SparseFileMap(int fileFd, qint64 size);
+    // 自行打开 path 用于查询，path 为空时按非稀疏文件处理
+    SparseFileMap(const QString &path, qint64 size);
+    ~SparseFileMap();
+
+    bool isSparse() const { return sparse; }
+    qint64 nextData(qint64 offset, qint64 *dataEnd);
+
+private:
+    void probe();
+
+    int fd { -1 };
+    bool ownsFd { false };
+    qint64 fileSize { 0 };
+    bool sparse { false };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // SPARSEFILEMAP_H
@@ -5,6 +5,7 @@
 #ifndef WORKERDATA_H
 #define WORKERDATA_H
 #include "dfmplugin_fileoperations_global.h"
+#include "filechecksum.h"
 #include <dfm-base/interfaces/abstractjobhandler.h>
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/utils/threadcontainer.h>
@@ -65,6 +66,10 @@ public:
     QAtomicInteger<qint64> skipWriteSize { 0 };   // 跳过的文件大
     QAtomicInteger<qint64> completeFileCount { 0 };   // copy complete file count
     std::atomic_bool singleThread { true };
+    std::atomic_bool ioUringCopy { false };   // copy big files through io_uring when the kernel supports it
+    std::atomic_uint32_t copyChunkSize { 1024 * 1024 };   // read/write block size, tuned per device by DeviceIoScheduler
+    std::atomic_bool reflinkCopy { false };   // clone extents with FICLONE, cleared once the filesystem refuses
+    FileChecksum::Algorithm integrityAlgorithm { FileChecksum::Algorithm::kCrc32c };   // set before copying starts
     DThreadMap<QUrl, qint64> everyFileWriteSize;
     DThreadList<QSharedPointer<DPFILEOPERATIONS_NAMESPACE::WorkerData::BlockFileCopyInfo>> blockCopyInfoQueue;
 };
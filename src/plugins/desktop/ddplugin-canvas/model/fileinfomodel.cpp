@@ -12,6 +12,7 @@
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/utils/thumbnail/thumbnailfactory.h>
+#include <dfm-base/utils/thumbnail/thumbnailcache.h>
 
 #include <dfm-framework/dpf.h>
 
@@ -296,7 +297,9 @@ void FileInfoModelPrivate::thumbUpdated(const QUrl &url, const QString &thumb)
     }
 
     // Creating thumbnail icon in a thread may cause the program to crash
-    QIcon thumbIcon(thumb);
+    // 优先使用生成线程中已解码的图像，避免在 GUI 线程重新读取和解码 PNG
+    const QImage &cached = ThumbnailCache::instance().image(thumb);
+    QIcon thumbIcon = cached.isNull() ? QIcon(thumb) : QIcon(QPixmap::fromImage(cached));
     if (thumbIcon.isNull()) {
         fmWarning() << "Failed to create thumbnail icon from path:" << thumb;
         return;
@@ -563,6 +566,8 @@ QVariant FileInfoModel::data(const QModelIndex &index, int itemRole) const
         return indexFileInfo->displayOf(DisPlayInfoType::kFileDisplayName);
     case Global::ItemRoles::kItemFilePinyinNameRole:
         return indexFileInfo->displayOf(DisPlayInfoType::kFileDisplayPinyinName);
+    case Global::ItemRoles::kItemFilePinyinInitialsRole:
+        return indexFileInfo->displayOf(DisPlayInfoType::kFileDisplayPinyinInitials);
     case Global::ItemRoles::kItemFileCreatedRole:
         return indexFileInfo->timeOf(TimeInfoType::kCreateTime).value<QDateTime>().toString("yyyy/MM/dd HH:mm:ss");
     case Global::ItemRoles::kItemFileLastModifiedRole:
@@ -996,6 +996,14 @@ QModelIndex CanvasViewPrivate::findIndex(const QString &key, bool matchStart, co
                        : pinyinName.contains(key, Qt::CaseInsensitive)) {
             return index;
         }
+
+        // 拼音首字母，如 "wd" 匹配 "文档"
+        const QString &initials = q->model()->data(index, Global::ItemRoles::kItemFilePinyinInitialsRole).toString();
+        if (initials != pinyinName
+            && (matchStart ? initials.startsWith(key, Qt::CaseInsensitive)
+                           : initials.contains(key, Qt::CaseInsensitive))) {
+            return index;
+        }
     }
 
     return QModelIndex();
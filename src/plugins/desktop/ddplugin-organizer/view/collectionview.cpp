@@ -1043,6 +1043,14 @@ QModelIndex CollectionViewPrivate::findIndex(const QString &key, bool matchStart
                        : pinyinName.contains(key, Qt::CaseInsensitive)) {
             return index;
         }
+
+        // 拼音首字母，如 "wd" 匹配 "文档"
+        const QString &initials = q->model()->data(index, Global::ItemRoles::kItemFilePinyinInitialsRole).toString();
+        if (initials != pinyinName
+            && (matchStart ? initials.startsWith(key, Qt::CaseInsensitive)
+                           : initials.contains(key, Qt::CaseInsensitive))) {
+            return index;
+        }
     }
 
     return QModelIndex();
@@ -64,6 +64,8 @@ inline constexpr char kEnableFullTextSearch[] { "enableFullTextSearch" };
 inline constexpr char kEnableOcrTextSearch[] { "enableOcrTextSearch" };
 inline constexpr char kEnableSemanticSearch[] { "enableSemanticSearch" };
 inline constexpr char kSearchAuthHintDone[] { "searchAuthHintDone" };
+inline constexpr char kEnableFileNameTrigramIndex[] { "enableFileNameTrigramIndex" };
+inline constexpr char kFileNameTrigramIndexMaxWatches[] { "fileNameTrigramIndexMaxWatches" };
 }
 
 DPSEARCH_END_NAMESPACE
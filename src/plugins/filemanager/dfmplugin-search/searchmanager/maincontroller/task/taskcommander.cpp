@@ -103,6 +103,11 @@ void SimplifiedSearchWorker::createSearchers()
             createSearchersForUrl(searchUrl);
         }
 
+        // 所有搜索器都未能启动时直接结束任务
+        if (searchers.isEmpty() && isRunning) {
+            emit searchCompleted(taskId);
+            isRunning = false;
+        }
         return;
     }
 
@@ -132,8 +137,14 @@ void SimplifiedSearchWorker::createSearchersForUrl(const QUrl &url)
 {
     // 为每种启用的搜索类型创建 DFMSearcher
     const QList<SearchType> searchTypes = resolveEnabledSearchTypes();
-    for (auto type : searchTypes)
-        appendSearcher(new DFMSearcher(url, searchKeyword, this, type));
+    for (auto type : searchTypes) {
+        if (appendSearcher(new DFMSearcher(url, searchKeyword, this, type)) || type != SearchType::FileName)
+            continue;
+
+        // 文件名搜索引擎不可用时退回到目录遍历，本地目录由多线程遍历器处理
+        fmWarning() << "File name search engine unavailable, falling back to directory walk for:" << url;
+        appendSearcher(new IteratorSearcher(url, searchKeyword, this));
+    }
 
     // Reuse the shared gating predicate so the pre-search grouping setup and
     // runtime adapter creation stay consistent.
@@ -158,13 +169,20 @@ QList<SearchType> SimplifiedSearchWorker::resolveEnabledSearchTypes() const
     return types;
 }
 
-void SimplifiedSearchWorker::appendSearcher(AbstractSearcher *searcher)
+bool SimplifiedSearchWorker::appendSearcher(AbstractSearcher *searcher)
 {
     connect(searcher, &AbstractSearcher::unearthed, this, &SimplifiedSearchWorker::onSearcherUnearthed);
     connect(searcher, &AbstractSearcher::finished, this, &SimplifiedSearchWorker::onSearcherFinished);
 
     searchers.append(searcher);
-    searcher->search();
+    if (searcher->search())
+        return true;
+
+    // 启动失败的搜索器不会发出 finished，移除以免任务无法结束
+    searchers.removeAll(searcher);
+    searcher->disconnect(this);
+    searcher->deleteLater();
+    return false;
 }
 
 void SimplifiedSearchWorker::cleanupSearchers()
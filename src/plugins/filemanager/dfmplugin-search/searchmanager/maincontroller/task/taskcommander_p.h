@@ -64,7 +64,7 @@ private:
 
     // 职责拆分：解析启用的搜索类型 / 注册 searcher
     QList<DFMSEARCH::SearchType> resolveEnabledSearchTypes() const;
-    void appendSearcher(AbstractSearcher *searcher);
+    bool appendSearcher(AbstractSearcher *searcher);
 
     QString taskId;
     QUrl searchUrl;
@@ -3,21 +3,80 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "iteratorsearcher.h"
+#include "localtreewalker.h"
+#include "trigramindexmanager.h"
 #include "utils/searchhelper.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/base/urlroute.h>
+#include <dfm-base/utils/chinese2pinyin.h>
 
 #include <QDebug>
 #include <QDirIterator>
 #include <QFileInfo>
 #include <QApplication>
 #include <QMetaObject>
+#include <QSet>
 #include <QTimer>
+#include <QtConcurrent>
 
 DFMBASE_USE_NAMESPACE
 DPSEARCH_USE_NAMESPACE
 
+namespace {
+QStringList queryTrigramIndex(const TrigramIndexManager::Snapshot &snapshot, const QRegularExpression &regex,
+                              const QString &initialsKey, const QString &localPath,
+                              QSharedPointer<std::atomic_bool> cancelled)
+{
+    QStringList paths = snapshot.index->search(regex, localPath, *cancelled);
+    QSet<QString> seen(paths.cbegin(), paths.cend());
+
+    // 字面量由三元组回答，拼音首字母另外扫描含汉字的文件名
+    if (!initialsKey.isEmpty()) {
+        for (const QString &path : snapshot.index->searchInitials(initialsKey, localPath, *cancelled)) {
+            if (!seen.contains(path)) {
+                seen.insert(path);
+                paths.append(path);
+            }
+        }
+    }
+
+    // 索引生成之后新增的文件
+    const QString &prefix = localPath.endsWith('/') ? localPath : localPath + '/';
+    for (const QString &path : snapshot.recentPaths) {
+        if (*cancelled)
+            break;
+        if (!path.startsWith(prefix) || seen.contains(path))
+            continue;
+
+        const QFileInfo info(path);
+        const QString &fileName = info.fileName();
+        const bool hit = regex.match(fileName).hasMatch()
+                || (!initialsKey.isEmpty() && Pinyin::matchInitials(fileName, initialsKey, false));
+        if (!hit || (!info.exists() && !info.isSymLink()))
+            continue;
+        seen.insert(path);
+        paths.append(path);
+    }
+
+    // desktop 文件按显示名称匹配，与 LocalTreeWalker 一致
+    static const QRegularExpression kDesktopFile(QStringLiteral("\\.desktop$"));
+    const QStringList &desktopFiles = snapshot.index->search(kDesktopFile, localPath, *cancelled);
+    for (const QString &path : desktopFiles) {
+        if (*cancelled)
+            break;
+        if (seen.contains(path))
+            continue;
+
+        const auto &info = InfoFactory::create<FileInfo>(QUrl::fromLocalFile(path));
+        if (info && regex.match(info->displayOf(DisPlayInfoType::kFileDisplayName)).hasMatch())
+            paths.append(path);
+    }
+    return paths;
+}
+}   // namespace
+
 // ================= IteratorSearcherBridge 实现 =================
 IteratorSearcherBridge::IteratorSearcherBridge(QObject *parent)
     : QObject(parent)
@@ -76,6 +135,11 @@ IteratorSearcher::IteratorSearcher(const QUrl &url, const QString &key, QObject
     // 创建正则表达式，忽略大小写
     regex = QRegularExpression(keyword, QRegularExpression::CaseInsensitiveOption);
 
+    // "wd" 也能搜到 "文档"
+    static const QRegularExpression kInitialsKey(QStringLiteral("^[A-Za-z]{2,}$"));
+    if (kInitialsKey.match(key).hasMatch())
+        initialsKey = key;
+
     // 连接处理目录的信号
     connect(this, &IteratorSearcher::requestProcessNextDirectory,
             this, &IteratorSearcher::processDirectory,
@@ -88,6 +152,9 @@ IteratorSearcher::IteratorSearcher(const QUrl &url, const QString &key, QObject
 
 IteratorSearcher::~IteratorSearcher()
 {
+    if (indexCancelled)
+        *indexCancelled = true;
+
     // 清理资源
     pendingDirs.clear();
 
@@ -104,6 +171,14 @@ bool IteratorSearcher::search()
         return false;
     }
 
+    // 本地路径直接在后台线程中遍历
+    const QString &localPath = localSearchPath(searchUrl);
+    if (!localPath.isEmpty()) {
+        if (!startIndexQuery(localPath))
+            startLocalWalk(localPath);
+        return true;
+    }
+
     // 从根URL开始搜索
     pendingDirs.enqueue(searchUrl);
 
@@ -131,6 +206,10 @@ void IteratorSearcher::stop()
     if (previousState == kRuning) {
         // 清理待处理目录
         pendingDirs.clear();
+        if (walker)
+            walker->stop();
+        if (indexCancelled)
+            *indexCancelled = true;
 
         // 确保处理挖掘的结果
         if (hasItem())
@@ -236,7 +315,9 @@ void IteratorSearcher::processIteratorResults(QSharedPointer<DFMBASE_NAMESPACE::
         }
 
         // The keyword check (the regex)
-        if (regex.match(info->displayOf(DisPlayInfoType::kFileDisplayName)).hasMatch())
+        const QString &displayName = info->displayOf(DisPlayInfoType::kFileDisplayName);
+        if (regex.match(displayName).hasMatch()
+            || (!initialsKey.isEmpty() && Pinyin::matchInitials(displayName, initialsKey, false)))
             addResultToMap(fileUrl, newResults);
     }
 
@@ -312,3 +393,91 @@ void IteratorSearcher::requestNextDirectory()
     // 通过信号请求处理下一个目录
     emit requestProcessNextDirectory();
 }
+
+QString IteratorSearcher::localSearchPath(const QUrl &url)
+{
+    // 虚拟协议的 url 不能直接映射到本地目录，仍然通过迭代器访问
+    if (UrlRoute::isVirtual(url))
+        return {};
+
+    const QString &path = url.isLocalFile() ? url.toLocalFile() : UrlRoute::urlToPath(url);
+    if (path.isEmpty() || !QFileInfo(path).isDir())
+        return {};
+    return path;
+}
+
+void IteratorSearcher::startLocalWalk(const QString &localPath)
+{
+    walker = new LocalTreeWalker(localPath, regex, initialsKey, this);
+    connect(walker, &LocalTreeWalker::resultsAvailable,
+            this, &IteratorSearcher::onWalkerResultsAvailable,
+            Qt::QueuedConnection);
+    connect(walker, &LocalTreeWalker::finished,
+            this, &IteratorSearcher::onWalkerFinished,
+            Qt::QueuedConnection);
+    walker->start();
+}
+
+void IteratorSearcher::onWalkerResultsAvailable()
+{
+    if (status.loadAcquire() != kRuning || !walker)
+        return;
+
+    // 沿用批量定时器的发布节奏
+    addLocalResults(walker->takeResults());
+}
+
+void IteratorSearcher::onWalkerFinished()
+{
+    if (status.loadAcquire() != kRuning)
+        return;
+
+    onWalkerResultsAvailable();
+    publishBatchedResults();
+    batchTimer->stop();
+
+    status.storeRelease(kCompleted);
+    fmDebug() << "Iterator search completed - local tree walk finished";
+    emit finished();
+}
+
+bool IteratorSearcher::startIndexQuery(const QString &localPath)
+{
+    const auto &snapshot = TrigramIndexManager::instance()->acquire(localPath);
+    if (!snapshot.index)
+        return false;
+
+    indexCancelled.reset(new std::atomic_bool(false));
+    indexWatcher = new QFutureWatcher<QStringList>(this);
+    connect(indexWatcher, &QFutureWatcher<QStringList>::finished,
+            this, &IteratorSearcher::onIndexQueryFinished);
+    indexWatcher->setFuture(QtConcurrent::run(queryTrigramIndex, snapshot, regex, initialsKey, localPath, indexCancelled));
+    return true;
+}
+
+void IteratorSearcher::onIndexQueryFinished()
+{
+    if (status.loadAcquire() != kRuning || !indexWatcher)
+        return;
+
+    addLocalResults(indexWatcher->result());
+    publishBatchedResults();
+    batchTimer->stop();
+
+    status.storeRelease(kCompleted);
+    fmDebug() << "Iterator search completed - answered from file name index";
+    emit finished();
+}
+
+void IteratorSearcher::addLocalResults(const QStringList &paths)
+{
+    if (paths.isEmpty())
+        return;
+
+    const QString &scheme = searchUrl.scheme();
+    DFMSearchResultMap newResults;
+    for (const QString &path : paths)
+        addResultToMap(searchUrl.isLocalFile() ? QUrl::fromLocalFile(path) : UrlRoute::pathToUrl(path, scheme), newResults);
+
+    addResults(newResults);
+}
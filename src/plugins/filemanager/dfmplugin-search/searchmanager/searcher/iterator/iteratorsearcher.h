@@ -8,6 +8,7 @@
 #include "dfm-base/dfm_base_global.h"
 #include "searchmanager/searcher/abstractsearcher.h"
 
+#include <QFutureWatcher>
 #include <QMutex>
 #include <QRegularExpression>
 #include <QSharedPointer>
@@ -17,6 +18,8 @@
 #include <QTimer>
 #include <QAtomicInt>
 
+#include <atomic>
+
 DFMBASE_BEGIN_NAMESPACE
 class AbstractDirIterator;
 DFMBASE_END_NAMESPACE
@@ -25,6 +28,7 @@ DPSEARCH_BEGIN_NAMESPACE
 
 // 前向声明
 class IteratorSearcherBridge;
+class LocalTreeWalker;
 
 class IteratorSearcher : public AbstractSearcher
 {
@@ -59,6 +63,13 @@ public slots:
     // 处理目录
     void processDirectory();
 
+    // 本地目录遍历器的结果与完成通知
+    void onWalkerResultsAvailable();
+    void onWalkerFinished();
+
+    // 文件名索引查询完成
+    void onIndexQueryFinished();
+
 private:
     // 处理迭代器结果
     void processIteratorResults(QSharedPointer<DFMBASE_NAMESPACE::AbstractDirIterator> iterator);
@@ -75,16 +86,30 @@ private:
     // 发布批量结果
     void publishBatchedResults();
 
+    // 本地路径使用多线程遍历器，不经过主线程创建迭代器
+    static QString localSearchPath(const QUrl &url);
+    void startLocalWalk(const QString &localPath);
+    bool startIndexQuery(const QString &localPath);
+    void addLocalResults(const QStringList &paths);
+
 private:
     QAtomicInt status = kReady;
     DFMSearchResultMap resultMap;
     mutable QMutex mutex;
     QRegularExpression regex;
+    QString initialsKey;   // 纯字母关键字同时按拼音首字母匹配
     QQueue<QUrl> pendingDirs;
     
     // 用于主线程与工作线程间通信的桥接对象
     QSharedPointer<IteratorSearcherBridge> bridge;
 
+    // 本地路径的多线程遍历器
+    LocalTreeWalker *walker { nullptr };
+
+    // 挂载点已有文件名索引时直接查询索引，不再遍历
+    QFutureWatcher<QStringList> *indexWatcher { nullptr };
+    QSharedPointer<std::atomic_bool> indexCancelled;
+
     // 批量处理相关
     QTimer *batchTimer;               // 批量定时器
     DFMSearchResultMap batchedResults; // 批量结果
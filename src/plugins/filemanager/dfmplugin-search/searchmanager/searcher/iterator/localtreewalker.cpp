@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localtreewalker.h"
+
+#include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/chinese2pinyin.h>
+
+#include <QFile>
+#include <QThread>
+
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+DFMBASE_USE_NAMESPACE
+DPSEARCH_USE_NAMESPACE
+
+static constexpr int kDentsBufferSize { 32 * 1024 };
+static constexpr int kMaxWalkerThreads { 8 };
+static constexpr unsigned long kIdleWaitMsecs { 5 };
+static constexpr char kDesktopSuffix[] { ".desktop" };
+
+namespace {
+struct LinuxDirent64
+{
+    ino64_t d_ino;
+    off64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+}   // namespace
+
+LocalTreeWalker::LocalTreeWalker(const QString &rootPath, const QRegularExpression &regex,
+                                 const QString &initialsKey, QObject *parent)
+    : QObject(parent),
+      rootPath(QFile::encodeName(rootPath)),
+      regex(regex),
+      initialsKey(initialsKey)
+{
+}
+
+LocalTreeWalker::~LocalTreeWalker()
+{
+    stop();
+    threadPool.waitForDone();
+}
+
+void LocalTreeWalker::start(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = qBound(2, QThread::idealThreadCount(), kMaxWalkerThreads);
+
+    queues.clear();
+    for (int i = 0; i < threadCount; ++i)
+        queues.emplace_back(new WorkQueue);
+
+    threadPool.setMaxThreadCount(threadCount);
+    runningWorkers = threadCount;
+    pushDirectory(0, rootPath);
+
+    fmInfo() << "Local tree walk started for:" << QFile::decodeName(rootPath) << "threads:" << threadCount;
+    for (int i = 0; i < threadCount; ++i)
+        threadPool.start([this, i] { run(i); });
+}
+
+void LocalTreeWalker::stop()
+{
+    stopped = true;
+    QMutexLocker lk(&idleLock);
+    workAvailable.wakeAll();
+}
+
+bool LocalTreeWalker::wait(int msecs)
+{
+    return threadPool.waitForDone(msecs);
+}
+
+bool LocalTreeWalker::isFinished() const
+{
+    return runningWorkers.load() == 0;
+}
+
+QStringList LocalTreeWalker::takeResults()
+{
+    QMutexLocker lk(&resultLock);
+    QStringList taken;
+    taken.swap(results);
+    return taken;
+}
+
+void LocalTreeWalker::run(int index)
+{
+    // 正则对象在各线程中各持有一份，避免共享匹配状态
+    const QRegularExpression matcher = regex;
+    QByteArray dir;
+    while (!stopped) {
+        if (takeDirectory(index, &dir)) {
+            walkDirectory(index, dir, matcher);
+            if (outstanding.fetch_sub(1) == 1) {
+                QMutexLocker lk(&idleLock);
+                workAvailable.wakeAll();
+            }
+            continue;
+        }
+
+        if (outstanding.load() == 0)
+            break;
+
+        // 其它线程仍在遍历，可能很快产生新的子目录
+        QMutexLocker lk(&idleLock);
+        if (!stopped && outstanding.load() > 0)
+            workAvailable.wait(&idleLock, kIdleWaitMsecs);
+    }
+
+    if (runningWorkers.fetch_sub(1) == 1) {
+        fmInfo() << "Local tree walk finished for:" << QFile::decodeName(rootPath) << "stopped:" << stopped.load();
+        Q_EMIT finished();
+    }
+}
+
+/*!
+ * \brief LocalTreeWalker::takeDirectory 先从自己队列的队尾取，再从其它队列的队首窃取
+ */
+bool LocalTreeWalker::takeDirectory(int index, QByteArray *dir)
+{
+    {
+        auto &own = *queues[static_cast<size_t>(index)];
+        QMutexLocker lk(&own.lock);
+        if (!own.dirs.empty()) {
+            *dir = std::move(own.dirs.back());
+            own.dirs.pop_back();
+            return true;
+        }
+    }
+
+    const int count = static_cast<int>(queues.size());
+    for (int i = 1; i < count; ++i) {
+        auto &victim = *queues[static_cast<size_t>((index + i) % count)];
+        QMutexLocker lk(&victim.lock);
+        if (!victim.dirs.empty()) {
+            *dir = std::move(victim.dirs.front());
+            victim.dirs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void LocalTreeWalker::pushDirectory(int index, QByteArray dir)
+{
+    outstanding.fetch_add(1);
+    {
+        auto &own = *queues[static_cast<size_t>(index)];
+        QMutexLocker lk(&own.lock);
+        own.dirs.push_back(std::move(dir));
+    }
+    workAvailable.wakeOne();
+}
+
+void LocalTreeWalker::walkDirectory(int index, const QByteArray &path, const QRegularExpression &matcher)
+{
+    const int fd = ::open(path.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    const QByteArray prefix = path.endsWith('/') ? path : path + '/';
+    alignas(LinuxDirent64) char buffer[kDentsBufferSize];
+    QStringList matched;
+
+    while (!stopped) {
+        const long bytes = ::syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (bytes <= 0)
+            break;
+
+        for (long pos = 0; pos < bytes;) {
+            const auto *entry = reinterpret_cast<const LinuxDirent64 *>(buffer + pos);
+            pos += entry->d_reclen;
+
+            const char *name = entry->d_name;
+            // 跳过 . 和 .. 以及隐藏文件
+            if (name[0] == '.')
+                continue;
+
+            unsigned char type = entry->d_type;
+            if (type == DT_UNKNOWN) {
+                struct stat st;
+                if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+                    continue;
+                type = S_ISDIR(st.st_mode) ? DT_DIR : (S_ISLNK(st.st_mode) ? DT_LNK : DT_REG);
+            }
+
+            const size_t length = strlen(name);
+            if (type == DT_DIR) {
+                QByteArray childPath = prefix + QByteArray(name, static_cast<int>(length));
+                if (!childPath.startsWith("/sys/"))
+                    pushDirectory(index, std::move(childPath));
+            }
+
+            const QString &fileName = QFile::decodeName(QByteArray::fromRawData(name, static_cast<int>(length)));
+            bool hit = matcher.match(fileName).hasMatch()
+                    || (!initialsKey.isEmpty() && Pinyin::matchInitials(fileName, initialsKey, false));
+            const QString filePath = hit || fileName.endsWith(kDesktopSuffix)
+                    ? QFile::decodeName(prefix + QByteArray(name, static_cast<int>(length)))
+                    : QString();
+            if (!hit && !filePath.isEmpty()) {
+                // desktop 文件按显示名称匹配，只有这类文件才需要构造 FileInfo
+                const auto &info = InfoFactory::create<FileInfo>(QUrl::fromLocalFile(filePath));
+                hit = info && matcher.match(info->displayOf(DisPlayInfoType::kFileDisplayName)).hasMatch();
+            }
+
+            if (hit)
+                matched.append(filePath);
+        }
+    }
+
+    ::close(fd);
+    if (!matched.isEmpty())
+        appendResults(&matched);
+}
+
+void LocalTreeWalker::appendResults(QStringList *matched)
+{
+    bool wasEmpty = false;
+    {
+        QMutexLocker lk(&resultLock);
+        wasEmpty = results.isEmpty();
+        results.append(*matched);
+    }
+
+    if (wasEmpty)
+        Q_EMIT resultsAvailable();
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALTREEWALKER_H
+#define LOCALTREEWALKER_H
+
+#include "dfmplugin_search_global.h"
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/*!
+ * \brief The LocalTreeWalker class 多线程遍历本地目录树并按文件名匹配
+ *
+ * 直接使用 getdents64 读取目录项，d_type 未知时才调用 fstatat，文件名在构造任何 FileInfo 之前
+ * 就完成正则匹配。每个线程有自己的目录队列，从队尾取出自己发现的子目录（深度优先，局部性好），
+ * 空闲时从其它线程队列的队首窃取（靠近根的大目录），使负载均衡且不需要经过 GUI 线程。
+ * 与原 IteratorSearcher 一致：不跟随符号链接目录，跳过隐藏文件和 /sys。
+ */
+class LocalTreeWalker : public QObject
+{
+    Q_OBJECT
+public:
+    // initialsKey 非空时，文件名的拼音首字母包含它也视为匹配
+    explicit LocalTreeWalker(const QString &rootPath, const QRegularExpression &regex,
+                             const QString &initialsKey = QString(), QObject *parent = nullptr);
+    ~LocalTreeWalker() override;
+
+    void start(int threadCount = 0);
+    void stop();
+    bool wait(int msecs = -1);
+    bool isFinished() const;
+
+    QStringList takeResults();
+
+Q_SIGNALS:
+    // 结果缓冲由空变为非空时发出，在遍历线程中发出
+    void resultsAvailable();
+    void finished();
+
+private:
+    struct WorkQueue
+    {
+        QMutex lock;
+        std::deque<QByteArray> dirs;
+    };
+
+    void run(int index);
+    bool takeDirectory(int index, QByteArray *dir);
+    void pushDirectory(int index, QByteArray dir);
+    void walkDirectory(int index, const QByteArray &path, const QRegularExpression &matcher);
+    void appendResults(QStringList *matched);
+
+    const QByteArray rootPath;
+    const QRegularExpression regex;
+    const QString initialsKey;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::atomic<qint64> outstanding { 0 };   // 已入队但尚未遍历完的目录数
+    std::atomic_bool stopped { false };
+    std::atomic_int runningWorkers { 0 };
+
+    QMutex idleLock;
+    QWaitCondition workAvailable;
+
+    QMutex resultLock;
+    QStringList results;
+
+    QThreadPool threadPool;
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // LOCALTREEWALKER_H
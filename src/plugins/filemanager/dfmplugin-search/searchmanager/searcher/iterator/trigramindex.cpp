@@ -0,0 +1,655 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "trigramindex.h"
+
+#include <dfm-base/utils/chinese2pinyin.h>
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+DPSEARCH_USE_NAMESPACE
+
+static constexpr char kMagic[8] { 'D', 'F', 'M', 'T', 'R', 'I', 'G', 'R' };
+static constexpr quint32 kVersion { 1 };
+static constexpr quint32 kMaxEntries { 16 * 1024 * 1024 };
+// 候选数乘以该倍数仍小于下一条倒排列表长度时，不再求交，直接用正则校验候选
+static constexpr quint64 kIntersectRatio { 128 };
+
+struct TrigramIndex::Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 entryCount;
+    quint32 slotCount;
+    quint32 reserved;
+    qint64 buildTime;
+    quint64 slotsOffset;
+    quint64 entriesOffset;
+    quint64 namesOffset;
+    quint64 namesSize;
+    quint64 postingsOffset;
+    quint64 postingsSize;
+};
+
+struct TrigramIndex::Entry
+{
+    quint32 parent;
+    quint32 nameOffset;
+    quint16 nameLength;
+    quint16 flags;
+};
+
+struct TrigramIndex::Slot
+{
+    quint32 trigram;
+    quint32 count;
+    quint64 offset;   // 相对倒排区起始位置
+};
+
+namespace {
+struct PostingBuilder
+{
+    quint32 last { 0 };
+    quint32 count { 0 };
+    QByteArray data;
+};
+
+inline quint32 trigramOf(const char *p)
+{
+    return (static_cast<quint32>(static_cast<uchar>(p[0])) << 16)
+            | (static_cast<quint32>(static_cast<uchar>(p[1])) << 8)
+            | static_cast<uchar>(p[2]);
+}
+
+// 索引和查询使用同样的大小写折叠，保证忽略大小写的正则不会因为预过滤而漏掉结果
+inline QByteArray foldedName(const QByteArray &name)
+{
+    return QFile::decodeName(name).toLower().toUtf8();
+}
+
+void appendVarint(QByteArray *out, quint32 value)
+{
+    while (value >= 0x80) {
+        out->append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out->append(static_cast<char>(value));
+}
+
+/*!
+ * \brief skipQuantifier 跳过 pos 处的量词（含懒惰/占有修饰符）
+ * \return 量词允许零次出现时返回 true
+ */
+bool skipQuantifier(const QString &pattern, int *pos, bool *isQuantifier = nullptr)
+{
+    const int size = pattern.size();
+    int i = *pos;
+    bool optional = false;
+    if (isQuantifier)
+        *isQuantifier = false;
+    if (i >= size)
+        return false;
+
+    const QChar c = pattern.at(i);
+    if (c == '?' || c == '*') {
+        optional = true;
+        ++i;
+    } else if (c == '+') {
+        ++i;
+    } else if (c == '{') {
+        const int end = pattern.indexOf('}', i);
+        if (end < 0)
+            return false;
+        const QString &range = pattern.mid(i + 1, end - i - 1);
+        optional = range.startsWith('0') || range.startsWith(',');
+        i = end + 1;
+    } else {
+        return false;
+    }
+
+    if (i < size && (pattern.at(i) == '?' || pattern.at(i) == '+'))
+        ++i;
+    *pos = i;
+    if (isQuantifier)
+        *isQuantifier = true;
+    return optional;
+}
+}   // namespace
+
+TrigramIndex::~TrigramIndex()
+{
+    if (data)
+        file.unmap(const_cast<uchar *>(data));
+}
+
+/*!
+ * \brief TrigramIndex::build 遍历挂载点并写出索引文件
+ * \param directories 输出遍历到的目录，供调用方添加 inotify 监听
+ * \param maxDirectories 大于 0 时，目录数超过该值即放弃构建（此时 directories 比上限多一项）
+ */
+bool TrigramIndex::build(const QString &mountPoint, const QString &indexFile,
+                         const std::atomic_bool &cancelled, QList<QByteArray> *directories,
+                         int maxDirectories)
+{
+    const QByteArray root = QFile::encodeName(mountPoint);
+    struct stat rootStat;
+    if (::stat(root.constData(), &rootStat) != 0 || !S_ISDIR(rootStat.st_mode))
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<Entry> entryTable;
+    QByteArray nameData;
+    QHash<quint32, PostingBuilder> postingTable;
+    std::vector<quint32> nameTrigrams;
+
+    // 根节点的名称保存挂载点的完整路径
+    entryTable.push_back({ 0, 0, static_cast<quint16>(root.size()), 1 });
+    nameData.append(root);
+
+    std::vector<std::pair<QByteArray, quint32>> pending { { root, 0 } };
+    int directoryCount = 0;
+    while (!pending.empty()) {
+        if (cancelled)
+            return false;
+
+        const std::pair<QByteArray, quint32> current = std::move(pending.back());
+        pending.pop_back();
+
+        DIR *dir = ::opendir(current.first.constData());
+        if (!dir)
+            continue;
+        if (directories)
+            directories->append(current.first);
+        if (maxDirectories > 0 && ++directoryCount > maxDirectories) {
+            ::closedir(dir);
+            fmInfo() << "Trigram index aborted, more than" << maxDirectories << "directories under:" << mountPoint;
+            return false;
+        }
+
+        const QByteArray &prefix = current.first.endsWith('/') ? current.first : current.first + '/';
+        while (const dirent *entry = ::readdir(dir)) {
+            const char *name = entry->d_name;
+            // 跳过 . 和 .. 以及隐藏文件，与 LocalTreeWalker 保持一致
+            if (name[0] == '.')
+                continue;
+
+            bool isDir = entry->d_type == DT_DIR;
+            struct stat st;
+            if (entry->d_type == DT_UNKNOWN || isDir) {
+                if (::fstatat(::dirfd(dir), name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+                    continue;
+                isDir = S_ISDIR(st.st_mode);
+            }
+
+            const int length = static_cast<int>(strlen(name));
+            const quint32 id = static_cast<quint32>(entryTable.size());
+            entryTable.push_back({ current.second, static_cast<quint32>(nameData.size()),
+                                   static_cast<quint16>(length), static_cast<quint16>(isDir ? 1 : 0) });
+            nameData.append(name, length);
+
+            const QByteArray &folded = foldedName(QByteArray::fromRawData(name, length));
+            nameTrigrams.clear();
+            for (int i = 0; i + 3 <= folded.size(); ++i)
+                nameTrigrams.push_back(trigramOf(folded.constData() + i));
+            std::sort(nameTrigrams.begin(), nameTrigrams.end());
+            nameTrigrams.erase(std::unique(nameTrigrams.begin(), nameTrigrams.end()), nameTrigrams.end());
+            for (quint32 trigram : nameTrigrams) {
+                PostingBuilder &posting = postingTable[trigram];
+                appendVarint(&posting.data, id - posting.last);
+                posting.last = id;
+                ++posting.count;
+            }
+
+            // 不跨越挂载点，其它设备上的目录由各自的索引负责
+            if (isDir && st.st_dev == rootStat.st_dev)
+                pending.emplace_back(prefix + QByteArray(name, length), id);
+
+            if (entryTable.size() >= kMaxEntries) {
+                ::closedir(dir);
+                fmWarning() << "Trigram index aborted, too many entries under:" << mountPoint;
+                return false;
+            }
+        }
+        ::closedir(dir);
+    }
+
+    QList<quint32> trigrams = postingTable.keys();
+    std::sort(trigrams.begin(), trigrams.end());
+
+    std::vector<Slot> slotData;
+    slotData.reserve(static_cast<size_t>(trigrams.size()));
+    quint64 postingsSize = 0;
+    for (quint32 trigram : trigrams) {
+        const PostingBuilder &posting = postingTable[trigram];
+        slotData.push_back({ trigram, posting.count, postingsSize });
+        postingsSize += static_cast<quint64>(posting.data.size());
+    }
+
+    Header header {};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.entryCount = static_cast<quint32>(entryTable.size());
+    header.slotCount = static_cast<quint32>(slotData.size());
+    header.buildTime = QDateTime::currentMSecsSinceEpoch();
+    header.slotsOffset = sizeof(Header);
+    header.entriesOffset = header.slotsOffset + slotData.size() * sizeof(Slot);
+    header.namesOffset = header.entriesOffset + entryTable.size() * sizeof(Entry);
+    header.namesSize = static_cast<quint64>(nameData.size());
+    header.postingsOffset = header.namesOffset + header.namesSize;
+    header.postingsSize = postingsSize;
+
+    QSaveFile out(indexFile);
+    if (!out.open(QIODevice::WriteOnly)) {
+        fmWarning() << "Cannot write trigram index:" << indexFile << out.errorString();
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(slotData.data()), static_cast<qint64>(slotData.size() * sizeof(Slot)));
+    out.write(reinterpret_cast<const char *>(entryTable.data()), static_cast<qint64>(entryTable.size() * sizeof(Entry)));
+    out.write(nameData);
+    for (quint32 trigram : trigrams)
+        out.write(postingTable[trigram].data);
+
+    if (cancelled) {
+        out.cancelWriting();
+        return false;
+    }
+    if (!out.commit()) {
+        fmWarning() << "Cannot commit trigram index:" << indexFile << out.errorString();
+        return false;
+    }
+
+    fmInfo() << "Trigram index built for:" << mountPoint << "entries:" << entryTable.size()
+             << "trigrams:" << slotData.size() << "elapsed:" << timer.elapsed() << "ms";
+    return true;
+}
+
+QSharedPointer<TrigramIndex> TrigramIndex::open(const QString &indexFile)
+{
+    QSharedPointer<TrigramIndex> index(new TrigramIndex);
+    index->file.setFileName(indexFile);
+    if (!index->file.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    index->size = index->file.size();
+    if (index->size < static_cast<qint64>(sizeof(Header)))
+        return nullptr;
+
+    index->data = index->file.map(0, index->size);
+    if (!index->data)
+        return nullptr;
+
+    const auto *header = reinterpret_cast<const Header *>(index->data);
+    if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+        fmWarning() << "Ignore trigram index with unknown format:" << indexFile;
+        return nullptr;
+    }
+
+    // 各段必须首尾相接并恰好覆盖整个文件
+    if (header->entryCount == 0
+        || header->slotsOffset != sizeof(Header)
+        || header->entriesOffset != header->slotsOffset + quint64(header->slotCount) * sizeof(Slot)
+        || header->namesOffset != header->entriesOffset + quint64(header->entryCount) * sizeof(Entry)
+        || header->postingsOffset != header->namesOffset + header->namesSize
+        || header->postingsOffset + header->postingsSize != static_cast<quint64>(index->size)) {
+        fmWarning() << "Ignore corrupted trigram index:" << indexFile;
+        return nullptr;
+    }
+
+    index->header = header;
+    index->slotTable = reinterpret_cast<const Slot *>(index->data + header->slotsOffset);
+    index->entries = reinterpret_cast<const Entry *>(index->data + header->entriesOffset);
+    index->names = reinterpret_cast<const char *>(index->data + header->namesOffset);
+    index->postingData = index->data + header->postingsOffset;
+    index->postingEnd = index->postingData + header->postingsSize;
+    return index;
+}
+
+QString TrigramIndex::mountPoint() const
+{
+    return QFile::decodeName(entryName(0));
+}
+
+qint64 TrigramIndex::buildTime() const
+{
+    return header->buildTime;
+}
+
+int TrigramIndex::entryCount() const
+{
+    return static_cast<int>(header->entryCount);
+}
+
+/*!
+ * \brief TrigramIndex::search 返回 underPath 下文件名匹配 regex 且仍然存在的文件路径
+ */
+QStringList TrigramIndex::search(const QRegularExpression &regex, const QString &underPath,
+                                 const std::atomic_bool &cancelled) const
+{
+    QStringList results;
+    bool scanAll = false;
+    const std::vector<quint32> &ids = candidates(requiredLiterals(regex.pattern()), &scanAll);
+    const QByteArray &prefix = QFile::encodeName(underPath.endsWith('/') ? underPath : underPath + '/');
+    QHash<quint32, QByteArray> dirCache;
+
+    auto check = [&](quint32 id) {
+        const QByteArray &name = entryName(id);
+        if (!name.isEmpty() && regex.match(QFile::decodeName(name)).hasMatch())
+            appendExisting(id, prefix, &dirCache, &results);
+    };
+
+    if (scanAll) {
+        for (quint32 id = 1; id < header->entryCount && !cancelled; ++id)
+            check(id);
+    } else {
+        for (quint32 id : ids) {
+            if (cancelled)
+                break;
+            check(id);
+        }
+    }
+    return results;
+}
+
+/*!
+ * \brief TrigramIndex::searchInitials 按拼音首字母匹配文件名，如 "wd" 匹配 "文档"
+ *
+ * 只有含汉字的文件名可能匹配，纯 ASCII 的文件名按字节跳过，不做解码。
+ */
+QStringList TrigramIndex::searchInitials(const QString &initials, const QString &underPath,
+                                         const std::atomic_bool &cancelled) const
+{
+    QStringList results;
+    const QByteArray &prefix = QFile::encodeName(underPath.endsWith('/') ? underPath : underPath + '/');
+    QHash<quint32, QByteArray> dirCache;
+
+    for (quint32 id = 1; id < header->entryCount && !cancelled; ++id) {
+        const QByteArray &name = entryName(id);
+        const bool ascii = std::all_of(name.cbegin(), name.cend(), [](char c) {
+            return static_cast<uchar>(c) < 0x80;
+        });
+        if (!ascii && Pinyin::matchInitials(QFile::decodeName(name), initials, false))
+            appendExisting(id, prefix, &dirCache, &results);
+    }
+    return results;
+}
+
+/*!
+ * \brief TrigramIndex::requiredLiterals 提取正则匹配时必须出现的字面量片段（已小写化）
+ *
+ * 只做保守分析：可选的字符和分组、字符类、环视以及含分支的分组都不产生字面量，
+ * 顶层含分支时返回空列表。返回的片段只用于预过滤，最终结果总是由正则本身校验。
+ */
+QList<QByteArray> TrigramIndex::requiredLiterals(const QString &pattern)
+{
+    struct Level
+    {
+        QList<QByteArray> literals;
+        bool alternation { false };
+        bool lookaround { false };
+    };
+
+    QList<Level> levels { Level() };
+    QString run;
+    auto flush = [&] {
+        if (!run.isEmpty())
+            levels.last().literals.append(run.toLower().toUtf8());
+        run.clear();
+    };
+
+    const int size = pattern.size();
+    int i = 0;
+    while (i < size) {
+        const QChar c = pattern.at(i);
+        QChar literal;
+        if (c == '\\') {
+            if (i + 1 >= size)
+                break;
+            const QChar next = pattern.at(i + 1);
+            i += 2;
+            if (next.unicode() < 128 && next.isLetterOrNumber()) {
+                // \d \w \b \A \z 等转义都不是字面量，\Q...\E 保守地整体跳过
+                flush();
+                if (next == 'Q') {
+                    const int end = pattern.indexOf(QLatin1String("\\E"), i);
+                    i = end < 0 ? size : end + 2;
+                } else if (i < size && pattern.at(i) == '{') {
+                    const int end = pattern.indexOf('}', i);
+                    i = end < 0 ? size : end + 1;
+                }
+                skipQuantifier(pattern, &i);
+                continue;
+            }
+            literal = next;
+        } else if (c == '[') {
+            int j = i + 1;
+            if (j < size && pattern.at(j) == '^')
+                ++j;
+            if (j < size && pattern.at(j) == ']')
+                ++j;
+            while (j < size && pattern.at(j) != ']') {
+                if (pattern.at(j) == '\\') {
+                    ++j;
+                } else if (pattern.at(j) == '[' && j + 1 < size && pattern.at(j + 1) == ':') {
+                    const int end = pattern.indexOf(QLatin1String(":]"), j + 2);
+                    j = end < 0 ? j : end + 1;
+                }
+                ++j;
+            }
+            i = j + 1;
+            flush();
+            skipQuantifier(pattern, &i);
+            continue;
+        } else if (c == '(') {
+            flush();
+            Level level;
+            ++i;
+            if (i < size && pattern.at(i) == '?') {
+                ++i;
+                if (i < size && (pattern.at(i) == '=' || pattern.at(i) == '!')) {
+                    level.lookaround = true;
+                    ++i;
+                } else if (i + 1 < size && pattern.at(i) == '<' && (pattern.at(i + 1) == '=' || pattern.at(i + 1) == '!')) {
+                    level.lookaround = true;
+                    i += 2;
+                } else if (i < size && (pattern.at(i) == '<' || pattern.at(i) == '\'' || pattern.at(i) == 'P')) {
+                    // 命名分组
+                    while (i < size && pattern.at(i) != '>' && pattern.at(i) != '\'')
+                        ++i;
+                    ++i;
+                } else {
+                    // 内联选项 (?i) 或 (?i:...)；扩展模式下空白不是字面量，放弃分析
+                    const int begin = i;
+                    while (i < size && pattern.at(i) != ':' && pattern.at(i) != ')')
+                        ++i;
+                    if (pattern.mid(begin, i - begin).contains('x'))
+                        return {};
+                    if (i < size && pattern.at(i) == ')') {
+                        ++i;
+                        continue;
+                    }
+                    ++i;
+                }
+            }
+            levels.append(level);
+            continue;
+        } else if (c == ')') {
+            flush();
+            ++i;
+            if (levels.size() == 1)
+                return {};
+            const Level level = levels.takeLast();
+            const bool optional = skipQuantifier(pattern, &i);
+            if (!optional && !level.alternation && !level.lookaround)
+                levels.last().literals.append(level.literals);
+            continue;
+        } else if (c == '|') {
+            flush();
+            levels.last().alternation = true;
+            ++i;
+            continue;
+        } else if (c == '.' || c == '^' || c == '$' || c == '*' || c == '+' || c == '?' || c == '{') {
+            flush();
+            if (c == '.' || c == '^' || c == '$')
+                ++i;
+            bool isQuantifier = false;
+            skipQuantifier(pattern, &i, &isQuantifier);
+            if (!isQuantifier && (c == '*' || c == '+' || c == '?' || c == '{'))
+                ++i;
+            continue;
+        } else {
+            literal = c;
+            ++i;
+        }
+
+        // 字符后跟量词时，可选则丢弃该字符，否则保留一次并截断片段
+        bool isQuantifier = false;
+        const bool optional = skipQuantifier(pattern, &i, &isQuantifier);
+        if (!isQuantifier) {
+            run.append(literal);
+            continue;
+        }
+        if (!optional)
+            run.append(literal);
+        flush();
+    }
+    flush();
+
+    if (levels.size() != 1 || levels.first().alternation)
+        return {};
+    return levels.first().literals;
+}
+
+std::vector<quint32> TrigramIndex::candidates(const QList<QByteArray> &literals, bool *scanAll) const
+{
+    std::vector<const Slot *> selected;
+    for (const QByteArray &literal : literals) {
+        for (int i = 0; i + 3 <= literal.size(); ++i) {
+            const Slot *slot = findSlot(trigramOf(literal.constData() + i));
+            // 必需的三元组不存在时不可能有匹配
+            if (!slot)
+                return {};
+            selected.push_back(slot);
+        }
+    }
+
+    if (selected.empty()) {
+        *scanAll = true;
+        return {};
+    }
+
+    std::sort(selected.begin(), selected.end(), [](const Slot *a, const Slot *b) {
+        return a->count < b->count;
+    });
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+    std::vector<quint32> result = postings(*selected.front());
+    for (size_t i = 1; i < selected.size() && !result.empty(); ++i) {
+        if (static_cast<quint64>(result.size()) * kIntersectRatio < selected[i]->count)
+            break;
+
+        const std::vector<quint32> &other = postings(*selected[i]);
+        std::vector<quint32> merged;
+        merged.reserve(std::min(result.size(), other.size()));
+        std::set_intersection(result.begin(), result.end(), other.begin(), other.end(), std::back_inserter(merged));
+        result.swap(merged);
+    }
+    return result;
+}
+
+std::vector<quint32> TrigramIndex::postings(const Slot &slot) const
+{
+    std::vector<quint32> ids;
+    ids.reserve(slot.count);
+    if (slot.offset >= header->postingsSize)
+        return ids;
+
+    const uchar *p = postingData + slot.offset;
+    quint32 id = 0;
+    for (quint32 n = 0; n < slot.count && p < postingEnd; ++n) {
+        quint32 delta = 0;
+        int shift = 0;
+        while (p < postingEnd && shift < 32) {
+            const uchar byte = *p++;
+            delta |= static_cast<quint32>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                break;
+            shift += 7;
+        }
+        id += delta;
+        if (id >= header->entryCount)
+            break;
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+const TrigramIndex::Slot *TrigramIndex::findSlot(quint32 trigram) const
+{
+    const Slot *end = slotTable + header->slotCount;
+    const Slot *it = std::lower_bound(slotTable, end, trigram, [](const Slot &slot, quint32 value) {
+        return slot.trigram < value;
+    });
+    return it != end && it->trigram == trigram ? it : nullptr;
+}
+
+QByteArray TrigramIndex::entryName(quint32 id) const
+{
+    if (id >= header->entryCount)
+        return {};
+
+    const Entry &entry = entries[id];
+    if (quint64(entry.nameOffset) + entry.nameLength > header->namesSize)
+        return {};
+    return QByteArray::fromRawData(names + entry.nameOffset, entry.nameLength);
+}
+
+QByteArray TrigramIndex::entryPath(quint32 id, QHash<quint32, QByteArray> *dirCache) const
+{
+    if (id == 0)
+        return QByteArray(entryName(0));
+    if (id >= header->entryCount)
+        return {};
+
+    // 父节点总是先于子节点写入，id 递减保证不会成环
+    const quint32 parent = entries[id].parent;
+    if (parent >= id)
+        return {};
+
+    auto it = dirCache->constFind(parent);
+    if (it == dirCache->constEnd())
+        it = dirCache->insert(parent, entryPath(parent, dirCache));
+
+    const QByteArray &dir = it.value();
+    if (dir.isEmpty())
+        return {};
+    return dir.endsWith('/') ? dir + entryName(id) : dir + '/' + entryName(id);
+}
+
+void TrigramIndex::appendExisting(quint32 id, const QByteArray &prefix, QHash<quint32, QByteArray> *dirCache,
+                                  QStringList *results) const
+{
+    const QByteArray &path = entryPath(id, dirCache);
+    if (!path.startsWith(prefix))
+        return;
+
+    // 索引生成之后删除的文件不应出现在结果中
+    struct stat st;
+    if (::lstat(path.constData(), &st) == 0)
+        results->append(QFile::decodeName(path));
+}
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include "dfmplugin_search_global.h"
+
+#include <QFile>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSharedPointer>
+#include <QStringList>
+
+#include <atomic>
+#include <vector>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/*!
+ * \brief The TrigramIndex class 单个挂载点的文件名三元组索引（只读快照）
+ *
+ * 索引文件由 build() 生成，open() 后通过 mmap 直接访问，不需要反序列化：
+ *   - 目录项表：父目录 id + 文件名在名称区中的位置，路径由父链拼接而成；
+ *   - 三元组表：按三元组排序，二分查找得到对应的倒排列表；
+ *   - 倒排列表：按 id 递增的差值 varint 编码。
+ * 三元组取自小写化后文件名的 UTF-8 字节。查询时从正则中提取必须出现的字面量，
+ * 对其三元组的倒排列表求交得到候选，再用原正则逐个校验文件名，所以子串、通配符和
+ * 正则表达式都走同一条路径；提取不到字面量（过短或包含分支）时退化为扫描全部文件名。
+ * 拼音首字母无法由三元组预过滤，searchInitials() 只扫描含非 ASCII 字符的文件名。
+ * 与 LocalTreeWalker 一致，不收录隐藏文件，不跨越到其它挂载点。
+ */
+class TrigramIndex
+{
+public:
+    ~TrigramIndex();
+
+    static bool build(const QString &mountPoint, const QString &indexFile,
+                      const std::atomic_bool &cancelled, QList<QByteArray> *directories,
+                      int maxDirectories = 0);
+    static QSharedPointer<TrigramIndex> open(const QString &indexFile);
+
+    QString mountPoint() const;
+    qint64 buildTime() const;
+    int entryCount() const;
+
+    QStringList search(const QRegularExpression &regex, const QString &underPath,
+                       const std::atomic_bool &cancelled) const;
+    QStringList searchInitials(const QString &initials, const QString &underPath,
+                               const std::atomic_bool &cancelled) const;
+
+    static QList<QByteArray> requiredLiterals(const QString &pattern);
+
+private:
+    struct Header;
+    struct Entry;
+    struct Slot;
+
+    TrigramIndex() = default;
+
+    std::vector<quint32> candidates(const QList<QByteArray> &literals, bool *scanAll) const;
+    std::vector<quint32> postings(const Slot &slot) const;
+    const Slot *findSlot(quint32 trigram) const;
+    QByteArray entryName(quint32 id) const;
+    QByteArray entryPath(quint32 id, QHash<quint32, QByteArray> *dirCache) const;
+    void appendExisting(quint32 id, const QByteArray &prefix, QHash<quint32, QByteArray> *dirCache,
+                        QStringList *results) const;
+
+    QFile file;
+    const uchar *data { nullptr };
+    qint64 size { 0 };
+    const Header *header { nullptr };
+    const Entry *entries { nullptr };
+    const char *names { nullptr };
+    const Slot *slotTable { nullptr };
+    const uchar *postingData { nullptr };
+    const uchar *postingEnd { nullptr };
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // TRIGRAMINDEX_H
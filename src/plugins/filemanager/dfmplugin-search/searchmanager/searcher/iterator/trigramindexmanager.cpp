@@ -0,0 +1,399 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "trigramindexmanager.h"
+
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QSocketNotifier>
+#include <QStorageInfo>
+#include <QThread>
+
+#include <cerrno>
+
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+DFMBASE_USE_NAMESPACE
+DPSEARCH_USE_NAMESPACE
+
+static constexpr char kIndexDirName[] { "search-index" };
+static constexpr char kIndexSuffix[] { ".trigram" };
+static constexpr char kMaxWatchesFile[] { "/proc/sys/fs/inotify/max_user_watches" };
+static constexpr quint32 kWatchMask { IN_CREATE | IN_MOVED_TO | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK };
+static constexpr int kDefaultMaxWatches { 8192 };
+static constexpr int kDefaultWatchBudget { 4096 };
+// 最多占用系统监听上限的 1/kWatchShareDivisor，给其它程序留出余量
+static constexpr int kWatchShareDivisor { 8 };
+// 每批添加的监听数，批与批之间释放锁，查询和事件处理不会被长时间阻塞
+static constexpr int kWatchChunkSize { 256 };
+static constexpr int kMaxRecentEntries { 50000 };
+static constexpr int kMaxScanEntries { 4096 };
+// 索引不完整时两次重建之间的最小间隔
+static constexpr qint64 kRebuildIntervalMsecs { 10 * 60 * 1000 };
+
+// 网络文件系统遍历代价高且不支持 inotify，仍然使用普通遍历
+static const QStringList kSkippedFileSystems { "cifs", "smb3", "nfs", "nfs4", "fuse.gvfsd-fuse", "fuse.sshfs",
+                                               "proc", "sysfs", "devtmpfs", "cgroup2" };
+
+TrigramIndexManager *TrigramIndexManager::instance()
+{
+    static TrigramIndexManager ins;
+    return &ins;
+}
+
+bool TrigramIndexManager::isEnabled()
+{
+    return DConfigManager::instance()->value(DConfig::kSearchCfgPath,
+                                             DConfig::kEnableFileNameTrigramIndex, false)
+            .toBool();
+}
+
+TrigramIndexManager::TrigramIndexManager(QObject *parent)
+    : QObject(parent)
+{
+    buildPool.setMaxThreadCount(1);
+    watchBudget = readWatchBudget();
+
+    inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0)
+        fmWarning() << "Trigram index cannot create inotify instance, errno:" << errno;
+
+    // inotify 事件和新目录的遍历在独立线程中处理，notifier 必须在该线程中创建和销毁
+    eventThread.setObjectName("TrigramIndexEvents");
+    connect(&eventThread, &QThread::started, this, [this] {
+        if (inotifyFd < 0)
+            return;
+        notifier = new QSocketNotifier(inotifyFd, QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated, this, &TrigramIndexManager::onNotifierActivated);
+    }, Qt::DirectConnection);
+    connect(&eventThread, &QThread::finished, this, [this] {
+        delete notifier;
+        notifier = nullptr;
+    }, Qt::DirectConnection);
+    moveToThread(&eventThread);
+    eventThread.start(QThread::LowPriority);
+
+    if (qApp)
+        connect(qApp, &QCoreApplication::aboutToQuit, this, [this] { shutdown(); }, Qt::DirectConnection);
+}
+
+TrigramIndexManager::~TrigramIndexManager()
+{
+    shutdown();
+    if (inotifyFd >= 0)
+        ::close(inotifyFd);
+}
+
+/*!
+ * \brief TrigramIndexManager::acquire 获取 path 所在挂载点的索引快照
+ *
+ * 只有本次运行中构建完成且所有目录都已监听的索引才会返回，否则返回空快照（必要时在后台开始构建），
+ * 调用方应回退到目录遍历。
+ */
+TrigramIndexManager::Snapshot TrigramIndexManager::acquire(const QString &path)
+{
+    Snapshot snapshot;
+    if (!isEnabled() || shuttingDown)
+        return snapshot;
+
+    const QStorageInfo storage(path);
+    if (!storage.isValid() || !storage.isReady() || kSkippedFileSystems.contains(QString::fromLatin1(storage.fileSystemType())))
+        return snapshot;
+
+    QMutexLocker lk(&lock);
+    MountPointer &mount = mounts[storage.rootPath()];
+    if (!mount) {
+        mount.reset(new Mount);
+        mount->mountPoint = storage.rootPath();
+        mount->indexFile = indexFilePath(mount->mountPoint, storage.device());
+        scheduleBuildLocked(mount);
+    } else if (needsRebuildLocked(*mount)) {
+        scheduleBuildLocked(mount);
+    }
+
+    // 上次运行保存的索引与磁盘之间的变化无从得知，不用于查询
+    if (!mount->index || !mount->complete || mount->watching)
+        return snapshot;
+
+    snapshot.index = mount->index;
+    snapshot.recentPaths = mount->recent;
+    return snapshot;
+}
+
+void TrigramIndexManager::onNotifierActivated()
+{
+    alignas(inotify_event) char buffer[16 * 1024];
+    QList<WatchedDir> createdDirs;
+    while (!shuttingDown) {
+        const ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        QMutexLocker lk(&lock);
+        for (ssize_t pos = 0; pos < length;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + pos);
+            pos += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            handleEventLocked(event, &createdDirs);
+        }
+    }
+
+    // 新目录的遍历和监听不持有锁
+    for (const WatchedDir &created : std::as_const(createdDirs)) {
+        if (shuttingDown)
+            break;
+        collectCreated(created.first, created.second);
+    }
+}
+
+QString TrigramIndexManager::indexFilePath(const QString &mountPoint, const QByteArray &device)
+{
+    // 同一挂载点可能挂载不同的设备，文件名同时包含设备和挂载点
+    const QByteArray &key = QCryptographicHash::hash(device + '\0' + mountPoint.toUtf8(), QCryptographicHash::Md5).toHex();
+    const QDir dir(QDir(StandardPaths::location(StandardPaths::kCachePath)).filePath(kIndexDirName));
+    return dir.filePath(QString::fromLatin1(key) + kIndexSuffix);
+}
+
+int TrigramIndexManager::readWatchBudget()
+{
+    int budget = DConfigManager::instance()->value(DConfig::kSearchCfgPath,
+                                                   DConfig::kFileNameTrigramIndexMaxWatches, kDefaultWatchBudget)
+                         .toInt();
+    if (budget <= 0)
+        budget = kDefaultWatchBudget;
+
+    QFile maxWatches(kMaxWatchesFile);
+    bool ok = false;
+    int systemMax = 0;
+    if (maxWatches.open(QIODevice::ReadOnly))
+        systemMax = maxWatches.readAll().trimmed().toInt(&ok);
+    if (!ok || systemMax <= 0)
+        systemMax = kDefaultMaxWatches;
+
+    return qMin(budget, systemMax / kWatchShareDivisor);
+}
+
+void TrigramIndexManager::shutdown()
+{
+    shuttingDown = true;
+    if (eventThread.isRunning()) {
+        eventThread.quit();
+        eventThread.wait();
+    }
+    buildPool.waitForDone();
+}
+
+bool TrigramIndexManager::needsRebuildLocked(const Mount &mount) const
+{
+    if (mount.building || mount.unsupported)
+        return false;
+    if (mount.recent.size() > kMaxRecentEntries)
+        return true;
+    if (mount.index && mount.complete)
+        return false;
+    return QDateTime::currentMSecsSinceEpoch() - mount.lastBuild > kRebuildIntervalMsecs;
+}
+
+void TrigramIndexManager::scheduleBuildLocked(const MountPointer &mount)
+{
+    if (mount->building || mount->unsupported || shuttingDown)
+        return;
+
+    mount->building = true;
+    mount->lastBuild = QDateTime::currentMSecsSinceEpoch();
+    mount->recentAtBuildStart = mount->recent.size();
+
+    // 每个目录占用一个监听，目录数超过预算的挂载点不可能完整监听，遍历到预算即放弃
+    const int maxDirs = watchBudget;
+    buildPool.start([this, mount, maxDirs] {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+        QDir().mkpath(QFileInfo(mount->indexFile).absolutePath());
+
+        QList<QByteArray> dirs;
+        QSharedPointer<TrigramIndex> index;
+        if (TrigramIndex::build(mount->mountPoint, mount->indexFile, shuttingDown, &dirs, maxDirs))
+            index = TrigramIndex::open(mount->indexFile);
+
+        {
+            QMutexLocker lk(&lock);
+            if (!index) {
+                mount->building = false;
+                if (dirs.size() > maxDirs && !shuttingDown) {
+                    mount->unsupported = true;
+                    mount->index.reset();
+                    mount->complete = false;
+                    fmInfo() << "Trigram index disabled for" << mount->mountPoint
+                             << ", directories exceed the watch budget:" << maxDirs;
+                } else {
+                    fmWarning() << "Trigram index unavailable for:" << mount->mountPoint;
+                }
+                return;
+            }
+
+            // 构建开始前记录的增量已经包含在新索引中；监听期间的溢出或目录移动会把 complete 置为 false
+            mount->index = index;
+            mount->recent = mount->recent.mid(mount->recentAtBuildStart);
+            mount->complete = true;
+            mount->watching = true;
+        }
+
+        const bool watched = watchDirectories(mount, dirs);
+
+        QMutexLocker lk(&lock);
+        mount->complete = mount->complete && watched;
+        mount->watching = false;
+        mount->building = false;
+        if (!mount->complete)
+            fmWarning() << "Trigram index for" << mount->mountPoint << "is not fully watched, watches:" << watches.size()
+                        << "budget:" << watchBudget;
+    });
+}
+
+/*!
+ * \brief TrigramIndexManager::watchDirectories 分批添加目录监听，添加过程中不持有锁
+ * \return 全部目录都已监听时返回 true
+ */
+bool TrigramIndexManager::watchDirectories(const MountPointer &mount, const QList<QByteArray> &dirs)
+{
+    if (inotifyFd < 0)
+        return false;
+
+    for (int begin = 0; begin < dirs.size();) {
+        if (shuttingDown)
+            return false;
+
+        int remaining = 0;
+        {
+            QMutexLocker lk(&lock);
+            remaining = watchBudget - watches.size();
+        }
+        if (remaining <= 0)
+            return false;
+
+        const int end = qMin(dirs.size(), begin + qMin(remaining, kWatchChunkSize));
+        QList<QPair<int, QByteArray>> added;
+        bool exhausted = false;
+        for (; begin < end; ++begin) {
+            const QByteArray &dir = dirs.at(begin);
+            const int wd = ::inotify_add_watch(inotifyFd, dir.constData(), kWatchMask);
+            if (wd < 0) {
+                if (errno == ENOSPC) {
+                    exhausted = true;
+                    break;
+                }
+                continue;
+            }
+            added.append({ wd, dir });
+        }
+
+        QMutexLocker lk(&lock);
+        // 同一目录重复添加时返回相同的 wd，这里顺便更新为当前路径
+        for (const auto &watch : std::as_const(added))
+            watches.insert(watch.first, { mount, watch.second });
+        if (exhausted)
+            return false;
+    }
+    return true;
+}
+
+void TrigramIndexManager::handleEventLocked(const inotify_event *event, QList<WatchedDir> *createdDirs)
+{
+    if (event->mask & IN_Q_OVERFLOW) {
+        for (const MountPointer &mount : std::as_const(mounts))
+            mount->complete = false;
+        return;
+    }
+
+    auto it = watches.find(event->wd);
+    if (it == watches.end())
+        return;
+
+    const MountPointer mount = it->first;
+    if (event->mask & IN_IGNORED) {
+        watches.erase(it);
+        return;
+    }
+
+    // 目录被移动后，记录的路径失效
+    if (event->mask & IN_MOVE_SELF) {
+        mount->complete = false;
+        return;
+    }
+
+    // 卸载后同一挂载点可能挂载其它设备，下次查询时重新识别
+    if (event->mask & IN_UNMOUNT) {
+        if (mounts.value(mount->mountPoint) == mount)
+            mounts.remove(mount->mountPoint);
+        return;
+    }
+
+    if (!(event->mask & (IN_CREATE | IN_MOVED_TO)) || event->len == 0 || event->name[0] == '.')
+        return;
+
+    const QByteArray &dir = it->second;
+    const QByteArray &path = (dir.endsWith('/') ? dir : dir + '/') + QByteArray(event->name);
+    mount->recent.append(QFile::decodeName(path));
+    if (event->mask & IN_ISDIR)
+        createdDirs->append({ mount, path });
+}
+
+/*!
+ * \brief TrigramIndexManager::collectCreated 记录新目录中已有的内容并监听其中的目录，在事件线程中执行
+ */
+void TrigramIndexManager::collectCreated(const MountPointer &mount, const QByteArray &path)
+{
+    QList<QByteArray> pending { path };
+    QList<QByteArray> dirs;
+    QStringList children;
+    bool truncated = false;
+    while (!pending.isEmpty() && !truncated) {
+        const QByteArray dirPath = pending.takeLast();
+        DIR *dir = ::opendir(dirPath.constData());
+        if (!dir)
+            continue;
+        dirs.append(dirPath);
+
+        while (const dirent *entry = ::readdir(dir)) {
+            if (entry->d_name[0] == '.')
+                continue;
+
+            // 移入的大目录交给下一次重建处理
+            if (children.size() >= kMaxScanEntries) {
+                truncated = true;
+                break;
+            }
+
+            const QByteArray &child = dirPath + '/' + QByteArray(entry->d_name);
+            children.append(QFile::decodeName(child));
+
+            bool childIsDir = entry->d_type == DT_DIR;
+            if (entry->d_type == DT_UNKNOWN) {
+                struct stat st;
+                childIsDir = ::lstat(child.constData(), &st) == 0 && S_ISDIR(st.st_mode);
+            }
+            if (childIsDir)
+                pending.append(child);
+        }
+        ::closedir(dir);
+    }
+
+    {
+        QMutexLocker lk(&lock);
+        mount->recent.append(children);
+        if (truncated)
+            mount->complete = false;
+    }
+
+    if (!watchDirectories(mount, dirs)) {
+        QMutexLocker lk(&lock);
+        mount->complete = false;
+    }
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TRIGRAMINDEXMANAGER_H
+#define TRIGRAMINDEXMANAGER_H
+
+#include "dfmplugin_search_global.h"
+#include "trigramindex.h"
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <QThreadPool>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+class QSocketNotifier;
+QT_END_NAMESPACE
+
+struct inotify_event;
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/*!
+ * \brief The TrigramIndexManager class 按挂载点管理文件名三元组索引
+ *
+ * 第一次在某个挂载点上回退到目录遍历时在后台构建索引，构建完成后分批为所有目录添加
+ * inotify 监听。索引生成之后新建或移入的文件记录在增量列表中，查询时与索引结果合并；
+ * 删除的文件在查询时通过 lstat 过滤。只有本次运行中构建且全部目录都已监听的索引才用于查询，
+ * 监听数超出预算、事件队列溢出或目录被移动后索引不再完整，查询回退到目录遍历，并触发
+ * 间隔受限的后台重建。目录数本身超过监听预算的挂载点永远无法完整监听，构建时一旦超出即放弃，
+ * 标记为不支持，本次运行中不再重建。inotify 事件和新目录的遍历都在独立的事件线程中处理，不占用 GUI 线程。
+ */
+class TrigramIndexManager : public QObject
+{
+    Q_OBJECT
+public:
+    struct Snapshot
+    {
+        QSharedPointer<TrigramIndex> index;
+        QStringList recentPaths;   // 索引生成之后新增的路径
+    };
+
+    static TrigramIndexManager *instance();
+    static bool isEnabled();
+
+    Snapshot acquire(const QString &path);
+
+private Q_SLOTS:
+    void onNotifierActivated();
+
+private:
+    struct Mount
+    {
+        QString mountPoint;
+        QString indexFile;
+        QSharedPointer<TrigramIndex> index;
+        QStringList recent;
+        int recentAtBuildStart { 0 };
+        bool building { false };
+        bool watching { false };   // 新索引的目录监听尚未全部添加
+        bool complete { false };
+        bool unsupported { false };   // 目录数超过监听预算，只使用目录遍历
+        qint64 lastBuild { 0 };
+    };
+    using MountPointer = QSharedPointer<Mount>;
+    using WatchedDir = QPair<MountPointer, QByteArray>;
+
+    explicit TrigramIndexManager(QObject *parent = nullptr);
+    ~TrigramIndexManager() override;
+
+    static QString indexFilePath(const QString &mountPoint, const QByteArray &device);
+    static int readWatchBudget();
+    void shutdown();
+    bool needsRebuildLocked(const Mount &mount) const;
+    void scheduleBuildLocked(const MountPointer &mount);
+    bool watchDirectories(const MountPointer &mount, const QList<QByteArray> &dirs);
+    void handleEventLocked(const inotify_event *event, QList<WatchedDir> *createdDirs);
+    void collectCreated(const MountPointer &mount, const QByteArray &path);
+
+    QMutex lock;
+    QHash<QString, MountPointer> mounts;                     // 挂载点 -> 索引
+    QHash<int, WatchedDir> watches;                          // inotify wd -> (挂载点, 目录)
+    int inotifyFd { -1 };
+    int watchBudget { 0 };
+    QSocketNotifier *notifier { nullptr };
+
+    QThread eventThread;
+    QThreadPool buildPool;
+    std::atomic_bool shuttingDown { false };
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // TRIGRAMINDEXMANAGER_H
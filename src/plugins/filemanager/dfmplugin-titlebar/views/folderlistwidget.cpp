@@ -289,10 +289,10 @@ bool FolderListWidgetPrivate::matchText(const QString &source, const QString &in
 
     if (sourceLower.startsWith(inputLower))
         return true;
-    // 上面的英文未匹配，使用拼音再匹配一次
+    // 上面的英文未匹配，使用拼音再匹配一次，全拼或首字母均可
     if (input[0].isLetter()) {
         QString pinyinText = Pinyin::Chinese2Pinyin(source);
-        return pinyinText.toLower().startsWith(inputLower);
+        return pinyinText.toLower().startsWith(inputLower) || Pinyin::matchInitials(source, input);
     }
 
     return false;
@@ -530,9 +530,24 @@ void GroupingEngine::setGroupOrder(Qt::SortOrder order)
     }
 }
 
-void GroupingEngine::setVisibleTreeChildren(QHash<QUrl, QList<QUrl>> *children)
+void GroupingEngine::setVisibleTreeChildren(const QHash<QUrl, QVector<SortKeyStore::Id>> *children,
+                                            const QHash<QUrl, SortKeyStore> *stores)
 {
     m_visibleTreeChildren = children;
+    m_sortKeyStores = stores;
+}
+
+QList<QUrl> GroupingEngine::visibleTreeChildrenOf(const QUrl &parent) const
+{
+    if (!m_visibleTreeChildren || !m_sortKeyStores)
+        return {};
+
+    const auto idsIt = m_visibleTreeChildren->constFind(parent);
+    const auto storeIt = m_sortKeyStores->constFind(parent);
+    if (idsIt == m_visibleTreeChildren->constEnd() || storeIt == m_sortKeyStores->constEnd())
+        return {};
+
+    return storeIt->urls(idsIt.value());
 }
 
 void GroupingEngine::setChildrenDataMap(QHash<QUrl, FileItemDataPointer> *map)
@@ -764,7 +779,7 @@ bool GroupingEngine::isGroupVisibleWithConversion(const QString &groupKey,
 QList<FileItemDataPointer> GroupingEngine::findExpandedFiles(const FileItemDataPointer &file) const
 {
     // 1. --- 前置安全检查 ---
-    if (!m_visibleTreeChildren || !m_childrenDataMap || file.isNull()) {
+    if (!m_visibleTreeChildren || !m_sortKeyStores || !m_childrenDataMap || file.isNull()) {
         return {};   // 如果初始节点未展开或数据结构无效，则其下没有任何“展开的文件”
     }
 
@@ -784,13 +799,10 @@ QList<FileItemDataPointer> GroupingEngine::findExpandedFiles(const FileItemDataP
 
     // 3. --- 遍历 ---
     // 遍历从`file`的直接子项开始，将它们压入栈中
-    auto initialChildrenIt = m_visibleTreeChildren->constFind(fileUrl);
-    if (initialChildrenIt != m_visibleTreeChildren->constEnd()) {
-        const QList<QUrl> &directChildren = initialChildrenIt.value();
-        // 使用反向迭代器将子项逆序压入栈中，以保证处理时是正序
-        for (auto it = directChildren.crbegin(); it != directChildren.crend(); ++it) {
-            urlsToProcess.push(*it);
-        }
+    const QList<QUrl> &directChildren = visibleTreeChildrenOf(fileUrl);
+    // 使用反向迭代器将子项逆序压入栈中，以保证处理时是正序
+    for (auto it = directChildren.crbegin(); it != directChildren.crend(); ++it) {
+        urlsToProcess.push(*it);
     }
 
     // 4. --- 迭代遍历 ---
@@ -821,13 +833,10 @@ QList<FileItemDataPointer> GroupingEngine::findExpandedFiles(const FileItemDataP
         bool currentItemIsExpanded = currentItem->data(ItemRoles::kItemTreeViewExpandedRole).toBool();
         if (currentItemIsExpanded) {
             // 如果是展开的，将其子项压入栈中，以便在后续迭代中处理
-            auto childrenIt = m_visibleTreeChildren->constFind(currentUrl);
-            if (childrenIt != m_visibleTreeChildren->constEnd()) {
-                const QList<QUrl> &childrenOfCurrent = childrenIt.value();
-                // 同样，将其子项逆序压入栈中
-                for (auto it = childrenOfCurrent.crbegin(); it != childrenOfCurrent.crend(); ++it) {
-                    urlsToProcess.push(*it);
-                }
+            const QList<QUrl> &childrenOfCurrent = visibleTreeChildrenOf(currentUrl);
+            // 同样，将其子项逆序压入栈中
+            for (auto it = childrenOfCurrent.crbegin(); it != childrenOfCurrent.crend(); ++it) {
+                urlsToProcess.push(*it);
             }
         }
     }
@@ -838,7 +847,7 @@ QList<FileItemDataPointer> GroupingEngine::findExpandedFiles(const FileItemDataP
 QUrl GroupingEngine::findTopLevelAncestorOf(const QUrl &anchorUrl) const
 {
     // --- 1. 前置安全与边界检查 ---
-    if (!m_visibleTreeChildren || m_visibleTreeChildren->isEmpty() || !anchorUrl.isValid()) {
+    if (!m_visibleTreeChildren || !m_sortKeyStores || m_visibleTreeChildren->isEmpty() || !anchorUrl.isValid()) {
         return QUrl();   // 数据无效
     }
 
@@ -848,7 +857,7 @@ QUrl GroupingEngine::findTopLevelAncestorOf(const QUrl &anchorUrl) const
     }
 
     // 检查 anchorUrl 是否本身就是顶层目录
-    const QList<QUrl> &rootChildren = m_visibleTreeChildren->value(m_rootUrl);
+    const QList<QUrl> &rootChildren = visibleTreeChildrenOf(m_rootUrl);
     if (rootChildren.contains(anchorUrl)) {
         return anchorUrl;
     }
@@ -857,7 +866,7 @@ QUrl GroupingEngine::findTopLevelAncestorOf(const QUrl &anchorUrl) const
     QHash<QUrl, QUrl> childToParentMap;
     for (auto it = m_visibleTreeChildren->constBegin(); it != m_visibleTreeChildren->constEnd(); ++it) {
         const QUrl &parent = it.key();
-        const QList<QUrl> &children = it.value();
+        const QList<QUrl> &children = visibleTreeChildrenOf(parent);
         for (const QUrl &child : children) {
             childToParentMap.insert(child, parent);
         }
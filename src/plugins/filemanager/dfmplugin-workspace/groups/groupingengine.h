@@ -8,6 +8,7 @@
 #include "dfmplugin_workspace_global.h"
 #include "groups/filegroupdata.h"
 #include "groups/groupedmodeldata.h"
+#include "utils/sortkeystore.h"
 
 #include <dfm-base/interfaces/abstractgroupstrategy.h>
 
@@ -159,9 +160,11 @@ public:
 
     /**
      * @brief Set the current visible tree children
-     * @param children The map of URLs to child URLs
+     * @param children The map of parent URLs to the sort key ids of their visible children
+     * @param stores The per-directory sort key stores the ids belong to
      */
-    void setVisibleTreeChildren(QHash<QUrl, QList<QUrl>> *children);
+    void setVisibleTreeChildren(const QHash<QUrl, QVector<SortKeyStore::Id>> *children,
+                                const QHash<QUrl, SortKeyStore> *stores);
 
     /**
      * @brief Set the children data map
@@ -253,6 +256,13 @@ private:
     QUrl findTopLevelAncestorOf(const QUrl &anchorUrl) const;
 
 private:
+    /**
+     * @brief Resolve the visible children of a tree node to URLs
+     * @param parent The parent directory URL
+     * @return The visible child URLs in display order
+     */
+    QList<QUrl> visibleTreeChildrenOf(const QUrl &parent) const;
+
     /**
      * @brief Get the group key for a set of files
      * @param filesToInsert List of files to determine group key from
@@ -323,7 +333,8 @@ private:
     QUrl m_rootUrl;
     Qt::SortOrder m_groupOrder = Qt::AscendingOrder;
     const QList<QUrl> *m_visibleChildren { nullptr };
-    const QHash<QUrl, QList<QUrl>> *m_visibleTreeChildren { nullptr };
+    const QHash<QUrl, QVector<SortKeyStore::Id>> *m_visibleTreeChildren { nullptr };
+    const QHash<QUrl, SortKeyStore> *m_sortKeyStores { nullptr };
     const QHash<QUrl, FileItemDataPointer> *m_childrenDataMap { nullptr };
     // for update
     UpdateMode m_updateMode { UpdateMode::kNoGrouping };
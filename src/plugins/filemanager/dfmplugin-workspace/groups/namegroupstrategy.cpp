@@ -128,9 +128,10 @@ QString NameGroupStrategy::classifyFirstCharacter(const QChar &ch) const
 
     // Check for Chinese characters
     if (isChinese(ch)) {
-        QString pinyin = getPinyin(ch);
+        // 直接查静态拼音表，不为每个字符构造字符串
+        const QLatin1String pinyin = Pinyin::syllableOf(ch.unicode());
         if (!pinyin.isEmpty()) {
-            char first = pinyin.at(0).toUpper().toLatin1();
+            char first = QChar(pinyin.front()).toUpper().toLatin1();
             if (first >= 'A' && first <= 'H') {
                 return "pinyin-A-H";
             } else if (first >= 'I' && first <= 'P') {
@@ -155,17 +156,9 @@ bool NameGroupStrategy::isChinese(const QChar &ch) const
 
 QString NameGroupStrategy::getPinyin(const QChar &ch) const
 {
-    // Use the existing Pinyin::Chinese2Pinyin function
-    QString singleChar = QString(ch);
-    QString pinyinResult = Pinyin::Chinese2Pinyin(singleChar);
-
-    if (!pinyinResult.isEmpty()) {
-        // The function returns a space-separated string, take the first word
-        QStringList pinyinWords = pinyinResult.split(' ', Qt::SkipEmptyParts);
-        if (!pinyinWords.isEmpty() && !pinyinWords.first().isEmpty()) {
-            return pinyinWords.first();
-        }
-    }
+    const QLatin1String pinyin = Pinyin::syllableOf(ch.unicode());
+    if (!pinyin.isEmpty())
+        return pinyin;
 
     fmDebug() << "NameGroupStrategy: Failed to convert Chinese character to pinyin:" << ch;
     return QString();   // Conversion failed
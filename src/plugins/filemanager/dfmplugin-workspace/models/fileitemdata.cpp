@@ -228,6 +228,10 @@ QVariant FileItemData::data(int role) const
         if (info)
             return info->displayOf(DisPlayInfoType::kFileDisplayPinyinName);
         return url.fileName();
+    case kItemFilePinyinInitialsRole:
+        if (info)
+            return info->displayOf(DisPlayInfoType::kFileDisplayPinyinInitials);
+        return url.fileName();
     case kItemFileBaseNameRole:
         if (info)
             return info->nameOf(NameInfoType::kCompleteBaseName);
@@ -22,6 +22,7 @@
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/base/application/application.h>
 #include <dfm-base/utils/thumbnail/thumbnailfactory.h>
+#include <dfm-base/utils/thumbnail/thumbnailcache.h>
 #include <dfm-base/utils/highlightprovider.h>
 #include <dfm-base/widgets/filemanagerwindowsmanager.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
@@ -55,6 +56,7 @@ FileViewModel::FileViewModel(QAbstractItemView *parent)
     // GroupingManager will be initialized when dirRootUrl is set in initFilterSortWork
 
     connect(ThumbnailFactory::instance(), &ThumbnailFactory::produceFinished, this, &FileViewModel::onFileThumbUpdated);
+    connect(ThumbnailFactory::instance(), &ThumbnailFactory::produceCanceled, this, &FileViewModel::onFileThumbCanceled);
     connect(HighlightProvider::instance(), &HighlightProvider::highlightReady, this, &FileViewModel::onHighlightReady);
     connect(Application::instance(), &Application::genericAttributeChanged, this, &FileViewModel::onGenericAttributeChanged);
     connect(Application::instance(), &Application::showedHiddenFilesChanged, this, &FileViewModel::onHiddenSettingChanged);
@@ -927,7 +929,9 @@ void FileViewModel::updateThumbnailIcon(const QModelIndex &index, const QString
     }
 
     // Creating thumbnail icon in a thread may cause the program to crash
-    QIcon thumbIcon(thumb);
+    // 优先使用生成线程中已解码的图像，避免在 GUI 线程重新读取和解码 PNG
+    const QImage &cached = ThumbnailCache::instance().image(thumb);
+    QIcon thumbIcon = cached.isNull() ? QIcon(thumb) : QIcon(QPixmap::fromImage(cached));
     if (thumbIcon.isNull()) {
         fmWarning() << "Cannot update thumbnail: icon is null for thumb:" << thumb;
         return;
@@ -1082,6 +1086,22 @@ void FileViewModel::onFileThumbUpdated(const QUrl &url, const QString &thumb)
     }
 }
 
+void FileViewModel::onFileThumbCanceled(const QUrl &url)
+{
+    auto index = getIndexByUrl(url);
+    if (!index.isValid())
+        return;
+
+    // 清除"已请求"标记，文件再次显示时重新请求缩略图
+    auto info = fileInfo(index);
+    if (!info)
+        return;
+
+    const auto &value = info->extendAttributes(ExtInfoType::kFileThumbnail);
+    if (value.isValid() && value.value<QIcon>().isNull())
+        info->setExtendedAttributes(ExtInfoType::kFileThumbnail, QVariant());
+}
+
 void FileViewModel::onHighlightReady(const QString &taskId, const QString &path, const QString &content)
 {
     Q_UNUSED(taskId)
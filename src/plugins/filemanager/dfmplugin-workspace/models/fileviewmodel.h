@@ -150,6 +150,7 @@ Q_SIGNALS:
 
 public Q_SLOTS:
     void onFileThumbUpdated(const QUrl &url, const QString &thumb);
+    void onFileThumbCanceled(const QUrl &url);
     void onHighlightReady(const QString &taskId, const QString &path, const QString &content);
     void onFileUpdated(int show);
     void onInsert(int firstIndex, int count);
@@ -15,6 +15,7 @@
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
 #include <dfm-base/utils/protocolutils.h>
+#include <dfm-base/utils/collation/collationstrategyprovider.h>
 
 #include <dfm-io/dfmio_utils.h>
 
@@ -32,6 +33,11 @@ using namespace dfmbase::Global;
 using namespace dfmio;
 
 namespace {
+// 监控事件合并窗口：空闲后的第一批事件立即处理，窗口内的后续事件缓存到窗口结束再处理
+constexpr int kWatcherCoalesceInterval { 100 };
+// 单次超过该数量的增删走批量路径：一次排序归并，只发一次区间或整体变更
+constexpr int kWatcherBatchThreshold { 64 };
+
 template<class T>
 void insertToList(QList<T> &list, int index, const T &t)
 {
@@ -70,6 +76,13 @@ FileSortWorker::FileSortWorker(const QUrl &url, const QString &key,
 
     connect(this, &FileSortWorker::requestSortByMimeType, this, &FileSortWorker::handleSortByMimeType,
             Qt::QueuedConnection);
+    // 排序策略变化后缓存的排序键全部失效，重排由 FileViewModel 触发
+    connect(dfmbase::CollationStrategyProvider::instance(), &dfmbase::CollationStrategyProvider::strategyChanged,
+            this, [this]() {
+                for (auto &store : children)
+                    store.invalidateKeys();
+            },
+            Qt::QueuedConnection);
 
     // Initialize grouping engine
     groupingEngine = std::make_unique<GroupingEngine>(current, this);
@@ -92,6 +105,10 @@ FileSortWorker::~FileSortWorker()
         updateRefresh->stop();
         updateRefresh = nullptr;
     }
+    if (watcherCoalesceTimer) {
+        watcherCoalesceTimer->stop();
+        watcherCoalesceTimer = nullptr;
+    }
 
     // 清理数据结构
     childrenDataMap.clear();
@@ -100,6 +117,7 @@ FileSortWorker::~FileSortWorker()
     visibleTreeChildren.clear();
     fileInfoRefresh.clear();
     waitUpdatedFiles.clear();
+    pendingWatcherEvents.clear();
 }
 
 FileSortWorker::GroupingOpt FileSortWorker::setGroupArguments(const Qt::SortOrder order,
@@ -485,15 +503,22 @@ void FileSortWorker::onShowHiddenFileChanged(bool isShow)
 
 void FileSortWorker::handleWatcherAddChildren(const QList<SortInfoPointer> &children)
 {
+    if (coalesceWatcherEvent(WatcherEventType::kWatcherAdd, children))
+        return;
+
     fmDebug() << "Handling watcher add children - count:" << children.size();
 
+    if (!istree && children.size() >= kWatcherBatchThreshold)
+        return addChildrenBatch(children);
+
     for (const auto &sortInfo : children) {
         if (isCanceled) {
             fmDebug() << "Operation canceled during watcher add children";
             return;
         }
 
-        if (this->children.value(makeParentUrl(sortInfo->fileUrl())).contains(sortInfo->fileUrl())) {
+        auto store = sortKeyStore(makeParentUrl(sortInfo->fileUrl()));
+        if (store && store->contains(sortInfo->fileUrl())) {
             auto data = childData(sortInfo->fileUrl());
             if (data && data->fileInfo())
                 data->fileInfo()->updateAttributes();
@@ -511,9 +536,14 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
         return;
     }
 
+    if (coalesceWatcherEvent(WatcherEventType::kWatcherRemove, children))
+        return;
+
     fmDebug() << "Handling watcher remove children - count:" << children.size();
 
     auto parentUrl = makeParentUrl(children.first()->fileUrl());
+    if (!istree && children.size() >= kWatcherBatchThreshold && UniversalUtils::urlEquals(parentUrl, current))
+        return removeChildrenBatch(children);
 
     for (const auto &sortInfo : children) {
         if (isCanceled) {
@@ -524,7 +554,7 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
         if (sortInfo.isNull())
             continue;
 
-        if (sortInfo->isDir() && visibleTreeChildren.keys().contains(sortInfo->fileUrl())) {
+        if (sortInfo->isDir() && visibleTreeChildren.contains(sortInfo->fileUrl())) {
             fmDebug() << "Removing subdirectory:" << sortInfo->fileUrl().toString();
             removeSubDir(sortInfo->fileUrl());
             continue;
@@ -537,11 +567,16 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
         if (isCanceled)
             return;
 
-        if (sortInfo.isNull() || !subChildren.contains(sortInfo->fileUrl()))
+        if (sortInfo.isNull())
+            continue;
+
+        // 先取 ID 再移除，移除后该 ID 可能被复用
+        const auto id = subChildren.id(sortInfo->fileUrl());
+        if (id == SortKeyStore::kInvalidId)
             continue;
 
         subChildren.remove(sortInfo->fileUrl());
-        subVisibleList.removeOne(sortInfo->fileUrl());
+        subVisibleList.removeOne(id);
 
         {
             QWriteLocker lk(&childrenDataLocker);
@@ -568,15 +603,262 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
     visibleTreeChildren.insert(parentUrl, subVisibleList);
 }
 
+/*!
+ * \brief FileSortWorker::coalesceWatcherEvent 突发期间缓存监控事件
+ * 空闲时的事件立即处理并开启合并窗口；窗口内到达的事件按到达顺序缓存，
+ * 相邻的同类且同一父目录的事件合并为一批，窗口结束时由 flushWatcherEvents 统一处理。
+ * 增删处理按批次第一项计算父目录，树形视图下不同目录的事件不能合并。
+ * \return true 表示事件已缓存，调用方不再处理
+ */
+bool FileSortWorker::coalesceWatcherEvent(const WatcherEventType type, const QList<SortInfoPointer> &children)
+{
+    if (flushingWatcherEvents || children.isEmpty() || isCanceled)
+        return false;
+
+    if (!watcherCoalesceTimer) {
+        watcherCoalesceTimer = new QTimer(this);
+        watcherCoalesceTimer->setSingleShot(true);
+        watcherCoalesceTimer->setInterval(kWatcherCoalesceInterval);
+        connect(watcherCoalesceTimer, &QTimer::timeout, this, &FileSortWorker::flushWatcherEvents);
+    }
+
+    if (!watcherCoalesceTimer->isActive()) {
+        watcherCoalesceTimer->start();
+        return false;
+    }
+
+    const QUrl parent = children.first() ? makeParentUrl(children.first()->fileUrl()) : current;
+    if (!pendingWatcherEvents.isEmpty() && pendingWatcherEvents.last().type == type
+        && UniversalUtils::urlEquals(pendingWatcherEvents.last().parent, parent))
+        pendingWatcherEvents.last().children.append(children);
+    else
+        pendingWatcherEvents.append({ type, parent, children });
+    return true;
+}
+
+void FileSortWorker::flushWatcherEvents()
+{
+    // 窗口内没有新事件，突发结束，下一次事件重新立即处理
+    if (pendingWatcherEvents.isEmpty() || isCanceled)
+        return;
+
+    const QList<WatcherEvent> events = std::move(pendingWatcherEvents);
+    pendingWatcherEvents.clear();
+
+    fmDebug() << "Flushing coalesced watcher events - batches:" << events.size();
+    flushingWatcherEvents = true;
+    for (const auto &event : events) {
+        if (isCanceled)
+            break;
+
+        switch (event.type) {
+        case WatcherEventType::kWatcherAdd:
+            handleWatcherAddChildren(event.children);
+            break;
+        case WatcherEventType::kWatcherRemove:
+            handleWatcherRemoveChildren(event.children);
+            break;
+        case WatcherEventType::kWatcherUpdate: {
+            // 持续写入的文件在一个窗口内会收到多次更新，只处理一次
+            QSet<QUrl> updated;
+            for (const auto &child : event.children) {
+                if (isCanceled)
+                    break;
+                if (!child || updated.contains(child->fileUrl()))
+                    continue;
+                updated.insert(child->fileUrl());
+                handleWatcherUpdateFile(child);
+            }
+            break;
+        }
+        }
+    }
+    flushingWatcherEvents = false;
+
+    // 仍处于突发中，继续合并下一个窗口
+    watcherCoalesceTimer->start();
+}
+
+/*!
+ * \brief FileSortWorker::flushPendingWatcherEvents 立即处理缓存的监控事件
+ * 不经过合并缓存的更新路径在处理前调用，避免越过尚未插入的新增文件或尚未移除的文件。
+ */
+void FileSortWorker::flushPendingWatcherEvents()
+{
+    if (!flushingWatcherEvents && !pendingWatcherEvents.isEmpty())
+        flushWatcherEvents();
+}
+
+/*!
+ * \brief FileSortWorker::addChildrenBatch 列表视图下批量添加监控到的新文件
+ * 新文件排序一次后与当前显示列表归并，新增项连续时发一次区间插入，否则整体重置显示列表。
+ */
+void FileSortWorker::addChildrenBatch(const QList<SortInfoPointer> &children)
+{
+    const auto depth = findDepth(current);
+    auto subChildren = this->children.take(current);
+    QVector<SortKeyStore::Id> newIds;
+    QList<SortInfoPointer> otherChildren;
+    for (const auto &sortInfo : children) {
+        if (sortInfo.isNull())
+            continue;
+
+        const QUrl &url = sortInfo->fileUrl();
+        if (!UniversalUtils::urlEquals(makeParentUrl(url), current)) {
+            otherChildren.append(sortInfo);
+            continue;
+        }
+
+        if (subChildren.contains(url)) {
+            auto data = childData(url);
+            if (data && data->fileInfo())
+                data->fileInfo()->updateAttributes();
+            continue;
+        }
+
+        const auto id = subChildren.insert(sortInfo);
+        createAndInsertItemData(depth, sortInfo, nullptr);
+        if (checkFilters(sortInfo, true))
+            newIds.append(id);
+    }
+    this->children.insert(current, subChildren);
+
+    for (const auto &sortInfo : otherChildren) {
+        if (isCanceled)
+            return;
+        addChild(sortInfo, SortScenarios::kSortScenariosWatcherAddFile);
+    }
+
+    // addChild 可能向 children 插入其他目录，存储指针在此之后再取
+    auto store = sortKeyStore(current);
+    if (newIds.isEmpty() || !store || isCanceled)
+        return;
+
+    const QVector<SortKeyStore::Id> oldList = visibleTreeChildren.value(current);
+    QVector<SortKeyStore::Id> newList;
+    if (orgSortRole == Global::ItemRoles::kItemDisplayRole) {
+        newList = oldList + newIds;
+    } else {
+        updateSorterContext();
+        newList = m_sorter.merge(oldList, m_sorter.sort(newIds, store), store);
+    }
+    if (isCanceled)
+        return;
+    visibleTreeChildren.insert(current, newList);
+
+    // 新增项在归并结果中是否连续
+    const QSet<SortKeyStore::Id> added(newIds.cbegin(), newIds.cend());
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < newList.size(); ++i) {
+        if (!added.contains(newList.at(i)))
+            continue;
+        if (first < 0)
+            first = i;
+        last = i;
+    }
+
+    fmDebug() << "Batch add watcher children - added:" << newIds.size() << "total:" << newList.size();
+    if (last - first + 1 == newIds.size())
+        insertVisibleChildren(first, store->urls(newList.mid(first, newIds.size())));
+    else
+        resetVisibleChildren(store->urls(newList));
+
+    // 与 addChild 一致：新建的文件到达后由视图决定是否选中并进入重命名
+    for (const auto id : newIds)
+        Q_EMIT selectAndEditFile(store->url(id));
+}
+
+/*!
+ * \brief FileSortWorker::removeChildrenBatch 列表视图下批量移除监控到的删除文件
+ * 被删除的显示项连续时发一次区间删除，否则整体重置显示列表。
+ */
+void FileSortWorker::removeChildrenBatch(const QList<SortInfoPointer> &children)
+{
+    auto subChildren = this->children.take(current);
+    QSet<QUrl> removed;
+    QSet<SortKeyStore::Id> removedIds;
+    for (const auto &sortInfo : children) {
+        if (sortInfo.isNull())
+            continue;
+
+        const auto id = subChildren.id(sortInfo->fileUrl());
+        if (id == SortKeyStore::kInvalidId)
+            continue;
+
+        subChildren.remove(sortInfo->fileUrl());
+        removed.insert(sortInfo->fileUrl());
+        removedIds.insert(id);
+    }
+    this->children.insert(current, subChildren);
+
+    if (removed.isEmpty())
+        return;
+
+    {
+        QWriteLocker lk(&childrenDataLocker);
+        for (const auto &url : removed)
+            childrenDataMap.remove(url);
+    }
+
+    QVector<SortKeyStore::Id> subVisibleList = visibleTreeChildren.take(current);
+    subVisibleList.erase(std::remove_if(subVisibleList.begin(), subVisibleList.end(),
+                                        [&removedIds](SortKeyStore::Id id) { return removedIds.contains(id); }),
+                         subVisibleList.end());
+    visibleTreeChildren.insert(current, subVisibleList);
+
+    const QList<QUrl> &visibleList = getChildrenUrls();
+    int first = -1;
+    int last = -1;
+    int count = 0;
+    for (int i = 0; i < visibleList.size(); ++i) {
+        if (!removed.contains(visibleList.at(i)))
+            continue;
+        if (first < 0)
+            first = i;
+        last = i;
+        ++count;
+    }
+    if (count == 0 || isCanceled)
+        return;
+
+    fmDebug() << "Batch remove watcher children - removed:" << removed.size() << "visible:" << count;
+    if (last - first + 1 == count)
+        removeVisibleChildren(first, count);
+    else
+        resetVisibleChildren(visibleTreeUrls(current));
+}
+
+void FileSortWorker::resetVisibleChildren(const QList<QUrl> &urls)
+{
+    const int oldCount = childrenCountInternal();
+    if (oldCount > 0) {
+        doModelChanged(ModelChangeType::kRemoveRows, 0, oldCount);
+        {
+            QWriteLocker lk(&locker);
+            visibleChildren.clear();
+        }
+        doModelChanged(ModelChangeType::kRemoveFinished);
+    }
+
+    if (!urls.isEmpty())
+        insertVisibleChildren(0, urls, InsertOpt::kInsertOptForce);
+}
+
 bool FileSortWorker::handleWatcherUpdateFile(const SortInfoPointer child)
 {
     if (isCanceled)
         return false;
 
+    flushPendingWatcherEvents();
+
     if (!child)
         return false;
 
-    if (!child->fileUrl().isValid() || !this->children.value(makeParentUrl(child->fileUrl())).contains(child->fileUrl()))
+    if (!child->fileUrl().isValid())
+        return false;
+    auto store = sortKeyStore(makeParentUrl(child->fileUrl()));
+    if (!store || !store->contains(child->fileUrl()))
         return false;
 
     FileInfoPointer info;
@@ -598,6 +880,9 @@ bool FileSortWorker::handleWatcherUpdateFile(const SortInfoPointer child)
 
 void FileSortWorker::handleWatcherUpdateFiles(const QList<SortInfoPointer> &children)
 {
+    if (coalesceWatcherEvent(WatcherEventType::kWatcherUpdate, children))
+        return;
+
     for (auto sort : children) {
         if (isCanceled)
             return;
@@ -609,12 +894,16 @@ void FileSortWorker::handleWatcherUpdateHideFile(const QUrl &hidUrl)
 {
     if (isCanceled)
         return;
+    flushPendingWatcherEvents();
     auto hiddenFileInfo = InfoFactory::create<FileInfo>(hidUrl);
     if (!hiddenFileInfo)
         return;
     auto hidlist = DFMUtils::hideListFromUrl(QUrl::fromLocalFile(hiddenFileInfo->pathOf(PathInfoType::kFilePath)));
     auto parentUrl = makeParentUrl(hidUrl);
-    for (const auto &child : children.value(parentUrl)) {
+    auto store = sortKeyStore(parentUrl);
+    if (!store)
+        return;
+    for (const auto &child : store->infos()) {
         if (isCanceled)
             return;
 
@@ -626,6 +915,7 @@ void FileSortWorker::handleWatcherUpdateHideFile(const QUrl &hidUrl)
         } else {
             child->setHide(hidlist.contains(fileName));
         }
+        store->refresh(child);
         auto info = item->fileInfo();
         if (!info)
             continue;
@@ -862,9 +1152,13 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    SortInfoPointer sortInfo = children.value(makeParentUrl(url)).value(url);
+    flushPendingWatcherEvents();
+
+    auto store = sortKeyStore(makeParentUrl(url));
+    SortInfoPointer sortInfo = store ? store->value(url) : nullptr;
     if (!sortInfo)
         return false;
+    store->refresh(sortInfo);
 
     bool childVisible = false;
     int childIndex = -1;
@@ -894,24 +1188,24 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
         int showIndex = findStartPos(parentUrl);
 
         // 插入到每个目录下的显示目录
+        const auto fileId = store->id(url);
         auto subVisibleList = visibleTreeChildren.take(parentUrl);
         auto offset = subVisibleList.count();
         if (orgSortRole != Global::ItemRoles::kItemDisplayRole)
-            offset = insertSortList(sortInfo->fileUrl(), subVisibleList);
+            offset = insertSortList(fileId, subVisibleList, store);
         auto subIndex = offset;
         // 根目录下的offset计算不一样
         if (UniversalUtils::urlEquals(parentUrl, current)) {
             if (offset >= subVisibleList.count() || offset == 0) {
                 offset = offset >= subVisibleList.count() ? childrenCountInternal() : 0;
             } else {
-                auto tmpUrl = offset >= subVisibleList.length() ? QUrl() : subVisibleList.at(offset);
-                offset = getChildShowIndexInternal(tmpUrl);
+                offset = getChildShowIndexInternal(store->url(subVisibleList.at(offset)));
                 if (offset < 0)
                     offset = childrenCountInternal();
             }
         }
 
-        insertToList(subVisibleList, subIndex, sortInfo->fileUrl());
+        insertToList(subVisibleList, subIndex, fileId);
 
         visibleTreeChildren.insert(parentUrl, subVisibleList);
 
@@ -920,7 +1214,7 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
 
         // 不为子目录中第一项的情况下，需要判断前面的项是否有展开
         if (subIndex != 0) {
-            QUrl preItemUrl = subVisibleList.at(subIndex - 1);
+            QUrl preItemUrl = store->url(subVisibleList.at(subIndex - 1));
             // 前一项展开的情况下，实际插入的位置应该在所有展开子项之后
             showIndex = findRealShowIndex(preItemUrl);
         }
@@ -956,6 +1250,9 @@ void FileSortWorker::handleRefresh()
 {
     fmInfo() << "Handling refresh operation";
 
+    // 刷新会重新遍历目录，缓存的监控事件已过时
+    pendingWatcherEvents.clear();
+
     int childrenCount = this->childrenCountInternal();
     if (childrenCount > 0)
         doModelChanged(ModelChangeType::kRemoveRows, 0, childrenCount);
@@ -967,6 +1264,7 @@ void FileSortWorker::handleRefresh()
     children.clear();
     visibleTreeChildren.clear();
     depthMap.clear();
+    pendingWatcherEvents.clear();
     if (isCurrentGroupingEnabled) {
         clearGroupedData();
     }
@@ -996,7 +1294,9 @@ void FileSortWorker::handleClearThumbnail()
 void FileSortWorker::handleFileInfoUpdated(const QUrl &url, const QString &infoPtr, const bool isLinkOrg)
 {
     Q_UNUSED(isLinkOrg);
-    if (!children.value(makeParentUrl(url)).contains(url))
+    flushPendingWatcherEvents();
+    auto store = sortKeyStore(makeParentUrl(url));
+    if (!store || !store->contains(url))
         return;
 
     auto itemdata = childData(url);
@@ -1158,7 +1458,7 @@ void FileSortWorker::handleCloseExpand(const QString &key, const QUrl &parent)
 {
     if (isCanceled || key != currentKey || UniversalUtils::urlEquals(parent, current))
         return;
-    if (!children.keys().contains(parent))
+    if (!children.contains(parent))
         return;
     removeSubDir(parent);
 }
@@ -1210,10 +1510,10 @@ bool FileSortWorker::handleAddChildren(const QString &key,
 
     auto parentUrl = makeParentUrl(children.first()->fileUrl());
     // 获取当前的插入的位置
-    auto childUrls = visibleTreeChildren.take(parentUrl);
+    auto childIds = visibleTreeChildren.take(parentUrl);
     auto startPos = findStartPos(parentUrl);
-    auto posOffset = childUrls.length();
-    QHash<QUrl, SortInfoPointer> tmpChildren = this->children.take(parentUrl);
+    auto posOffset = childIds.length();
+    SortKeyStore tmpChildren = this->children.take(parentUrl);
     // 辅助或者fileinfo
     int index = 0;
     int infosSize = childInfos.count();
@@ -1222,9 +1522,11 @@ bool FileSortWorker::handleAddChildren(const QString &key,
     for (const auto &sortInfo : children) {
         if (tmpChildren.contains(sortInfo->fileUrl()))
             continue;
-        tmpChildren.insert(sortInfo->fileUrl(), sortInfo);
-        if (checkFilters(sortInfo))
+        const auto id = tmpChildren.insert(sortInfo);
+        if (checkFilters(sortInfo)) {
             newChildren.append(sortInfo->fileUrl());
+            childIds.append(id);
+        }
         if (isCanceled)
             return false;
         FileInfoPointer info { nullptr };
@@ -1235,8 +1537,7 @@ bool FileSortWorker::handleAddChildren(const QString &key,
     }
 
     this->children.insert(parentUrl, tmpChildren);
-    childUrls.append(newChildren);
-    visibleTreeChildren.insert(parentUrl, childUrls);
+    visibleTreeChildren.insert(parentUrl, childIds);
     depthMap.remove(depth - 1, parentUrl);
     depthMap.insert(depth - 1, parentUrl);
     if (newChildren.isEmpty())
@@ -1308,7 +1609,7 @@ void FileSortWorker::filterAndSortFiles(const QUrl &dir, const bool fileter, con
     if (istree)
         visibleList = sortAllTreeFilesByParent(dir, reverse);
     else {
-        visibleList = sortTreeFiles(visibleTreeChildren.contains(current) ? visibleTreeChildren[current] : visibleChildren, reverse);
+        visibleList = sortTreeFiles(current, currentVisibleIds(), reverse);
     }
 
     // 执行界面刷新  设置过滤，当前的目录是当前树的根目录，反序。所有的显示url都要改变
@@ -1337,7 +1638,7 @@ void FileSortWorker::resortCurrent(const bool reverse)
     if (istree)
         visibleList = sortAllTreeFilesByParent(current, reverse);
     else {
-        visibleList = sortTreeFiles(visibleTreeChildren.contains(current) ? visibleTreeChildren[current] : visibleChildren, reverse);
+        visibleList = sortTreeFiles(current, currentVisibleIds(), reverse);
     }
 
     resortVisibleChildren(visibleList);
@@ -1364,7 +1665,8 @@ QList<QUrl> FileSortWorker::filterFilesByParent(const QUrl &dir, const bool byIn
                 return {};
             if (!UniversalUtils::urlEquals(parent, current) && !UniversalUtils::isParentUrl(parent, dir))
                 continue;
-            auto sortInfo = children.value(makeParentUrl(parent)).value(parent);
+            auto parentStore = sortKeyStore(makeParentUrl(parent));
+            auto sortInfo = parentStore ? parentStore->value(parent) : nullptr;
             if (sortInfo && sortInfo->needsCompletion())
                 doCompleteFileInfo(sortInfo);
             if (!UniversalUtils::urlEquals(parent, current) && !checkFilters(sortInfo, byInfo)) {
@@ -1386,20 +1688,23 @@ void FileSortWorker::filterTreeDirFiles(const QUrl &parent, const bool byInfo)
     if (isCanceled)
         return;
 
-    QList<QUrl> filterUrls {};
-    for (const auto &sortInfo : children.value(parent)) {
+    QVector<SortKeyStore::Id> filterIds {};
+    auto store = sortKeyStore(parent);
+    const QVector<SortKeyStore::Id> ids = store ? store->ids() : QVector<SortKeyStore::Id>();
+    for (const auto id : ids) {
         if (isCanceled)
             return;
 
+        const SortInfoPointer &sortInfo = store->info(id);
         if (sortInfo && sortInfo->needsCompletion())
             doCompleteFileInfo(sortInfo);
 
         if (checkFilters(sortInfo, byInfo))
-            filterUrls.append(sortInfo->fileUrl());
+            filterIds.append(id);
     }
 
     visibleTreeChildren.remove(parent);
-    if (filterUrls.isEmpty()) {
+    if (filterIds.isEmpty()) {
         if (UniversalUtils::urlEquals(parent, current)) {
             doModelChanged(ModelChangeType::kRemoveRows, 0, visibleChildren.count());
             {
@@ -1411,7 +1716,7 @@ void FileSortWorker::filterTreeDirFiles(const QUrl &parent, const bool byInfo)
         return;
     }
 
-    visibleTreeChildren.insert(parent, filterUrls);
+    visibleTreeChildren.insert(parent, filterIds);
 }
 
 bool FileSortWorker::addChild(const SortInfoPointer &sortInfo,
@@ -1425,12 +1730,11 @@ bool FileSortWorker::addChild(const SortInfoPointer &sortInfo,
     if (depth < 0)
         return false;
 
-    if (children.value(parentUrl).contains(sortInfo->fileUrl()))
+    auto &childList = children[parentUrl];
+    if (childList.contains(sortInfo->fileUrl()))
         return false;
 
-    auto childList = children.take(parentUrl);
-    childList.insert(sortInfo->fileUrl(), sortInfo);
-    children.insert(parentUrl, childList);
+    const auto fileId = childList.insert(sortInfo);
     {
         // 不在此处创建 FileInfo 和触发 updateAttributes()
         // FileInfo 的创建和缩略图生成延迟到视图 paint 时按需触发（FileItemData 懒加载路径）
@@ -1449,24 +1753,24 @@ bool FileSortWorker::addChild(const SortInfoPointer &sortInfo,
     int showIndex = findStartPos(parentUrl);
 
     // 插入到每个目录下的显示目录
+    auto store = sortKeyStore(parentUrl);
     auto subVisibleList = visibleTreeChildren.take(parentUrl);
     auto offset = subVisibleList.length();
     if (orgSortRole != Global::ItemRoles::kItemDisplayRole)
-        offset = insertSortList(sortInfo->fileUrl(), subVisibleList);
+        offset = insertSortList(fileId, subVisibleList, store);
     auto subIndex = offset;
     // 根目录下的offset计算不一样
     if (UniversalUtils::urlEquals(parentUrl, current)) {
         if (offset >= subVisibleList.length() || offset == 0) {
             offset = offset >= subVisibleList.length() ? childrenCountInternal() : 0;
         } else {
-            auto tmpUrl = offset >= subVisibleList.length() ? QUrl() : subVisibleList.at(offset);
-            offset = getChildShowIndexInternal(tmpUrl);
+            offset = getChildShowIndexInternal(store->url(subVisibleList.at(offset)));
             if (offset < 0)
                 offset = childrenCountInternal();
         }
     }
 
-    insertToList(subVisibleList, subIndex, sortInfo->fileUrl());
+    insertToList(subVisibleList, subIndex, fileId);
     visibleTreeChildren.insert(parentUrl, subVisibleList);
 
     // kItemDisplayRole 是不进行排序的
@@ -1474,7 +1778,7 @@ bool FileSortWorker::addChild(const SortInfoPointer &sortInfo,
 
     // 不为子目录中第一项的情况下，需要判断前面的项是否有展开
     if (subIndex != 0) {
-        QUrl preItemUrl = subVisibleList.at(subIndex - 1);
+        QUrl preItemUrl = store->url(subVisibleList.at(subIndex - 1));
         // 前一项展开的情况下，实际插入的位置应该在所有展开子项之后
         showIndex = findRealShowIndex(preItemUrl);
     }
@@ -1502,10 +1806,8 @@ bool FileSortWorker::sortInfoUpdateByFileInfo(const FileInfoPointer fileInfo)
 
     auto url = fileInfo->fileUrl();
     auto parentUrl = makeParentUrl(url);
-    if (!children.value(parentUrl).contains(url))
-        return false;
-
-    SortInfoPointer sortInfo = children.value(parentUrl).value(url);
+    auto store = sortKeyStore(parentUrl);
+    SortInfoPointer sortInfo = store ? store->value(url) : nullptr;
     if (!sortInfo)
         return false;
 
@@ -1522,6 +1824,7 @@ bool FileSortWorker::sortInfoUpdateByFileInfo(const FileInfoPointer fileInfo)
     sortInfo->setLastModifiedTime(fileInfo->timeOf(TimeInfoType::kLastModified).value<QDateTime>().toSecsSinceEpoch());
     sortInfo->setCreateTime(fileInfo->timeOf(TimeInfoType::kCreateTime).value<QDateTime>().toSecsSinceEpoch());
     fileInfo->fileMimeType();
+    updateSortKey(sortInfo);
 
     return true;
 }
@@ -1539,7 +1842,8 @@ void FileSortWorker::switchTreeView()
 void FileSortWorker::switchListView()
 {
     // 移除depthMap和visibleTreeChildren
-    auto allShowList = visibleTreeChildren.value(current);
+    const auto allShowIds = visibleTreeChildren.value(current);
+    auto allShowList = visibleTreeUrls(current);
     // 保持选中
     Q_EMIT aboutToSwitchToListView(allShowList);
 
@@ -1550,21 +1854,18 @@ void FileSortWorker::switchListView()
     isMixDirAndFile = Application::instance()->appAttribute(Application::kFileAndDirMixedSort).toBool();
     // 排序
     if (isMixDirAndFile != oldMix) {
-        allShowList = sortTreeFiles(allShowList);
+        allShowList = sortTreeFiles(current, allShowIds);
     } else {
-        visibleTreeChildren.insert(current, allShowList);
+        visibleTreeChildren.insert(current, allShowIds);
     }
 
     // 更新显示项
     insertVisibleChildren(0, allShowList, InsertOpt::kInsertOptForce);
     // 移除children
-    auto allShowChildren = children.value(current);
+    auto allShowChildren = children.take(current);
     QList<QUrl> removeChildren;
-    for (const auto &url : children.keys()) {
-        if (UniversalUtils::urlEquals(url, current))
-            continue;
-        removeChildren.append(children.value(url).keys());
-    }
+    for (const auto &store : std::as_const(children))
+        removeChildren.append(store.urls());
     children.clear();
     children.insert(current, allShowChildren);
     // 移除fileitem
@@ -1596,9 +1897,9 @@ QList<QUrl> FileSortWorker::sortAllTreeFilesByParent(const QUrl &dir, const bool
 
             QList<QUrl> sortList {};
             if (visibleTreeChildren.isEmpty() && UniversalUtils::urlEquals(parent, current)) {
-                sortList = sortTreeFiles(visibleChildren, reverse);
+                sortList = sortTreeFiles(current, currentVisibleIds(), reverse);
             } else {
-                sortList = bSort ? sortTreeFiles(visibleTreeChildren.take(parent), reverse) : visibleTreeChildren.value(parent);
+                sortList = bSort ? sortTreeFiles(parent, visibleTreeChildren.take(parent), reverse) : visibleTreeUrls(parent);
             }
 
             if (sortList.isEmpty())
@@ -1617,59 +1918,60 @@ QList<QUrl> FileSortWorker::sortAllTreeFilesByParent(const QUrl &dir, const bool
     return visibleList;
 }
 
-QList<QUrl> FileSortWorker::sortTreeFiles(const QList<QUrl> &children, const bool reverse)
+QList<QUrl> FileSortWorker::sortTreeFiles(const QUrl &parent, const QVector<SortKeyStore::Id> &ids, const bool reverse)
 {
-    if (isCanceled || children.isEmpty())
+    if (isCanceled || ids.isEmpty())
+        return {};
+
+    auto store = sortKeyStore(parent);
+    if (!store)
         return {};
 
     QElapsedTimer timer;
     timer.start();
 
-    auto parentUrl = makeParentUrl(children.first());
-
     // 不排序的情况：kItemDisplayRole 角色不进行排序
     if (orgSortRole == Global::ItemRoles::kItemDisplayRole) {
-        visibleTreeChildren.insert(parentUrl, children);
+        visibleTreeChildren.insert(parent, ids);
         return {};
     }
 
-    if (children.count() <= 1) {
-        visibleTreeChildren.insert(parentUrl, children);
-        return children;
+    if (ids.count() <= 1) {
+        visibleTreeChildren.insert(parent, ids);
+        return store->urls(ids);
     }
 
     // 更新排序器上下文
     updateSorterContext();
 
-    QList<QUrl> sortList;
+    QVector<SortKeyStore::Id> sortList;
 
-    // reverse 为 true 时，传入的 children 已经是之前排序好的数据
+    // reverse 为 true 时，传入的 ids 已经是之前排序好的数据
     // 直接 reverse 即可，无需重新排序
     if (reverse) {
-        sortList = m_sorter.reverse(children);
+        sortList = m_sorter.reverse(ids, store);
     } else {
-        // 使用 sortKey + 快排
-        sortList = m_sorter.sort(children);
+        // 只置换 ID 数组，比较时直接读取列式存储
+        sortList = m_sorter.sort(ids, store);
     }
 
     if (sortList.isEmpty())
         return {};
 
-    visibleTreeChildren.insert(parentUrl, sortList);
+    visibleTreeChildren.insert(parent, sortList);
 
     fmDebug() << "sortTreeFiles completed in" << timer.elapsed() << "ms, sorted"
-              << sortList.count() << "items for" << parentUrl.toString();
+              << sortList.count() << "items for" << parent.toString();
 
-    return sortList;
+    // 只在交给模型的边界处转换为 URL
+    return store->urls(sortList);
 }
 
 QList<QUrl> FileSortWorker::removeChildrenByParents(const QList<QUrl> &dirs)
 {
     QList<QUrl> urls;
     for (const auto &dir : dirs) {
-        for (const auto &sortInfo : children.value(dir))
-            urls << sortInfo->fileUrl();
-        children.remove(dir);
+        urls << children.take(dir).urls();
         auto item = childData(dir);
         if (item)
             item->setExpanded(false);
@@ -1700,6 +2002,30 @@ QList<QUrl> FileSortWorker::removeVisibleTreeChildren(const QUrl &parent)
     return removeUrls;
 }
 
+QList<QUrl> FileSortWorker::visibleTreeUrls(const QUrl &parent) const
+{
+    const auto idsIt = visibleTreeChildren.constFind(parent);
+    const auto storeIt = children.constFind(parent);
+    if (idsIt == visibleTreeChildren.cend() || storeIt == children.cend())
+        return {};
+
+    return storeIt->urls(idsIt.value());
+}
+
+QVector<SortKeyStore::Id> FileSortWorker::currentVisibleIds()
+{
+    if (visibleTreeChildren.contains(current))
+        return visibleTreeChildren.value(current);
+
+    // 尚未建立当前目录的可见顺序时，以显示列表为准
+    auto store = sortKeyStore(current);
+    if (!store)
+        return {};
+
+    QReadLocker lk(&locker);
+    return store->ids(visibleChildren);
+}
+
 void FileSortWorker::removeSubDir(const QUrl &dir)
 {
     auto startPos = findStartPos(dir);
@@ -1741,14 +2067,19 @@ int FileSortWorker::findEndPos(const QUrl &dir)
         return childrenCountInternal();
 
     const auto &parentUrl = makeParentUrl(dir);
-    auto index = visibleTreeChildren.value(parentUrl).indexOf(dir);
+    auto store = sortKeyStore(parentUrl);
+    if (!store)
+        return -1;
+
+    const auto siblings = visibleTreeChildren.value(parentUrl);
+    auto index = siblings.indexOf(store->id(dir));
     if (index < 0)
         return -1;
 
-    if (index == visibleTreeChildren.value(parentUrl).length() - 1)
+    if (index == siblings.length() - 1)
         return findEndPos(makeParentUrl(dir));
 
-    return getChildShowIndexInternal(visibleTreeChildren.value(parentUrl).at(index + 1));
+    return getChildShowIndexInternal(store->url(siblings.at(index + 1)));
 }
 
 int FileSortWorker::findStartPos(const QUrl &parent)
@@ -1827,7 +2158,7 @@ void FileSortWorker::createAndInsertItemData(const int8_t depth, const SortInfoP
     childrenDataMap.insert(child->fileUrl(), item);
 }
 
-int FileSortWorker::insertSortList(const QUrl &needNode, const QList<QUrl> &list)
+int FileSortWorker::insertSortList(const SortKeyStore::Id needNode, const QVector<SortKeyStore::Id> &list, SortKeyStore *store)
 {
     if (list.isEmpty())
         return 0;
@@ -1839,7 +2170,22 @@ int FileSortWorker::insertSortList(const QUrl &needNode, const QList<QUrl> &list
     updateSorterContext();
 
     // 使用 FileViewSorter 的二分查找定位
-    return m_sorter.findInsertPosition(needNode, list);
+    return m_sorter.findInsertPosition(needNode, list, store);
+}
+
+SortKeyStore *FileSortWorker::sortKeyStore(const QUrl &parent)
+{
+    auto it = children.find(parent);
+    return it == children.end() ? nullptr : &it.value();
+}
+
+void FileSortWorker::updateSortKey(const SortInfoPointer &sortInfo)
+{
+    if (!sortInfo)
+        return;
+
+    if (auto store = sortKeyStore(makeParentUrl(sortInfo->fileUrl())))
+        store->refresh(sortInfo);
 }
 
 bool FileSortWorker::checkFilters(const SortInfoPointer &sortInfo, const bool byInfo)
@@ -1969,12 +2315,12 @@ int FileSortWorker::findRealShowIndex(const QUrl &preItemUrl)
     if (!preItemPtr || !preItemPtr->data(Global::ItemRoles::kItemTreeViewExpandedRole).toBool())
         return indexOfVisibleChild(preItemUrl) + 1;
 
-    QList<QUrl> preSubItemList = visibleTreeChildren.value(preItemUrl, {});
-    if (preSubItemList.isEmpty())
+    const auto preSubItemList = visibleTreeChildren.value(preItemUrl);
+    auto store = sortKeyStore(preItemUrl);
+    if (preSubItemList.isEmpty() || !store)
         return indexOfVisibleChild(preItemUrl) + 1;
 
-    const QUrl &subPreItemUrl = preSubItemList.last();
-    return findRealShowIndex(subPreItemUrl);
+    return findRealShowIndex(store->url(preSubItemList.last()));
 }
 
 int FileSortWorker::indexOfVisibleChild(const QUrl &itemUrl)
@@ -2099,6 +2445,7 @@ void FileSortWorker::doCompleteFileInfo(SortInfoPointer sortInfo)
 
     // 标记所有信息已完成
     sortInfo->setInfoCompleted(true);
+    updateSortKey(sortInfo);
 }
 
 QList<FileItemDataPointer> FileSortWorker::getAllFiles() const
@@ -2111,7 +2458,7 @@ QList<FileItemDataPointer> FileSortWorker::getAllFiles() const
     // 在 TeeView 下使用 visibleChildren 将导致子目录的文件也被分组
     const QList<QUrl> &children =
             visibleTreeChildren.contains(current)
-            ? visibleTreeChildren[current]
+            ? visibleTreeUrls(current)
             : visibleChildren;
 
     for (const QUrl &url : children) {
@@ -2142,7 +2489,7 @@ void FileSortWorker::applyGrouping(const QList<FileItemDataPointer> &files)
 
     // Perform grouping using GroupingEngine
     groupingEngine->setGroupOrder(groupOrder);
-    groupingEngine->setVisibleTreeChildren(&visibleTreeChildren);
+    groupingEngine->setVisibleTreeChildren(&visibleTreeChildren, &children);
     groupingEngine->setChildrenDataMap(&childrenDataMap);
     groupingEngine->setVisibleChildren(&visibleChildren);
 
@@ -10,6 +10,7 @@
 #include "groups/groupingengine.h"
 #include "groups/groupedmodeldata.h"
 #include "utils/fileviewsorter.h"
+#include "utils/sortkeystore.h"
 
 #include <dfm-base/interfaces/abstractgroupstrategy.h>
 #include <dfm-base/dfm_global_defines.h>
@@ -56,6 +57,19 @@ class FileSortWorker : public QObject
         kSortScenariosWatcherOther = 5,   // Other file watcher scenarios
     };
 
+    enum class WatcherEventType : uint8_t {
+        kWatcherAdd,
+        kWatcherRemove,
+        kWatcherUpdate,
+    };
+
+    struct WatcherEvent
+    {
+        WatcherEventType type;
+        QUrl parent;   // 树形视图下各目录的增删分别处理，只合并同一父目录的事件
+        QList<SortInfoPointer> children;
+    };
+
     enum class ModelChangeType {
         // normal
         kInsertRows,
@@ -205,14 +219,22 @@ private:
 
     bool addChild(const SortInfoPointer &sortInfo,
                   const SortScenarios sort);
+    bool coalesceWatcherEvent(const WatcherEventType type, const QList<SortInfoPointer> &children);
+    void flushWatcherEvents();
+    void flushPendingWatcherEvents();
+    void addChildrenBatch(const QList<SortInfoPointer> &children);
+    void removeChildrenBatch(const QList<SortInfoPointer> &children);
+    void resetVisibleChildren(const QList<QUrl> &urls);
     bool sortInfoUpdateByFileInfo(const FileInfoPointer fileInfo);
 
     void switchTreeView();
     void switchListView();
     QList<QUrl> sortAllTreeFilesByParent(const QUrl &dir, const bool reverse = false);
-    QList<QUrl> sortTreeFiles(const QList<QUrl> &children, const bool reverse = false);
+    QList<QUrl> sortTreeFiles(const QUrl &parent, const QVector<SortKeyStore::Id> &ids, const bool reverse = false);
     QList<QUrl> removeChildrenByParents(const QList<QUrl> &dirs);
     QList<QUrl> removeVisibleTreeChildren(const QUrl &parent);
+    QList<QUrl> visibleTreeUrls(const QUrl &parent) const;
+    QVector<SortKeyStore::Id> currentVisibleIds();
     void removeSubDir(const QUrl &dir);
     void removeFileItems(const QList<QUrl> &urls);
     int8_t findDepth(const QUrl &parent);
@@ -226,7 +248,9 @@ private:
     void removeVisibleChildren(const int startPos, const int size);
     void createAndInsertItemData(const int8_t depth, const SortInfoPointer child, const FileInfoPointer info);
 
-    int insertSortList(const QUrl &needNode, const QList<QUrl> &list);
+    int insertSortList(const SortKeyStore::Id needNode, const QVector<SortKeyStore::Id> &list, SortKeyStore *store);
+    SortKeyStore *sortKeyStore(const QUrl &parent);
+    void updateSortKey(const SortInfoPointer &sortInfo);
     bool checkFilters(const SortInfoPointer &sortInfo, const bool byInfo = false);
     bool isDefaultHiddenFile(const QUrl &fileUrl);
     QUrl makeParentUrl(const QUrl &url);
@@ -261,7 +285,7 @@ private:
     QUrl current;
     QStringList nameFilters {};
     QDir::Filters filters { QDir::NoFilter };
-    QHash<QUrl, QHash<QUrl, SortInfoPointer>> children {};
+    QHash<QUrl, SortKeyStore> children {};   // 每个目录下的子项，以列式存储保存排序数据
     mutable QReadWriteLock childrenDataLocker;
     QHash<QUrl, FileItemDataPointer> childrenDataMap {};
     QList<QUrl> visibleChildren {};
@@ -284,12 +308,16 @@ private:
 
     std::atomic_bool isCanceled { false };
     bool isMixDirAndFile { false };
-    QHash<QUrl, QList<QUrl>> visibleTreeChildren {};
+    QHash<QUrl, QVector<SortKeyStore::Id>> visibleTreeChildren {};   // 每个目录下可见子项的顺序，保存 children 中对应目录的 ID
     QMultiMap<int8_t, QUrl> depthMap;
     std::atomic_bool istree { false };
     std::atomic_bool currentSupportTreeView { false };
     QList<QUrl> fileInfoRefresh;
     QTimer *updateRefresh { nullptr };
+    // 监控事件合并：突发期间按固定窗口缓存增删改，窗口结束时批量处理
+    QList<WatcherEvent> pendingWatcherEvents;
+    QTimer *watcherCoalesceTimer { nullptr };
+    bool flushingWatcherEvents { false };
     std::atomic_bool mimeSorting { false };
     QSet<QUrl> waitUpdatedFiles;
 
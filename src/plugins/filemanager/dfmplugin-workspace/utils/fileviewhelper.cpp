@@ -237,6 +237,14 @@ QModelIndex FileViewHelper::findIndex(const QByteArray &keys, bool matchStart, i
                        : pinyinName.contains(keys, Qt::CaseInsensitive)) {
             return index;
         }
+
+        // 拼音首字母，如 "wd" 匹配 "文档"
+        const QString &initials = parent()->model()->data(index, kItemFilePinyinInitialsRole).toString();
+        if (initials != pinyinName
+            && (matchStart ? initials.startsWith(keys, Qt::CaseInsensitive)
+                           : initials.contains(keys, Qt::CaseInsensitive))) {
+            return index;
+        }
     }
 
     fmDebug() << "No match found for keys:" << keys;
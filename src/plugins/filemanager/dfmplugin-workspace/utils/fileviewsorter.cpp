@@ -17,8 +17,13 @@
 #include <QPair>
 #include <QDateTime>
 #include <QFileInfo>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include <algorithm>
+#include <iterator>
+#include <mutex>
 
 DPWORKSPACE_BEGIN_NAMESPACE
 DFMGLOBAL_USE_NAMESPACE
@@ -83,6 +88,113 @@ const QHash<QString, int> &getMimeTypeGroupMap()
     };
     return map;
 }
+
+// 超过该数量才并行生成排序键和排序，小目录并行的调度开销大于收益
+constexpr qsizetype kParallelSortThreshold { 20000 };
+constexpr qsizetype kMinItemsPerTask { 8192 };
+
+struct SortRange
+{
+    qsizetype begin { 0 };
+    qsizetype mid { 0 };
+    qsizetype end { 0 };
+};
+
+// 独立线程池：避免与缩略图、文件信息等占用全局线程池的任务互相等待
+QThreadPool *sortThreadPool()
+{
+    static QThreadPool pool;
+    static std::once_flag initFlag;
+    std::call_once(initFlag, [] {
+        pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+    });
+    return &pool;
+}
+
+int sortTaskCount(qsizetype count)
+{
+    if (count < kParallelSortThreshold)
+        return 1;
+    return static_cast<int>(qMin<qsizetype>(qMax(1, QThread::idealThreadCount()), count / kMinItemsPerTask));
+}
+
+// 将 [0, count) 均分后并行执行 func(begin, end)，数量不足时在当前线程执行
+template<typename Func>
+void parallelRanges(qsizetype count, Func func)
+{
+    const int tasks = sortTaskCount(count);
+    if (tasks < 2) {
+        func(0, count);
+        return;
+    }
+
+    QVector<SortRange> ranges;
+    for (int i = 0; i < tasks; ++i)
+        ranges.append({ count * i / tasks, 0, count * (i + 1) / tasks });
+    QtConcurrent::blockingMap(sortThreadPool(), ranges, [&func](const SortRange &range) {
+        func(range.begin, range.end);
+    });
+}
+
+// 并行归并排序：各段并行 stable_sort，再逐轮两两 inplace_merge，整体保持稳定
+template<typename Iterator, typename Compare>
+void parallelStableSort(Iterator first, Iterator last, Compare comp)
+{
+    const qsizetype count = last - first;
+    const int tasks = sortTaskCount(count);
+    if (tasks < 2) {
+        std::stable_sort(first, last, comp);
+        return;
+    }
+
+    QVector<qsizetype> bounds;
+    for (int i = 0; i <= tasks; ++i)
+        bounds.append(count * i / tasks);
+
+    parallelRanges(count, [&](qsizetype begin, qsizetype end) {
+        std::stable_sort(first + begin, first + end, comp);
+    });
+
+    while (bounds.size() > 2) {
+        QVector<SortRange> merges;
+        QVector<qsizetype> next;
+        int i = 0;
+        for (; i + 2 < bounds.size(); i += 2) {
+            merges.append({ bounds.at(i), bounds.at(i + 1), bounds.at(i + 2) });
+            next.append(bounds.at(i));
+        }
+        // 奇数段时最后一段留到下一轮
+        for (; i < bounds.size() - 1; ++i)
+            next.append(bounds.at(i));
+        next.append(count);
+
+        QtConcurrent::blockingMap(sortThreadPool(), merges, [&](const SortRange &range) {
+            std::inplace_merge(first + range.begin, first + range.mid, first + range.end, comp);
+        });
+        bounds = next;
+    }
+}
+
+// 目录在前、文件在后的列表按组各自反序；grouped 为 false 时整体反序
+template<typename List, typename IsDir>
+List reverseGrouped(const List &items, bool grouped, IsDir isDir)
+{
+    List result = items;
+    if (!grouped) {
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    // 找到第一个文件的位置（目录在前，文件在后）
+    qsizetype firstFileIndex = 0;
+    while (firstFileIndex < items.size() && isDir(items.at(firstFileIndex)))
+        ++firstFileIndex;
+
+    // 全部是目录或全部是文件时两段之一为空
+    std::reverse(result.begin(), result.begin() + firstFileIndex);
+    std::reverse(result.begin() + firstFileIndex, result.end());
+    return result;
+}
 }   // namespace
 
 void FileViewSorter::setContext(const SortContext &context)
@@ -104,6 +216,42 @@ QList<QUrl> FileViewSorter::sort(const QList<QUrl> &urls)
     return sortMixed(urls);
 }
 
+QVector<SortKeyStore::Id> FileViewSorter::sort(const QVector<SortKeyStore::Id> &ids, SortKeyStore *store)
+{
+    if (!store || ids.size() <= 1)
+        return ids;
+
+    QVector<SortKeyStore::Id> sorted = ids;
+    prepareKeys(store, sorted);
+    parallelStableSort(sorted.begin(), sorted.end(), [this, store](SortKeyStore::Id left, SortKeyStore::Id right) {
+        return lessThan(store, left, right);
+    });
+
+    return sorted;
+}
+
+QVector<SortKeyStore::Id> FileViewSorter::merge(const QVector<SortKeyStore::Id> &sortedIds,
+                                                const QVector<SortKeyStore::Id> &sortedNew, SortKeyStore *store)
+{
+    if (sortedNew.isEmpty())
+        return sortedIds;
+    if (sortedIds.isEmpty() || !store)
+        return sortedIds + sortedNew;
+
+    prepareKeys(store, sortedIds);
+    prepareKeys(store, sortedNew);
+
+    // std::merge 在相等时先取第一个区间，保证已有项在前
+    QVector<SortKeyStore::Id> merged;
+    merged.reserve(sortedIds.size() + sortedNew.size());
+    std::merge(sortedIds.cbegin(), sortedIds.cend(), sortedNew.cbegin(), sortedNew.cend(), std::back_inserter(merged),
+               [this, store](SortKeyStore::Id left, SortKeyStore::Id right) {
+                   return lessThan(store, left, right);
+               });
+
+    return merged;
+}
+
 QList<QUrl> FileViewSorter::sortSeparated(const QList<QUrl> &urls)
 {
     // 分离目录和文件
@@ -141,37 +289,44 @@ QList<QUrl> FileViewSorter::sortMixed(const QList<QUrl> &urls)
         mimeTypeMap = batchGetMimeTypes(urls);
     }
 
-    // 预生成所有 sortKey（不包含目录/文件前缀）
-    // 批次入口一次性获取策略，保证整个批次内策略一致（避免 dconfig 切换竞态）
-    const dfmbase::CollationStrategy &sortStrategy =
-            dfmbase::CollationStrategyProvider::instance()->strategy();
-    QVector<QPair<QUrl, QByteArray>> items;
-    items.reserve(urls.size());
-
-    for (const QUrl &url : urls) {
-        QString keyStr;
-        // MimeType 排序使用预计算结果
-        if (m_context.role == SortRole::MimeType) {
-            QString mimeType = mimeTypeMap.value(url, "Unknown");
-            QString fileName;
-            if (m_context.getDataCallback) {
-                auto itemData = m_context.getDataCallback(url);
-                fileName = getFileDisplayName(url, itemData);
+    // 预生成所有 sortKey（不包含目录/文件前缀），大目录分段并行生成
+    // 每段入口一次性获取策略（策略为线程局部实例），保证段内策略一致
+    QVector<QPair<QUrl, QByteArray>> items(urls.size());
+    auto *out = items.data();   // 各段只写自己的元素，提前取指针避免并发 detach 检查
+    parallelRanges(urls.size(), [&](qsizetype begin, qsizetype end) {
+        const dfmbase::CollationStrategy &sortStrategy =
+                dfmbase::CollationStrategyProvider::instance()->strategy();
+        for (qsizetype i = begin; i < end; ++i) {
+            const QUrl &url = urls.at(i);
+            QString keyStr;
+            // MimeType 排序使用预计算结果
+            if (m_context.role == SortRole::MimeType) {
+                QString mimeType = mimeTypeMap.value(url, "Unknown");
+                QString fileName;
+                if (m_context.getDataCallback) {
+                    auto itemData = m_context.getDataCallback(url);
+                    fileName = getFileDisplayName(url, itemData);
+                } else {
+                    fileName = url.fileName();
+                }
+                keyStr = encodeMimeTypeSortKey(mimeType, fileName);
             } else {
-                fileName = url.fileName();
+                keyStr = generateSortKeyStringInternal(url);
             }
-            keyStr = encodeMimeTypeSortKey(mimeType, fileName);
-        } else {
-            keyStr = generateSortKeyStringInternal(url);
+            out[i] = qMakePair(url, sortStrategy.sortKey(keyStr));
         }
-        items.append(qMakePair(url, sortStrategy.sortKey(keyStr)));
-    }
+    });
 
-    // 使用 FileNameSorter 的排序模板
-    dfmbase::FileNameSorter::sortByKey(
-            items,
-            [](const auto &item) { return item.second; },
-            m_context.order);
+    // 与 FileNameSorter::sortByKey 相同的稳定排序语义，大目录使用并行归并
+    if (m_context.order == Qt::AscendingOrder) {
+        parallelStableSort(items.begin(), items.end(), [](const auto &a, const auto &b) {
+            return a.second < b.second;
+        });
+    } else {
+        parallelStableSort(items.begin(), items.end(), [](const auto &a, const auto &b) {
+            return b.second < a.second;
+        });
+    }
 
     // 提取排序后的 URL
     QList<QUrl> result;
@@ -242,55 +397,180 @@ QHash<QUrl, QString> FileViewSorter::batchGetMimeTypes(const QList<QUrl> &urls)
     return result;
 }
 
-QList<QUrl> FileViewSorter::reverse(const QList<QUrl> &urls)
+void FileViewSorter::prepareKeys(SortKeyStore *store, const QVector<SortKeyStore::Id> &ids)
 {
-    if (urls.isEmpty())
-        return urls;
-
-    // Size 排序时，始终分组处理（无论是否混排）
-    // 因为目录和文件的 size 语义不同，不应该混在一起 reverse
-    bool needGroupedReverse = !m_context.isMixDirAndFile || (m_context.role == SortRole::Size);
+    const bool needItemData = m_context.isUnderHomeDir || m_context.checkDesktopFile;
+
+    store->setKeyRole(static_cast<int>(m_context.role));
+    QVector<SortKeyStore::Id> missingNames;
+    QVector<SortKeyStore::Id> missingRoles;
+    for (SortKeyStore::Id id : ids) {
+        if (!store->hasNameKey(id))
+            missingNames.append(id);
+        if (store->hasRoleKey(id))
+            continue;
 
-    if (!needGroupedReverse) {
-        // 普通混排：直接整体 reverse
-        QList<QUrl> result = urls;
-        std::reverse(result.begin(), result.end());
-        return result;
+        switch (m_context.role) {
+        case SortRole::FileName:
+        case SortRole::Size:
+            // 名称与大小直接使用 nameKeys / 原始列
+            store->setRoleKey(id, 0);
+            break;
+        case SortRole::LastModified:
+        case SortRole::LastCreated:
+        case SortRole::LastRead:
+            store->setRoleKey(id, getSortTime(store->url(id), store, id));
+            break;
+        default:
+            missingRoles.append(id);
+            break;
+        }
     }
 
-    // 分组 reverse：目录组和文件组各自内部 reverse
-    // 找到第一个文件的位置（目录在前，文件在后）
-    int firstFileIndex = -1;
-    for (int i = 0; i < urls.size(); ++i) {
-        if (!isDir(urls.at(i))) {
-            firstFileIndex = i;
-            break;
+    // 生成 collation key 是排序的主要开销，大目录分段并行计算后再统一写回
+    QVector<QByteArray> keys(missingNames.size());
+    QByteArray *out = keys.data();
+    parallelRanges(missingNames.size(), [&](qsizetype begin, qsizetype end) {
+        const dfmbase::CollationStrategy &sortStrategy =
+                dfmbase::CollationStrategyProvider::instance()->strategy();
+        for (qsizetype i = begin; i < end; ++i) {
+            const QUrl &url = store->url(missingNames.at(i));
+            auto itemData = (needItemData && m_context.getDataCallback) ? m_context.getDataCallback(url) : nullptr;
+            out[i] = sortStrategy.sortKey(getFileDisplayName(url, itemData));
         }
+    });
+    for (qsizetype i = 0; i < missingNames.size(); ++i)
+        store->setNameKey(missingNames.at(i), keys.at(i));
+
+    if (missingRoles.isEmpty())
+        return;
+
+    QHash<QUrl, QString> mimeTypeMap;
+    if (m_context.role == SortRole::MimeType) {
+        QList<QUrl> urls;
+        urls.reserve(missingRoles.size());
+        for (SortKeyStore::Id id : missingRoles)
+            urls.append(store->url(id));
+        mimeTypeMap = batchGetMimeTypes(urls);
     }
 
-    QList<QUrl> result;
+    keys.fill(QByteArray(), missingRoles.size());
+    out = keys.data();
+    parallelRanges(missingRoles.size(), [&](qsizetype begin, qsizetype end) {
+        const dfmbase::CollationStrategy &sortStrategy =
+                dfmbase::CollationStrategyProvider::instance()->strategy();
+        for (qsizetype i = begin; i < end; ++i) {
+            const QUrl &url = store->url(missingRoles.at(i));
+            if (m_context.role != SortRole::MimeType) {
+                out[i] = sortStrategy.sortKey(generateSortKeyStringInternal(url));
+                continue;
+            }
 
-    if (firstFileIndex == -1) {
-        // 全部是目录
-        result = urls;
-        std::reverse(result.begin(), result.end());
-    } else if (firstFileIndex == 0) {
-        // 全部是文件
-        result = urls;
-        std::reverse(result.begin(), result.end());
-    } else {
-        // 有目录也有文件：分别 reverse
-        QList<QUrl> dirs = urls.mid(0, firstFileIndex);
-        QList<QUrl> files = urls.mid(firstFileIndex);
+            QString fileName;
+            if (m_context.getDataCallback) {
+                auto itemData = m_context.getDataCallback(url);
+                fileName = getFileDisplayName(url, itemData);
+            } else {
+                fileName = url.fileName();
+            }
+            out[i] = sortStrategy.sortKey(encodeMimeTypeSortKey(mimeTypeMap.value(url, "Unknown"), fileName));
+        }
+    });
+    for (qsizetype i = 0; i < missingRoles.size(); ++i)
+        store->setRoleKey(missingRoles.at(i), 0, keys.at(i));
+}
+
+qint64 FileViewSorter::getSortTime(const QUrl &url, const SortKeyStore *store, SortKeyStore::Id id)
+{
+    if (m_context.role == SortRole::LastModified && store->lastModified(id) > 0)
+        return store->lastModified(id);
 
-        std::reverse(dirs.begin(), dirs.end());
-        std::reverse(files.begin(), files.end());
+    FileItemDataPointer itemData = m_context.getDataCallback ? m_context.getDataCallback(url) : nullptr;
+    SortInfoPointer sortInfo = itemData ? itemData->fileSortInfo() : nullptr;
+    FileInfoPointer fileInfo = itemData ? itemData->fileInfo() : nullptr;
 
-        result = dirs;
-        result.append(files);
+    dfmbase::TimeInfoType type = dfmbase::TimeInfoType::kLastModified;
+    qint64 secs = 0;
+    if (m_context.role == SortRole::LastCreated) {
+        type = dfmbase::TimeInfoType::kCreateTime;
+        secs = sortInfo ? sortInfo->createTime() : 0;
+    } else if (m_context.role == SortRole::LastRead) {
+        type = dfmbase::TimeInfoType::kLastRead;
+        secs = sortInfo ? sortInfo->lastReadTime() : 0;
     }
+    if (secs > 0)
+        return secs;
 
-    return result;
+    // 与 getSortData 相同的回退顺序：已有 FileInfo，再新建 FileInfo
+    if (!fileInfo)
+        fileInfo = dfmbase::InfoFactory::create<dfmbase::FileInfo>(url);
+    if (fileInfo) {
+        const QDateTime &time = fileInfo->timeOf(type).value<QDateTime>();
+        if (time.isValid())
+            return qMax<qint64>(0, time.toSecsSinceEpoch());
+    }
+    return 0;
+}
+
+bool FileViewSorter::lessThan(const SortKeyStore *store, SortKeyStore::Id left, SortKeyStore::Id right) const
+{
+    // 非混排时目录始终在前；混排下按大小排序同样保持目录在前（与 sortKey 前缀规则一致）
+    if (!m_context.isMixDirAndFile || m_context.role == SortRole::Size) {
+        const bool leftDir = store->isDir(left);
+        const bool rightDir = store->isDir(right);
+        if (leftDir != rightDir)
+            return leftDir;
+    }
+
+    int result = 0;
+    switch (m_context.role) {
+    case SortRole::FileName:
+        break;
+    case SortRole::Size: {
+        const qint64 leftSize = store->isDir(left) ? 0 : store->size(left);
+        const qint64 rightSize = store->isDir(right) ? 0 : store->size(right);
+        result = leftSize < rightSize ? -1 : (leftSize > rightSize ? 1 : 0);
+        break;
+    }
+    case SortRole::LastModified:
+    case SortRole::LastCreated:
+    case SortRole::LastRead: {
+        const qint64 leftTime = store->roleValue(left);
+        const qint64 rightTime = store->roleValue(right);
+        result = leftTime < rightTime ? -1 : (leftTime > rightTime ? 1 : 0);
+        break;
+    }
+    default:
+        result = store->roleKey(left).compare(store->roleKey(right));
+        if (result != 0)
+            return m_context.order == Qt::AscendingOrder ? result < 0 : result > 0;
+        return false;
+    }
+
+    if (result == 0)
+        result = store->nameKey(left).compare(store->nameKey(right));
+
+    return m_context.order == Qt::AscendingOrder ? result < 0 : result > 0;
+}
+
+QList<QUrl> FileViewSorter::reverse(const QList<QUrl> &urls)
+{
+    if (urls.isEmpty())
+        return urls;
+
+    // Size 排序时，始终分组处理（无论是否混排）
+    // 因为目录和文件的 size 语义不同，不应该混在一起 reverse
+    const bool needGroupedReverse = !m_context.isMixDirAndFile || (m_context.role == SortRole::Size);
+    return reverseGrouped(urls, needGroupedReverse, [this](const QUrl &url) { return isDir(url); });
+}
+
+QVector<SortKeyStore::Id> FileViewSorter::reverse(const QVector<SortKeyStore::Id> &ids, const SortKeyStore *store)
+{
+    if (ids.isEmpty() || !store)
+        return ids;
+
+    const bool needGroupedReverse = !m_context.isMixDirAndFile || (m_context.role == SortRole::Size);
+    return reverseGrouped(ids, needGroupedReverse, [store](SortKeyStore::Id id) { return store->isDir(id); });
 }
 
 int FileViewSorter::findInsertPosition(const QUrl &url, const QList<QUrl> &sortedList)
@@ -327,6 +607,30 @@ int FileViewSorter::findInsertPosition(const QUrl &url, const QList<QUrl> &sorte
     return left;
 }
 
+int FileViewSorter::findInsertPosition(SortKeyStore::Id id, const QVector<SortKeyStore::Id> &sortedIds, SortKeyStore *store)
+{
+    if (sortedIds.isEmpty() || !store || id == SortKeyStore::kInvalidId)
+        return sortedIds.size();
+
+    prepareKeys(store, { id });
+
+    // 与 findInsertPosition(url, sortedList) 一致：相等时插在后面
+    int left = 0;
+    int right = sortedIds.size();
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        const SortKeyStore::Id midId = sortedIds.at(mid);
+        prepareKeys(store, { midId });
+        if (lessThan(store, id, midId)) {
+            right = mid;
+        } else {
+            left = mid + 1;
+        }
+    }
+
+    return left;
+}
+
 FileViewSorter::SortRole FileViewSorter::toItemRole(dfmbase::Global::ItemRoles role)
 {
     using namespace dfmbase::Global;
@@ -6,6 +6,7 @@
 #define FILEVIEWSORTER_H
 
 #include "dfmplugin_workspace_global.h"
+#include "utils/sortkeystore.h"
 
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/interfaces/fileinfo.h>
@@ -84,6 +85,24 @@ public:
      */
     QList<QUrl> sort(const QList<QUrl> &urls);
 
+    /**
+     * @brief 基于列式存储的批量排序，只置换 ID 数组
+     * @param ids 待排序的条目 ID，均属于 store
+     * @param store ids 所在目录的排序数据，不能为空
+     * @return 排序后的 ID 列表
+     */
+    QVector<SortKeyStore::Id> sort(const QVector<SortKeyStore::Id> &ids, SortKeyStore *store);
+
+    /**
+     * @brief 将已排序的新增 ID 一次归并进已排序 ID 列表（相等时新项在后，与 findInsertPosition 一致）
+     * @param sortedIds 当前已排序的 ID 列表
+     * @param sortedNew 已按同一上下文排序的新增 ID 列表
+     * @param store 两个列表所在目录的排序数据，不能为空
+     * @return 归并后的 ID 列表
+     */
+    QVector<SortKeyStore::Id> merge(const QVector<SortKeyStore::Id> &sortedIds, const QVector<SortKeyStore::Id> &sortedNew,
+                                    SortKeyStore *store);
+
     /**
      * @brief 简单反序列表
      * @param urls URL 列表
@@ -91,6 +110,11 @@ public:
      */
     QList<QUrl> reverse(const QList<QUrl> &urls);
 
+    /**
+     * @brief 反序 ID 列表，目录/文件分组规则与 reverse(urls) 一致
+     */
+    QVector<SortKeyStore::Id> reverse(const QVector<SortKeyStore::Id> &ids, const SortKeyStore *store);
+
     /**
      * @brief 增量插入定位（使用 sortKey + 二分查找）
      * @param url 待插入的 URL
@@ -99,6 +123,13 @@ public:
      */
     int findInsertPosition(const QUrl &url, const QList<QUrl> &sortedList);
 
+    /**
+     * @brief 增量插入定位，比较时使用 store 中缓存的排序键
+     * @param id 待插入条目的 ID
+     * @param sortedIds 已排序的 ID 列表，均属于 store
+     */
+    int findInsertPosition(SortKeyStore::Id id, const QVector<SortKeyStore::Id> &sortedIds, SortKeyStore *store);
+
     /**
      * @brief 从 ItemRoles 转换为 SortRole
      */
@@ -157,6 +188,21 @@ private:
      */
     QHash<QUrl, QString> batchGetMimeTypes(const QList<QUrl> &urls);
 
+    /**
+     * @brief 为 ids 填充当前排序角色需要的派生列（已缓存的跳过）
+     */
+    void prepareKeys(SortKeyStore *store, const QVector<SortKeyStore::Id> &ids);
+
+    /**
+     * @brief 时间类角色的秒数，无效时间返回 0
+     */
+    qint64 getSortTime(const QUrl &url, const SortKeyStore *store, SortKeyStore::Id id);
+
+    /**
+     * @brief 按当前上下文比较两个条目（含目录优先规则）
+     */
+    bool lessThan(const SortKeyStore *store, SortKeyStore::Id left, SortKeyStore::Id right) const;
+
 private:
     SortContext m_context;
 };
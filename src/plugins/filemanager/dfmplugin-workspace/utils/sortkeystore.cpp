@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sortkeystore.h"
+
+DPWORKSPACE_BEGIN_NAMESPACE
+
+namespace {
+constexpr quint8 kDerivedFlags { SortKeyStore::kNameKeyValid | SortKeyStore::kRoleKeyValid };
+}   // namespace
+
+/*!
+ * \brief SortKeyStore::insert 添加一个条目，已存在时刷新其数据
+ * \param info 文件排序信息
+ * \return 条目 ID，info 无效时返回 kInvalidId
+ */
+SortKeyStore::Id SortKeyStore::insert(const SortInfoPointer &info)
+{
+    if (!info)
+        return kInvalidId;
+
+    const QUrl &fileUrl = info->fileUrl();
+    auto it = idOf.constFind(fileUrl);
+    if (it != idOf.constEnd()) {
+        fill(it.value(), info);
+        return it.value();
+    }
+
+    Id newId;
+    if (!freeIds.isEmpty()) {
+        newId = freeIds.takeLast();
+    } else {
+        newId = static_cast<Id>(urlColumn.size());
+        urlColumn.append(QUrl());
+        infoColumn.append(SortInfoPointer());
+        flagColumn.append(0);
+        sizeColumn.append(0);
+        mtimeColumn.append(0);
+        nameKeys.append(QByteArray());
+        roleValues.append(0);
+        roleKeys.append(QByteArray());
+    }
+
+    urlColumn[static_cast<int>(newId)] = fileUrl;
+    idOf.insert(fileUrl, newId);
+    fill(newId, info);
+    return newId;
+}
+
+/*!
+ * \brief SortKeyStore::refresh 文件属性变化后重新读取原始列并使派生列失效
+ * \return 条目不存在时返回 false
+ */
+bool SortKeyStore::refresh(const SortInfoPointer &info)
+{
+    if (!info)
+        return false;
+
+    const Id fileId = id(info->fileUrl());
+    if (fileId == kInvalidId)
+        return false;
+
+    fill(fileId, info);
+    return true;
+}
+
+/*!
+ * \brief SortKeyStore::remove 移除条目并回收其 ID
+ * \return 条目不存在时返回 false
+ */
+bool SortKeyStore::remove(const QUrl &url)
+{
+    auto it = idOf.find(url);
+    if (it == idOf.end())
+        return false;
+
+    const Id fileId = it.value();
+    idOf.erase(it);
+    const int index = static_cast<int>(fileId);
+    urlColumn[index] = QUrl();
+    infoColumn[index].reset();
+    flagColumn[index] = kRemoved;
+    nameKeys[index].clear();
+    roleKeys[index].clear();
+    freeIds.append(fileId);
+    return true;
+}
+
+void SortKeyStore::clear()
+{
+    idOf.clear();
+    freeIds.clear();
+    currentKeyRole = -1;
+    urlColumn.clear();
+    infoColumn.clear();
+    flagColumn.clear();
+    sizeColumn.clear();
+    mtimeColumn.clear();
+    nameKeys.clear();
+    roleValues.clear();
+    roleKeys.clear();
+}
+
+/*!
+ * \brief SortKeyStore::invalidateKeys 排序策略变化时丢弃所有派生列
+ */
+void SortKeyStore::invalidateKeys()
+{
+    for (auto &flag : flagColumn)
+        flag &= static_cast<quint8>(~kDerivedFlags);
+}
+
+/*!
+ * \brief SortKeyStore::ids 所有有效条目的 ID，按 ID 升序
+ */
+QVector<SortKeyStore::Id> SortKeyStore::ids() const
+{
+    QVector<Id> result;
+    result.reserve(idOf.size());
+    for (int index = 0; index < flagColumn.size(); ++index) {
+        if (!(flagColumn.at(index) & kRemoved))
+            result.append(static_cast<Id>(index));
+    }
+    return result;
+}
+
+QVector<SortKeyStore::Id> SortKeyStore::ids(const QList<QUrl> &urls) const
+{
+    QVector<Id> result;
+    result.reserve(urls.size());
+    for (const QUrl &fileUrl : urls) {
+        auto it = idOf.constFind(fileUrl);
+        if (it == idOf.constEnd())
+            return {};
+        result.append(it.value());
+    }
+    return result;
+}
+
+QList<QUrl> SortKeyStore::urls() const
+{
+    return urls(ids());
+}
+
+QList<SortInfoPointer> SortKeyStore::infos() const
+{
+    QList<SortInfoPointer> result;
+    result.reserve(idOf.size());
+    for (Id fileId : ids())
+        result.append(info(fileId));
+    return result;
+}
+
+SortInfoPointer SortKeyStore::value(const QUrl &url) const
+{
+    auto it = idOf.constFind(url);
+    return it == idOf.constEnd() ? SortInfoPointer() : infoColumn.at(static_cast<int>(it.value()));
+}
+
+QList<QUrl> SortKeyStore::urls(const QVector<Id> &ids) const
+{
+    QList<QUrl> result;
+    result.reserve(ids.size());
+    for (Id fileId : ids)
+        result.append(url(fileId));
+    return result;
+}
+
+void SortKeyStore::setNameKey(Id id, const QByteArray &key)
+{
+    const int index = static_cast<int>(id);
+    nameKeys[index] = key;
+    flagColumn[index] |= kNameKeyValid;
+}
+
+/*!
+ * \brief SortKeyStore::setKeyRole 切换角色派生列对应的排序角色，角色变化时该列整体失效
+ */
+void SortKeyStore::setKeyRole(int role)
+{
+    if (currentKeyRole == role)
+        return;
+
+    currentKeyRole = role;
+    for (auto &flag : flagColumn)
+        flag &= static_cast<quint8>(~kRoleKeyValid);
+}
+
+void SortKeyStore::setRoleKey(Id id, qint64 value, const QByteArray &key)
+{
+    const int index = static_cast<int>(id);
+    roleValues[index] = value;
+    roleKeys[index] = key;
+    flagColumn[index] |= kRoleKeyValid;
+}
+
+void SortKeyStore::fill(Id id, const SortInfoPointer &info)
+{
+    const int index = static_cast<int>(id);
+    quint8 flag = 0;
+    if (info->isDir())
+        flag |= kDir;
+    if (info->isHide())
+        flag |= kHidden;
+    if (info->isSymLink())
+        flag |= kSymLink;
+
+    infoColumn[index] = info;
+    flagColumn[index] = flag;
+    sizeColumn[index] = info->fileSize();
+    mtimeColumn[index] = info->lastModifiedTime();
+}
+
+DPWORKSPACE_END_NAMESPACE
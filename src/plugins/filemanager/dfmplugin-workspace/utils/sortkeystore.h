@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SORTKEYSTORE_H
+#define SORTKEYSTORE_H
+
+#include "dfmplugin_workspace_global.h"
+
+#include <dfm-base/interfaces/sortfileinfo.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QUrl>
+#include <QVector>
+
+#include <limits>
+
+DPWORKSPACE_BEGIN_NAMESPACE
+
+/**
+ * @class SortKeyStore
+ * @brief 单个目录下文件排序数据的列式存储
+ *
+ * 每个条目分配一个稠密的整数 ID，名称排序键、大小、修改时间、类型键和标志位
+ * 分别保存在连续数组中。排序与过滤只需对 ID 数组做置换，比较时直接访问数组，
+ * 不再对完整 QUrl 做哈希查找和共享指针解引用。
+ *
+ * FileSortWorker 以它作为每个目录下子项的唯一容器，SortFileInfo 也保存在列中，
+ * 不再另外维护 QHash<QUrl, SortInfoPointer>。
+ *
+ * 派生列（排序键、按角色计算的值）由 FileViewSorter 按需填充并缓存，
+ * 文件更新、排序角色或排序策略变化时失效。
+ */
+class SortKeyStore
+{
+public:
+    using Id = quint32;
+    static constexpr Id kInvalidId { std::numeric_limits<Id>::max() };
+
+    enum Flag : quint8 {
+        kDir = 0x01,
+        kHidden = 0x02,
+        kSymLink = 0x04,
+        kNameKeyValid = 0x10,   // nameKeys 列已计算
+        kRoleKeyValid = 0x20,   // roleValues/roleKeys 列已按 keyRole 计算
+        kRemoved = 0x80,   // ID 已回收，等待复用
+    };
+
+    Id insert(const SortInfoPointer &info);
+    bool refresh(const SortInfoPointer &info);
+    bool remove(const QUrl &url);
+    void clear();
+    void invalidateKeys();
+
+    int count() const { return idOf.size(); }
+    bool isEmpty() const { return idOf.isEmpty(); }
+    bool contains(const QUrl &url) const { return idOf.contains(url); }
+    Id id(const QUrl &url) const { return idOf.value(url, kInvalidId); }
+    QVector<Id> ids() const;
+    QVector<Id> ids(const QList<QUrl> &urls) const;
+    QList<QUrl> urls() const;
+    QList<QUrl> urls(const QVector<Id> &ids) const;
+    QList<SortInfoPointer> infos() const;
+    SortInfoPointer value(const QUrl &url) const;
+
+    const QUrl &url(Id id) const { return urlColumn.at(static_cast<int>(id)); }
+    const SortInfoPointer &info(Id id) const { return infoColumn.at(static_cast<int>(id)); }
+    quint8 flags(Id id) const { return flagColumn.at(static_cast<int>(id)); }
+    bool isDir(Id id) const { return flags(id) & kDir; }
+    bool isHidden(Id id) const { return flags(id) & kHidden; }
+    qint64 size(Id id) const { return sizeColumn.at(static_cast<int>(id)); }
+    qint64 lastModified(Id id) const { return mtimeColumn.at(static_cast<int>(id)); }
+
+    bool hasNameKey(Id id) const { return flags(id) & kNameKeyValid; }
+    const QByteArray &nameKey(Id id) const { return nameKeys.at(static_cast<int>(id)); }
+    void setNameKey(Id id, const QByteArray &key);
+
+    // 角色相关的派生列：时间类角色使用 roleValue，类型/路径类角色使用 roleKey
+    void setKeyRole(int role);
+    int keyRole() const { return currentKeyRole; }
+    bool hasRoleKey(Id id) const { return flags(id) & kRoleKeyValid; }
+    qint64 roleValue(Id id) const { return roleValues.at(static_cast<int>(id)); }
+    const QByteArray &roleKey(Id id) const { return roleKeys.at(static_cast<int>(id)); }
+    void setRoleKey(Id id, qint64 value, const QByteArray &key = QByteArray());
+
+private:
+    void fill(Id id, const SortInfoPointer &info);
+
+    QHash<QUrl, Id> idOf;
+    QVector<Id> freeIds;
+    int currentKeyRole { -1 };
+
+    QVector<QUrl> urlColumn;
+    QVector<SortInfoPointer> infoColumn;
+    QVector<quint8> flagColumn;
+    QVector<qint64> sizeColumn;
+    QVector<qint64> mtimeColumn;
+    QVector<QByteArray> nameKeys;
+    QVector<qint64> roleValues;
+    QVector<QByteArray> roleKeys;
+};
+
+DPWORKSPACE_END_NAMESPACE
+
+#endif   // SORTKEYSTORE_H
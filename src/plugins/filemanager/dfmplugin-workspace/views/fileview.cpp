@@ -32,6 +32,7 @@
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/base/application/application.h>
 #include <dfm-base/base/application/settings.h>
+#include <dfm-base/base/urlroute.h>
 #include <dfm-base/utils/windowutils.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/networkutils.h>
@@ -42,6 +43,7 @@
 #include <dfm-base/utils/fileinfohelper.h>
 #include <dfm-base/utils/protocolutils.h>
 #include <dfm-base/utils/viewdefines.h>
+#include <dfm-base/utils/thumbnail/thumbnailfactory.h>
 
 #ifdef DTKWIDGET_CLASS_DSizeMode
 #    include <DSizeMode>
@@ -2484,11 +2486,18 @@ void FileView::initializeScrollBarWatcher()
 
     connect(d->scrollBarValueChangedTimer, &QTimer::timeout, this, [this] { this->update(); });
 
+    // 滚动停下后取消已滚出视口的缩略图任务
+    d->thumbnailCancelTimer = new QTimer(this);
+    d->thumbnailCancelTimer->setInterval(200);
+    d->thumbnailCancelTimer->setSingleShot(true);
+    connect(d->thumbnailCancelTimer, &QTimer::timeout, this, &FileView::cancelInvisibleThumbnailJobs);
+
     connect(verticalScrollBar(), &QScrollBar::sliderPressed, this, [this] { d->scrollBarSliderPressed = true; });
     connect(verticalScrollBar(), &QScrollBar::sliderReleased, this, [this] { d->scrollBarSliderPressed = false; });
     connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
         if (d->scrollBarSliderPressed)
             d->scrollBarValueChangedTimer->start();
+        d->thumbnailCancelTimer->start();
 
         if (isGroupedView()) {
             viewport()->update();
@@ -2496,6 +2505,27 @@ void FileView::initializeScrollBarWatcher()
     });
 }
 
+void FileView::cancelInvisibleThumbnailJobs()
+{
+    if (!model() || ThumbnailFactory::instance()->pendingJobCount() == 0)
+        return;
+
+    QSet<QUrl> visibleUrls;
+    const QRect &rect = viewport()->rect().translated(horizontalOffset(), verticalOffset());
+    for (const RangeIndex &range : visibleIndexes(rect)) {
+        for (int row = range.first; row <= range.second; ++row) {
+            const QModelIndex &index = model()->index(row, 0, rootIndex());
+            visibleUrls.insert(model()->data(index, ItemRoles::kItemUrlRole).toUrl());
+        }
+    }
+
+    // 只取消当前目录下的文件，其它窗口或展开的子目录的任务不受影响
+    const QUrl &root = rootUrl();
+    ThumbnailFactory::instance()->cancelThumbnailJobsIf([&visibleUrls, &root](const QUrl &url) {
+        return !visibleUrls.contains(url) && UniversalUtils::urlEquals(UrlRoute::urlParent(url), root);
+    });
+}
+
 void FileView::initializePreSelectTimer()
 {
     d->preSelectTimer = new QTimer(this);
@@ -221,6 +221,7 @@ private:
     void initializeStatusBar();
     void initializeConnect();
     void initializeScrollBarWatcher();
+    void cancelInvisibleThumbnailJobs();
     void initializePreSelectTimer();
     void initializeGroupHeaderTimer();
     void updateDelegateHighlightKeywords(const QStringList &keywords);
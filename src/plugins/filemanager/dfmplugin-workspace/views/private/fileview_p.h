@@ -82,6 +82,7 @@ class FileViewPrivate
     QMap<QString, bool> columnForRoleHiddenMap;
 
     QTimer *scrollBarValueChangedTimer { nullptr };
+    QTimer *thumbnailCancelTimer { nullptr };
     bool scrollBarSliderPressed { false };
 
     bool pressedStartWithExpand { false };
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "indexruntime.h"
+#include "utils/textindexconfig.h"
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 
@@ -10,10 +11,13 @@ IndexRuntime::IndexRuntime(IndexProfile profile, QObject *parent)
     : QObject(parent),
       m_profile(std::move(profile)),
       m_stateStore(m_profile),
+      m_processExtractor(TextIndexConfig::instance().maxExtractorProcesses()),
       m_context(m_profile, &m_stateStore, selectExtractor(), selectDocumentBuilder()),
       m_taskManager(new TaskManager(&m_context, this)),
-      m_fsEventController(new FSEventController(m_profile, this))
+      m_fsEventController(new FSEventController(m_profile, this)),
+      m_envDetector(new EnvDetector(this))
 {
+    initExtractorPolicy();
 }
 
 const IndexProfile &IndexRuntime::profile() const
@@ -41,6 +45,20 @@ FSEventController *IndexRuntime::fsEventController() const
     return m_fsEventController;
 }
 
+void IndexRuntime::initExtractorPolicy()
+{
+    // 用户正在使用电脑、使用电池或处于节能模式时只保留一个提取进程
+    connect(m_envDetector, &EnvDetector::envStateChanged, this, [this](const EnvState &state) {
+        m_processExtractor.setThrottled(!state.isIdleOk() || !state.isPowerOk() || !state.isPowerSaveOff());
+    });
+    connect(&TextIndexConfig::instance(), &TextIndexConfig::configChanged, this, [this]() {
+        m_processExtractor.setMaxProcesses(TextIndexConfig::instance().maxExtractorProcesses());
+    });
+
+    m_envDetector->setDataPath(m_profile.indexDirectory());
+    m_envDetector->start();
+}
+
 const IndexExtractor *IndexRuntime::selectExtractor() const
 {
     return &m_processExtractor;
@@ -8,6 +8,7 @@
 #include "core/indexcontext.h"
 #include "document/contentdocumentbuilder.h"
 #include "document/ocrdocumentbuilder.h"
+#include "env/envdetector.h"
 #include "fsmonitor/fseventcontroller.h"
 #include "extractor/processextractor.h"
 #include "profile/indexprofile.h"
@@ -35,6 +36,7 @@ public:
 private:
     const IndexExtractor *selectExtractor() const;
     const IndexDocumentBuilder *selectDocumentBuilder() const;
+    void initExtractorPolicy();
 
     IndexProfile m_profile;
     IndexStateStore m_stateStore;
@@ -44,6 +46,7 @@ private:
     IndexContext m_context;
     TaskManager *m_taskManager { nullptr };
     FSEventController *m_fsEventController { nullptr };
+    EnvDetector *m_envDetector { nullptr };
 };
 
 SERVICETEXTINDEX_END_NAMESPACE
@@ -36,7 +36,21 @@ QString lookupByTextChecksum(const QString &checksum, const QString &contentInde
             }
         });
 
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
+        return lookupByTextChecksum(checksum, newLucene<IndexSearcher>(reader));
+    } catch (...) {
+        // Deduplication is a best-effort optimization.
+        // On any failure, fall through to normal content extraction.
+        return {};
+    }
+}
+
+QString lookupByTextChecksum(const QString &checksum, const SearcherPtr &searcher)
+{
+    if (checksum.isEmpty() || !searcher) {
+        return {};
+    }
+
+    try {
         TermQueryPtr query = newLucene<TermQuery>(
                 newLucene<Term>(Content::kCheckSum, checksum.toStdWString()));
 
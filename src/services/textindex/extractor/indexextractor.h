@@ -7,7 +7,9 @@
 
 #include "service_textindex_global.h"
 
+#include <QList>
 #include <QString>
+#include <QStringList>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 
@@ -26,6 +28,26 @@ public:
     virtual ~IndexExtractor() = default;
 
     virtual IndexExtractionResult extract(const QString &filePath, size_t maxBytes = 0) const = 0;
+
+    /**
+     * @brief Extract several files at once, results are in the same order as filePaths.
+     *
+     * Implementations backed by more than one worker process the files concurrently;
+     * the default implementation simply calls extract() for each file.
+     */
+    virtual QList<IndexExtractionResult> extractBatch(const QStringList &filePaths, size_t maxBytes = 0) const
+    {
+        QList<IndexExtractionResult> results;
+        results.reserve(filePaths.size());
+        for (const QString &filePath : filePaths)
+            results.append(extract(filePath, maxBytes));
+        return results;
+    }
+
+    /**
+     * @brief Number of files a caller should hand to extractBatch() to keep every worker busy
+     */
+    virtual int preferredBatchSize() const { return 1; }
 };
 
 SERVICETEXTINDEX_END_NAMESPACE
@@ -7,6 +7,8 @@
 
 #include "service_textindex_global.h"
 
+#include <lucene++/LuceneHeaders.h>
+
 #include <QString>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
@@ -28,6 +30,14 @@ namespace OcrDeduplication {
  */
 QString lookupByTextChecksum(const QString &checksum, const QString &ocrIndexDir);
 
+/**
+ * @brief Same as above, but searches through an already opened searcher
+ *
+ * Used by indexing tasks that keep one reader/searcher open for the whole task
+ * instead of opening the index for every checksum lookup.
+ */
+QString lookupByTextChecksum(const QString &checksum, const Lucene::SearcherPtr &searcher);
+
 }   // namespace OcrDeduplication
 
 SERVICETEXTINDEX_END_NAMESPACE
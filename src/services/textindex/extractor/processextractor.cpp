@@ -8,8 +8,17 @@
 #include <controllerpipe.h>
 
 #include <QEventLoop>
+#include <QMutex>
+#include <QSharedPointer>
 #include <QThread>
 #include <QTimer>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 
@@ -17,236 +26,411 @@ namespace {
 
 constexpr int kExtractorRequestTimeoutMs = 120000;
 constexpr int kExtractorIdleShutdownMs = 60000;
+// 每个进程管道中最多排队的文件数，当前文件完成时下一个文件已经送达，省去一次往返
+constexpr int kPipelineDepth = 2;
+constexpr int kAutoMaxProcesses = 4;
+constexpr int kMaxProcessesLimit = 16;
+
+int resolveMaxProcesses(int maxProcesses)
+{
+    if (maxProcesses <= 0)
+        maxProcesses = qBound(1, QThread::idealThreadCount() / 2, kAutoMaxProcesses);
+    return qBound(1, maxProcesses, kMaxProcessesLimit);
+}
+
+/**
+ * @brief 一次 extractBatch 调用的结果，调用线程等待，进程池所在线程逐个填充
+ */
+struct ExtractionBatch
+{
+    QMutex mutex;
+    QWaitCondition finished;
+    QList<IndexExtractionResult> results;
+    int remaining { 0 };
+    QEventLoop *loop { nullptr };   // 调用方与进程池在同一线程时使用
+};
+using ExtractionBatchPtr = QSharedPointer<ExtractionBatch>;
 
-struct ActiveExtraction
+struct ExtractionRequest
 {
     QString filePath;
-    IndexExtractionResult result;
-    QEventLoop *loop { nullptr };
+    ExtractionBatchPtr batch;
+    int index { 0 };
+};
+
+struct ExtractorWorker
+{
+    int id { 0 };
+    EXTRACTOR_NAMESPACE::ControllerPipe *pipe { nullptr };
+    QTimer requestTimer;
+    QTimer idleTimer;
+    std::deque<ExtractionRequest> inFlight;   // 已发送给子进程的文件，子进程按发送顺序处理
+    bool stopping { false };
 };
 
-class ProcessExtractorProxy : public QObject
+class ProcessExtractorPool : public QObject
 {
 public:
-    explicit ProcessExtractorProxy(QString extractorPath, QObject *parent = nullptr)
+    ProcessExtractorPool(QString extractorPath, int maxProcesses, QObject *parent = nullptr)
         : QObject(parent),
           m_extractorPath(std::move(extractorPath)),
-          m_pipe(new EXTRACTOR_NAMESPACE::ControllerPipe(this))
+          m_maxProcesses(resolveMaxProcesses(maxProcesses))
     {
-        m_requestTimeoutTimer.setSingleShot(true);
-        m_idleShutdownTimer.setSingleShot(true);
+        ensureWorkers();
+    }
 
-        connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::extractionFinished, this,
-                [this](const QString &path, const QByteArray &data) {
-                    if (!m_activeExtraction || path != m_activeExtraction->filePath) {
-                        return;
-                    }
+    int maxProcesses() const
+    {
+        return m_maxProcesses;
+    }
 
-                    fmDebug() << "ProcessExtractorProxy: extraction finished for:" << path
-                              << "size:" << data.size();
-                    finishActiveExtraction({ true, QString::fromUtf8(data).trimmed(), QString() });
-                });
+    void submit(const QList<ExtractionRequest> &requests)
+    {
+        Q_ASSERT(QThread::currentThread() == thread());
 
-        connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::extractionFailed, this,
-                [this](const QString &path, const QString &error) {
-                    if (!m_activeExtraction || path != m_activeExtraction->filePath) {
-                        return;
-                    }
+        if (m_shuttingDown) {
+            for (const ExtractionRequest &request : requests)
+                complete(request, { false, QString(), QStringLiteral("Process extractor shutting down") });
+            return;
+        }
 
-                    fmWarning() << "ProcessExtractorProxy: extraction failed for:" << path
-                                << "error:" << error;
-                    finishActiveExtraction({ false, QString(), error });
-                });
+        for (const ExtractionRequest &request : requests)
+            m_queue.push_back(request);
+        dispatch();
+    }
 
-        connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::errorOccurred, this,
-                [this](const QString &error) {
-                    if (m_stoppingPipe) {
-                        return;
-                    }
+    void setMaxProcesses(int maxProcesses)
+    {
+        Q_ASSERT(QThread::currentThread() == thread());
 
-                    if (!m_activeExtraction) {
-                        fmWarning() << "ProcessExtractorProxy: extractor reported error without active request:"
-                                    << error;
-                        return;
-                    }
+        m_maxProcesses = resolveMaxProcesses(maxProcesses);
+        fmInfo() << "ProcessExtractorPool: max extractor processes:" << m_maxProcesses.load();
+        ensureWorkers();
+        stopSurplusWorkers();
+        dispatch();
+    }
+
+    void setThrottled(bool throttled)
+    {
+        Q_ASSERT(QThread::currentThread() == thread());
+
+        if (m_throttled == throttled)
+            return;
+
+        m_throttled = throttled;
+        fmInfo() << "ProcessExtractorPool: active extractor processes:" << activeLimit();
+        stopSurplusWorkers();
+        dispatch();
+    }
+
+    void shutdown()
+    {
+        if (QThread::currentThread() != thread()) {
+            QMetaObject::invokeMethod(this, [this]() {
+                shutdown();
+            }, Qt::BlockingQueuedConnection);
+            return;
+        }
+
+        m_shuttingDown = true;
+        const IndexExtractionResult aborted { false, QString(), QStringLiteral("Process extractor shutting down") };
+        for (const auto &worker : m_workers) {
+            std::deque<ExtractionRequest> inFlight;
+            inFlight.swap(worker->inFlight);
+            stopWorker(worker.get());
+            for (const ExtractionRequest &request : inFlight)
+                complete(request, aborted);
+        }
+        failQueue(aborted.error);
+    }
+
+private:
+    int activeLimit() const
+    {
+        return m_throttled ? 1 : m_maxProcesses.load();
+    }
+
+    void ensureWorkers()
+    {
+        while (static_cast<int>(m_workers.size()) < m_maxProcesses) {
+            auto worker = std::make_unique<ExtractorWorker>();
+            worker->id = static_cast<int>(m_workers.size());
+            worker->pipe = new EXTRACTOR_NAMESPACE::ControllerPipe(this);
+            worker->requestTimer.setSingleShot(true);
+            worker->idleTimer.setSingleShot(true);
+            connectWorker(worker.get());
+            m_workers.push_back(std::move(worker));
+        }
+    }
+
+    void connectWorker(ExtractorWorker *worker)
+    {
+        using EXTRACTOR_NAMESPACE::ControllerPipe;
 
-                    fmWarning() << "ProcessExtractorProxy: extractor error for:"
-                                << m_activeExtraction->filePath << "error:" << error;
-                    stopPipe();
-                    finishActiveExtraction({ false, QString(), error });
+        // 开始处理下一个文件时重新计时，超时针对单个文件
+        connect(worker->pipe, &ControllerPipe::extractionStarted, this, [worker](const QString &) {
+            worker->requestTimer.start(kExtractorRequestTimeoutMs);
+        });
+
+        connect(worker->pipe, &ControllerPipe::extractionFinished, this,
+                [this, worker](const QString &path, const QByteArray &data) {
+                    fmDebug() << "ProcessExtractorPool: extraction finished for:" << path
+                              << "size:" << data.size() << "worker:" << worker->id;
+                    finishRequest(worker, path, { true, QString::fromUtf8(data).trimmed(), QString() });
                 });
 
-        connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::processCrashed, this, [this]() {
-            if (m_stoppingPipe) {
+        connect(worker->pipe, &ControllerPipe::extractionFailed, this,
+                [this, worker](const QString &path, const QString &error) {
+                    fmWarning() << "ProcessExtractorPool: extraction failed for:" << path
+                                << "error:" << error << "worker:" << worker->id;
+                    finishRequest(worker, path, { false, QString(), error });
+                });
+
+        connect(worker->pipe, &ControllerPipe::errorOccurred, this, [this, worker](const QString &error) {
+            if (worker->stopping)
                 return;
-            }
 
-            if (!m_activeExtraction) {
-                fmWarning() << "ProcessExtractorProxy: extractor process crashed without active request";
-                stopPipe();
+            if (worker->inFlight.empty()) {
+                fmWarning() << "ProcessExtractorPool: extractor reported error without active request:"
+                            << error << "worker:" << worker->id;
                 return;
             }
 
-            fmWarning() << "ProcessExtractorProxy: extractor process crashed during request for:"
-                        << m_activeExtraction->filePath;
-            stopPipe();
-            finishActiveExtraction({ false, QString(), QStringLiteral("Extractor process crashed") });
+            fmWarning() << "ProcessExtractorPool: extractor error for:" << worker->inFlight.front().filePath
+                        << "error:" << error << "worker:" << worker->id;
+            workerLost(worker, error);
         });
 
-        connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::processFinished, this,
-                [this](int exitCode, QProcess::ExitStatus exitStatus) {
-                    if (m_stoppingPipe) {
-                        return;
-                    }
+        connect(worker->pipe, &ControllerPipe::processCrashed, this, [this, worker]() {
+            if (worker->stopping)
+                return;
+
+            if (worker->inFlight.empty()) {
+                fmWarning() << "ProcessExtractorPool: extractor process crashed without active request, worker:" << worker->id;
+                stopWorker(worker);
+                return;
+            }
+
+            fmWarning() << "ProcessExtractorPool: extractor process crashed during request for:"
+                        << worker->inFlight.front().filePath << "worker:" << worker->id;
+            workerLost(worker, QStringLiteral("Extractor process crashed"));
+        });
 
-                    if (!m_activeExtraction || exitStatus == QProcess::CrashExit) {
+        connect(worker->pipe, &ControllerPipe::processFinished, this,
+                [this, worker](int exitCode, QProcess::ExitStatus exitStatus) {
+                    if (worker->stopping || worker->inFlight.empty() || exitStatus == QProcess::CrashExit)
                         return;
-                    }
 
-                    fmWarning() << "ProcessExtractorProxy: extractor process finished unexpectedly during request for:"
-                                << m_activeExtraction->filePath << "exitCode:" << exitCode
-                                << "exitStatus:" << exitStatus;
-                    stopPipe();
-                    finishActiveExtraction({ false, QString(), QStringLiteral("Extractor process finished unexpectedly") });
+                    fmWarning() << "ProcessExtractorPool: extractor process finished unexpectedly during request for:"
+                                << worker->inFlight.front().filePath << "exitCode:" << exitCode
+                                << "exitStatus:" << exitStatus << "worker:" << worker->id;
+                    workerLost(worker, QStringLiteral("Extractor process finished unexpectedly"));
                 });
 
-        connect(&m_requestTimeoutTimer, &QTimer::timeout, this, [this]() {
-            if (!m_activeExtraction) {
+        connect(&worker->requestTimer, &QTimer::timeout, this, [this, worker]() {
+            if (worker->inFlight.empty())
                 return;
-            }
 
-            fmWarning() << "ProcessExtractorProxy: request timed out for:" << m_activeExtraction->filePath;
-            stopPipe();
-            finishActiveExtraction({ false, QString(), QStringLiteral("Extractor request timed out") });
+            fmWarning() << "ProcessExtractorPool: request timed out for:" << worker->inFlight.front().filePath
+                        << "worker:" << worker->id;
+            workerLost(worker, QStringLiteral("Extractor request timed out"));
         });
 
-        connect(&m_idleShutdownTimer, &QTimer::timeout, this, [this]() {
-            if (!m_activeExtraction) {
-                fmInfo() << "ProcessExtractorProxy: stopping idle extractor process after timeout";
-                stopPipe();
+        connect(&worker->idleTimer, &QTimer::timeout, this, [this, worker]() {
+            if (worker->inFlight.empty()) {
+                fmInfo() << "ProcessExtractorPool: stopping idle extractor process after timeout, worker:" << worker->id;
+                stopWorker(worker);
             }
         });
     }
 
-    IndexExtractionResult extractSync(const QString &filePath, size_t maxBytes)
+    /**
+     * @brief 把排队的文件分给可用的进程，每轮给每个进程一个文件，直到管道填满
+     */
+    void dispatch()
     {
         Q_ASSERT(QThread::currentThread() == thread());
-        Q_UNUSED(maxBytes)
 
-        if (m_activeExtraction) {
-            fmWarning() << "ProcessExtractorProxy: received overlapping extract request for:" << filePath;
-            return { false, QString(), QStringLiteral("Extractor is busy processing another file") };
-        }
-
-        m_idleShutdownTimer.stop();
+        if (m_shuttingDown || m_queue.empty())
+            return;
 
-        if (!ensurePipeStarted()) {
-            return { false, QString(), QStringLiteral("Failed to start dde-file-manager-extractor") };
+        const int limit = std::min(activeLimit(), static_cast<int>(m_workers.size()));
+        std::vector<QList<ExtractionRequest>> assigned(static_cast<size_t>(limit));
+        for (int round = 0; round < kPipelineDepth && !m_queue.empty(); ++round) {
+            for (int i = 0; i < limit && !m_queue.empty(); ++i) {
+                const auto queued = static_cast<int>(m_workers[static_cast<size_t>(i)]->inFlight.size()
+                                                     + assigned[static_cast<size_t>(i)].size());
+                if (queued > round)
+                    continue;
+                assigned[static_cast<size_t>(i)].append(m_queue.front());
+                m_queue.pop_front();
+            }
         }
 
-        QEventLoop loop;
-        ActiveExtraction extraction;
-        extraction.filePath = filePath;
-        extraction.loop = &loop;
-        m_activeExtraction = &extraction;
-
-        m_requestTimeoutTimer.start(kExtractorRequestTimeoutMs);
-        if (!m_pipe->extractBatch({ filePath })) {
-            fmWarning() << "ProcessExtractorProxy: failed to send extractor request for:" << filePath;
-            stopPipe();
-            finishActiveExtraction({ false, QString(), QStringLiteral("Failed to send extractor request") });
+        bool startFailed = false;
+        for (int i = limit - 1; i >= 0; --i) {
+            QList<ExtractionRequest> &requests = assigned[static_cast<size_t>(i)];
+            if (requests.isEmpty())
+                continue;
+
+            ExtractorWorker *worker = m_workers[static_cast<size_t>(i)].get();
+            if (!ensureStarted(worker)) {
+                // 放回队首，交给其它进程
+                startFailed = true;
+                for (auto it = requests.crbegin(); it != requests.crend(); ++it)
+                    m_queue.push_front(*it);
+                continue;
+            }
+            send(worker, requests);
         }
 
-        if (m_activeExtraction) {
-            loop.exec();
-        }
+        if (!startFailed)
+            return;
 
-        return extraction.result;
+        const bool anyRunning = std::any_of(m_workers.cbegin(), m_workers.cbegin() + limit, [](const auto &worker) {
+            return worker->pipe->isRunning();
+        });
+        if (!anyRunning)
+            failQueue(QStringLiteral("Failed to start dde-file-manager-extractor"));
     }
 
-    void shutdown()
+    void send(ExtractorWorker *worker, const QList<ExtractionRequest> &requests)
     {
-        if (QThread::currentThread() != thread()) {
-            QMetaObject::invokeMethod(this, [this]() {
-                shutdown();
-            }, Qt::BlockingQueuedConnection);
-            return;
+        worker->idleTimer.stop();
+        if (worker->inFlight.empty())
+            worker->requestTimer.start(kExtractorRequestTimeoutMs);
+
+        QVector<QString> filePaths;
+        filePaths.reserve(requests.size());
+        for (const ExtractionRequest &request : requests) {
+            filePaths.append(request.filePath);
+            worker->inFlight.push_back(request);
         }
 
-        m_idleShutdownTimer.stop();
-        m_requestTimeoutTimer.stop();
-
-        finishActiveExtraction({ false, QString(), QStringLiteral("Process extractor shutting down") });
-        stopPipe();
+        if (!worker->pipe->extractBatch(filePaths)) {
+            fmWarning() << "ProcessExtractorPool: failed to send extractor request for:" << filePaths
+                        << "worker:" << worker->id;
+            workerLost(worker, QStringLiteral("Failed to send extractor request"));
+        }
     }
 
-private:
-    bool ensurePipeStarted()
+    bool ensureStarted(ExtractorWorker *worker)
     {
-        Q_ASSERT(QThread::currentThread() == thread());
-
-        if (m_pipe->isRunning()) {
+        if (worker->pipe->isRunning())
             return true;
-        }
 
         if (m_extractorPath.isEmpty()) {
-            fmCritical() << "ProcessExtractorProxy: extractor path is empty";
+            fmCritical() << "ProcessExtractorPool: extractor path is empty";
             return false;
         }
 
-        if (!m_pipe->start(m_extractorPath)) {
-            fmCritical() << "ProcessExtractorProxy: failed to start extractor process";
+        if (!worker->pipe->start(m_extractorPath)) {
+            fmCritical() << "ProcessExtractorPool: failed to start extractor process, worker:" << worker->id;
             return false;
         }
 
-        fmInfo() << "ProcessExtractorProxy: extractor process started, pid:" << m_pipe->processId();
+        fmInfo() << "ProcessExtractorPool: extractor process started, pid:" << worker->pipe->processId()
+                 << "worker:" << worker->id;
         return true;
     }
 
-    void finishActiveExtraction(const IndexExtractionResult &result)
+    void finishRequest(ExtractorWorker *worker, const QString &path, const IndexExtractionResult &result)
     {
-        Q_ASSERT(QThread::currentThread() == thread());
-
-        if (!m_activeExtraction) {
+        auto it = std::find_if(worker->inFlight.begin(), worker->inFlight.end(), [&path](const ExtractionRequest &request) {
+            return request.filePath == path;
+        });
+        if (it == worker->inFlight.end())
             return;
+
+        const ExtractionRequest request = *it;
+        worker->inFlight.erase(it);
+
+        if (worker->inFlight.empty()) {
+            worker->requestTimer.stop();
+            if (worker->id < activeLimit())
+                worker->idleTimer.start(kExtractorIdleShutdownMs);
+            else
+                stopWorker(worker);
         }
 
-        m_requestTimeoutTimer.stop();
-        m_activeExtraction->result = result;
+        complete(request, result);
+        dispatch();
+    }
 
-        QEventLoop *loop = m_activeExtraction->loop;
-        m_activeExtraction = nullptr;
+    /**
+     * @brief 进程崩溃、超时或通信失败：只有正在处理的文件失败，其余文件重新排队
+     */
+    void workerLost(ExtractorWorker *worker, const QString &error)
+    {
+        std::deque<ExtractionRequest> inFlight;
+        inFlight.swap(worker->inFlight);
+        stopWorker(worker);
 
-        if (m_pipe->isRunning()) {
-            m_idleShutdownTimer.start(kExtractorIdleShutdownMs);
-        }
+        if (inFlight.empty())
+            return;
 
-        if (loop && loop->isRunning()) {
-            loop->quit();
-        }
+        const ExtractionRequest current = inFlight.front();
+        inFlight.pop_front();
+        for (auto it = inFlight.crbegin(); it != inFlight.crend(); ++it)
+            m_queue.push_front(*it);
+
+        complete(current, { false, QString(), error });
+
+        // 当前仍处于该进程的信号处理中，下一轮事件循环再重启进程
+        QTimer::singleShot(0, this, [this]() {
+            dispatch();
+        });
     }
 
-    void stopPipe()
+    void stopWorker(ExtractorWorker *worker)
     {
-        Q_ASSERT(QThread::currentThread() == thread());
+        worker->requestTimer.stop();
+        worker->idleTimer.stop();
 
-        if (!m_pipe->isRunning()) {
+        if (!worker->pipe->isRunning())
             return;
+
+        worker->stopping = true;
+        fmInfo() << "ProcessExtractorPool: stopping extractor process, worker:" << worker->id;
+        worker->pipe->stop();
+        worker->stopping = false;
+    }
+
+    void stopSurplusWorkers()
+    {
+        for (size_t i = static_cast<size_t>(activeLimit()); i < m_workers.size(); ++i) {
+            if (m_workers[i]->inFlight.empty())
+                stopWorker(m_workers[i].get());
         }
+    }
 
-        m_stoppingPipe = true;
-        fmInfo() << "ProcessExtractorProxy: stopping extractor process";
-        m_pipe->stop();
-        m_stoppingPipe = false;
+    void failQueue(const QString &error)
+    {
+        std::deque<ExtractionRequest> queue;
+        queue.swap(m_queue);
+        for (const ExtractionRequest &request : queue)
+            complete(request, { false, QString(), error });
+    }
+
+    static void complete(const ExtractionRequest &request, const IndexExtractionResult &result)
+    {
+        QMutexLocker locker(&request.batch->mutex);
+        request.batch->results[request.index] = result;
+        if (--request.batch->remaining > 0)
+            return;
+
+        request.batch->finished.wakeAll();
+        if (request.batch->loop && request.batch->loop->isRunning())
+            request.batch->loop->quit();
     }
 
 private:
     const QString m_extractorPath;
-    EXTRACTOR_NAMESPACE::ControllerPipe *m_pipe { nullptr };
-    ActiveExtraction *m_activeExtraction { nullptr };
-    QTimer m_requestTimeoutTimer;
-    QTimer m_idleShutdownTimer;
-    bool m_stoppingPipe { false };
+    std::atomic_int m_maxProcesses { 1 };
+    bool m_throttled { true };
+    bool m_shuttingDown { false };
+    std::vector<std::unique_ptr<ExtractorWorker>> m_workers;
+    std::deque<ExtractionRequest> m_queue;
 };
 
 }   // namespace
@@ -254,61 +438,128 @@ private:
 class ProcessExtractorPrivate
 {
 public:
-    ProcessExtractorPrivate()
-        : proxy(new ProcessExtractorProxy(QStringLiteral(DFM_EXTRACTOR_TOOL)))
+    explicit ProcessExtractorPrivate(int maxProcesses)
+        : pool(new ProcessExtractorPool(QStringLiteral(DFM_EXTRACTOR_TOOL), maxProcesses))
     {
     }
 
     ~ProcessExtractorPrivate()
     {
-        delete proxy;
+        delete pool;
     }
 
-    ProcessExtractorProxy *proxy { nullptr };
-};
+    QList<IndexExtractionResult> waitSameThread(const ExtractionBatchPtr &batch, const QList<ExtractionRequest> &requests)
+    {
+        pool->submit(requests);
 
-IndexExtractionResult invokeProxyExtract(ProcessExtractorProxy *proxy, const QString &filePath, size_t maxBytes)
-{
-    IndexExtractionResult result;
-    const bool invoked = QMetaObject::invokeMethod(
-            proxy, [proxy, &result, filePath, maxBytes]() {
-                result = proxy->extractSync(filePath, maxBytes);
-            },
-            Qt::BlockingQueuedConnection);
-
-    if (!invoked) {
-        fmCritical() << "ProcessExtractor::extract: failed to invoke extractor request for:" << filePath;
-        return { false, QString(), QStringLiteral("Failed to invoke extractor request") };
+        {
+            QMutexLocker locker(&batch->mutex);
+            if (batch->remaining == 0)
+                return batch->results;
+        }
+
+        QEventLoop loop;
+        batch->loop = &loop;
+        loop.exec();
+        batch->loop = nullptr;
+        return batch->results;
     }
 
-    return result;
-}
+    QList<IndexExtractionResult> waitOtherThread(const ExtractionBatchPtr &batch, const QList<ExtractionRequest> &requests)
+    {
+        ProcessExtractorPool *target = pool;
+        const bool invoked = QMetaObject::invokeMethod(
+                target, [target, requests]() {
+                    target->submit(requests);
+                },
+                Qt::QueuedConnection);
+
+        if (!invoked) {
+            fmCritical() << "ProcessExtractor::extractBatch: failed to invoke extractor request";
+            return QList<IndexExtractionResult>(requests.size(),
+                                                { false, QString(), QStringLiteral("Failed to invoke extractor request") });
+        }
 
-ProcessExtractor::ProcessExtractor()
-    : d(new ProcessExtractorPrivate())
+        QMutexLocker locker(&batch->mutex);
+        while (batch->remaining > 0)
+            batch->finished.wait(&batch->mutex);
+        return batch->results;
+    }
+
+    ProcessExtractorPool *pool { nullptr };
+};
+
+ProcessExtractor::ProcessExtractor(int maxProcesses)
+    : d(new ProcessExtractorPrivate(maxProcesses))
 {
 }
 
 ProcessExtractor::~ProcessExtractor()
 {
-    if (d->proxy) {
-        Q_ASSERT(QThread::currentThread() == d->proxy->thread());
-        d->proxy->shutdown();
+    if (d->pool) {
+        Q_ASSERT(QThread::currentThread() == d->pool->thread());
+        d->pool->shutdown();
     }
 }
 
 IndexExtractionResult ProcessExtractor::extract(const QString &filePath, size_t maxBytes) const
 {
-    if (!d->proxy) {
-        fmCritical() << "ProcessExtractor::extract: extractor proxy is unavailable for:" << filePath;
-        return { false, QString(), QStringLiteral("Extractor proxy is unavailable") };
-    }
+    return extractBatch({ filePath }, maxBytes).value(0);
+}
+
+QList<IndexExtractionResult> ProcessExtractor::extractBatch(const QStringList &filePaths, size_t maxBytes) const
+{
+    Q_UNUSED(maxBytes)
 
-    if (QThread::currentThread() == d->proxy->thread()) {
-        return d->proxy->extractSync(filePath, maxBytes);
+    if (filePaths.isEmpty())
+        return {};
+
+    if (!d->pool) {
+        fmCritical() << "ProcessExtractor::extractBatch: extractor pool is unavailable for:" << filePaths;
+        return QList<IndexExtractionResult>(filePaths.size(),
+                                            { false, QString(), QStringLiteral("Extractor pool is unavailable") });
     }
 
-    return invokeProxyExtract(d->proxy, filePath, maxBytes);
+    auto batch = ExtractionBatchPtr::create();
+    batch->results.resize(filePaths.size());
+    batch->remaining = static_cast<int>(filePaths.size());
+
+    QList<ExtractionRequest> requests;
+    requests.reserve(filePaths.size());
+    for (int i = 0; i < filePaths.size(); ++i)
+        requests.append({ filePaths.at(i), batch, i });
+
+    if (QThread::currentThread() == d->pool->thread())
+        return d->waitSameThread(batch, requests);
+
+    return d->waitOtherThread(batch, requests);
+}
+
+int ProcessExtractor::preferredBatchSize() const
+{
+    return d->pool ? d->pool->maxProcesses() * kPipelineDepth : 1;
+}
+
+void ProcessExtractor::setMaxProcesses(int maxProcesses)
+{
+    ProcessExtractorPool *target = d->pool;
+    if (!target)
+        return;
+
+    QMetaObject::invokeMethod(target, [target, maxProcesses]() {
+        target->setMaxProcesses(maxProcesses);
+    });
+}
+
+void ProcessExtractor::setThrottled(bool throttled)
+{
+    ProcessExtractorPool *target = d->pool;
+    if (!target)
+        return;
+
+    QMetaObject::invokeMethod(target, [target, throttled]() {
+        target->setThrottled(throttled);
+    });
 }
 
 SERVICETEXTINDEX_END_NAMESPACE
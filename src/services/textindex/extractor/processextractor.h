@@ -13,15 +13,36 @@ SERVICETEXTINDEX_BEGIN_NAMESPACE
 
 class ProcessExtractorPrivate;
 
+/**
+ * @brief Extracts file text in a pool of dde-file-manager-extractor processes.
+ *
+ * Requests from any thread go into one shared queue. Each worker process gets a
+ * short pipeline of files so it starts the next file as soon as one finishes.
+ * A crash or timeout only affects the worker it happens in: the file being
+ * processed fails, the rest of that worker's files go back to the queue, and the
+ * process restarts when it is needed again.
+ */
 class ProcessExtractor : public IndexExtractor
 {
 public:
-    ProcessExtractor();
+    /**
+     * @param maxProcesses Upper bound of concurrent extractor processes, 0 picks a value from the CPU count
+     */
+    explicit ProcessExtractor(int maxProcesses = 0);
     ~ProcessExtractor() override;
 
     Q_DISABLE_COPY_MOVE(ProcessExtractor)
 
     IndexExtractionResult extract(const QString &filePath, size_t maxBytes = 0) const override;
+    QList<IndexExtractionResult> extractBatch(const QStringList &filePaths, size_t maxBytes = 0) const override;
+    int preferredBatchSize() const override;
+
+    void setMaxProcesses(int maxProcesses);
+
+    /**
+     * @brief Limit the pool to a single process, e.g. while the user is active or on battery
+     */
+    void setThrottled(bool throttled);
 
 private:
     const QScopedPointer<ProcessExtractorPrivate> d;
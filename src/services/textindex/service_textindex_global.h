@@ -44,6 +44,7 @@ inline const QString kFolderExcludeFilters = QLatin1String("folderExcludeFilters
 inline const QString kCpuUsageLimitPercent = QLatin1String("cpuUsageLimitPercent");
 inline const QString kInotifyWatchesCoefficient = QLatin1String("inotifyWatchesCoefficient");
 inline const QString kBatchCommitInterval = QLatin1String("batchCommitInterval");
+inline const QString kMaxExtractorProcesses = QLatin1String("maxExtractorProcesses");
 
 // Strategy optimization – environment detection
 inline const QString kIdleThresholdSeconds = QLatin1String("idleThresholdSeconds");
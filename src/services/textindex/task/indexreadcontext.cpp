@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "indexreadcontext.h"
+#include "extractor/contentdeduplication.h"
+#include "extractor/ocrdeduplication.h"
+
+#include <FieldCache.h>
+
+#include <QElapsedTimer>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+using namespace Lucene;
+
+IndexReadContext::IndexReadContext(const IndexProfile &profile, const QString &indexDir)
+    : m_profile(profile), m_indexDir(indexDir)
+{
+}
+
+IndexReadContext::~IndexReadContext()
+{
+    close();
+}
+
+IndexReaderPtr IndexReadContext::reader()
+{
+    if (!m_reader) {
+        m_reader = IndexReader::open(FSDirectory::open(m_indexDir.toStdWString()), true);
+        m_stale = false;
+        return m_reader;
+    }
+
+    if (m_stale) {
+        m_stale = false;
+        IndexReaderPtr reopened = m_reader->reopen();
+        if (reopened != m_reader) {
+            fmDebug() << "[IndexReadContext::reader] Reopened index reader after commit:" << m_indexDir;
+            close();
+            m_reader = reopened;
+        }
+    }
+    return m_reader;
+}
+
+SearcherPtr IndexReadContext::searcher()
+{
+    IndexReaderPtr current = reader();
+    if (!m_searcher)
+        m_searcher = newLucene<IndexSearcher>(current);
+    return m_searcher;
+}
+
+void IndexReadContext::markCommitted()
+{
+    m_stale = true;
+}
+
+std::optional<qint64> IndexReadContext::storedModifyTime(const QString &path)
+{
+    if (!m_modifyTimesLoaded)
+        loadModifyTimes();
+
+    auto it = m_modifyTimes.constFind(path);
+    if (it == m_modifyTimes.constEnd())
+        return std::nullopt;
+    return it.value();
+}
+
+void IndexReadContext::recordIndexed(const QString &path, qint64 modifyTime)
+{
+    if (m_modifyTimesLoaded)
+        m_modifyTimes.insert(path, modifyTime);
+}
+
+void IndexReadContext::forget(const QString &path)
+{
+    if (m_modifyTimesLoaded)
+        m_modifyTimes.remove(path);
+}
+
+QString IndexReadContext::lookupTextByChecksum(const QString &checksum)
+{
+    if (checksum.isEmpty())
+        return {};
+
+    SearcherPtr current;
+    try {
+        current = searcher();
+    } catch (...) {
+        // 新建的索引可能还没有可读的提交，去重只是优化，直接跳过
+        return {};
+    }
+
+    switch (m_profile.type()) {
+    case IndexProfile::Type::Ocr:
+        return OcrDeduplication::lookupByTextChecksum(checksum, current);
+    case IndexProfile::Type::Content:
+    default:
+        return ContentDeduplication::lookupByTextChecksum(checksum, current);
+    }
+}
+
+/**
+ * @brief 一次性加载全部文档的路径和修改时间
+ *
+ * FieldCache 按词项枚举填充以文档号为下标的数组，不读取存储字段；修改时间是 NumericField，
+ * 使用 NUMERIC_UTILS_LONG_PARSER 只解析全精度的词项。加载完成后立即从 FieldCache 中清除，
+ * 避免数组随 reader 常驻内存。
+ */
+void IndexReadContext::loadModifyTimes()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    IndexReaderPtr current = reader();
+    const FieldCachePtr cache = FieldCache::DEFAULT();
+    const Collection<String> paths = cache->getStrings(current, m_profile.pathField());
+    const Collection<int64_t> times = cache->getLongs(current, m_profile.modifyTimeField(),
+                                                      FieldCache::NUMERIC_UTILS_LONG_PARSER());
+
+    QHash<QString, qint64> loaded;
+    const int32_t maxDoc = current->maxDoc();
+    loaded.reserve(current->numDocs());
+    for (int32_t doc = 0; doc < maxDoc; ++doc) {
+        if (current->isDeleted(doc) || paths[doc].empty())
+            continue;
+        loaded.insert(QString::fromStdWString(paths[doc]), times[doc]);
+    }
+    cache->purge(current);
+
+    // 加载失败时抛出异常且不标记为已加载，避免把所有文件都当作新文件重复添加
+    m_modifyTimes.swap(loaded);
+    m_modifyTimesLoaded = true;
+
+    fmInfo() << "[IndexReadContext::loadModifyTimes] Loaded" << m_modifyTimes.size()
+             << "indexed modify times in" << timer.elapsed() << "ms";
+}
+
+void IndexReadContext::close()
+{
+    m_searcher.reset();
+    if (!m_reader)
+        return;
+
+    try {
+        m_reader->close();
+    } catch (...) {
+        fmWarning() << "[IndexReadContext::close] Exception occurred while closing index reader";
+    }
+    m_reader.reset();
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INDEXREADCONTEXT_H
+#define INDEXREADCONTEXT_H
+
+#include "service_textindex_global.h"
+#include "profile/indexprofile.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QHash>
+#include <QString>
+#include <optional>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * @brief 索引任务范围内共享的只读视图
+ *
+ * 一个任务只打开一次 IndexReader/IndexSearcher，供增量检查、去重查询和目录删除共用。
+ * 写入器提交后调用 markCommitted()，下一次取用时通过 IndexReader::reopen() 近实时刷新，
+ * 索引未变化时不重新打开。
+ *
+ * 路径 → 修改时间对照表在第一次查询时通过 FieldCache 对路径和修改时间字段各做一次词项枚举
+ * 整体加载，之后每个文件的检查只是一次哈希查找；本任务写入的文档通过 recordIndexed()
+ * 补充到表中，不需要为此重新加载。
+ */
+class IndexReadContext
+{
+public:
+    IndexReadContext(const IndexProfile &profile, const QString &indexDir);
+    ~IndexReadContext();
+
+    IndexReadContext(const IndexReadContext &) = delete;
+    IndexReadContext &operator=(const IndexReadContext &) = delete;
+
+    /**
+     * @brief 当前的 reader，首次调用时打开索引；打开失败时抛出 LuceneException
+     */
+    Lucene::IndexReaderPtr reader();
+    Lucene::SearcherPtr searcher();
+
+    /**
+     * @brief 写入器已提交，下次取用 reader/searcher 时重新打开
+     */
+    void markCommitted();
+
+    /**
+     * @brief 索引中记录的修改时间（秒），文件不在索引中时返回 std::nullopt
+     */
+    std::optional<qint64> storedModifyTime(const QString &path);
+    void recordIndexed(const QString &path, qint64 modifyTime);
+    void forget(const QString &path);
+
+    /**
+     * @brief 按校验和查找已索引的文本，尽力而为，任何失败都返回空字符串
+     */
+    QString lookupTextByChecksum(const QString &checksum);
+
+private:
+    void loadModifyTimes();
+    void close();
+
+    const IndexProfile m_profile;
+    const QString m_indexDir;
+    Lucene::IndexReaderPtr m_reader;
+    Lucene::SearcherPtr m_searcher;
+    bool m_stale { false };
+
+    QHash<QString, qint64> m_modifyTimes;
+    bool m_modifyTimesLoaded { false };
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // INDEXREADCONTEXT_H
@@ -6,6 +6,7 @@
 #include "document/builderoptions.h"
 #include "fileprovider.h"
 #include "indexcontentmigrator.h"
+#include "indexreadcontext.h"
 #include "progressnotifier.h"
 #include "moveprocessor.h"
 #include "utils/scopeguard.h"
@@ -25,6 +26,7 @@
 
 #include <QDir>
 #include <QDateTime>
+#include <QSet>
 
 SERVICETEXTINDEX_USE_NAMESPACE
 
@@ -111,8 +113,8 @@ std::unique_ptr<FileProvider> createAnythingFileProvider(const IndexContext &con
 class ProgressReporter
 {
 public:
-    explicit ProgressReporter(IndexWriterPtr writer = nullptr)
-        : processedCount(0), totalCount(0), lastReportTime(QDateTime::currentDateTime()), m_writer(writer), m_batchCommitInterval(TextIndexConfig::instance().batchCommitInterval()), m_lastCommitCount(0)
+    explicit ProgressReporter(IndexWriterPtr writer = nullptr, IndexReadContext *readContext = nullptr)
+        : processedCount(0), totalCount(0), lastReportTime(QDateTime::currentDateTime()), m_writer(writer), m_readContext(readContext), m_batchCommitInterval(TextIndexConfig::instance().batchCommitInterval()), m_lastCommitCount(0)
     {
         fmDebug() << "[ProgressReporter] Initialized progress reporter with batch commit interval:" << m_batchCommitInterval;
     }
@@ -128,6 +130,7 @@ public:
         if (m_writer && processedCount > m_lastCommitCount) {
             try {
                 m_writer->commit();
+                markCommitted();
                 fmDebug() << "[ProgressReporter] Final batch commit completed - processed:" << processedCount;
             } catch (const std::exception &e) {
                 fmWarning() << "[ProgressReporter] Final batch commit failed:" << e.what();
@@ -151,6 +154,7 @@ public:
         if (m_writer && (processedCount - m_lastCommitCount) >= m_batchCommitInterval) {
             try {
                 m_writer->commit();
+                markCommitted();
                 m_lastCommitCount = processedCount;
                 fmDebug() << "[ProgressReporter::increment] Batch commit completed at count:" << processedCount;
             } catch (const std::exception &e) {
@@ -185,10 +189,18 @@ public:
     }
 
 private:
+    // 提交后任务共享的 reader 需要近实时刷新
+    void markCommitted()
+    {
+        if (m_readContext)
+            m_readContext->markCommitted();
+    }
+
     qint64 processedCount;
     qint64 totalCount;
     QDateTime lastReportTime;
     IndexWriterPtr m_writer;
+    IndexReadContext *m_readContext;
     int m_batchCommitInterval;
     qint64 m_lastCommitCount;
     bool m_indexChanged { false };
@@ -197,121 +209,258 @@ private:
 // 目录遍历相关函数
 using FileHandler = std::function<void(const QString &path)>;
 
-DocumentPtr createFileDocument(const IndexContext &context, const QString &file,
-                                  const IndexContentMigrator *migrator = nullptr)
+/**
+ * @brief 一个等待写入索引的文件
+ */
+struct PendingDocument
 {
-    try {
-        if (!context.extractor() || !context.documentBuilder()) {
-            fmCritical() << "[createFileDocument] Missing extractor or document builder for profile:" << context.profile().id();
-            return nullptr;
-        }
-
-        const int truncationSizeMB = context.profile().maxFileTruncationSizeMB();
-        const size_t maxBytes = static_cast<size_t>(truncationSizeMB) * 1024 * 1024;
-
-        BuilderOptions options;
-        IndexExtractionResult extraction;
+    QString path;
+    bool update { false };   // 替换索引中已有的文档
+    std::optional<qint64> modifyTime;   // 写入成功后补充到 IndexReadContext 的修改时间表
+    BuilderOptions options;
+    IndexExtractionResult extraction;
+};
 
+// 尝试通过校验和去重或旧索引迁移得到文本，成功时不需要再提取
+bool resolveCachedText(const IndexContext &context, PendingDocument &pending,
+                       const IndexContentMigrator *migrator, IndexReadContext *readContext)
+{
+    try {
         // Checksum-based deduplication (profile decides whether to support it)
-        options.checksum = context.profile().computeChecksum(file);
-        if (!options.checksum.isEmpty()) {
-            const QString cachedText = context.profile().lookupCachedText(options.checksum);
+        pending.options.checksum = context.profile().computeChecksum(pending.path);
+        if (!pending.options.checksum.isEmpty()) {
+            // 任务内复用同一个 searcher，不再为每次查询打开索引
+            const QString cachedText = readContext ? readContext->lookupTextByChecksum(pending.options.checksum)
+                                                   : context.profile().lookupCachedText(pending.options.checksum);
             if (!cachedText.isEmpty()) {
-                fmInfo() << "[createFileDocument] Text cache hit for:" << file
+                fmInfo() << "[resolveCachedText] Text cache hit for:" << pending.path
                          << "profile:" << context.profile().id()
-                         << "checksum:" << options.checksum;
-                extraction = { .success = true,
-                               .text = cachedText,
-                               .error = {},
-                               .checksum = options.checksum,
-                               .deduplicated = true };
+                         << "checksum:" << pending.options.checksum;
+                pending.extraction = { .success = true,
+                                       .text = cachedText,
+                                       .error = {},
+                                       .checksum = pending.options.checksum,
+                                       .deduplicated = true };
+                return true;
             }
         }
 
         // If cache did not provide text, try content migration from old index
-        if (!extraction.deduplicated && migrator && migrator->isActive()) {
-            const auto migratedContent = migrator->lookupContent(file);
+        if (migrator && migrator->isActive()) {
+            const auto migratedContent = migrator->lookupContent(pending.path);
             if (migratedContent.has_value()) {
-                extraction = { .success = true,
-                               .text = *migratedContent,
-                               .error = {},
-                               .checksum = options.checksum,
-                               .deduplicated = true };
+                pending.extraction = { .success = true,
+                                       .text = *migratedContent,
+                                       .error = {},
+                                       .checksum = pending.options.checksum,
+                                       .deduplicated = true };
+                return true;
             }
         }
+    } catch (const LuceneException &e) {
+        fmWarning() << "[resolveCachedText] Lookup cached text failed with Lucene exception:" << pending.path
+                    << "error:" << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "[resolveCachedText] Lookup cached text failed with exception:" << pending.path
+                    << "error:" << e.what();
+    } catch (...) {
+        fmWarning() << "[resolveCachedText] Lookup cached text failed with unknown exception:" << pending.path;
+    }
 
-        // If neither cache nor migration provided text, perform normal extraction
-        if (!extraction.deduplicated) {
-            extraction = context.extractor()->extract(file, maxBytes);
-            if (!extraction.success) {
-                fmInfo() << "[createFileDocument] Failed to extract content from file:" << file
-                         << "profile:" << context.profile().id()
-                         << "error:" << extraction.error;
-            }
-            extraction.checksum = options.checksum;
-        }
+    return false;
+}
 
-        return context.documentBuilder()->build(file, extraction.text, options);
+DocumentPtr createFileDocument(const IndexContext &context, const PendingDocument &pending)
+{
+    try {
+        return context.documentBuilder()->build(pending.path, pending.extraction.text, pending.options);
     } catch (const LuceneException &e) {
-        fmWarning() << "[createFileDocument] Create document failed with Lucene exception:" << file
+        fmWarning() << "[createFileDocument] Create document failed with Lucene exception:" << pending.path
                     << "error:" << QString::fromStdWString(e.getError());
     } catch (const std::exception &e) {
-        fmWarning() << "[createFileDocument] Create document failed with exception:" << file
+        fmWarning() << "[createFileDocument] Create document failed with exception:" << pending.path
                     << "error:" << e.what();
     } catch (...) {
-        fmWarning() << "[createFileDocument] Create document failed with unknown exception:" << file;
+        fmWarning() << "[createFileDocument] Create document failed with unknown exception:" << pending.path;
     }
 
     // 发生异常时返回一个空的基本文档，防止调用方受到影响
     try {
-        DocumentPtr basicDoc = context.documentBuilder()->build(file, QString());
-        fmDebug() << "[createFileDocument] Created basic document without content for:" << file;
+        DocumentPtr basicDoc = context.documentBuilder()->build(pending.path, QString());
+        fmDebug() << "[createFileDocument] Created basic document without content for:" << pending.path;
         return basicDoc;
     } catch (...) {
-        fmCritical() << "[createFileDocument] Failed to create even a basic document for:" << file;
+        fmCritical() << "[createFileDocument] Failed to create even a basic document for:" << pending.path;
         return nullptr;   // 最坏情况，返回空指针，调用方需要检查
     }
 }
 
-bool checkNeedUpdate(const IndexContext &context, const QString &file, const IndexReaderPtr &reader, bool *needAdd)
+/**
+ * @brief 攒够一批文件后一起提交给提取器
+ *
+ * 提取器由多个进程组成时，逐个文件同步提取只能用到其中一个进程。这里按提取器建议的批量
+ * 收集需要提取的文件，一次提交、并行提取，再在任务线程中按加入顺序写入索引。
+ * 去重和迁移在加入时完成，命中的文件不会提交给提取器。
+ */
+class DocumentBatch
 {
-    try {
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
-        TermQueryPtr query = newLucene<TermQuery>(newLucene<Term>(context.profile().pathField(), file.toStdWString()));
+public:
+    DocumentBatch(const IndexContext &context, const IndexWriterPtr &writer, ProgressReporter *reporter,
+                  const IndexContentMigrator *migrator = nullptr, IndexReadContext *readContext = nullptr)
+        : m_context(context),
+          m_writer(writer),
+          m_reporter(reporter),
+          m_migrator(migrator),
+          m_readContext(readContext),
+          m_capacity(context.extractor() ? qMax(1, context.extractor()->preferredBatchSize()) : 1)
+    {
+    }
 
-        Collection<String> fieldsToLoad = Collection<String>::newInstance();
-        fieldsToLoad.add(context.profile().pathField());
-        fieldsToLoad.add(context.profile().modifyTimeField());
-        FieldSelectorPtr fieldSelector = newLucene<MapFieldSelector>(fieldsToLoad);
+    void add(const QString &path, bool update, std::optional<qint64> modifyTime = std::nullopt)
+    {
+        if (!m_context.extractor() || !m_context.documentBuilder()) {
+            fmCritical() << "[DocumentBatch::add] Missing extractor or document builder for profile:" << m_context.profile().id();
+            return;
+        }
+
+        PendingDocument pending;
+        pending.path = path;
+        pending.update = update;
+        pending.modifyTime = modifyTime;
+        resolveCachedText(m_context, pending, m_migrator, m_readContext);
+        m_pendingPaths.insert(path);
+        m_pending.append(std::move(pending));
+
+        if (m_pending.size() >= m_capacity)
+            flush();
+    }
+
+    void flush()
+    {
+        if (m_pending.isEmpty())
+            return;
+
+        QList<PendingDocument> pending;
+        pending.swap(m_pending);
+        m_pendingPaths.clear();
+
+        extract(pending);
+        for (const PendingDocument &document : std::as_const(pending)) {
+            // 只有写入成功的文档才记录，失败或中断丢弃的文件下次仍会被检查
+            if (write(document) && m_readContext && document.modifyTime)
+                m_readContext->recordIndexed(document.path, *document.modifyTime);
+        }
+    }
+
+    bool contains(const QString &path) const
+    {
+        return m_pendingPaths.contains(path);
+    }
+
+private:
+    void extract(QList<PendingDocument> &pending) const
+    {
+        QStringList paths;
+        QList<int> indexes;
+        for (int i = 0; i < pending.size(); ++i) {
+            if (pending.at(i).extraction.deduplicated)
+                continue;
+            paths.append(pending.at(i).path);
+            indexes.append(i);
+        }
+
+        if (paths.isEmpty())
+            return;
+
+        const int truncationSizeMB = m_context.profile().maxFileTruncationSizeMB();
+        const size_t maxBytes = static_cast<size_t>(truncationSizeMB) * 1024 * 1024;
+        const QList<IndexExtractionResult> results = m_context.extractor()->extractBatch(paths, maxBytes);
+
+        for (int i = 0; i < indexes.size(); ++i) {
+            PendingDocument &document = pending[indexes.at(i)];
+            document.extraction = results.value(i, { false, QString(), QStringLiteral("Missing extraction result") });
+            if (!document.extraction.success) {
+                fmInfo() << "[DocumentBatch::extract] Failed to extract content from file:" << document.path
+                         << "profile:" << m_context.profile().id()
+                         << "error:" << document.extraction.error;
+            }
+            document.extraction.checksum = document.options.checksum;
+        }
+    }
+
+    bool write(const PendingDocument &pending) const
+    {
+        try {
+            DocumentPtr doc = createFileDocument(m_context, pending);
+            if (!doc) {
+                fmWarning() << "[DocumentBatch::write] Failed to create document for:" << pending.path;
+                return false;
+            }
+
+            if (pending.update) {
+                fmDebug() << "[DocumentBatch::write] Updating existing file:" << pending.path;
+                TermPtr term = newLucene<Term>(m_context.profile().pathField(), pending.path.toStdWString());
+                m_writer->updateDocument(term, doc);
+            } else {
+                m_writer->addDocument(doc);
+            }
 
-        TopDocsPtr topDocs = searcher->search(query, 1);
-        int32_t numTotalHits = topDocs->totalHits;
-        if (numTotalHits == 0) {
+            if (m_reporter) {
+                m_reporter->markIndexChanged();
+                m_reporter->increment();
+            }
+            return true;
+        } catch (const LuceneException &e) {
+            fmWarning() << "[DocumentBatch::write] Write document failed with Lucene exception:" << pending.path
+                        << "error:" << QString::fromStdWString(e.getError());
+        } catch (const std::exception &e) {
+            fmWarning() << "[DocumentBatch::write] Write document failed with exception:" << pending.path
+                        << "error:" << e.what();
+        } catch (...) {
+            fmWarning() << "[DocumentBatch::write] Write document failed with unknown exception:" << pending.path;
+        }
+        return false;
+    }
+
+    const IndexContext &m_context;
+    IndexWriterPtr m_writer;
+    ProgressReporter *m_reporter { nullptr };
+    const IndexContentMigrator *m_migrator { nullptr };
+    IndexReadContext *m_readContext { nullptr };
+    const int m_capacity;
+    QList<PendingDocument> m_pending;
+    QSet<QString> m_pendingPaths;
+};
+
+bool checkNeedUpdate(const IndexContext &context, const QString &file, IndexReadContext &readContext,
+                     bool *needAdd, qint64 *modifyTime)
+{
+    try {
+        // 修改时间在任务内整体加载一次，逐个文件只做哈希查找
+        const std::optional<qint64> storeTime = readContext.storedModifyTime(file);
+        if (!storeTime.has_value()) {
             if (needAdd)
                 *needAdd = true;
+            *modifyTime = QFileInfo(file).lastModified().toSecsSinceEpoch();
             return true;
         }
 
-        DocumentPtr doc = searcher->doc(topDocs->scoreDocs[0]->doc, fieldSelector);
         QFileInfo fileInfo(file);
         if (!fileInfo.exists()) {
             fmDebug() << "[checkNeedUpdate] File no longer exists:" << file;
             return false;
         }
 
+        *modifyTime = fileInfo.lastModified().toSecsSinceEpoch();
         if (!context.profile().supportsModifiedTimestampCheck()) {
             return true;
         }
 
-        const QDateTime modifyTime = fileInfo.lastModified();
-        const QString modifyEpoch = QString::number(modifyTime.toSecsSinceEpoch());
-        const String &storeTime = doc->get(context.profile().modifyTimeField());
-
-        bool needsUpdate = modifyEpoch.toStdWString() != storeTime;
+        bool needsUpdate = *modifyTime != *storeTime;
         if (needsUpdate) {
             fmDebug() << "[checkNeedUpdate] File needs update:" << file
-                      << "stored time:" << QString::fromStdWString(storeTime)
-                      << "current time:" << modifyEpoch;
+                      << "stored time:" << *storeTime
+                      << "current time:" << *modifyTime;
         }
         return needsUpdate;
     } catch (const LuceneException &e) {
@@ -342,8 +491,7 @@ bool shouldSkipExcludedFile(const QString &path, const PathExcludeMatcher &exclu
 }
 
 void processFile(const IndexContext &context, const QString &path, const PathExcludeMatcher &excludeMatcher,
-                 const IndexWriterPtr &writer, ProgressReporter *reporter,
-                 const IndexContentMigrator *migrator = nullptr)
+                 DocumentBatch &batch)
 {
     try {
         if (!context.profile().isCandidateFile(path))
@@ -353,16 +501,7 @@ void processFile(const IndexContext &context, const QString &path, const PathExc
 #ifdef QT_DEBUG
         fmDebug() << "Adding [" << path << "]";
 #endif
-        DocumentPtr doc = createFileDocument(context, path, migrator);
-        if (!doc) {
-            fmWarning() << "[processFile] Failed to create document for:" << path;
-            return;
-        }
-        writer->addDocument(doc);
-        if (reporter) {
-            reporter->markIndexChanged();
-            reporter->increment();
-        }
+        batch.add(path, false);
     } catch (const LuceneException &e) {
         fmWarning() << "[processFile] Process file failed with Lucene exception:" << path
                     << "error:" << QString::fromStdWString(e.getError());
@@ -375,39 +514,25 @@ void processFile(const IndexContext &context, const QString &path, const PathExc
 }
 
 void updateFile(const IndexContext &context, const QString &path, const PathExcludeMatcher &excludeMatcher,
-                const IndexReaderPtr &reader,
-                const IndexWriterPtr &writer, ProgressReporter *reporter,
-                const IndexContentMigrator *migrator = nullptr)
+                IndexReadContext &readContext, DocumentBatch &batch, ProgressReporter *reporter)
 {
     try {
         if (!context.profile().isCandidateFile(path))
             return;
         if (shouldSkipExcludedFile(path, excludeMatcher))
             return;
+        // 同一任务内再次遇到尚在批次中的路径时不重复添加，写入后由 recordIndexed 的记录去重
+        if (batch.contains(path))
+            return;
 
         bool needAdd = false;
-        if (checkNeedUpdate(context, path, reader, &needAdd)) {
-            DocumentPtr doc = createFileDocument(context, path, migrator);
-            if (!doc) {
-                fmWarning() << "[updateFile] Failed to create document for:" << path;
-                return;
-            }
-
-            if (needAdd) {
+        qint64 modifyTime = 0;
+        if (checkNeedUpdate(context, path, readContext, &needAdd, &modifyTime)) {
 #ifdef QT_DEBUG
+            if (needAdd)
                 fmDebug() << "Adding [" << path << "]";
 #endif
-                writer->addDocument(doc);
-            } else {
-                fmDebug() << "[updateFile] Updating existing file:" << path;
-                TermPtr term = newLucene<Term>(context.profile().pathField(), path.toStdWString());
-                writer->updateDocument(term, doc);
-            }
-
-            if (reporter) {
-                reporter->markIndexChanged();
-                reporter->increment();
-            }
+            batch.add(path, !needAdd, modifyTime);
         } else {
             if (reporter) {
                 reporter->increment();
@@ -446,16 +571,17 @@ void removeFile(const IndexContext &context, const QString &path, const IndexWri
     }
 }
 
-bool cleanupIndexs(const IndexContext &context, IndexReaderPtr reader, IndexWriterPtr writer, TaskState &running, ProgressReporter *reporter)
+bool cleanupIndexs(const IndexContext &context, IndexReadContext &readContext, IndexWriterPtr writer, TaskState &running, ProgressReporter *reporter)
 {
     try {
+        IndexReaderPtr reader = readContext.reader();
         if (!reader || !writer) {
             fmCritical() << "[cleanupIndexs] Invalid reader or writer for index cleanup";
             return false;
         }
 
         fmInfo() << "[cleanupIndexs] Starting index cleanup - checking for deleted files";
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
+        SearcherPtr searcher = readContext.searcher();
         if (!searcher) {
             fmCritical() << "[cleanupIndexs] Failed to create searcher for index cleanup";
             return false;
@@ -536,6 +662,7 @@ bool cleanupIndexs(const IndexContext &context, IndexReaderPtr reader, IndexWrit
                     TermPtr term = newLucene<Term>(context.profile().pathField(), pathValue);   // Create Term only when needed
                     if (term) {
                         writer->deleteDocuments(term);
+                        readContext.forget(filePath);
                         removedCount++;
                     }
                 } catch (const std::exception &e) {
@@ -577,20 +704,18 @@ bool cleanupIndexs(const IndexContext &context, IndexReaderPtr reader, IndexWrit
 
 // 移除目录下所有文件的索引
 void removeDirectoryIndex(const IndexContext &context, const QString &dirPath, const IndexWriterPtr &writer,
-                          const IndexReaderPtr &reader, ProgressReporter *reporter)
+                          const SearcherPtr &searcher, ProgressReporter *reporter)
 {
     try {
         fmInfo() << "[removeDirectoryIndex] Removing directory index for:" << dirPath;
 
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
-
         // 使用 TermQuery 在 ancestor_paths 字段上进行精确匹配
         // ancestor_paths 字段存储了文件的所有祖先路径（不带尾部斜杠）
         // 利用此字段可以避免 PrefixQuery 的字典树扫描，显著提升性能
         TermQueryPtr ancestorQuery = newLucene<TermQuery>(
                 newLucene<Term>(context.profile().ancestorPathsField(), dirPath.toStdWString()));
 
-        TopDocsPtr allDocs = searcher->search(ancestorQuery, reader->maxDoc());
+        TopDocsPtr allDocs = searcher->search(ancestorQuery, searcher->maxDoc());
 
         // 检查allDocs是否有效
         if (!allDocs) {
@@ -727,15 +852,18 @@ TaskHandler TaskHandlers::CreateIndexHandler(const IndexContext &context)
                 fmInfo() << "[CreateIndexHandler] Using ANYTHING for file discovery";
             }
 
-            ProgressReporter reporter(writer);
+            // 去重查询共用一个 reader，每次批量提交后刷新
+            IndexReadContext readContext(context.profile(), indexDir);
+            ProgressReporter reporter(writer, &readContext);
             const PathExcludeMatcher excludeMatcher = PathExcludeMatcher::createForIndex();
             qint64 totalCount = provider->totalCount();
             reporter.setTotal(totalCount);
             fmInfo() << "[CreateIndexHandler] Starting file processing, estimated total files:" << totalCount;
 
+            DocumentBatch batch(context, writer, &reporter,
+                                migrator.isActive() ? &migrator : nullptr, &readContext);
             provider->traverse(running, [&](const QString &file) {
-                processFile(context, file, excludeMatcher, writer, &reporter,
-                      migrator.isActive() ? &migrator : nullptr);
+                processFile(context, file, excludeMatcher, batch);
             });
 
             // Only the creation of an index that is interrupted is also considered a failure
@@ -747,6 +875,9 @@ TaskHandler TaskHandlers::CreateIndexHandler(const IndexContext &context)
                 return result;
             }
 
+            // 写入最后一批未满的文件
+            batch.flush();
+
             // ProgressReporter的析构函数会处理最后的commit，但为了确保在optimize前所有更改都已提交
             // 我们显式调用一次commit
             fmDebug() << "[CreateIndexHandler] Ensuring all changes are committed before optimization";
@@ -790,20 +921,9 @@ TaskHandler TaskHandlers::UpdateIndexHandler(const IndexContext &context)
         }
 
         try {
-            IndexReaderPtr reader = IndexReader::open(
-                    FSDirectory::open(indexDir.toStdWString()), true);
-
-            // 添加 reader 的 ScopeGuard
-            ScopeGuard readerCloser([&reader]() {
-                try {
-                    if (reader) {
-                        reader->close();
-                        fmDebug() << "[UpdateIndexHandler] Index reader closed successfully";
-                    }
-                } catch (...) {
-                    fmWarning() << "[UpdateIndexHandler] Exception occurred while closing index reader";
-                }
-            });
+            // 整个任务共用一个 reader，在这里打开以便索引损坏时立即抛出
+            IndexReadContext readContext(context.profile(), indexDir);
+            readContext.reader();
 
             IndexWriterPtr writer = newLucene<IndexWriter>(
                     FSDirectory::open(indexDir.toStdWString()),
@@ -825,10 +945,10 @@ TaskHandler TaskHandlers::UpdateIndexHandler(const IndexContext &context)
 
             fmDebug() << "[UpdateIndexHandler] Index reader and writer initialized for directory:" << indexDir;
 
-            ProgressReporter reporter(writer);
+            ProgressReporter reporter(writer, &readContext);
 
             // 清理已删除文件的索引
-            if (!cleanupIndexs(context, reader, writer, running, &reporter)) {
+            if (!cleanupIndexs(context, readContext, writer, running, &reporter)) {
                 fmCritical() << "[UpdateIndexHandler] Index cleanup failed, aborting update";
                 result.success = false;
                 result.fatal = true;
@@ -852,14 +972,18 @@ TaskHandler TaskHandlers::UpdateIndexHandler(const IndexContext &context)
             reporter.setTotal(totalCount);
             fmDebug() << "[UpdateIndexHandler] Starting file update processing, estimated total files:" << totalCount;
 
+            DocumentBatch batch(context, writer, &reporter,
+                                migrator.isActive() ? &migrator : nullptr, &readContext);
             provider->traverse(running, [&](const QString &file) {
-                updateFile(context, file, excludeMatcher, reader, writer, &reporter,
-                       migrator.isActive() ? &migrator : nullptr);
+                updateFile(context, file, excludeMatcher, readContext, batch, &reporter);
             });
 
             if (!running.isRunning()) {
                 fmWarning() << "[UpdateIndexHandler] Index update was interrupted by user request";
                 result.interrupted = true;
+            } else {
+                // 写入最后一批未满的文件，中断时丢弃，留给下次更新
+                batch.flush();
             }
 
             // ProgressReporter的析构函数会处理最后的commit，确保所有更改都已提交
@@ -905,20 +1029,9 @@ TaskHandler TaskHandlers::CreateOrUpdateFileListHandler(const IndexContext &cont
         QString indexDir = context.profile().indexDirectory();
 
         try {
-            IndexReaderPtr reader = IndexReader::open(
-                    FSDirectory::open(indexDir.toStdWString()), true);
-
-            // 添加 reader 的 ScopeGuard
-            ScopeGuard readerCloser([&reader]() {
-                try {
-                    if (reader) {
-                        reader->close();
-                        fmDebug() << "[CreateOrUpdateFileListHandler] Index reader closed successfully";
-                    }
-                } catch (...) {
-                    fmWarning() << "[CreateOrUpdateFileListHandler] Exception occurred while closing index reader";
-                }
-            });
+            // 整个任务共用一个 reader，在这里打开以便索引损坏时立即抛出
+            IndexReadContext readContext(context.profile(), indexDir);
+            readContext.reader();
 
             IndexWriterPtr writer = newLucene<IndexWriter>(
                     FSDirectory::open(indexDir.toStdWString()),
@@ -947,19 +1060,23 @@ TaskHandler TaskHandlers::CreateOrUpdateFileListHandler(const IndexContext &cont
                 return result;
             }
 
-            ProgressReporter reporter(writer);
+            ProgressReporter reporter(writer, &readContext);
             const PathExcludeMatcher excludeMatcher = PathExcludeMatcher::createForIndex();
             qint64 totalCount = provider->totalCount();
             reporter.setTotal(totalCount);
             fmInfo() << "[CreateOrUpdateFileListHandler] Starting file list processing, total files:" << totalCount;
 
+            DocumentBatch batch(context, writer, &reporter, nullptr, &readContext);
             provider->traverse(running, [&](const QString &file) {
-                updateFile(context, file, excludeMatcher, reader, writer, &reporter);
+                updateFile(context, file, excludeMatcher, readContext, batch, &reporter);
             });
 
             if (!running.isRunning()) {
                 fmWarning() << "[CreateOrUpdateFileListHandler] File list update was interrupted by user request";
                 result.interrupted = true;
+            } else {
+                // 写入最后一批未满的文件，中断时丢弃，留给下次更新
+                batch.flush();
             }
 
             // ProgressReporter的析构函数会处理最后的commit
@@ -1052,7 +1169,7 @@ TaskHandler TaskHandlers::RemoveFileListHandler(const IndexContext &context, con
 
                 if (result->totalHits > 0) {
                     // 有子文件，是目录
-                    removeDirectoryIndex(context, itemPath, writer, reader, &reporter);
+                    removeDirectoryIndex(context, itemPath, writer, searcher, &reporter);
                     directoriesRemoved++;
                     fmDebug() << "[RemoveFileListHandler] Processed directory removal:" << itemPath;
                 } else {
@@ -198,6 +198,16 @@ void TextIndexConfig::loadAllConfigs()
         m_batchCommitInterval = DEFAULT_BATCH_COMMIT_INTERVAL;
     }
 
+    // Extractor process pool size
+    m_maxExtractorProcesses = m_dconfigManager->value(
+                                                      Defines::DConf::kTextIndexSchema,
+                                                      Defines::DConf::kMaxExtractorProcesses,
+                                                      DEFAULT_MAX_EXTRACTOR_PROCESSES)
+                                      .toInt();
+    if (m_maxExtractorProcesses < 0 || m_maxExtractorProcesses > 16) {
+        m_maxExtractorProcesses = DEFAULT_MAX_EXTRACTOR_PROCESSES;
+    }
+
     // --- Strategy optimization config keys (environment detection) ---
 
     m_idleThresholdSeconds = m_dconfigManager->value(
@@ -321,6 +331,12 @@ int TextIndexConfig::batchCommitInterval() const
     return m_batchCommitInterval;
 }
 
+int TextIndexConfig::maxExtractorProcesses() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxExtractorProcesses;
+}
+
 int TextIndexConfig::idleThresholdSeconds() const
 {
     QMutexLocker locker(&m_mutex);
@@ -38,6 +38,7 @@ public:
     int cpuUsageLimitPercent() const;
     double inotifyWatchesCoefficient() const;
     int batchCommitInterval() const;
+    int maxExtractorProcesses() const;
 
     // Strategy optimization – environment detection
     int idleThresholdSeconds() const;
@@ -75,6 +76,7 @@ private:
     int m_cpuUsageLimitPercent;
     double m_inotifyWatchesCoefficient;
     int m_batchCommitInterval;
+    int m_maxExtractorProcesses { 0 };
 
     int m_idleThresholdSeconds { 30 };
     int m_loadSampleIntervalSeconds { 5 };
@@ -95,6 +97,7 @@ private:
     static const int DEFAULT_CPU_USAGE_LIMIT_PERCENT = 50;
     static constexpr double DEFAULT_INOTIFY_WATCHES_COEFFICIENT = 0.5;
     static const int DEFAULT_BATCH_COMMIT_INTERVAL = 1000;
+    static const int DEFAULT_MAX_EXTRACTOR_PROCESSES = 0;   // 0: decided by CPU count
     static const int DEFAULT_IDLE_THRESHOLD_SECONDS = 30;
     static const int DEFAULT_LOAD_SAMPLE_INTERVAL_SECONDS = 5;
     static const int DEFAULT_CPU_LOAD_THRESHOLD_PERCENT = 30;
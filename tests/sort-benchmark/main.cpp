@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 文件视图排序基准：用合成目录（默认 10 万 / 100 万项）测量 FileViewSorter 各排序角色的耗时
+//   cold   - 首次排序，包含排序键生成
+//   warm   - 排序键已缓存时的重排（切换列后再切回、插入新文件后重排）
+//   legacy - 不使用 SortKeyStore 的 QUrl 路径
+
+#include "utils/fileviewsorter.h"
+#include "utils/sortkeystore.h"
+
+#include <dfm-base/interfaces/sortfileinfo.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QThread>
+
+#include <functional>
+
+namespace dfmplugin_workspace {
+DFM_LOG_REGISTER_CATEGORY(DPWORKSPACE_NAMESPACE)
+}
+
+using namespace dfmplugin_workspace;
+
+namespace {
+
+const QStringList kNamePatterns {
+    QStringLiteral("IMG_%1.jpg"),
+    QStringLiteral("DSC%1.NEF"),
+    QStringLiteral("Screenshot %1.png"),
+    QStringLiteral("report-%1.pdf"),
+    QStringLiteral("视频%1.mp4"),
+    QStringLiteral("新建文档 (%1).txt"),
+    QStringLiteral("archive_%1.tar.gz"),
+    QStringLiteral("folder %1"),
+};
+
+QList<SortInfoPointer> makeDirectory(int count, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QList<SortInfoPointer> infos;
+    infos.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const int pattern = static_cast<int>(random.bounded(kNamePatterns.size()));
+        const bool isDir = pattern == kNamePatterns.size() - 1;
+        SortInfoPointer info(new dfmbase::SortFileInfo);
+        info->setUrl(QUrl::fromLocalFile(QStringLiteral("/tmp/sort-benchmark/")
+                                         + kNamePatterns.at(pattern).arg(random.bounded(count * 4))
+                                         + QLatin1Char('.') + QString::number(i)));
+        info->setDir(isDir);
+        info->setFile(!isDir);
+        info->setSize(isDir ? 0 : static_cast<qint64>(random.bounded(1u << 30)));
+        info->setLastModifiedTime(1500000000 + random.bounded(300000000));
+        info->setInfoCompleted(true);
+        infos.append(info);
+    }
+    return infos;
+}
+
+qint64 measure(const std::function<void()> &func)
+{
+    QElapsedTimer timer;
+    timer.start();
+    func();
+    return timer.elapsed();
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark FileViewSorter on synthetic directories");
+    parser.addHelpOption();
+    parser.addPositionalArgument("counts", "Entry counts of the synthetic directories (default: 100000 1000000)");
+    QCommandLineOption noLegacyOption("no-legacy", "Skip the QUrl based sort without SortKeyStore");
+    parser.addOption(noLegacyOption);
+    parser.process(app);
+
+    QList<int> counts;
+    for (const QString &arg : parser.positionalArguments()) {
+        bool ok = false;
+        const int count = arg.toInt(&ok);
+        if (ok && count > 0)
+            counts.append(count);
+    }
+    if (counts.isEmpty())
+        counts = { 100000, 1000000 };
+
+    const QList<QPair<QString, FileViewSorter::SortRole>> roles {
+        { "FileName", FileViewSorter::SortRole::FileName },
+        { "Size", FileViewSorter::SortRole::Size },
+        { "LastModified", FileViewSorter::SortRole::LastModified },
+        { "MimeType", FileViewSorter::SortRole::MimeType },
+    };
+
+    QTextStream out(stdout);
+    out << "threads: " << QThread::idealThreadCount() << Qt::endl;
+    out << QString("%1 %2 %3 %4 %5").arg("entries", 9).arg("role", 14).arg("cold ms", 9).arg("warm ms", 9).arg("legacy ms", 10)
+        << Qt::endl;
+
+    for (int count : counts) {
+        const QList<SortInfoPointer> &infos = makeDirectory(count, static_cast<quint32>(count));
+        SortKeyStore store;
+        QList<QUrl> urls;
+        urls.reserve(infos.size());
+        for (const auto &info : infos) {
+            store.insert(info);
+            urls.append(info->fileUrl());
+        }
+
+        for (const auto &role : roles) {
+            FileViewSorter sorter;
+            FileViewSorter::SortContext ctx;
+            ctx.role = role.second;
+            ctx.order = Qt::AscendingOrder;
+            ctx.isMixDirAndFile = false;
+            sorter.setContext(ctx);
+
+            store.invalidateKeys();
+            QList<QUrl> sorted;
+            const qint64 cold = measure([&] { sorted = sorter.sort(urls, &store); });
+            const qint64 warm = measure([&] { sorted = sorter.sort(urls, &store); });
+            qint64 legacy = -1;
+            if (!parser.isSet(noLegacyOption))
+                legacy = measure([&] { sorted = sorter.sort(urls); });
+
+            out << QString("%1 %2 %3 %4 %5")
+                            .arg(count, 9)
+                            .arg(role.first, 14)
+                            .arg(cold, 9)
+                            .arg(warm, 9)
+                            .arg(legacy < 0 ? QString("-") : QString::number(legacy), 10)
+                << Qt::endl;
+        }
+    }
+
+    return 0;
+}